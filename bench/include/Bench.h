@@ -0,0 +1,119 @@
+#pragma once
+
+#include <json/json.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Bench
+{
+    //
+    // A single benchmark case, built only when the case is selected by the filter.
+    // run is the timed operation. reset, when set, is called before every run without being timed
+    // (eg. to clear caches or discard the previous iteration's writes).
+    //
+    struct Case
+    {
+        std::function<void()> run;
+        std::function<void()> reset{ nullptr };
+    };
+
+    struct Result
+    {
+        std::string name;
+
+        // Number of items (proofs, hashes, blocks, etc.) processed by each run.
+        uint64_t items;
+        uint64_t iterations;
+
+        // Nanoseconds per run.
+        double min_ns;
+        double mean_ns;
+        double median_ns;
+        double p99_ns;
+        double stddev_ns;
+
+        Json::Value ToJSON() const;
+    };
+
+    struct Options
+    {
+        std::string filter{ "" };
+        uint64_t min_time_ms{ 1000 };
+        uint64_t min_iterations{ 5 };
+        uint64_t max_iterations{ 1'000'000 };
+        bool list_only{ false };
+    };
+
+    class Runner
+    {
+    public:
+        Runner(const Options& options) : m_options(options) { }
+
+        //
+        // Runs the case returned by prepare if name contains the filter.
+        // Each run processes the given number of items, which is used to report per-item timings.
+        //
+        void Run(const std::string& name, const uint64_t items, const std::function<Case()>& prepare);
+
+        const std::vector<Result>& GetResults() const noexcept { return m_results; }
+
+    private:
+        Options m_options;
+        std::vector<Result> m_results;
+    };
+
+    using Group = std::function<void(Runner&)>;
+
+    // Defined out-of-line, so the compiler can't see that the pointer is never read.
+    void UseCharPointer(const volatile char* pValue);
+
+    //
+    // Keeps a result that's otherwise unused from being optimized away, along with the work that computed it.
+    //
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    class Registry
+    {
+    public:
+        static std::vector<std::pair<std::string, Group>>& GetGroups();
+
+        struct Registrar
+        {
+            Registrar(const std::string& name, const Group& group)
+            {
+                GetGroups().push_back({ name, group });
+            }
+        };
+    };
+}
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+
+//
+// Registers a group of related benchmark cases. Usage:
+//
+// BENCH_GROUP("crypto/commitments", runner)
+// {
+//     runner.Run("crypto/commitments/add/100", 100, []() { ... return Bench::Case{ ... }; });
+// }
+//
+#define BENCH_GROUP(name, runner) \
+    static void BENCH_CONCAT(BenchGroup_, __LINE__)(Bench::Runner& runner); \
+    static Bench::Registry::Registrar BENCH_CONCAT(BenchRegistrar_, __LINE__)(name, &BENCH_CONCAT(BenchGroup_, __LINE__)); \
+    static void BENCH_CONCAT(BenchGroup_, __LINE__)(Bench::Runner& runner)
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Core/Models/FullBlock.h>
+#include <Core/Models/TransactionKernel.h>
+#include <Core/Models/TransactionOutput.h>
+#include <Crypto/Models/BlindingFactor.h>
+#include <Crypto/Models/Commitment.h>
+#include <filesystem.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+//
+// Deterministic inputs for the benchmarks.
+// Everything is derived from a single seed, so results are comparable across runs and machines.
+// Expensive items (rangeproofs, signatures, commitments) come from small pools that are generated on first use,
+// and larger inputs repeat pool items, which doesn't affect the cost of verifying or serializing them.
+//
+class BenchData
+{
+public:
+    static void SetSeed(const uint64_t seed) noexcept;
+    static uint64_t GetSeed() noexcept;
+
+    // Returns a generator for the given stream. The same seed and stream always produce the same sequence.
+    static std::mt19937_64 Rng(const uint64_t stream);
+
+    static std::vector<uint8_t> RandomBytes(std::mt19937_64& rng, const size_t numBytes);
+    static BlindingFactor RandomBlind(std::mt19937_64& rng);
+
+    static std::vector<Commitment> Commitments(const size_t count);
+    static std::vector<TransactionOutput> Outputs(const size_t count);
+    static std::vector<TransactionKernel> Kernels(const size_t count);
+
+    // A block with the genesis header and the given number of inputs, outputs and kernels.
+    static FullBlock Block(const size_t numInputs, const size_t numOutputs, const size_t numKernels);
+
+    // Directory for files created by the benchmarks. Removed when the benchmarks finish.
+    static fs::path GetTempDir();
+    static void RemoveTempDir();
+
+private:
+    template<typename T>
+    static std::vector<T> Cycle(const std::vector<T>& pool, const size_t count)
+    {
+        std::vector<T> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            items.push_back(pool[i % pool.size()]);
+        }
+
+        return items;
+    }
+};
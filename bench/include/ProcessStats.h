@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+//
+// Resource usage of the current process, as reported by the OS.
+//
+class ProcessStats
+{
+public:
+    // The largest resident set size the process has reached so far, in bytes.
+    static uint64_t GetPeakRSS()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return (uint64_t)counters.PeakWorkingSetSize;
+        }
+
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+
+#ifdef __APPLE__
+        return (uint64_t)usage.ru_maxrss;
+#else
+        // Reported in kilobytes on Linux and the BSDs.
+        return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+    }
+
+    // User plus system CPU time consumed by all threads of the process.
+    static std::chrono::microseconds GetCPUTime()
+    {
+#ifdef _WIN32
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+            return std::chrono::microseconds(0);
+        }
+
+        // FILETIMEs are in 100 nanosecond intervals.
+        const uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+        const uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+        return std::chrono::microseconds((kernel + user) / 10);
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return std::chrono::microseconds(0);
+        }
+
+        return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+            + std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+    }
+
+    // User plus system CPU time consumed by the calling thread.
+    static std::chrono::microseconds GetThreadCPUTime()
+    {
+#ifdef _WIN32
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+            return std::chrono::microseconds(0);
+        }
+
+        const uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+        const uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+        return std::chrono::microseconds((kernel + user) / 10);
+#else
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+            return std::chrono::microseconds(0);
+        }
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+#endif
+    }
+};
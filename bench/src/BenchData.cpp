@@ -0,0 +1,147 @@
+#include <BenchData.h>
+#include <TxBuilder.h>
+
+#include <Core/Global.h>
+#include <Crypto/Crypto.h>
+#include <Common/Util/FileUtil.h>
+#include <Wallet/Keychain/KeyChain.h>
+#include <uuid.h>
+
+// Generating rangeproofs is slow, so only a handful of distinct outputs are built.
+static const size_t OUTPUT_POOL_SIZE = 128;
+static const size_t KERNEL_POOL_SIZE = 1024;
+static const size_t COMMITMENT_POOL_SIZE = 4096;
+
+// Streams used to derive each kind of input from the seed.
+enum EStream : uint64_t
+{
+    COMMITMENTS = 1,
+    OUTPUTS = 2,
+    KERNELS = 3,
+    KEYCHAIN = 4
+};
+
+static uint64_t SEED = 0x6772696e2b2b;
+
+void BenchData::SetSeed(const uint64_t seed) noexcept
+{
+    SEED = seed;
+}
+
+uint64_t BenchData::GetSeed() noexcept
+{
+    return SEED;
+}
+
+std::mt19937_64 BenchData::Rng(const uint64_t stream)
+{
+    std::seed_seq seq({ (uint32_t)SEED, (uint32_t)(SEED >> 32), (uint32_t)stream, (uint32_t)(stream >> 32) });
+    return std::mt19937_64(seq);
+}
+
+std::vector<uint8_t> BenchData::RandomBytes(std::mt19937_64& rng, const size_t numBytes)
+{
+    std::vector<uint8_t> bytes(numBytes);
+    for (size_t i = 0; i < numBytes; i++)
+    {
+        bytes[i] = (uint8_t)rng();
+    }
+
+    return bytes;
+}
+
+BlindingFactor BenchData::RandomBlind(std::mt19937_64& rng)
+{
+    std::vector<uint8_t> bytes = RandomBytes(rng, 32);
+
+    // Keeps the scalar below the curve order.
+    bytes[0] &= 0x7f;
+    return BlindingFactor(Hash(std::move(bytes)));
+}
+
+static KeyChain GetKeyChain()
+{
+    std::mt19937_64 rng = BenchData::Rng(EStream::KEYCHAIN);
+    const std::vector<uint8_t> seed = BenchData::RandomBytes(rng, 32);
+    return KeyChain::FromSeed(SecureVector(seed.cbegin(), seed.cend()));
+}
+
+std::vector<Commitment> BenchData::Commitments(const size_t count)
+{
+    static std::vector<Commitment> pool;
+    if (pool.empty())
+    {
+        std::mt19937_64 rng = Rng(EStream::COMMITMENTS);
+        for (size_t i = 0; i < COMMITMENT_POOL_SIZE; i++)
+        {
+            pool.push_back(Crypto::CommitBlinded(rng() % 1'000'000'000, RandomBlind(rng)));
+        }
+    }
+
+    return Cycle(pool, count);
+}
+
+std::vector<TransactionOutput> BenchData::Outputs(const size_t count)
+{
+    static std::vector<TransactionOutput> pool;
+    if (pool.empty())
+    {
+        std::mt19937_64 rng = Rng(EStream::OUTPUTS);
+        TxBuilder txBuilder(GetKeyChain());
+        for (uint32_t i = 0; i < OUTPUT_POOL_SIZE; i++)
+        {
+            const Test::Output output{ KeyChainPath({ 1, i }), rng() % 1'000'000'000 };
+            pool.push_back(txBuilder.BuildOutput(output, EOutputFeatures::DEFAULT).second);
+        }
+    }
+
+    return Cycle(pool, count);
+}
+
+std::vector<TransactionKernel> BenchData::Kernels(const size_t count)
+{
+    static std::vector<TransactionKernel> pool;
+    if (pool.empty())
+    {
+        std::mt19937_64 rng = Rng(EStream::KERNELS);
+        TxBuilder txBuilder(GetKeyChain());
+        for (size_t i = 0; i < KERNEL_POOL_SIZE; i++)
+        {
+            BlindingFactor blind = RandomBlind(rng);
+            pool.push_back(txBuilder.BuildKernel(
+                EKernelFeatures::DEFAULT_KERNEL,
+                Fee::From(rng() % 100'000'000),
+                blind,
+                Crypto::CommitBlinded(0, blind)
+            ));
+        }
+    }
+
+    return Cycle(pool, count);
+}
+
+FullBlock BenchData::Block(const size_t numInputs, const size_t numOutputs, const size_t numKernels)
+{
+    std::vector<TransactionInput> inputs;
+    for (const Commitment& commitment : Commitments(numInputs))
+    {
+        inputs.push_back(TransactionInput(EOutputFeatures::DEFAULT, commitment));
+    }
+
+    return FullBlock(
+        Global::GetGenesisHeader(),
+        TransactionBody(std::move(inputs), Outputs(numOutputs), Kernels(numKernels))
+    );
+}
+
+fs::path BenchData::GetTempDir()
+{
+    static fs::path tempDir = fs::temp_directory_path() / ("grinpp_bench_" + uuids::to_string(uuids::uuid_system_generator()()));
+    FileUtil::CreateDirectories(tempDir);
+    return tempDir;
+}
+
+void BenchData::RemoveTempDir()
+{
+    FileUtil::RemoveFile(GetTempDir());
+}
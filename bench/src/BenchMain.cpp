@@ -0,0 +1,103 @@
+#include <Bench.h>
+#include <BenchData.h>
+
+#include <Core/Global.h>
+#include <Core/Context.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/TimeUtil.h>
+#include <PoW/SipHashLanes.h>
+
+#include <iostream>
+#include <thread>
+
+//
+// Microbenchmarks for the crypto, PMMR, serialization and PoW hot paths.
+//
+// Usage: Bench [--filter <substring>] [--json <file|->] [--min-time <ms>] [--seed <n>] [--list]
+//
+// Timings are printed to stderr as they complete. With --json, the results are also written as JSON
+// (to stdout when the file is "-") so they can be compared between builds to catch regressions.
+//
+static void PrintUsage()
+{
+    std::cerr << "Usage: Bench [--filter <substring>] [--json <file|->] [--min-time <ms>] [--seed <n>] [--list]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    Bench::Options options;
+    std::optional<std::string> jsonPath = std::nullopt;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = std::make_optional<std::string>(argv[++i]);
+        } else if (arg == "--min-time" && hasValue) {
+            options.min_time_ms = std::stoull(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            BenchData::SetSeed(std::stoull(argv[++i]));
+        } else if (arg == "--list") {
+            options.list_only = true;
+        } else {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    auto pContext = Context::Create(Environment::AUTOMATED_TESTING, Config::Default(Environment::AUTOMATED_TESTING));
+    Global::Init(pContext);
+
+    Bench::Runner runner(options);
+    try
+    {
+        for (const auto& group : Bench::Registry::GetGroups())
+        {
+            group.second(runner);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        BenchData::RemoveTempDir();
+        Global::Shutdown();
+        return -1;
+    }
+
+    BenchData::RemoveTempDir();
+
+    if (jsonPath.has_value() && !options.list_only)
+    {
+        Json::Value json;
+        json["timestamp"] = Json::Int64(TimeUtil::Now());
+        json["seed"] = Json::UInt64(BenchData::GetSeed());
+        json["min_time_ms"] = Json::UInt64(options.min_time_ms);
+        json["threads"] = std::thread::hardware_concurrency();
+        json["siphash"] = SipHashLanes::GetImplementation();
+#ifdef NDEBUG
+        json["build"] = "release";
+#else
+        json["build"] = "debug";
+#endif
+
+        Json::Value resultsJSON(Json::arrayValue);
+        for (const Bench::Result& result : runner.GetResults())
+        {
+            resultsJSON.append(result.ToJSON());
+        }
+        json["results"] = resultsJSON;
+
+        if (jsonPath.value() == "-") {
+            std::cout << json.toStyledString();
+        } else {
+            FileUtil::WriteTextToFile(jsonPath.value(), json.toStyledString());
+        }
+    }
+
+    Global::Shutdown();
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "GeneratedChain.h"
+#include "ChainReplayer.h"
+
+#include <ProcessStats.h>
+
+#include <Core/Global.h>
+#include <Core/Context.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/StringUtil.h>
+#include <Common/Util/TimeUtil.h>
+
+#include <iomanip>
+#include <iostream>
+
+//
+// End-to-end block processing benchmark.
+//
+// Usage: ChainBench [--blocks <n>] [--txs <m>] [--outputs <k>] [--reorg-depth <r>]
+//                   [--chain <file>] [--regenerate] [--scenarios <list>] [--json <file>]
+//
+// Mines a synthetic automated-testing chain with the given shape (or loads it from --chain, if it was saved with the same shape),
+// then replays it into a fresh node for each scenario: add_block, add_block_headers, add_compact_block and reorg.
+// Mining is slow, so the chain is saved to --chain and reused by later runs, which also keeps runs comparable.
+//
+static void PrintUsage()
+{
+    std::cerr << "Usage: ChainBench [--blocks <n>] [--txs <m>] [--outputs <k>] [--reorg-depth <r>]" << std::endl
+        << "                  [--chain <file>] [--regenerate] [--scenarios <list>] [--json <file>]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    ChainParams params;
+    std::optional<fs::path> chainPath = std::nullopt;
+    std::optional<fs::path> jsonPath = std::nullopt;
+    bool regenerate = false;
+    std::vector<std::string> scenarios({ "add_block", "add_block_headers", "add_compact_block", "reorg" });
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--blocks" && hasValue) {
+            params.num_blocks = std::stoull(argv[++i]);
+        } else if (arg == "--txs" && hasValue) {
+            params.txs_per_block = std::stoull(argv[++i]);
+        } else if (arg == "--outputs" && hasValue) {
+            params.outputs_per_tx = std::stoull(argv[++i]);
+        } else if (arg == "--reorg-depth" && hasValue) {
+            params.reorg_depth = std::stoull(argv[++i]);
+        } else if (arg == "--chain" && hasValue) {
+            chainPath = std::make_optional<fs::path>(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = std::make_optional<fs::path>(argv[++i]);
+        } else if (arg == "--scenarios" && hasValue) {
+            scenarios = StringUtil::Split(argv[++i], ",");
+        } else if (arg == "--regenerate") {
+            regenerate = true;
+        } else {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if (params.num_blocks == 0 || params.outputs_per_tx == 0) {
+        PrintUsage();
+        return -1;
+    }
+
+    auto pContext = Context::Create(Environment::AUTOMATED_TESTING, Config::Default(Environment::AUTOMATED_TESTING));
+    Global::Init(pContext);
+
+    if (!chainPath.has_value()) {
+        chainPath = std::make_optional<fs::path>(StringUtil::Format(
+            "chain_{}_{}_{}_{}.bin",
+            params.num_blocks,
+            params.txs_per_block,
+            params.outputs_per_tx,
+            params.reorg_depth
+        ));
+    }
+
+    Json::Value resultsJSON(Json::arrayValue);
+    try
+    {
+        GeneratedChain::Ptr pChain = regenerate ? nullptr : GeneratedChain::Load(chainPath.value(), params);
+        if (pChain == nullptr) {
+            std::cerr << "Generating chain: " << chainPath.value().u8string() << std::endl;
+            pChain = GeneratedChain::Generate(params);
+            pChain->Save(chainPath.value());
+        }
+
+        ChainReplayer replayer(pChain);
+        for (const std::string& scenario : scenarios)
+        {
+            ReplayResult result;
+            if (scenario == "add_block") {
+                result = replayer.ReplayBlocks();
+            } else if (scenario == "add_block_headers") {
+                result = replayer.ReplayHeaders();
+            } else if (scenario == "add_compact_block") {
+                result = replayer.ReplayCompactBlocks();
+            } else if (scenario == "reorg") {
+                result = replayer.ReplayReorg();
+            } else {
+                std::cerr << "Unknown scenario: " << scenario << std::endl;
+                continue;
+            }
+
+            const Json::Value json = result.ToJSON();
+            std::cerr << std::left << std::setw(20) << scenario
+                << std::right << std::fixed << std::setprecision(1)
+                << std::setw(12) << json["blocks_per_sec"].asDouble() << " blocks/s"
+                << std::setw(12) << json["p50_ns"].asDouble() / 1e6 << " ms p50"
+                << std::setw(12) << json["p99_ns"].asDouble() / 1e6 << " ms p99"
+                << std::setw(10) << json["peak_rss_bytes"].asUInt64() / (1024 * 1024) << " MB peak RSS" << std::endl;
+
+            resultsJSON.append(json);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        Global::Shutdown();
+        return -1;
+    }
+
+    if (jsonPath.has_value())
+    {
+        Json::Value json;
+        json["timestamp"] = Json::Int64(TimeUtil::Now());
+        json["blocks"] = Json::UInt64(params.num_blocks);
+        json["txs_per_block"] = Json::UInt64(params.txs_per_block);
+        json["outputs_per_tx"] = Json::UInt64(params.outputs_per_tx);
+        json["reorg_depth"] = Json::UInt64(params.reorg_depth);
+        json["results"] = resultsJSON;
+        FileUtil::WriteTextToFile(jsonPath.value(), json.toStyledString());
+    }
+
+    Global::Shutdown();
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include "ChainReplayer.h"
+
+#include <ProcessStats.h>
+#include <TestServer.h>
+
+#include <BlockChain/CompactBlockFactory.h>
+#include <P2P/Common.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+template<typename F>
+static double Time(const F& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void RequireStatus(const EBlockChainStatus status, const std::vector<EBlockChainStatus>& expected, const std::string& what)
+{
+    if (std::find(expected.cbegin(), expected.cend(), status) == expected.cend()) {
+        throw std::runtime_error("Unexpected status " + std::to_string((int)status) + " for " + what);
+    }
+}
+
+static double Percentile(const std::vector<double>& sorted, const double percentile)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    const size_t rank = (size_t)std::ceil(sorted.size() * percentile);
+    return sorted[(std::min)(sorted.size() - 1, (std::max)(rank, (size_t)1) - 1)];
+}
+
+Json::Value ReplayResult::ToJSON() const
+{
+    std::vector<double> sorted = step_ns;
+    std::sort(sorted.begin(), sorted.end());
+    const double total_ns = std::accumulate(sorted.cbegin(), sorted.cend(), 0.0);
+
+    Json::Value json;
+    json["scenario"] = scenario;
+    json["blocks"] = Json::UInt64(num_blocks);
+    json["steps"] = Json::UInt64(step_ns.size());
+    json["total_ns"] = total_ns;
+    json["blocks_per_sec"] = total_ns > 0 ? (num_blocks * 1e9) / total_ns : 0.0;
+    json["p50_ns"] = Percentile(sorted, 0.5);
+    json["p99_ns"] = Percentile(sorted, 0.99);
+    json["max_ns"] = sorted.empty() ? 0.0 : sorted.back();
+    if (reorg_ns > 0) {
+        json["reorg_ns"] = reorg_ns;
+    }
+    json["peak_rss_bytes"] = Json::UInt64(peak_rss);
+    return json;
+}
+
+ReplayResult ChainReplayer::ReplayBlocks() const
+{
+    TestServer::Ptr pServer = TestServer::Create();
+    auto pBlockChain = pServer->GetBlockChain();
+
+    ReplayResult result;
+    result.scenario = "add_block";
+    result.num_blocks = m_pChain->GetBlocks().size();
+
+    for (const GeneratedBlock& block : m_pChain->GetBlocks())
+    {
+        EBlockChainStatus status;
+        result.step_ns.push_back(Time([&]() { status = pBlockChain->AddBlock(block.block); }));
+        RequireStatus(status, { EBlockChainStatus::SUCCESS }, "block " + std::to_string(block.block.GetHeight()));
+    }
+
+    result.peak_rss = ProcessStats::GetPeakRSS();
+    return result;
+}
+
+ReplayResult ChainReplayer::ReplayHeaders() const
+{
+    TestServer::Ptr pServer = TestServer::Create();
+    auto pBlockChain = pServer->GetBlockChain();
+
+    ReplayResult result;
+    result.scenario = "add_block_headers";
+    result.num_blocks = m_pChain->GetBlocks().size();
+
+    const std::vector<GeneratedBlock>& blocks = m_pChain->GetBlocks();
+    for (size_t i = 0; i < blocks.size(); i += P2P::MAX_BLOCK_HEADERS)
+    {
+        std::vector<BlockHeaderPtr> headers;
+        for (size_t j = i; j < (std::min)(blocks.size(), i + P2P::MAX_BLOCK_HEADERS); j++)
+        {
+            headers.push_back(blocks[j].block.GetHeader());
+        }
+
+        EBlockChainStatus status;
+        result.step_ns.push_back(Time([&]() { status = pBlockChain->AddBlockHeaders(headers); }));
+        RequireStatus(status, { EBlockChainStatus::SUCCESS }, "headers from " + std::to_string(headers.front()->GetHeight()));
+    }
+
+    result.peak_rss = ProcessStats::GetPeakRSS();
+    return result;
+}
+
+ReplayResult ChainReplayer::ReplayCompactBlocks() const
+{
+    TestServer::Ptr pServer = TestServer::Create();
+    auto pBlockChain = pServer->GetBlockChain();
+
+    ReplayResult result;
+    result.scenario = "add_compact_block";
+    result.num_blocks = m_pChain->GetBlocks().size();
+
+    for (const GeneratedBlock& block : m_pChain->GetBlocks())
+    {
+        for (const TransactionPtr& pTx : block.txs)
+        {
+            RequireStatus(
+                pBlockChain->AddTransaction(pTx, EPoolType::MEMPOOL),
+                { EBlockChainStatus::SUCCESS },
+                "transaction in block " + std::to_string(block.block.GetHeight())
+            );
+        }
+
+        const CompactBlock compactBlock = CompactBlockFactory::CreateCompactBlock(block.block);
+
+        EBlockChainStatus status;
+        result.step_ns.push_back(Time([&]() { status = pBlockChain->AddCompactBlock(compactBlock); }));
+        RequireStatus(status, { EBlockChainStatus::SUCCESS }, "compact block " + std::to_string(block.block.GetHeight()));
+    }
+
+    result.peak_rss = ProcessStats::GetPeakRSS();
+    return result;
+}
+
+ReplayResult ChainReplayer::ReplayReorg() const
+{
+    TestServer::Ptr pServer = TestServer::Create();
+    auto pBlockChain = pServer->GetBlockChain();
+
+    for (const GeneratedBlock& block : m_pChain->GetBlocks())
+    {
+        RequireStatus(pBlockChain->AddBlock(block.block), { EBlockChainStatus::SUCCESS }, "block " + std::to_string(block.block.GetHeight()));
+    }
+
+    ReplayResult result;
+    result.scenario = "reorg";
+    result.num_blocks = m_pChain->GetFork().size();
+
+    for (const FullBlock& block : m_pChain->GetFork())
+    {
+        EBlockChainStatus status;
+        result.step_ns.push_back(Time([&]() { status = pBlockChain->AddBlock(block); }));
+        RequireStatus(status, { EBlockChainStatus::SUCCESS }, "fork block " + std::to_string(block.GetHeight()));
+    }
+
+    if (pBlockChain->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() != m_pChain->GetFork().back().GetHash()) {
+        throw std::runtime_error("Fork did not become the confirmed chain");
+    }
+
+    // Only the fork block that overtakes the main chain triggers the reorg.
+    result.reorg_ns = result.step_ns.back();
+    result.peak_rss = ProcessStats::GetPeakRSS();
+    return result;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "GeneratedChain.h"
+
+#include <json/json.h>
+#include <string>
+#include <vector>
+
+struct ReplayResult
+{
+    std::string scenario;
+
+    // Number of blocks (or headers) processed, and the time each timed step took.
+    // A step is one block, except for headers, which are added a batch at a time.
+    uint64_t num_blocks{ 0 };
+    std::vector<double> step_ns;
+
+    // Time taken by the block that caused the reorg, if any.
+    double reorg_ns{ 0.0 };
+
+    // Peak RSS of the process so far, which includes mining the chain when it wasn't loaded from a file.
+    uint64_t peak_rss{ 0 };
+
+    Json::Value ToJSON() const;
+};
+
+//
+// Replays a generated chain into a fresh node, timing each step of the validation pipeline.
+// Every scenario starts from an empty chain, so scenarios don't affect each other (other than through process-wide caches).
+//
+class ChainReplayer
+{
+public:
+    ChainReplayer(const GeneratedChain::Ptr& pChain) : m_pChain(pChain) { }
+
+    // Adds every block in order using AddBlock.
+    ReplayResult ReplayBlocks() const;
+
+    // Adds every header using AddBlockHeaders, in batches the size of a P2P headers message.
+    ReplayResult ReplayHeaders() const;
+
+    // Relays each block's transactions to the mempool (untimed), then adds the block as a compact block.
+    ReplayResult ReplayCompactBlocks() const;
+
+    // Adds every block (untimed), then the longer fork, which reorgs the chain once its last block arrives.
+    ReplayResult ReplayReorg() const;
+
+private:
+    GeneratedChain::Ptr m_pChain;
+};
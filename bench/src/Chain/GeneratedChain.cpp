@@ -0,0 +1,197 @@
+#include "GeneratedChain.h"
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <Consensus.h>
+#include <Common/Util/FileUtil.h>
+#include <Core/Util/FeeUtil.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Crypto/Crypto.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+#include <Wallet/Keychain/KeyChain.h>
+#include <deque>
+#include <stdexcept>
+
+static const uint32_t FILE_VERSION = 1;
+static const uint64_t FEE_BASE = 500'000;
+
+// Keychain path branches used for each kind of output.
+static const uint32_t COINBASE_BRANCH = 0;
+static const uint32_t FORK_COINBASE_BRANCH = 1;
+static const uint32_t OUTPUT_BRANCH = 2;
+
+GeneratedChain::Ptr GeneratedChain::Generate(const ChainParams& params)
+{
+    if (params.reorg_depth >= params.num_blocks) {
+        throw std::invalid_argument("Reorg depth must be less than the number of blocks");
+    }
+
+    TestServer::Ptr pServer = TestServer::Create();
+    TestMiner miner(pServer);
+    const KeyChain keyChain = KeyChain::FromSeed(SecureVector(32, 0x42));
+    TxBuilder txBuilder(keyChain);
+
+    const uint64_t fee = FeeUtil::CalculateFee(FEE_BASE, 1, params.outputs_per_tx, 1);
+
+    // Outputs that can be spent in the next block, oldest first, and coinbases waiting to mature.
+    std::deque<Test::Input> spendable;
+    std::deque<std::pair<uint64_t, Test::Input>> immature;
+
+    std::vector<GeneratedBlock> blocks;
+    BlockHeaderPtr pPrevHeader = Global::GetGenesisHeader();
+    for (uint32_t height = 1; height <= params.num_blocks; height++)
+    {
+        while (!immature.empty() && immature.front().first <= Consensus::GetMaxCoinbaseHeight(height))
+        {
+            spendable.push_back(immature.front().second);
+            immature.pop_front();
+        }
+
+        std::vector<TransactionPtr> txs;
+        std::vector<Test::Input> created;
+        while (txs.size() < params.txs_per_block && !spendable.empty())
+        {
+            const Test::Input input = spendable.front();
+            spendable.pop_front();
+
+            // Outputs that have been split too many times to pay the fee are dropped.
+            if (input.amount < fee + params.outputs_per_tx) {
+                continue;
+            }
+
+            const uint64_t amountPerOutput = (input.amount - fee) / params.outputs_per_tx;
+
+            TxBuilder::Criteria criteria;
+            criteria.inputs = { input };
+            criteria.fee_base = FEE_BASE;
+            for (uint32_t i = 0; i < params.outputs_per_tx; i++)
+            {
+                // Any remainder goes to the last output, so amounts balance exactly.
+                const uint64_t remainder = (i == params.outputs_per_tx - 1) ? (input.amount - fee) % params.outputs_per_tx : 0;
+                criteria.outputs.push_back({ KeyChainPath({ OUTPUT_BRANCH, height, (uint32_t)txs.size(), i }), amountPerOutput + remainder });
+            }
+
+            for (const Test::Output& output : criteria.outputs)
+            {
+                const SecretKey blind = keyChain.DerivePrivateKey(output.path, output.amount);
+                const Commitment commitment = Crypto::CommitBlinded(output.amount, BlindingFactor(blind.GetBytes()));
+                created.push_back({ TransactionInput(EOutputFeatures::DEFAULT, commitment), output.path, output.amount });
+            }
+
+            TransactionPtr pTx = std::make_shared<Transaction>(txBuilder.BuildTx(criteria));
+            txs.push_back(pTx);
+        }
+
+        Test::Tx coinbase = txBuilder.BuildCoinbaseTx(KeyChainPath({ COINBASE_BRANCH, height }), Consensus::REWARD + fee * txs.size());
+        const TransactionOutput& coinbaseOutput = coinbase.pTransaction->GetOutputs().front();
+        immature.push_back({
+            height,
+            Test::Input{ TransactionInput(coinbaseOutput.GetFeatures(), coinbaseOutput.GetCommitment()), coinbase.outputs.front().path, coinbase.outputs.front().amount }
+        });
+
+        std::vector<TransactionPtr> blockTxs = txs;
+        blockTxs.push_back(coinbase.pTransaction);
+
+        FullBlock block = miner.MineNextBlock(pPrevHeader, *TransactionUtil::Aggregate(blockTxs));
+        if (pServer->GetBlockChain()->AddBlock(block) != EBlockChainStatus::SUCCESS) {
+            throw std::runtime_error("Failed to add generated block " + std::to_string(height));
+        }
+
+        spendable.insert(spendable.end(), created.cbegin(), created.cend());
+        pPrevHeader = block.GetHeader();
+        blocks.push_back({ std::move(block), std::move(txs) });
+    }
+
+    // The fork only contains coinbases, so it never conflicts with the main chain's spends.
+    const uint64_t forkHeight = params.num_blocks - params.reorg_depth;
+    const BlockHeaderPtr pForkHeader = forkHeight == 0 ? Global::GetGenesisHeader() : blocks[forkHeight - 1].block.GetHeader();
+
+    std::vector<FullBlock> fork;
+    for (uint32_t height = (uint32_t)forkHeight + 1; height <= params.num_blocks + 1; height++)
+    {
+        Test::Tx coinbase = txBuilder.BuildCoinbaseTx(KeyChainPath({ FORK_COINBASE_BRANCH, height }));
+        fork.push_back(miner.MineNextBlock(pForkHeader, *coinbase.pTransaction, fork));
+    }
+
+    return GeneratedChain::Ptr(new GeneratedChain(params, std::move(blocks), std::move(fork)));
+}
+
+GeneratedChain::Ptr GeneratedChain::Load(const fs::path& path, const ChainParams& params)
+{
+    std::vector<uint8_t> bytes;
+    if (!FileUtil::ReadFile(path, bytes)) {
+        return nullptr;
+    }
+
+    ByteBuffer byteBuffer(std::move(bytes));
+    if (byteBuffer.ReadU32() != FILE_VERSION) {
+        return nullptr;
+    }
+
+    ChainParams fileParams;
+    fileParams.num_blocks = byteBuffer.ReadU64();
+    fileParams.txs_per_block = byteBuffer.ReadU64();
+    fileParams.outputs_per_tx = byteBuffer.ReadU64();
+    fileParams.reorg_depth = byteBuffer.ReadU64();
+    if (!(fileParams == params)) {
+        return nullptr;
+    }
+
+    std::vector<GeneratedBlock> blocks;
+    const uint64_t numBlocks = byteBuffer.ReadU64();
+    for (uint64_t i = 0; i < numBlocks; i++)
+    {
+        FullBlock block = FullBlock::Deserialize(byteBuffer);
+
+        std::vector<TransactionPtr> txs;
+        const uint64_t numTxs = byteBuffer.ReadU64();
+        for (uint64_t j = 0; j < numTxs; j++)
+        {
+            txs.push_back(std::make_shared<Transaction>(Transaction::Deserialize(byteBuffer)));
+        }
+
+        blocks.push_back({ std::move(block), std::move(txs) });
+    }
+
+    std::vector<FullBlock> fork;
+    const uint64_t numForkBlocks = byteBuffer.ReadU64();
+    for (uint64_t i = 0; i < numForkBlocks; i++)
+    {
+        fork.push_back(FullBlock::Deserialize(byteBuffer));
+    }
+
+    return GeneratedChain::Ptr(new GeneratedChain(params, std::move(blocks), std::move(fork)));
+}
+
+void GeneratedChain::Save(const fs::path& path) const
+{
+    Serializer serializer;
+    serializer.Append<uint32_t>(FILE_VERSION);
+    serializer.Append<uint64_t>(m_params.num_blocks);
+    serializer.Append<uint64_t>(m_params.txs_per_block);
+    serializer.Append<uint64_t>(m_params.outputs_per_tx);
+    serializer.Append<uint64_t>(m_params.reorg_depth);
+
+    serializer.Append<uint64_t>(m_blocks.size());
+    for (const GeneratedBlock& block : m_blocks)
+    {
+        block.block.Serialize(serializer);
+
+        serializer.Append<uint64_t>(block.txs.size());
+        for (const TransactionPtr& pTx : block.txs)
+        {
+            pTx->Serialize(serializer);
+        }
+    }
+
+    serializer.Append<uint64_t>(m_fork.size());
+    for (const FullBlock& block : m_fork)
+    {
+        block.Serialize(serializer);
+    }
+
+    FileUtil::SafeWriteToFile(path, serializer.GetBytes());
+}
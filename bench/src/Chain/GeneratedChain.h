@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Core/Models/FullBlock.h>
+#include <Core/Models/Transaction.h>
+#include <filesystem.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct ChainParams
+{
+    uint64_t num_blocks{ 100 };
+    uint64_t txs_per_block{ 4 };
+    uint64_t outputs_per_tx{ 2 };
+
+    // Number of main chain blocks replaced by the competing fork.
+    uint64_t reorg_depth{ 5 };
+
+    bool operator==(const ChainParams& rhs) const noexcept
+    {
+        return num_blocks == rhs.num_blocks
+            && txs_per_block == rhs.txs_per_block
+            && outputs_per_tx == rhs.outputs_per_tx
+            && reorg_depth == rhs.reorg_depth;
+    }
+};
+
+struct GeneratedBlock
+{
+    FullBlock block;
+
+    // The non-coinbase transactions aggregated into the block, used to fill the mempool before relaying it as a compact block.
+    std::vector<TransactionPtr> txs;
+};
+
+//
+// A synthetic automated-testing chain: num_blocks blocks, each with a coinbase plus up to txs_per_block transactions
+// that each spend one earlier output and create outputs_per_tx new ones (early blocks have fewer, until coinbases mature).
+// The fork branches off reorg_depth blocks below the tip and is one block longer, so adding it causes a reorg.
+//
+class GeneratedChain
+{
+public:
+    using Ptr = std::shared_ptr<GeneratedChain>;
+
+    // Mines a new chain. Every block is validated by a throwaway node as it's mined, so this is slow for large chains.
+    static GeneratedChain::Ptr Generate(const ChainParams& params);
+
+    // Loads a chain saved by Save, returning nullptr if it doesn't exist or was generated with different params.
+    static GeneratedChain::Ptr Load(const fs::path& path, const ChainParams& params);
+    void Save(const fs::path& path) const;
+
+    const ChainParams& GetParams() const noexcept { return m_params; }
+    const std::vector<GeneratedBlock>& GetBlocks() const noexcept { return m_blocks; }
+    const std::vector<FullBlock>& GetFork() const noexcept { return m_fork; }
+
+private:
+    GeneratedChain(const ChainParams& params, std::vector<GeneratedBlock>&& blocks, std::vector<FullBlock>&& fork)
+        : m_params(params), m_blocks(std::move(blocks)), m_fork(std::move(fork)) { }
+
+    ChainParams m_params;
+    std::vector<GeneratedBlock> m_blocks;
+    std::vector<FullBlock> m_fork;
+};
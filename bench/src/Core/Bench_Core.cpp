@@ -0,0 +1,104 @@
+#include <Bench.h>
+#include <BenchData.h>
+
+#include <Core/Exceptions/FileException.h>
+#include <Core/File/BitmapFile.h>
+#include <Core/Models/FullBlock.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+#include <Common/Util/FileUtil.h>
+
+BENCH_GROUP("core/bitmap_file", runner)
+{
+    static const uint64_t NUM_LEAVES = 1 << 20;
+
+    for (const uint64_t numModified : std::vector<uint64_t>({ 16, 1024, 65536 }))
+    {
+        runner.Run("core/bitmap_file/commit/" + std::to_string(numModified), numModified, [numModified]() {
+            const fs::path path = BenchData::GetTempDir() / "bitmap.bin";
+            FileUtil::RemoveFile(path);
+
+            std::shared_ptr<BitmapFile> pBitmapFile = BitmapFile::Load(path);
+            for (uint64_t i = 0; i < NUM_LEAVES; i++)
+            {
+                pBitmapFile->Set(i);
+            }
+            pBitmapFile->Commit();
+
+            auto pRng = std::make_shared<std::mt19937_64>(BenchData::Rng(numModified));
+
+            return Bench::Case{
+                [pBitmapFile]() { pBitmapFile->Commit(); },
+                [pBitmapFile, pRng, numModified]() {
+                    for (uint64_t i = 0; i < numModified; i++)
+                    {
+                        const uint64_t leafIndex = (*pRng)() % NUM_LEAVES;
+                        if (pBitmapFile->IsSet(leafIndex)) {
+                            pBitmapFile->Unset(leafIndex);
+                        } else {
+                            pBitmapFile->Set(leafIndex);
+                        }
+                    }
+                }
+            };
+        });
+    }
+}
+
+BENCH_GROUP("core/serialization", runner)
+{
+    struct BlockSize
+    {
+        std::string name;
+        size_t numInputs;
+        size_t numOutputs;
+        size_t numKernels;
+    };
+
+    const std::vector<BlockSize> blockSizes({
+        { "small", 2, 4, 2 },
+        { "medium", 100, 200, 100 },
+        { "full", 1000, 2000, 1000 }
+    });
+
+    for (const BlockSize& size : blockSizes)
+    {
+        runner.Run("core/serialization/full_block/serialize/" + size.name, 1, [size]() {
+            auto pBlock = std::make_shared<FullBlock>(BenchData::Block(size.numInputs, size.numOutputs, size.numKernels));
+
+            return Bench::Case{
+                [pBlock]() {
+                    Serializer serializer;
+                    pBlock->Serialize(serializer);
+                }
+            };
+        });
+
+        runner.Run("core/serialization/full_block/deserialize/" + size.name, 1, [size]() {
+            Serializer serializer;
+            BenchData::Block(size.numInputs, size.numOutputs, size.numKernels).Serialize(serializer);
+            auto pBytes = std::make_shared<std::vector<uint8_t>>(serializer.GetBytes());
+
+            return Bench::Case{
+                [pBytes]() {
+                    ByteBuffer byteBuffer(*pBytes);
+                    FullBlock::Deserialize(byteBuffer);
+                }
+            };
+        });
+
+        runner.Run("core/serialization/full_block/round_trip/" + size.name, 1, [size]() {
+            auto pBlock = std::make_shared<FullBlock>(BenchData::Block(size.numInputs, size.numOutputs, size.numKernels));
+
+            return Bench::Case{
+                [pBlock]() {
+                    Serializer serializer;
+                    pBlock->Serialize(serializer);
+
+                    ByteBuffer byteBuffer(serializer.GetBytes());
+                    FullBlock::Deserialize(byteBuffer);
+                }
+            };
+        });
+    }
+}
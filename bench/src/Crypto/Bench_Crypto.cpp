@@ -0,0 +1,94 @@
+#include <Bench.h>
+#include <BenchData.h>
+
+#include <Crypto/Crypto.h>
+#include <Crypto/VerificationCache.h>
+#include <Core/Validation/KernelSignatureValidator.h>
+#include <stdexcept>
+
+static const std::vector<size_t> BATCH_SIZES({ 1, 16, 128, 1024 });
+
+BENCH_GROUP("crypto/rangeproofs", runner)
+{
+    for (const size_t batchSize : BATCH_SIZES)
+    {
+        runner.Run("crypto/rangeproofs/verify/" + std::to_string(batchSize), batchSize, [batchSize]() {
+            auto pRangeProofs = std::make_shared<std::vector<std::pair<Commitment, RangeProof>>>();
+            for (const TransactionOutput& output : BenchData::Outputs(batchSize))
+            {
+                pRangeProofs->push_back({ output.GetCommitment(), output.GetRangeProof() });
+            }
+
+            return Bench::Case{
+                [pRangeProofs]() {
+                    if (!Crypto::VerifyRangeProofs(*pRangeProofs)) {
+                        throw std::runtime_error("Rangeproof verification failed");
+                    }
+                },
+                []() { VerificationCache::RangeProofs().Clear(); }
+            };
+        });
+    }
+
+    runner.Run("crypto/rangeproofs/verify_cached/1024", 1024, []() {
+        auto pRangeProofs = std::make_shared<std::vector<std::pair<Commitment, RangeProof>>>();
+        for (const TransactionOutput& output : BenchData::Outputs(1024))
+        {
+            pRangeProofs->push_back({ output.GetCommitment(), output.GetRangeProof() });
+        }
+
+        return Bench::Case{ [pRangeProofs]() { Crypto::VerifyRangeProofs(*pRangeProofs); } };
+    });
+}
+
+BENCH_GROUP("crypto/kernels", runner)
+{
+    for (const size_t batchSize : BATCH_SIZES)
+    {
+        runner.Run("crypto/kernels/batch_verify/" + std::to_string(batchSize), batchSize, [batchSize]() {
+            auto pKernels = std::make_shared<std::vector<TransactionKernel>>(BenchData::Kernels(batchSize));
+
+            return Bench::Case{
+                [pKernels]() {
+                    if (!KernelSignatureValidator::BatchVerify(*pKernels)) {
+                        throw std::runtime_error("Kernel signature verification failed");
+                    }
+                },
+                []() { VerificationCache::KernelSignatures().Clear(); }
+            };
+        });
+    }
+
+    runner.Run("crypto/kernels/batch_verify_cached/1024", 1024, []() {
+        auto pKernels = std::make_shared<std::vector<TransactionKernel>>(BenchData::Kernels(1024));
+
+        return Bench::Case{ [pKernels]() { KernelSignatureValidator::BatchVerify(*pKernels); } };
+    });
+}
+
+BENCH_GROUP("crypto/commitments", runner)
+{
+    // The largest sizes are summed in parallel.
+    for (const size_t numCommitments : std::vector<size_t>({ 16, 1024, 65536, 1048576 }))
+    {
+        runner.Run("crypto/commitments/add/" + std::to_string(numCommitments), numCommitments, [numCommitments]() {
+            auto pPositive = std::make_shared<std::vector<Commitment>>(BenchData::Commitments(numCommitments));
+            auto pNegative = std::make_shared<std::vector<Commitment>>(BenchData::Commitments(numCommitments / 4));
+
+            return Bench::Case{ [pPositive, pNegative]() { Crypto::AddCommitments(*pPositive, *pNegative); } };
+        });
+
+        runner.Run("crypto/commitments/add_streamed/" + std::to_string(numCommitments), numCommitments, [numCommitments]() {
+            auto pCommitments = std::make_shared<std::vector<Commitment>>(BenchData::Commitments(numCommitments));
+
+            return Bench::Case{
+                [pCommitments]() {
+                    Crypto::AddCommitments(
+                        pCommitments->size(),
+                        [pCommitments](const uint64_t index) { return std::make_optional((*pCommitments)[index]); }
+                    );
+                }
+            };
+        });
+    }
+}
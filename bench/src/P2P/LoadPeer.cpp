@@ -0,0 +1,262 @@
+#include "LoadPeer.h"
+
+#include <ProcessStats.h>
+
+#include <P2P/Messages/HandMessage.h>
+#include <P2P/Messages/ShakeMessage.h>
+#include <P2P/Messages/PingMessage.h>
+#include <P2P/Messages/PongMessage.h>
+#include <P2P/Common.h>
+#include <Core/Global.h>
+#include <stdexcept>
+#include <thread>
+
+using steady_clock = std::chrono::steady_clock;
+
+static const std::array<std::string, NUM_LOAD_MESSAGES> LOAD_MESSAGE_NAMES = {
+    "ping",
+    "transaction",
+    "stem_transaction",
+    "compact_block",
+    "get_headers"
+};
+
+std::string LoadMessage::ToString(const ELoadMessage type)
+{
+    return LOAD_MESSAGE_NAMES[(size_t)type];
+}
+
+std::optional<ELoadMessage> LoadMessage::FromString(const std::string& name)
+{
+    for (size_t i = 0; i < NUM_LOAD_MESSAGES; i++)
+    {
+        if (LOAD_MESSAGE_NAMES[i] == name) {
+            return std::make_optional((ELoadMessage)i);
+        }
+    }
+
+    return std::nullopt;
+}
+
+LoadPeer::LoadPeer(
+    const size_t index,
+    const SocketAddress& nodeAddress,
+    const std::shared_ptr<const LoadMix>& pMix,
+    const std::chrono::milliseconds& timeout)
+    : m_sourceIP(IPAddress::CreateV4({ 127, 1, (uint8_t)((index + 1) >> 8), (uint8_t)((index + 1) & 0xFF) })),
+    m_nodeAddress(nodeAddress),
+    m_pMix(pMix),
+    m_timeout(timeout),
+    m_socket(m_context),
+    m_protocolVersion(ProtocolVersion::Local()),
+    m_rng(index)
+{
+
+}
+
+bool LoadPeer::Connect()
+{
+    asio::error_code ec;
+    m_socket = asio::ip::tcp::socket(m_context);
+    m_socket.open(asio::ip::tcp::v4(), ec);
+    if (!ec) {
+        m_socket.bind(asio::ip::tcp::endpoint(m_sourceIP.GetAddress(), 0), ec);
+    }
+
+    if (ec) {
+        throw std::runtime_error("Failed to bind " + m_sourceIP.Format() + ": " + ec.message());
+    }
+
+    m_socket.connect(m_nodeAddress.GetEndpoint(), ec);
+    if (ec) {
+        Disconnect();
+        return false;
+    }
+
+    m_protocolVersion = ProtocolVersion::Local();
+
+    // Advertise no work, so the node never tries to sync from the load peers.
+    const HandMessage hand(
+        P2P::PROTOCOL_VERSION,
+        Capabilities::UNKNOWN,
+        m_rng(),
+        Global::GetGenesisHash(),
+        0,
+        SocketAddress(m_sourceIP, m_socket.local_endpoint().port()),
+        SocketAddress(m_nodeAddress),
+        "P2PLoad"
+    );
+
+    std::unique_ptr<RawMessage> pShake;
+    if (!Send(hand.Serialize(m_protocolVersion))
+        || Receive(pShake, steady_clock::now() + m_timeout) != EReceive::RECEIVED
+        || pShake->GetMessageType() != MessageTypes::Shake)
+    {
+        Disconnect();
+        return false;
+    }
+
+    ByteBuffer byteBuffer(pShake->GetPayload());
+    const ShakeMessage shake = ShakeMessage::Deserialize(byteBuffer);
+    m_protocolVersion = ProtocolVersion::ToEnum((std::min)(P2P::PROTOCOL_VERSION, shake.GetVersion()));
+
+    m_stats.connects++;
+    return true;
+}
+
+void LoadPeer::Disconnect()
+{
+    asio::error_code ignoreError;
+    m_socket.shutdown(asio::socket_base::shutdown_both, ignoreError);
+    m_socket.close(ignoreError);
+}
+
+bool LoadPeer::Reconnect(const BanCheck& isBanned)
+{
+    // The node refuses a second connection from an IP until it has pruned the first, so give it a moment.
+    for (int attempt = 0; attempt < 10; attempt++)
+    {
+        m_stats.ban_reason = isBanned(m_sourceIP);
+        if (m_stats.ban_reason.has_value()) {
+            return false;
+        }
+
+        if (Connect()) {
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    return false;
+}
+
+void LoadPeer::Run(const steady_clock::time_point& deadline, const double messagesPerSec, const BanCheck& isBanned)
+{
+    const std::chrono::microseconds cpuStart = ProcessStats::GetThreadCPUTime();
+
+    std::discrete_distribution<size_t> pickType(m_pMix->weights.cbegin(), m_pMix->weights.cend());
+    const auto interval = std::chrono::duration_cast<steady_clock::duration>(
+        std::chrono::duration<double>(messagesPerSec > 0 ? 1.0 / messagesPerSec : 0.0)
+    );
+    const std::vector<uint8_t> ping = PingMessage(0, 0).Serialize(m_protocolVersion);
+
+    bool connected = m_socket.is_open();
+    steady_clock::time_point nextSend = steady_clock::now();
+    while (steady_clock::now() < deadline)
+    {
+        if (!connected && !Reconnect(isBanned)) {
+            break;
+        }
+
+        connected = true;
+        if (interval.count() > 0) {
+            std::this_thread::sleep_until(nextSend);
+            nextSend += interval;
+        }
+
+        const size_t type = pickType(m_rng);
+        const std::vector<IMessagePtr>& payloads = m_pMix->payloads[type];
+        const std::vector<uint8_t> serialized = payloads[m_rng() % payloads.size()]->Serialize(m_protocolVersion);
+
+        const steady_clock::time_point start = steady_clock::now();
+        EReceive result = EReceive::DISCONNECTED;
+        if (Send(serialized)) {
+            if ((ELoadMessage)type == ELoadMessage::PING) {
+                result = Await(MessageTypes::Pong);
+            } else if ((ELoadMessage)type == ELoadMessage::GET_HEADERS) {
+                result = Await(MessageTypes::Headers);
+            } else if (Send(ping)) {
+                result = Await(MessageTypes::Pong);
+            }
+        }
+
+        if (result == EReceive::RECEIVED) {
+            m_stats.latency_ns[type].push_back(
+                (double)std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count()
+            );
+        } else {
+            m_stats.drops[type]++;
+            if (result == EReceive::DISCONNECTED) {
+                m_stats.disconnects++;
+            }
+
+            Disconnect();
+            connected = false;
+        }
+    }
+
+    Disconnect();
+    m_stats.cpu_time = ProcessStats::GetThreadCPUTime() - cpuStart;
+}
+
+bool LoadPeer::Send(const std::vector<uint8_t>& serialized)
+{
+    asio::error_code ec;
+    asio::write(m_socket, asio::buffer(serialized), ec);
+    return !ec;
+}
+
+LoadPeer::EReceive LoadPeer::Await(const MessageTypes::EMessageType type)
+{
+    const steady_clock::time_point deadline = steady_clock::now() + m_timeout;
+    while (true)
+    {
+        std::unique_ptr<RawMessage> pMessage;
+        const EReceive result = Receive(pMessage, deadline);
+        if (result != EReceive::RECEIVED || pMessage->GetMessageType() == type) {
+            return result;
+        }
+
+        // Answer the node's own pings like a real peer would. Anything else, like relayed headers, is ignored.
+        if (pMessage->GetMessageType() == MessageTypes::Ping) {
+            if (!Send(PongMessage(0, 0).Serialize(m_protocolVersion))) {
+                return EReceive::DISCONNECTED;
+            }
+        }
+    }
+}
+
+LoadPeer::EReceive LoadPeer::Receive(std::unique_ptr<RawMessage>& pMessage, const steady_clock::time_point& deadline)
+{
+    std::vector<uint8_t> headerBytes(11);
+    EReceive result = Read(headerBytes, deadline);
+    if (result != EReceive::RECEIVED) {
+        return result;
+    }
+
+    try
+    {
+        ByteBuffer byteBuffer(std::move(headerBytes));
+        MessageHeader header = MessageHeader::Deserialize(byteBuffer);
+
+        std::vector<uint8_t> payload(header.GetMessageLength());
+        result = Read(payload, deadline);
+        if (result == EReceive::RECEIVED) {
+            pMessage = std::make_unique<RawMessage>(std::move(header), std::move(payload));
+        }
+
+        return result;
+    }
+    catch (const std::exception&)
+    {
+        return EReceive::DISCONNECTED;
+    }
+}
+
+LoadPeer::EReceive LoadPeer::Read(std::vector<uint8_t>& buffer, const steady_clock::time_point& deadline)
+{
+    asio::error_code ec = asio::error::would_block;
+    asio::async_read(m_socket, asio::buffer(buffer), [&ec](const asio::error_code& result, const size_t) { ec = result; });
+
+    m_context.restart();
+    m_context.run_until(deadline);
+    if (!m_context.stopped()) {
+        // Closing the socket cancels the read, which must finish before the buffer goes away.
+        Disconnect();
+        m_context.run();
+        return EReceive::TIMED_OUT;
+    }
+
+    return ec ? EReceive::DISCONNECTED : EReceive::RECEIVED;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <P2P/Messages/Message.h>
+#include <P2P/Messages/RawMessage.h>
+#include <P2P/BanReason.h>
+#include <Net/SocketAddress.h>
+
+#include <asio.hpp>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class ELoadMessage : uint8_t
+{
+    PING,
+    TRANSACTION,
+    STEM_TRANSACTION,
+    COMPACT_BLOCK,
+    GET_HEADERS
+};
+
+static const size_t NUM_LOAD_MESSAGES = 5;
+
+namespace LoadMessage
+{
+    std::string ToString(const ELoadMessage type);
+    std::optional<ELoadMessage> FromString(const std::string& name);
+}
+
+//
+// The messages a load peer floods the node with.
+// Each time a peer picks a type (by weight), it sends one of that type's payloads at random.
+//
+struct LoadMix
+{
+    std::array<uint32_t, NUM_LOAD_MESSAGES> weights{};
+    std::array<std::vector<IMessagePtr>, NUM_LOAD_MESSAGES> payloads;
+};
+
+struct LoadPeerStats
+{
+    // Round trip of every message that completed, by type.
+    std::array<std::vector<double>, NUM_LOAD_MESSAGES> latency_ns;
+
+    // Messages whose response never arrived, because the node timed out or closed the connection.
+    std::array<uint64_t, NUM_LOAD_MESSAGES> drops{};
+
+    uint64_t connects{ 0 };
+    uint64_t disconnects{ 0 };
+    std::optional<EBanReason> ban_reason{ std::nullopt };
+
+    // CPU time spent by the peer's own thread, so it can be subtracted from the process total.
+    std::chrono::microseconds cpu_time{ 0 };
+};
+
+//
+// A single loopback connection to the node, speaking just enough of the protocol to handshake and flood it.
+//
+// Each peer binds its own 127.x.x.x source address, since the node allows only one connection per IP
+// and bans by IP, so peers must not share one. Linux routes all of 127.0.0.0/8 to the loopback interface;
+// other platforms need those addresses aliased first.
+//
+// A node handles each connection's messages one at a time, in order, so a message is complete once the
+// node has answered a ping sent after it. Ping and GetHeaders are timed to their own Pong and Headers,
+// every other message to that trailing ping.
+//
+class LoadPeer
+{
+public:
+    using Ptr = std::shared_ptr<LoadPeer>;
+
+    // Returns the reason the node banned the IP, if it's banned.
+    using BanCheck = std::function<std::optional<EBanReason>(const IPAddress&)>;
+
+    LoadPeer(
+        const size_t index,
+        const SocketAddress& nodeAddress,
+        const std::shared_ptr<const LoadMix>& pMix,
+        const std::chrono::milliseconds& timeout
+    );
+
+    const IPAddress& GetSourceIP() const noexcept { return m_sourceIP; }
+    const LoadPeerStats& GetStats() const noexcept { return m_stats; }
+
+    // Opens the connection and performs the handshake. Returns false if the node refused it.
+    bool Connect();
+
+    // Sends messages until the deadline, throttled to the given rate (0 for no limit).
+    // When the node disconnects, reconnects unless the IP was banned, in which case the peer stops.
+    void Run(const std::chrono::steady_clock::time_point& deadline, const double messagesPerSec, const BanCheck& isBanned);
+
+private:
+    enum class EReceive
+    {
+        RECEIVED,
+        TIMED_OUT,
+        DISCONNECTED
+    };
+
+    void Disconnect();
+    bool Reconnect(const BanCheck& isBanned);
+
+    bool Send(const std::vector<uint8_t>& serialized);
+    EReceive Await(const MessageTypes::EMessageType type);
+    EReceive Receive(std::unique_ptr<RawMessage>& pMessage, const std::chrono::steady_clock::time_point& deadline);
+    EReceive Read(std::vector<uint8_t>& buffer, const std::chrono::steady_clock::time_point& deadline);
+
+    IPAddress m_sourceIP;
+    SocketAddress m_nodeAddress;
+    std::shared_ptr<const LoadMix> m_pMix;
+    std::chrono::milliseconds m_timeout;
+
+    asio::io_context m_context;
+    asio::ip::tcp::socket m_socket;
+    EProtocolVersion m_protocolVersion;
+
+    std::mt19937_64 m_rng;
+    LoadPeerStats m_stats;
+};
@@ -0,0 +1,337 @@
+#include "LoadPeer.h"
+#include "../Chain/GeneratedChain.h"
+
+#include <ProcessStats.h>
+#include <TestServer.h>
+
+#include <P2P/P2PServer.h>
+#include <P2P/Messages/PingMessage.h>
+#include <P2P/Messages/TransactionMessage.h>
+#include <P2P/Messages/StemTransactionMessage.h>
+#include <P2P/Messages/CompactBlockMessage.h>
+#include <P2P/Messages/GetHeadersMessage.h>
+#include <BlockChain/CompactBlockFactory.h>
+#include <Core/Global.h>
+#include <Core/Context.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/StringUtil.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Common/Util/TimeUtil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+
+//
+// P2P load generator.
+//
+// Usage: P2PLoad [--connections <n>] [--duration <secs>] [--rate <msgs/sec>] [--mix <type=weight,...>]
+//                [--timeout-ms <ms>] [--blocks <n>] [--txs <m>] [--chain <file>] [--json <file>]
+//
+// Starts an automated-testing node in-process, loaded with all but the last block of a generated chain,
+// then opens --connections loopback peers that each flood it with a weighted mix of ping, transaction,
+// stem_transaction, compact_block and get_headers messages for --duration seconds (at most --rate messages
+// per second per peer, if given). Transactions come from the chain's last block, the compact block is an
+// equal-height competitor to the node's tip, and get_headers asks for every header from genesis.
+//
+// Reports per-type message handling latency and drops, how many peers were disconnected or banned (and why),
+// and the node's CPU time per message: process CPU time minus what the peers' own threads used.
+// Every non-ping message is followed by a ping to time it, which counts against the node's rate limit too.
+//
+static void PrintUsage()
+{
+    std::cerr << "Usage: P2PLoad [--connections <n>] [--duration <secs>] [--rate <msgs/sec>] [--mix <type=weight,...>]" << std::endl
+        << "               [--timeout-ms <ms>] [--blocks <n>] [--txs <m>] [--chain <file>] [--json <file>]" << std::endl;
+}
+
+static bool ParseMix(const std::string& mix, LoadMix& loadMix)
+{
+    loadMix.weights.fill(0);
+    for (const std::string& entry : StringUtil::Split(mix, ","))
+    {
+        const std::vector<std::string> parts = StringUtil::Split(entry, "=");
+        const std::optional<ELoadMessage> type = LoadMessage::FromString(parts.front());
+        if (parts.size() != 2 || !type.has_value()) {
+            std::cerr << "Unknown message type in mix: " << entry << std::endl;
+            return false;
+        }
+
+        loadMix.weights[(size_t)type.value()] = (uint32_t)std::stoul(parts.back());
+    }
+
+    return std::any_of(loadMix.weights.cbegin(), loadMix.weights.cend(), [](const uint32_t weight) { return weight > 0; });
+}
+
+static double Percentile(const std::vector<double>& sorted, const double percentile)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    const size_t rank = (size_t)std::ceil(sorted.size() * percentile);
+    return sorted[(std::min)(sorted.size() - 1, (std::max)(rank, (size_t)1) - 1)];
+}
+
+int main(int argc, char* argv[])
+{
+    size_t numConnections = 200;
+    uint64_t durationSecs = 30;
+    double rate = 0.0;
+    std::string mix = "ping=1,transaction=4,stem_transaction=2,compact_block=1,get_headers=2";
+    uint64_t timeoutMs = 5000;
+    std::optional<fs::path> chainPath = std::nullopt;
+    std::optional<fs::path> jsonPath = std::nullopt;
+
+    // The compact block is the first block of the fork, which is as tall as the node's tip when it branches 2 below the full chain.
+    ChainParams params;
+    params.num_blocks = 40;
+    params.txs_per_block = 8;
+    params.reorg_depth = 2;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--connections" && hasValue) {
+            numConnections = std::stoull(argv[++i]);
+        } else if (arg == "--duration" && hasValue) {
+            durationSecs = std::stoull(argv[++i]);
+        } else if (arg == "--rate" && hasValue) {
+            rate = std::stod(argv[++i]);
+        } else if (arg == "--mix" && hasValue) {
+            mix = argv[++i];
+        } else if (arg == "--timeout-ms" && hasValue) {
+            timeoutMs = std::stoull(argv[++i]);
+        } else if (arg == "--blocks" && hasValue) {
+            params.num_blocks = std::stoull(argv[++i]);
+        } else if (arg == "--txs" && hasValue) {
+            params.txs_per_block = std::stoull(argv[++i]);
+        } else if (arg == "--chain" && hasValue) {
+            chainPath = std::make_optional<fs::path>(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = std::make_optional<fs::path>(argv[++i]);
+        } else {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    auto pLoadMix = std::make_shared<LoadMix>();
+    if (numConnections == 0 || numConnections >= 0xFFFF || params.num_blocks <= params.reorg_depth || !ParseMix(mix, *pLoadMix)) {
+        PrintUsage();
+        return -1;
+    }
+
+    // Room for every load peer, and no outbound connections of the node's own.
+    ConfigPtr pConfig = Config::Default(Environment::AUTOMATED_TESTING);
+    pConfig->SetMaxPeers((int)numConnections + 1);
+    pConfig->SetMinPeers(0);
+
+    auto pContext = Context::Create(Environment::AUTOMATED_TESTING, pConfig);
+    Global::Init(pContext);
+
+    if (!chainPath.has_value()) {
+        chainPath = std::make_optional<fs::path>(StringUtil::Format(
+            "chain_{}_{}_{}_{}.bin",
+            params.num_blocks,
+            params.txs_per_block,
+            params.outputs_per_tx,
+            params.reorg_depth
+        ));
+    }
+
+    Json::Value json;
+    try
+    {
+        GeneratedChain::Ptr pChain = GeneratedChain::Load(chainPath.value(), params);
+        if (pChain == nullptr) {
+            std::cerr << "Generating chain: " << chainPath.value().u8string() << std::endl;
+            pChain = GeneratedChain::Generate(params);
+            pChain->Save(chainPath.value());
+        }
+
+        const std::vector<GeneratedBlock>& blocks = pChain->GetBlocks();
+        if (blocks.back().txs.empty()) {
+            throw std::runtime_error("The chain's last block has no transactions. Use more --blocks, so coinbases can mature.");
+        }
+
+        TestServer::Ptr pServer = TestServer::Create();
+        for (size_t i = 0; i < blocks.size() - 1; i++)
+        {
+            if (pServer->GetBlockChain()->AddBlock(blocks[i].block) != EBlockChainStatus::SUCCESS) {
+                throw std::runtime_error("Failed to add block " + std::to_string(blocks[i].block.GetHeight()));
+            }
+        }
+
+        pLoadMix->payloads[(size_t)ELoadMessage::PING].push_back(std::make_shared<PingMessage>(0, 0));
+        for (const TransactionPtr& pTx : blocks.back().txs)
+        {
+            pLoadMix->payloads[(size_t)ELoadMessage::TRANSACTION].push_back(std::make_shared<TransactionMessage>(pTx));
+            pLoadMix->payloads[(size_t)ELoadMessage::STEM_TRANSACTION].push_back(std::make_shared<StemTransactionMessage>(pTx));
+        }
+        pLoadMix->payloads[(size_t)ELoadMessage::COMPACT_BLOCK].push_back(
+            std::make_shared<CompactBlockMessage>(CompactBlockFactory::CreateCompactBlock(pChain->GetFork().front()))
+        );
+        pLoadMix->payloads[(size_t)ELoadMessage::GET_HEADERS].push_back(
+            std::make_shared<GetHeadersMessage>(std::vector<Hash>({ Global::GetGenesisHash() }))
+        );
+
+        IP2PServerPtr pP2PServer = P2PAPI::StartP2PServer(
+            pContext,
+            pServer->GetBlockChain(),
+            pServer->GetTxHashSetManager(),
+            pServer->GetDatabase(),
+            pServer->GetTxPool()
+        );
+
+        const SocketAddress nodeAddress(IPAddress::CreateV4({ 127, 0, 0, 1 }), pConfig->GetP2PPort());
+        std::vector<LoadPeer::Ptr> peers;
+        size_t refused = 0;
+        for (size_t i = 0; i < numConnections; i++)
+        {
+            auto pPeer = std::make_shared<LoadPeer>(i, nodeAddress, pLoadMix, std::chrono::milliseconds(timeoutMs));
+            if (pPeer->Connect()) {
+                peers.push_back(pPeer);
+            } else {
+                refused++;
+            }
+        }
+
+        std::cerr << "Connected " << peers.size() << " peers (" << refused << " refused)" << std::endl;
+
+        // Transactions are ignored until the node decides it's synced, which needs connected peers.
+        const auto syncTimeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (pP2PServer->GetSyncStatus()->GetStatus() != ESyncStatus::NOT_SYNCING && std::chrono::steady_clock::now() < syncTimeout) {
+            ThreadUtil::SleepFor(std::chrono::milliseconds(10));
+        }
+
+        const LoadPeer::BanCheck isBanned = [pP2PServer](const IPAddress& address) -> std::optional<EBanReason> {
+            auto peerOpt = pP2PServer->GetPeer(address);
+            if (peerOpt.has_value() && peerOpt.value()->IsBanned()) {
+                return std::make_optional(peerOpt.value()->GetBanReason());
+            }
+
+            return std::nullopt;
+        };
+
+        const std::chrono::microseconds cpuStart = ProcessStats::GetCPUTime();
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + std::chrono::seconds(durationSecs);
+
+        std::vector<std::thread> threads;
+        for (const LoadPeer::Ptr& pPeer : peers)
+        {
+            threads.push_back(std::thread([pPeer, deadline, rate, isBanned]() { pPeer->Run(deadline, rate, isBanned); }));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        const double elapsedSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::chrono::microseconds nodeCPU = ProcessStats::GetCPUTime() - cpuStart;
+
+        // Aggregate the peers' stats.
+        std::array<std::vector<double>, NUM_LOAD_MESSAGES> latencies;
+        std::array<uint64_t, NUM_LOAD_MESSAGES> drops{};
+        uint64_t disconnects = 0;
+        uint64_t reconnects = 0;
+        std::map<std::string, uint64_t> bans;
+        for (const LoadPeer::Ptr& pPeer : peers)
+        {
+            const LoadPeerStats& stats = pPeer->GetStats();
+            for (size_t type = 0; type < NUM_LOAD_MESSAGES; type++)
+            {
+                latencies[type].insert(latencies[type].end(), stats.latency_ns[type].cbegin(), stats.latency_ns[type].cend());
+                drops[type] += stats.drops[type];
+            }
+
+            disconnects += stats.disconnects;
+            reconnects += stats.connects - 1;
+            if (stats.ban_reason.has_value()) {
+                bans[BanReason::Format(stats.ban_reason.value())]++;
+            }
+
+            nodeCPU -= stats.cpu_time;
+        }
+
+        uint64_t totalMessages = 0;
+        Json::Value messagesJSON(Json::arrayValue);
+        for (size_t type = 0; type < NUM_LOAD_MESSAGES; type++)
+        {
+            std::vector<double>& sorted = latencies[type];
+            std::sort(sorted.begin(), sorted.end());
+            totalMessages += sorted.size() + drops[type];
+
+            Json::Value typeJSON;
+            typeJSON["type"] = LoadMessage::ToString((ELoadMessage)type);
+            typeJSON["completed"] = Json::UInt64(sorted.size());
+            typeJSON["dropped"] = Json::UInt64(drops[type]);
+            typeJSON["msgs_per_sec"] = sorted.size() / elapsedSecs;
+            typeJSON["p50_ns"] = Percentile(sorted, 0.5);
+            typeJSON["p99_ns"] = Percentile(sorted, 0.99);
+            typeJSON["max_ns"] = sorted.empty() ? 0.0 : sorted.back();
+            messagesJSON.append(typeJSON);
+
+            if (pLoadMix->weights[type] > 0) {
+                std::cerr << std::left << std::setw(20) << typeJSON["type"].asString()
+                    << std::right << std::fixed << std::setprecision(1)
+                    << std::setw(12) << typeJSON["msgs_per_sec"].asDouble() << " msgs/s"
+                    << std::setw(12) << typeJSON["p50_ns"].asDouble() / 1e6 << " ms p50"
+                    << std::setw(12) << typeJSON["p99_ns"].asDouble() / 1e6 << " ms p99"
+                    << std::setw(10) << drops[type] << " dropped" << std::endl;
+            }
+        }
+
+        Json::Value bansJSON(Json::objectValue);
+        uint64_t totalBans = 0;
+        for (const auto& ban : bans)
+        {
+            std::cerr << "Banned for '" << ban.first << "': " << ban.second << " peers" << std::endl;
+            bansJSON[ban.first] = Json::UInt64(ban.second);
+            totalBans += ban.second;
+        }
+
+        const double cpuPerMessage = totalMessages > 0 ? (double)nodeCPU.count() / totalMessages : 0.0;
+        std::cerr << "Node CPU: " << std::fixed << std::setprecision(1) << cpuPerMessage << " us/msg, "
+            << disconnects << " disconnects, " << totalBans << " peers banned" << std::endl;
+
+        json["connections"] = Json::UInt64(peers.size());
+        json["refused"] = Json::UInt64(refused);
+        json["duration_secs"] = elapsedSecs;
+        json["rate_per_connection"] = rate;
+        json["mix"] = mix;
+        json["messages"] = messagesJSON;
+        json["total_messages"] = Json::UInt64(totalMessages);
+        json["disconnects"] = Json::UInt64(disconnects);
+        json["reconnects"] = Json::UInt64(reconnects);
+        json["banned"] = Json::UInt64(totalBans);
+        json["bans"] = bansJSON;
+        json["node_cpu_us"] = Json::Int64(nodeCPU.count());
+        json["node_cpu_us_per_msg"] = cpuPerMessage;
+        json["peak_rss_bytes"] = Json::UInt64(ProcessStats::GetPeakRSS());
+
+        peers.clear();
+        pP2PServer.reset();
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Load test failed: " << e.what() << std::endl;
+        Global::Shutdown();
+        return -1;
+    }
+
+    if (jsonPath.has_value())
+    {
+        json["timestamp"] = Json::Int64(TimeUtil::Now());
+        FileUtil::WriteTextToFile(jsonPath.value(), json.toStyledString());
+    }
+
+    Global::Shutdown();
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <Bench.h>
+#include <BenchData.h>
+
+#include <PMMR/Common/MMRHashUtil.h>
+#include <PMMR/Common/PruneList.h>
+#include <PMMR/Common/LeafIndex.h>
+#include <Common/Util/FileUtil.h>
+
+// Builds a hash file containing the given number of leaves, each a serialized commitment-sized blob.
+static HashFile::Ptr BuildHashFile(const std::string& name, const uint64_t numLeaves)
+{
+    const fs::path path = BenchData::GetTempDir() / name;
+    FileUtil::RemoveFile(path);
+
+    HashFile::Ptr pHashFile = HashFile::Load(path);
+    std::mt19937_64 rng = BenchData::Rng(numLeaves);
+    for (uint64_t i = 0; i < numLeaves; i++)
+    {
+        MMRHashUtil::AddHashes(pHashFile, BenchData::RandomBytes(rng, 33), nullptr);
+    }
+
+    pHashFile->Commit();
+    return pHashFile;
+}
+
+// Builds a prune list for an MMR with the given number of leaves, where roughly half of the leaves are pruned.
+static PruneList::Ptr BuildPruneList(const std::string& name, const uint64_t numLeaves)
+{
+    const fs::path path = BenchData::GetTempDir() / name;
+    FileUtil::RemoveFile(path);
+
+    PruneList::Ptr pPruneList = PruneList::Load(path);
+    std::mt19937_64 rng = BenchData::Rng(numLeaves);
+    for (uint64_t i = 0; i < numLeaves; i++)
+    {
+        if (rng() % 2 == 0) {
+            pPruneList->Add(LeafIndex::At(i).GetIndex());
+        }
+    }
+
+    // The shift caches are only built when loading.
+    pPruneList->Flush();
+    return PruneList::Load(path);
+}
+
+BENCH_GROUP("pmmr/hashes", runner)
+{
+    for (const uint64_t numLeaves : std::vector<uint64_t>({ 64, 1024 }))
+    {
+        runner.Run("pmmr/hashes/add/" + std::to_string(numLeaves), numLeaves, [numLeaves]() {
+            HashFile::Ptr pHashFile = BuildHashFile("add_hashes.bin", 65536);
+
+            std::mt19937_64 rng = BenchData::Rng(0);
+            auto pLeaves = std::make_shared<std::vector<std::vector<uint8_t>>>();
+            for (uint64_t i = 0; i < numLeaves; i++)
+            {
+                pLeaves->push_back(BenchData::RandomBytes(rng, 33));
+            }
+
+            return Bench::Case{
+                [pHashFile, pLeaves]() {
+                    for (const std::vector<uint8_t>& leaf : *pLeaves)
+                    {
+                        MMRHashUtil::AddHashes(pHashFile, leaf, nullptr);
+                    }
+                },
+                [pHashFile]() { pHashFile->Rollback(); }
+            };
+        });
+    }
+
+    // Sizes are just below a power of 2, so the MMRs have many peaks.
+    for (const uint64_t numLeaves : std::vector<uint64_t>({ 65535, 1048575 }))
+    {
+        runner.Run("pmmr/hashes/root/" + std::to_string(numLeaves), 1, [numLeaves]() {
+            HashFile::Ptr pHashFile = BuildHashFile("root.bin", numLeaves);
+
+            return Bench::Case{ [pHashFile]() { MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr); } };
+        });
+    }
+}
+
+BENCH_GROUP("pmmr/prune_list", runner)
+{
+    static const uint64_t NUM_LOOKUPS = 4096;
+
+    for (const uint64_t numLeaves : std::vector<uint64_t>({ 65536, 1048576 }))
+    {
+        runner.Run("pmmr/prune_list/get_shift/" + std::to_string(numLeaves), NUM_LOOKUPS, [numLeaves]() {
+            PruneList::CPtr pPruneList = BuildPruneList("prune_list.bin", numLeaves);
+
+            const uint64_t mmrSize = LeafIndex::At(numLeaves).GetPosition();
+            std::mt19937_64 rng = BenchData::Rng(0);
+            auto pIndices = std::make_shared<std::vector<Index>>();
+            for (uint64_t i = 0; i < NUM_LOOKUPS; i++)
+            {
+                pIndices->push_back(Index::At(rng() % mmrSize));
+            }
+
+            return Bench::Case{
+                [pPruneList, pIndices]() {
+                    uint64_t totalShift = 0;
+                    for (const Index& index : *pIndices)
+                    {
+                        totalShift += pPruneList->GetShift(index);
+                    }
+
+                    Bench::DoNotOptimize(totalShift);
+                }
+            };
+        });
+    }
+}
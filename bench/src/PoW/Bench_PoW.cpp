@@ -0,0 +1,60 @@
+#include <Bench.h>
+#include <BenchData.h>
+
+#include <PoW/Common.h>
+#include <PoW/Cuckaroo.h>
+#include <PoW/Cuckatoo.h>
+#include <Core/Global.h>
+#include <algorithm>
+#include <set>
+
+//
+// Builds a header with a well-formed proof (ascending, in range) of random edges.
+// There's no solver to find real cycles, so validation fails when the edge endpoints don't match up.
+// That check happens after every edge has been hashed, which is where nearly all of the time goes.
+//
+static BlockHeader BuildHeader(const uint8_t edgeBits, const uint64_t stream)
+{
+    std::mt19937_64 rng = BenchData::Rng(stream);
+
+    std::set<uint64_t> edges;
+    while (edges.size() < PROOFSIZE)
+    {
+        edges.insert(rng() & (((uint64_t)1 << edgeBits) - 1));
+    }
+
+    const BlockHeader& genesis = *Global::GetGenesisHeader();
+    return BlockHeader(
+        genesis.GetVersion(),
+        genesis.GetHeight() + 1,
+        genesis.GetTimestamp() + 60,
+        Hash(genesis.GetHash()),
+        Hash(genesis.GetPreviousRoot()),
+        Hash(genesis.GetOutputRoot()),
+        Hash(genesis.GetRangeProofRoot()),
+        Hash(genesis.GetKernelRoot()),
+        BlindingFactor(genesis.GetTotalKernelOffset()),
+        genesis.GetOutputMMRSize(),
+        genesis.GetKernelMMRSize(),
+        genesis.GetTotalDifficulty() + 1,
+        genesis.GetScalingDifficulty(),
+        rng(),
+        ProofOfWork(edgeBits, std::vector<uint64_t>(edges.cbegin(), edges.cend()))
+    );
+}
+
+BENCH_GROUP("pow", runner)
+{
+    runner.Run("pow/cuckaroo29/validate", 1, []() {
+        auto pHeader = std::make_shared<BlockHeader>(BuildHeader(29, 29));
+        return Bench::Case{ [pHeader]() { Cuckaroo::Validate(*pHeader); } };
+    });
+
+    for (const uint8_t edgeBits : std::vector<uint8_t>({ 31, 32 }))
+    {
+        runner.Run("pow/cuckatoo" + std::to_string(edgeBits) + "/validate", 1, [edgeBits]() {
+            auto pHeader = std::make_shared<BlockHeader>(BuildHeader(edgeBits, edgeBits));
+            return Bench::Case{ [pHeader]() { Cuckatoo::Validate(*pHeader); } };
+        });
+    }
+}
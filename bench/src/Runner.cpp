@@ -0,0 +1,98 @@
+#include <Bench.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+using namespace Bench;
+
+std::vector<std::pair<std::string, Group>>& Registry::GetGroups()
+{
+    static std::vector<std::pair<std::string, Group>> groups;
+    return groups;
+}
+
+void Bench::UseCharPointer(const volatile char*) { }
+
+Json::Value Result::ToJSON() const
+{
+    Json::Value json;
+    json["name"] = name;
+    json["items"] = Json::UInt64(items);
+    json["iterations"] = Json::UInt64(iterations);
+    json["min_ns"] = min_ns;
+    json["mean_ns"] = mean_ns;
+    json["median_ns"] = median_ns;
+    json["p99_ns"] = p99_ns;
+    json["stddev_ns"] = stddev_ns;
+    json["ns_per_item"] = median_ns / (std::max)(items, (uint64_t)1);
+    json["items_per_sec"] = median_ns > 0 ? (items * 1e9) / median_ns : 0.0;
+    return json;
+}
+
+void Runner::Run(const std::string& name, const uint64_t items, const std::function<Case()>& prepare)
+{
+    if (name.find(m_options.filter) == std::string::npos) {
+        return;
+    }
+
+    if (m_options.list_only) {
+        std::cout << name << std::endl;
+        return;
+    }
+
+    const Case benchCase = prepare();
+
+    // Warm up caches, lazy initialization and the branch predictor before measuring.
+    if (benchCase.reset) {
+        benchCase.reset();
+    }
+    benchCase.run();
+
+    std::vector<double> samples;
+    const auto minTime = std::chrono::milliseconds(m_options.min_time_ms);
+    std::chrono::nanoseconds totalTime(0);
+    while (samples.size() < m_options.max_iterations
+        && (samples.size() < m_options.min_iterations || totalTime < minTime))
+    {
+        if (benchCase.reset) {
+            benchCase.reset();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        benchCase.run();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        totalTime += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        samples.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const double mean = std::accumulate(samples.cbegin(), samples.cend(), 0.0) / samples.size();
+    double variance = 0.0;
+    for (const double sample : samples)
+    {
+        variance += (sample - mean) * (sample - mean);
+    }
+
+    Result result;
+    result.name = name;
+    result.items = items;
+    result.iterations = samples.size();
+    result.min_ns = samples.front();
+    result.mean_ns = mean;
+    result.median_ns = samples[samples.size() / 2];
+    result.p99_ns = samples[(std::min)(samples.size() - 1, (size_t)std::ceil(samples.size() * 0.99) - 1)];
+    result.stddev_ns = std::sqrt(variance / samples.size());
+
+    std::cerr << std::left << std::setw(56) << name
+        << std::right << std::setw(14) << std::fixed << std::setprecision(1) << result.median_ns / 1000.0 << " us/op"
+        << std::setw(14) << result.median_ns / (std::max)(items, (uint64_t)1) << " ns/item"
+        << std::setw(10) << result.iterations << " iters" << std::endl;
+
+    m_results.push_back(std::move(result));
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#define METRICS_API
+
+//
+// Process-wide counters, gauges and latency histograms, exported in the Prometheus text format at /v1/metrics.
+//
+// Metrics are created on first lookup and live until the process exits. Lookups take a lock, so hot paths
+// keep the returned reference (usually in a function-local static). Recording only touches atomics.
+//
+namespace Metrics
+{
+	class Counter
+	{
+	public:
+		void Increment(const uint64_t amount = 1) noexcept { m_value.fetch_add(amount, std::memory_order_relaxed); }
+		uint64_t Get() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_value{ 0 };
+	};
+
+	class Gauge
+	{
+	public:
+		void Set(const int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+		void Add(const int64_t amount) noexcept { m_value.fetch_add(amount, std::memory_order_relaxed); }
+		int64_t Get() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<int64_t> m_value{ 0 };
+	};
+
+	//
+	// Log-linear histogram of durations, in the style of HdrHistogram: every power of two from 1us to ~34s
+	// is split into equal-width buckets, so relative error is bounded across the whole range instead of
+	// depending on hand-picked bucket bounds. Faster observations land in the first bucket, slower in the last.
+	//
+	class Histogram
+	{
+	public:
+		static constexpr uint32_t SUB_BUCKET_BITS = 1;
+		static constexpr uint32_t MIN_EXPONENT = 10;
+		static constexpr uint32_t MAX_EXPONENT = 35;
+		static constexpr size_t NUM_BUCKETS = ((size_t)(MAX_EXPONENT - MIN_EXPONENT) << SUB_BUCKET_BITS) + 2;
+
+		void Observe(const std::chrono::nanoseconds& duration) noexcept;
+
+		uint64_t GetCount() const noexcept { return m_count.load(std::memory_order_relaxed); }
+		uint64_t GetSumNanos() const noexcept { return m_sum.load(std::memory_order_relaxed); }
+		uint64_t GetBucketCount(const size_t bucket) const noexcept { return m_buckets[bucket].load(std::memory_order_relaxed); }
+
+		// Index of the bucket a duration of the given nanoseconds falls in.
+		static size_t GetBucket(const uint64_t nanos) noexcept;
+
+		// Exclusive upper bound of the bucket, in nanoseconds. The last bucket has none, and returns UINT64_MAX.
+		static uint64_t GetUpperBound(const size_t bucket) noexcept;
+
+	private:
+		std::array<std::atomic<uint64_t>, NUM_BUCKETS> m_buckets{};
+		std::atomic<uint64_t> m_count{ 0 };
+		std::atomic<uint64_t> m_sum{ 0 };
+	};
+
+	//
+	// Observes the time from construction until destruction.
+	//
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Histogram& histogram) noexcept
+			: m_histogram(histogram), m_start(std::chrono::steady_clock::now()) { }
+		~ScopedTimer() { m_histogram.Observe(std::chrono::steady_clock::now() - m_start); }
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		Histogram& m_histogram;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	//
+	// Returns the metric with the given name and labels, creating it on first use.
+	// Labels are given as they appear in the export, e.g. R"(stage="apply")". Every metric sharing a name
+	// forms one family, so they must be the same kind and should share the same help text.
+	//
+	METRICS_API Counter& GetCounter(const std::string& name, const std::string& help, const std::string& labels = "");
+	METRICS_API Gauge& GetGauge(const std::string& name, const std::string& help, const std::string& labels = "");
+	METRICS_API Histogram& GetHistogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+	//
+	// Every metric in the Prometheus text exposition format (0.0.4). Histograms are exported in seconds.
+	//
+	METRICS_API std::string ExportPrometheus();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#define TRACING_API
+
+//
+// Scoped timeline spans, for seeing how work on different threads overlaps (e.g. pipeline bubbles during sync).
+//
+// Tracing is off by default, and a disabled span costs one relaxed atomic load. While enabled, each thread
+// records into its own fixed-size ring buffer, so the oldest spans are overwritten rather than growing without
+// bound. The buffers are exported in the Chrome trace-event JSON format, which chrome://tracing and
+// ui.perfetto.dev can both open.
+//
+namespace Tracing
+{
+	// Spans kept per thread, ~750KB once full. Threads that never record while enabled allocate nothing.
+	static constexpr size_t BUFFER_CAPACITY = 16384;
+
+	// Short-lived worker threads each get their own buffer, so only the most recently exited ones are kept.
+	static constexpr size_t MAX_EXITED_THREADS = 256;
+
+	//
+	// Enabling discards anything recorded by a previous session.
+	//
+	TRACING_API void SetEnabled(const bool enabled);
+	TRACING_API bool IsEnabled() noexcept;
+
+	//
+	// Names the calling thread's track in the exported trace. LoggerAPI::SetThreadName calls this,
+	// so threads named for logging don't need to do so again.
+	//
+	TRACING_API void SetThreadName(const std::string& threadName);
+
+	//
+	// Every buffered span, as a Chrome trace-event JSON document.
+	//
+	TRACING_API std::string ExportChromeJSON();
+
+	//
+	// Records a completed span on the calling thread. Name and arg name must outlive the trace, so string literals only.
+	//
+	TRACING_API void Record(
+		const char* name,
+		const std::chrono::steady_clock::time_point& start,
+		const std::chrono::steady_clock::time_point& end,
+		const char* argName,
+		const uint64_t argValue
+	) noexcept;
+
+	//
+	// Records the time from construction until destruction, if tracing was enabled when it was constructed.
+	// An optional numeric arg (e.g. a block height) is shown alongside the span.
+	//
+	class Span
+	{
+	public:
+		explicit Span(const char* name, const char* argName = nullptr, const uint64_t argValue = 0) noexcept
+			: m_name(IsEnabled() ? name : nullptr), m_argName(argName), m_argValue(argValue)
+		{
+			if (m_name != nullptr) {
+				m_start = std::chrono::steady_clock::now();
+			}
+		}
+
+		~Span()
+		{
+			if (m_name != nullptr) {
+				Record(m_name, m_start, std::chrono::steady_clock::now(), m_argName, m_argValue);
+			}
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+
+	private:
+		const char* m_name;
+		const char* m_argName;
+		uint64_t m_argValue;
+		std::chrono::steady_clock::time_point m_start;
+	};
+}
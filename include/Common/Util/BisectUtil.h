@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+class BisectUtil
+{
+public:
+	//
+	// Finds the items responsible for a failed batch verification.
+	// verifyRange(begin, end) should return true only if every item in [begin, end) is valid.
+	// A failing range is split in half until each failure is isolated, and ranges that verify are never split further.
+	// Returns the indices of the failing items in ascending order, or an empty vector if the whole batch verifies.
+	//
+	static std::vector<size_t> FindFailures(const size_t numItems, const std::function<bool(const size_t, const size_t)>& verifyRange)
+	{
+		std::vector<size_t> failures;
+		if (numItems > 0 && !verifyRange(0, numItems)) {
+			Bisect(0, numItems, verifyRange, failures);
+		}
+
+		return failures;
+	}
+
+	//
+	// Like FindFailures, but only isolates the first failing item, for callers that reject the whole batch anyway.
+	// Only one half of each failing range is re-verified, so isolating it costs at most about twice the original batch.
+	//
+	static std::optional<size_t> FindFirstFailure(const size_t numItems, const std::function<bool(const size_t, const size_t)>& verifyRange)
+	{
+		if (numItems == 0 || verifyRange(0, numItems)) {
+			return std::nullopt;
+		}
+
+		// [begin, end) is known to contain at least one failure.
+		size_t begin = 0;
+		size_t end = numItems;
+		while (end - begin > 1)
+		{
+			const size_t mid = begin + ((end - begin) / 2);
+			if (verifyRange(begin, mid)) {
+				begin = mid;
+			} else {
+				end = mid;
+			}
+		}
+
+		return begin;
+	}
+
+private:
+	// [begin, end) is already known to contain at least one failure.
+	static void Bisect(
+		const size_t begin,
+		const size_t end,
+		const std::function<bool(const size_t, const size_t)>& verifyRange,
+		std::vector<size_t>& failures)
+	{
+		if (end - begin == 1) {
+			failures.push_back(begin);
+			return;
+		}
+
+		const size_t mid = begin + ((end - begin) / 2);
+		if (verifyRange(begin, mid)) {
+			// The first half is valid, so the failure must be in the second half.
+			Bisect(mid, end, verifyRange, failures);
+		} else {
+			Bisect(begin, mid, verifyRange, failures);
+
+			if (!verifyRange(mid, end)) {
+				Bisect(mid, end, verifyRange, failures);
+			}
+		}
+	}
+};
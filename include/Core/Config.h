@@ -6,6 +6,7 @@
 #include <filesystem.h>
 #include <json/json.h>
 #include <Net/IPAddress.h>
+#include <Net/Servers/ServerOptions.h>
 #include <unordered_set>
 
 class Config
@@ -31,6 +32,7 @@ public:
 	const fs::path& GetDatabasePath() const noexcept;
 	const fs::path& GetTxHashSetPath() const noexcept;
 	uint16_t GetRestAPIPort() const noexcept;
+	const ServerOptions& GetRestAPIServerOptions() const noexcept;
 	uint64_t GetFeeBase() const noexcept;
 
 	//
@@ -66,11 +68,30 @@ public:
 	uint8_t GetPatienceSeconds() const noexcept;
 	uint8_t GetStemProbability() const noexcept;
 
+	//
+	// TxPool
+	//
+	uint64_t GetMempoolMaxBytes() const noexcept;
+	uint64_t GetMempoolMaxWeight() const noexcept;
+	uint64_t GetStempoolMaxBytes() const noexcept;
+	uint64_t GetStempoolMaxWeight() const noexcept;
+
+	//
+	// Chain DB
+	//
+	uint64_t GetChainDBBlockCacheBytes() const noexcept;
+	uint64_t GetChainDBHeaderCacheBytes() const noexcept;
+	int GetChainDBBloomBitsPerKey() const noexcept;
+	const std::string& GetChainDBBlockCompression() const noexcept;
+	uint64_t GetChainDBWriteBufferBytes() const noexcept;
+	uint64_t GetChainDBArchiveDepth() const noexcept;
+
 	//
 	// Wallet
 	//
 	const fs::path& GetWalletPath() const noexcept;
 	uint32_t GetOwnerPort() const noexcept;
+	const ServerOptions& GetWalletServerOptions() const noexcept;
 	uint32_t GetPublicKeyVersion() const noexcept;
 	uint32_t GetPrivateKeyVersion() const noexcept;
 
@@ -29,6 +29,11 @@ public:
 
 	void Discard() noexcept;
 	uint64_t GetSize() const noexcept;
+	const fs::path& GetPath() const noexcept { return m_path; }
+
+	// Replaces the contents of this file with the file at the given path, which is moved into place.
+	// Fails if there are unflushed changes.
+	void Replace(const fs::path& replacement);
 
 	bool Read(
 		const uint64_t position,
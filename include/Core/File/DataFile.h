@@ -1,11 +1,16 @@
 #pragma once
 
 #include <Core/File/AppendOnlyFile.h>
+#include <Core/File/FileSwap.h>
 #include <Core/Exceptions/FileException.h>
 #include <Core/Traits/Batchable.h>
 #include <Crypto/Models/BigInteger.h>
 #include <Common/Util/StringUtil.h>
+#include <Common/GrinStr.h>
+#include <algorithm>
+#include <fstream>
 #include <memory>
+#include <vector>
 
 template<size_t NUM_BYTES>
 class DataFile : public Traits::IBatchable
@@ -84,6 +89,105 @@ public:
 		m_pFile->Append(data.GetData());
 	}
 
+	const fs::path& GetPath() const noexcept
+	{
+		return m_pFile->GetPath();
+	}
+
+	//
+	// Writes a compacted copy of the file at 'path' to its staged path, keeping only the elements whose position is flagged in 'keep'.
+	// The file is read directly rather than through a loaded DataFile, so this can run without holding any lock while the DataFile is in use,
+	// as long as its first keep.size() elements are committed and don't change.
+	//
+	static void StageCompaction(const fs::path& path, const std::vector<bool>& keep)
+	{
+		std::ifstream inFile(path, std::ios::in | std::ios::binary);
+		if (!inFile.is_open())
+		{
+			throw FILE_EXCEPTION_F("Failed to open {}", path);
+		}
+
+		const fs::path stagedPath = FileSwap::GetStagedPath(path);
+		std::ofstream outFile(stagedPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!outFile.is_open())
+		{
+			throw FILE_EXCEPTION_F("Failed to open {}", stagedPath);
+		}
+
+		std::vector<unsigned char> chunk(ELEMENTS_PER_CHUNK * NUM_BYTES);
+		for (uint64_t chunkStart = 0; chunkStart < keep.size(); chunkStart += ELEMENTS_PER_CHUNK)
+		{
+			const uint64_t chunkSize = (std::min)(ELEMENTS_PER_CHUNK, keep.size() - chunkStart);
+			if (!inFile.read((char*)chunk.data(), chunkSize * NUM_BYTES))
+			{
+				throw FILE_EXCEPTION_F("Failed to read {}", path);
+			}
+
+			for (uint64_t i = 0; i < chunkSize; i++)
+			{
+				if (keep[chunkStart + i])
+				{
+					outFile.write((const char*)chunk.data() + (i * NUM_BYTES), NUM_BYTES);
+				}
+			}
+		}
+
+		outFile.close();
+		if (outFile.fail())
+		{
+			throw FILE_EXCEPTION_F("Failed to write {}", stagedPath);
+		}
+	}
+
+	//
+	// Appends the elements from 'position' onwards to the staged copy, so it also includes everything added since it was staged.
+	//
+	void AppendToStaged(const uint64_t position) const
+	{
+		if (IsDirty() || position > GetSize())
+		{
+			throw FILE_EXCEPTION_F("Unable to append to staged copy of {}", GetPath());
+		}
+
+		const fs::path stagedPath = FileSwap::GetStagedPath(GetPath());
+		std::ofstream outFile(stagedPath, std::ios::out | std::ios::binary | std::ios::app);
+		if (!outFile.is_open())
+		{
+			throw FILE_EXCEPTION_F("Failed to open {}", stagedPath);
+		}
+
+		std::vector<unsigned char> chunk;
+		for (uint64_t chunkStart = position; chunkStart < GetSize(); chunkStart += ELEMENTS_PER_CHUNK)
+		{
+			const uint64_t chunkSize = (std::min)(ELEMENTS_PER_CHUNK, GetSize() - chunkStart);
+			if (!m_pFile->Read(chunkStart * NUM_BYTES, chunkSize * NUM_BYTES, chunk))
+			{
+				throw FILE_EXCEPTION_F("Failed to read {}", GetPath());
+			}
+
+			outFile.write((const char*)chunk.data(), chunk.size());
+		}
+
+		outFile.close();
+		if (outFile.fail())
+		{
+			throw FILE_EXCEPTION_F("Failed to write {}", stagedPath);
+		}
+	}
+
+	//
+	// Replaces the file with its staged copy.
+	//
+	void SwapStaged()
+	{
+		if (IsDirty())
+		{
+			throw FILE_EXCEPTION_F("Unable to swap {} with uncommitted changes", GetPath());
+		}
+
+		m_pFile->Replace(FileSwap::GetStagedPath(GetPath()));
+	}
+
 private:
 	DataFile(std::shared_ptr<AppendOnlyFile> pFile)
 		: m_pFile(pFile)
@@ -91,5 +195,7 @@ private:
 
 	}
 
+	static constexpr uint64_t ELEMENTS_PER_CHUNK = (1024 * 1024) / NUM_BYTES;
+
 	std::shared_ptr<AppendOnlyFile> m_pFile;
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem.h>
+#include <vector>
+
+//
+// Replaces a set of files with staged copies of them, as a single unit.
+// The manifest listing the files is written before any of them is replaced, and removed once they all are,
+// so if the process dies part way through, Recover() finishes the swap on the next startup.
+//
+class FileSwap
+{
+public:
+	//
+	// Returns the path of the staged copy that will replace the given file.
+	//
+	static fs::path GetStagedPath(const fs::path& path);
+
+	//
+	// Writes the manifest. Every file must already be fully staged, since once this returns, the swap will be completed, even if interrupted.
+	//
+	static void Begin(const fs::path& manifestPath, const std::vector<fs::path>& files);
+
+	//
+	// Replaces the file with its staged copy.
+	//
+	static void Swap(const fs::path& path);
+
+	//
+	// Removes the manifest, once every file has been swapped.
+	//
+	static void End(const fs::path& manifestPath);
+
+	//
+	// Removes any staged copies of the files, for swaps that won't go ahead.
+	//
+	static void Discard(const std::vector<fs::path>& files) noexcept;
+
+	//
+	// Completes a swap that was interrupted after its manifest was written.
+	// Staged copies of the given files that aren't part of such a swap were never swapped in, so they're discarded.
+	//
+	static void Recover(const fs::path& manifestPath, const std::vector<fs::path>& files);
+};
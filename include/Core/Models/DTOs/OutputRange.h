@@ -1,6 +1,10 @@
 #pragma once
 
 #include <Core/Models/DTOs/OutputDTO.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Exceptions/DeserializationException.h>
+#include <functional>
 
 class OutputRange
 {
@@ -15,6 +19,134 @@ public:
 	uint64_t GetLastRetrievedIndex() const { return m_lastRetrievedIndex; }
 	const std::vector<OutputDTO>& GetOutputs() const { return m_outputs; }
 
+	//
+	// Binary format, streamed by /v1/txhashset/outputs/binary:
+	//   u8 version | u64 highest_index | { u32 length | OutputDTO }* | u32 0 | u64 last_retrieved_index
+	// Each output is length-prefixed, so readers can skip fields added in later versions.
+	//
+	static constexpr uint8_t BINARY_FORMAT_VERSION = 1;
+
+	static void SerializeHeader(Serializer& serializer, const uint64_t highestIndex)
+	{
+		serializer.Append<uint8_t>(BINARY_FORMAT_VERSION);
+		serializer.Append<uint64_t>(highestIndex);
+	}
+
+	static void SerializeOutput(Serializer& serializer, const OutputDTO& output)
+	{
+		Serializer outputSerializer;
+		output.Serialize(outputSerializer);
+		serializer.AppendByteVector(outputSerializer.GetBytes(), ESerializeLength::U32);
+	}
+
+	static void SerializeTrailer(Serializer& serializer, const uint64_t lastRetrievedIndex)
+	{
+		serializer.Append<uint32_t>(0);
+		serializer.Append<uint64_t>(lastRetrievedIndex);
+	}
+
+	void Serialize(Serializer& serializer) const
+	{
+		SerializeHeader(serializer, m_highestIndex);
+		for (const OutputDTO& output : m_outputs)
+		{
+			SerializeOutput(serializer, output);
+		}
+		SerializeTrailer(serializer, m_lastRetrievedIndex);
+	}
+
+	//
+	// Reads up to maxOutputs outputs starting at startIndex, fetching them a page at a time, so only one page is ever held in memory.
+	// getPage(startIndex, maxOutputs) returns one page. onHeader is called with the highest index before any outputs,
+	// then onOutput is called for each output. Returns the last retrieved index.
+	//
+	static uint64_t ReadPages(
+		const uint64_t startIndex,
+		const uint64_t maxOutputs,
+		const uint64_t pageSize,
+		const std::function<OutputRange(const uint64_t, const uint64_t)>& getPage,
+		const std::function<void(const uint64_t)>& onHeader,
+		const std::function<void(const OutputDTO&)>& onOutput)
+	{
+		uint64_t nextIndex = startIndex;
+		uint64_t remaining = maxOutputs;
+		uint64_t lastRetrievedIndex = 0;
+		bool first = true;
+		do
+		{
+			OutputRange range = getPage(nextIndex, (std::min)(remaining, pageSize));
+			if (first)
+			{
+				onHeader(range.GetHighestIndex());
+				first = false;
+			}
+
+			for (const OutputDTO& output : range.GetOutputs())
+			{
+				onOutput(output);
+			}
+
+			if (range.GetOutputs().empty())
+			{
+				break;
+			}
+
+			lastRetrievedIndex = range.GetLastRetrievedIndex();
+			remaining -= range.GetOutputs().size();
+			nextIndex = lastRetrievedIndex + 1;
+		} while (remaining > 0);
+
+		return lastRetrievedIndex;
+	}
+
+	//
+	// Serializes up to maxOutputs outputs starting at startIndex, so only the serialized bytes and one page are held in memory.
+	// See ReadPages.
+	//
+	static void SerializePages(
+		Serializer& serializer,
+		const uint64_t startIndex,
+		const uint64_t maxOutputs,
+		const uint64_t pageSize,
+		const std::function<OutputRange(const uint64_t, const uint64_t)>& getPage)
+	{
+		const uint64_t lastRetrievedIndex = ReadPages(
+			startIndex,
+			maxOutputs,
+			pageSize,
+			getPage,
+			[&serializer](const uint64_t highestIndex) { SerializeHeader(serializer, highestIndex); },
+			[&serializer](const OutputDTO& output) { SerializeOutput(serializer, output); }
+		);
+
+		SerializeTrailer(serializer, lastRetrievedIndex);
+	}
+
+	static OutputRange Deserialize(ByteBuffer& byteBuffer)
+	{
+		const uint8_t version = byteBuffer.ReadU8();
+		if (version != BINARY_FORMAT_VERSION)
+		{
+			throw DESERIALIZATION_EXCEPTION_F("Unsupported output range version {}", version);
+		}
+
+		const uint64_t highestIndex = byteBuffer.ReadU64();
+
+		std::vector<OutputDTO> outputs;
+		uint32_t length = byteBuffer.ReadU32();
+		while (length > 0)
+		{
+			ByteBuffer outputBuffer(byteBuffer.ReadVector(length));
+			outputs.push_back(OutputDTO::Deserialize(outputBuffer));
+
+			length = byteBuffer.ReadU32();
+		}
+
+		const uint64_t lastRetrievedIndex = byteBuffer.ReadU64();
+
+		return OutputRange(highestIndex, lastRetrievedIndex, std::move(outputs));
+	}
+
 	static OutputRange FromJSON(const Json::Value& json)
 	{
 		const uint64_t highestIndex = JsonUtil::GetRequiredUInt64(json, "highest_index");
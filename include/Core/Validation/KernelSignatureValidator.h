@@ -1,8 +1,10 @@
 #pragma once
 
 #include <Crypto/Crypto.h>
+#include <Crypto/VerificationCache.h>
 #include <Core/Models/TransactionKernel.h>
 #include <Common/Logger.h>
+#include <Common/Util/BisectUtil.h>
 
 class KernelSignatureValidator
 {
@@ -13,9 +15,20 @@ public:
 	}
 
 	// Verify the tx kernels.
-	// No ability to batch verify these right now so just do them individually.
-	static bool BatchVerify(const std::vector<TransactionKernel>& kernels)
+	// Kernels whose signatures were already verified (eg. when their tx entered the mempool) are skipped.
+	static bool BatchVerify(const std::vector<TransactionKernel>& allKernels)
 	{
+		VerificationCache& cache = VerificationCache::KernelSignatures();
+
+		std::vector<const TransactionKernel*> kernels;
+		kernels.reserve(allKernels.size());
+		for (const TransactionKernel& kernel : allKernels)
+		{
+			if (!cache.Contains(kernel.GetHash().GetData())) {
+				kernels.push_back(&kernel);
+			}
+		}
+
 		if (kernels.empty()) {
 			return true;
 		}
@@ -32,7 +45,7 @@ public:
 		// Verify the transaction proof validity. Entails handling the commitment as a public key and checking the signature verifies with the fee as message.
 		for (size_t i = 0; i < kernels.size(); i++)
 		{
-			const TransactionKernel& kernel = kernels[i];
+			const TransactionKernel& kernel = *kernels[i];
 			commitments.push_back(&kernel.GetExcessCommitment());
 			signatures.push_back(&kernel.GetExcessSignature());
 			msgs.emplace_back(kernel.GetSignatureMessage());
@@ -54,7 +67,35 @@ public:
 			return false;
 		}
 
+		for (const TransactionKernel* pKernel : kernels)
+		{
+			cache.Add(pKernel->GetHash().GetData());
+		}
+
 		LOG_TRACE("Verify success");
 		return true;
 	}
+
+	// Verify the tx kernels, returning the indices of any with invalid signatures.
+	// A failing batch is bisected until the invalid kernels are isolated, and the valid ones are cached along the way.
+	static std::vector<size_t> FindInvalid(const std::vector<TransactionKernel>& kernels)
+	{
+		return BisectUtil::FindFailures(
+			kernels.size(),
+			[&kernels](const size_t begin, const size_t end) {
+				return BatchVerify(std::vector<TransactionKernel>(kernels.cbegin() + begin, kernels.cbegin() + end));
+			}
+		);
+	}
+
+	// Verify the tx kernels as a single batch, returning the index of the first kernel with an invalid signature if the batch fails.
+	static std::optional<size_t> FindFirstInvalid(const std::vector<TransactionKernel>& kernels)
+	{
+		return BisectUtil::FindFirstFailure(
+			kernels.size(),
+			[&kernels](const size_t begin, const size_t end) {
+				return BatchVerify(std::vector<TransactionKernel>(kernels.cbegin() + begin, kernels.cbegin() + end));
+			}
+		);
+	}
 };
\ No newline at end of file
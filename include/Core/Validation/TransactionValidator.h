@@ -7,6 +7,12 @@ class TransactionValidator
 public:
 	void Validate(const Transaction& transaction, const uint64_t block_height) const;
 
+	//
+	// Runs only the cheap checks, which may give a different result for a different block height.
+	// Rangeproofs, kernel signatures, and kernel sums don't depend on the height, so they're skipped.
+	//
+	void ValidateForHeight(const Transaction& transaction, const uint64_t block_height) const;
+
 private:
 	void ValidateWeight(const TransactionBody& body, const uint64_t block_height) const;
 	void ValidateFeatures(const TransactionBody& transactionBody) const;
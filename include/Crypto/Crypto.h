@@ -16,6 +16,8 @@
 #include <Crypto/Models/PublicKey.h>
 #include <Crypto/Models/SecretKey.h>
 #include <cstdint>
+#include <functional>
+#include <optional>
 #include <vector>
 #include <memory>
 
@@ -46,6 +48,16 @@ public:
 		const std::vector<Commitment>& negative
 	);
 
+	//
+	// Adds together the commitments returned by getCommitment for every index in [0, numCommitments),
+	// without gathering them all into memory first. Indices are summed in parallel, so getCommitment
+	// must be safe to call from multiple threads. Indices for which std::nullopt is returned are skipped.
+	//
+	static Commitment AddCommitments(
+		const uint64_t numCommitments,
+		const std::function<std::optional<Commitment>(const uint64_t)>& getCommitment
+	);
+
 	//
 	// Takes a vector of blinding factors and calculates an additional blinding value that adds to zero.
 	//
@@ -81,6 +93,21 @@ public:
 		const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs
 	);
 
+	//
+	// Verifies the rangeproofs as a batch, returning the indices of any that are invalid.
+	// A failing batch is bisected until the invalid proofs are isolated. Valid proofs are cached along the way.
+	//
+	static std::vector<size_t> FindInvalidRangeProofs(
+		const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs
+	);
+
+	//
+	// Verifies the rangeproofs as a single batch, returning the index of the first invalid proof if the batch fails.
+	//
+	static std::optional<size_t> FindFirstInvalidRangeProof(
+		const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs
+	);
+
 	//
 	//
 	//
@@ -105,4 +105,11 @@ public:
 		const uint64_t k1,
 		const std::vector<unsigned char>& data
 	);
+
+	static uint64_t SipHash24(
+		const uint64_t k0,
+		const uint64_t k1,
+		const uint8_t* data,
+		const size_t len
+	);
 };
\ No newline at end of file
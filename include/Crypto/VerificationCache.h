@@ -0,0 +1,52 @@
+#pragma once
+
+// Copyright (c) 2018-2019 David Burkett
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#define CRYPTO_API
+
+//
+// Lock-free, fixed-size set of items (signatures, rangeproofs, etc.) that have already been verified.
+// Keys are reduced to 64-bit fingerprints using SipHash with a random per-process key,
+// so an attacker can't craft an item whose fingerprint collides with that of a verified one.
+// The table is split into many small buckets that are read and updated independently using atomics.
+// When a bucket is full, a pseudo-random slot is overwritten, so the cache never grows beyond its initial size.
+//
+class CRYPTO_API VerificationCache
+{
+public:
+	VerificationCache(const size_t numEntries);
+
+	//
+	// Cache of kernel signatures that were already verified, keyed by kernel hash.
+	// Shared between the transaction pool and block validation.
+	//
+	static VerificationCache& KernelSignatures();
+
+	//
+	// Cache of rangeproofs that were already verified, keyed by commitment and proof.
+	//
+	static VerificationCache& RangeProofs();
+
+	bool Contains(const std::vector<uint8_t>& key) const noexcept;
+	void Add(const std::vector<uint8_t>& key) noexcept;
+
+	// Forgets every verified item, so the next verification of each is done in full.
+	void Clear() noexcept;
+
+private:
+	static const size_t SLOTS_PER_BUCKET = 4;
+
+	uint64_t Fingerprint(const std::vector<uint8_t>& key) const noexcept;
+	std::atomic<uint64_t>* GetBucket(const uint64_t fingerprint) const noexcept;
+
+	size_t m_numBuckets;
+	std::unique_ptr<std::atomic<uint64_t>[]> m_pSlots;
+	uint64_t m_sipKey[2];
+};
@@ -39,13 +39,20 @@ public:
 	virtual void MigrateBlocks() = 0;
 
 	/// <summary>
-	/// Removes all blocks beyond the horizon.
+	/// Removes all blocks and spent output records older than the configured archive depth.
+	/// The archive depth is never less than the cut-through horizon.
 	/// </summary>
-	/// <param name="pChain"></param>
+	/// <param name="pChain">The confirmed chain.</param>
 	virtual void Compact(const std::shared_ptr<const Chain>& pChain) = 0;
 
 	virtual BlockHeaderPtr GetBlockHeader(const Hash& hash) const = 0;
 
+	/// <summary>
+	/// Loads the most recent headers of the chain into the in-memory header cache.
+	/// </summary>
+	/// <param name="pChain">The chain whose headers should be cached, typically the candidate chain.</param>
+	virtual void WarmHeaderCache(const std::shared_ptr<const Chain>& pChain) const = 0;
+
 	virtual void AddBlockHeader(BlockHeaderPtr pBlockHeader) = 0;
 	virtual void AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) = 0;
 
@@ -53,11 +60,17 @@ public:
 	virtual std::unique_ptr<FullBlock> GetBlock(const Hash& hash) const = 0;
 	virtual void ClearBlocks() = 0;
 
+	/// <summary>
+	/// Removes the full blocks and spent output records of the given blocks. Headers are kept.
+	/// </summary>
+	virtual void RemoveBlocks(const std::vector<Hash>& blockHashes) = 0;
+
 	virtual void AddBlockSums(const Hash& blockHash, const BlockSums& blockSums) = 0;
 	virtual std::unique_ptr<BlockSums> GetBlockSums(const Hash& blockHash) const = 0;
 	virtual void ClearBlockSums() = 0;
 
 	virtual void AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location) = 0;
+	virtual void AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>& outputPositions) = 0;
 	virtual std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const = 0;
 	virtual void RemoveOutputPositions(const std::vector<Commitment>& outputCommitments) = 0;
 	virtual void ClearOutputPositions() = 0;
@@ -41,6 +41,13 @@ public:
 		return Invoke(location, RPC::Request::BuildRequest(method));
 	}
 
+	// Sends a plain GET request, for endpoints that don't use json-rpc.
+	HTTP::Response Get(const std::string& location)
+	{
+		HTTPClient httpClient;
+		return httpClient.Invoke(HTTP::Request(HTTP::EHTTPMethod::GET, location, m_host, m_port, ""));
+	}
+
 private:
 	std::string m_host;
 	uint16_t m_port;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Common/Util/TimeUtil.h>
+#include <Common/Metrics.h>
 #include <mutex>
 #include <queue>
 
@@ -28,6 +29,25 @@ public:
 		m_sent.push(TimeUtil::Now());
 	}
 
+	// Bytes are only tallied across all connections, for /v1/metrics. Rate limiting is still by message count.
+	static void AddBytesReceived(const size_t bytes)
+	{
+		static Metrics::Counter& counter = Metrics::GetCounter(
+			"grinpp_p2p_received_bytes_total",
+			"Bytes received from all P2P peers."
+		);
+		counter.Increment(bytes);
+	}
+
+	static void AddBytesSent(const size_t bytes)
+	{
+		static Metrics::Counter& counter = Metrics::GetCounter(
+			"grinpp_p2p_sent_bytes_total",
+			"Bytes sent to all P2P peers."
+		);
+		counter.Increment(bytes);
+	}
+
 	size_t GetReceivedInLastMinute()
 	{
 		std::unique_lock<std::mutex> lock(m_receivedMutex);
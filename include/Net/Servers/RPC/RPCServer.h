@@ -19,9 +19,10 @@ public:
 		const EServerType type,
 		const std::optional<uint16_t>& port,
 		const std::string& uri,
-		const LoggerAPI::LogFile& logFile)
+		const LoggerAPI::LogFile& logFile,
+		const ServerOptions& options = ServerOptions())
 	{
-		ServerPtr pServer = Server::Create(type, port);
+		ServerPtr pServer = Server::Create(type, port, options);
 		return RPCServer::Create(pServer, uri, logFile);
 	}
 
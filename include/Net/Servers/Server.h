@@ -1,9 +1,13 @@
 #pragma once
 
+#include <Net/Servers/ServerOptions.h>
+#include <atomic>
 #include <cassert>
 #include <string>
 #include <optional>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 enum class EServerType
 {
@@ -19,23 +23,48 @@ typedef int(*mg_request_handler)(struct mg_connection* conn, void* cbdata);
 class Server
 {
 public:
-	static std::shared_ptr<Server> Create(const EServerType type, const std::optional<uint16_t>& port);
+	static std::shared_ptr<Server> Create(
+		const EServerType type,
+		const std::optional<uint16_t>& port,
+		const ServerOptions& options = ServerOptions()
+	);
 	virtual ~Server();
 
 	uint16_t GetPortNumber() const noexcept { return m_portNumber; }
 
+	//
+	// Registers the handler for the given uri.
+	// If the server options limit the uri's concurrency, requests beyond the limit receive a 503.
+	//
 	void AddListener(const std::string& uri, mg_request_handler handler, void* pCallbackData) noexcept;
 
 private:
-	Server(mg_context* pContext, const uint16_t portNumber)
-		: m_pContext(pContext), m_portNumber(portNumber)
+	struct LimitedListener
+	{
+		LimitedListener(mg_request_handler handler_, void* pCallbackData_, const uint32_t maxActive_)
+			: handler(handler_), pCallbackData(pCallbackData_), maxActive(maxActive_), numActive(0) { }
+
+		mg_request_handler handler;
+		void* pCallbackData;
+		uint32_t maxActive;
+		std::atomic<uint32_t> numActive;
+	};
+
+	Server(mg_context* pContext, const uint16_t portNumber, const ServerOptions& options)
+		: m_pContext(pContext), m_portNumber(portNumber), m_options(options)
 	{
 		assert(pContext != nullptr);
 		assert(portNumber > 0);
 	}
 
+	static int LimitedHandler(struct mg_connection* conn, void* pLimitedListener);
+
 	mg_context* m_pContext;
 	uint16_t m_portNumber;
+	ServerOptions m_options;
+
+	std::mutex m_listenersMutex;
+	std::vector<std::unique_ptr<LimitedListener>> m_limitedListeners;
 };
 
-typedef std::shared_ptr<Server> ServerPtr;
\ No newline at end of file
+typedef std::shared_ptr<Server> ServerPtr;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+//
+// Tuning options for the embedded HTTP server.
+//
+struct ServerOptions
+{
+	// Number of worker threads. With keep-alive, an idle connection occupies a worker until it times out.
+	uint32_t numThreads = 10;
+
+	bool keepAlive = true;
+	uint32_t keepAliveTimeoutMs = 5000;
+	uint32_t requestTimeoutMs = 120000;
+
+	// Accepted connections waiting for a free worker.
+	uint32_t connectionQueue = 64;
+
+	// Connections waiting to be accepted by the OS.
+	uint32_t listenBacklog = 256;
+
+	// Maximum number of concurrent requests per listener URI. Listeners not in the map are unlimited.
+	std::unordered_map<std::string, uint32_t> endpointLimits;
+};
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <Net/Clients/HTTP/HTTP.h>
+#include <Net/Util/JsonStreamWriter.h>
 #include <json/json.h>
 #include <cassert>
+#include <functional>
 #include <string>
 #include <optional>
+#include <utility>
+#include <vector>
 
 // Forward Declarations
 struct mg_connection;
@@ -24,9 +28,21 @@ public:
 
 	static int BuildSuccessResponseJSON(mg_connection* conn, const Json::Value& json);
 	static int BuildSuccessResponse(mg_connection* conn, const std::string& response);
+	static int BuildSuccessResponseBinary(mg_connection* conn, const std::vector<uint8_t>& response);
+	static int BuildSuccessResponseText(mg_connection* conn, const std::string& response, const std::string& contentType = "text/plain");
+
+	// Sends a 200 response using chunked transfer encoding, streaming the JSON as writeBody produces it.
+	// Once the headers are sent the status can't change, so failures while writing the body abort the response.
+	static int BuildChunkedJSONResponse(
+		mg_connection* conn,
+		const std::function<void(JsonStreamWriter&)>& writeBody,
+		const std::vector<std::pair<std::string, std::string>>& headers = {}
+	);
+
 	static int BuildBadRequestResponse(mg_connection* conn, const std::string& response);
 	static int BuildConflictResponse(mg_connection* conn, const std::string& response);
 	static int BuildUnauthorizedResponse(mg_connection* conn, const std::string& response);
 	static int BuildNotFoundResponse(mg_connection* conn, const std::string& response);
+	static int BuildServiceUnavailableResponse(mg_connection* conn, const std::string& response);
 	static int BuildInternalErrorResponse(mg_connection* conn, const std::string& response);
 };
\ No newline at end of file
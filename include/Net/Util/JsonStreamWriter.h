@@ -0,0 +1,61 @@
+#pragma once
+
+#include <json/json.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+//
+// Writes a JSON document incrementally, handing it to a sink in chunks as it's built.
+// Only the pending chunk and the element currently being written are held in memory,
+// so arbitrarily large responses can be produced with bounded memory.
+//
+// Ex: writer.BeginObject(); writer.WriteMember("height", 5); writer.Key("outputs"); writer.BeginArray(); ...
+//
+class JsonStreamWriter
+{
+public:
+	using Sink = std::function<void(const std::string&)>;
+
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+	JsonStreamWriter(const Sink& sink, const size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	// Writes the name of the next object member. Must be followed by a value, object, or array.
+	void Key(const std::string& name);
+
+	// Writes a complete value, either as an array element or as the value of the preceding key.
+	void Write(const Json::Value& value);
+
+	void WriteMember(const std::string& name, const Json::Value& value)
+	{
+		Key(name);
+		Write(value);
+	}
+
+	// Passes any buffered output to the sink. Must be called once the document is complete.
+	void Flush();
+
+private:
+	struct Scope
+	{
+		bool isArray;
+		size_t numEntries;
+	};
+
+	void BeginValue();
+	void Append(const std::string& str);
+
+	Sink m_sink;
+	size_t m_chunkSize;
+	std::string m_buffer;
+	std::vector<Scope> m_scopes;
+	bool m_awaitingValue;
+	Json::StreamWriterBuilder m_builder;
+};
@@ -21,6 +21,22 @@ class Transaction;
 class TransactionBody;
 class SyncStatus;
 
+//
+// A compaction of the output and rangeproof PMMRs, staged in separate files before they replace the originals.
+//
+class ITxHashSetCompaction
+{
+public:
+	using UPtr = std::unique_ptr<ITxHashSetCompaction>;
+
+	virtual ~ITxHashSetCompaction() = default;
+
+	//
+	// Writes the compacted files. Doesn't touch the TxHashSet itself, so no lock needs to be held.
+	//
+	virtual void Stage() = 0;
+};
+
 class ITxHashSet : public Traits::IBatchable
 {
 public:
@@ -146,8 +162,28 @@ public:
 
 	//
 	// Removes pruned leaves and hashes from the output and rangeproof PMMRs to reduce disk usage.
+	// Only outputs spent at or below the horizon are removed, so the MMRs can still be rewound to the horizon.
+	//
+	virtual void Compact(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const Chain::CPtr& pChain
+	) = 0;
+
+	//
+	// Same as Compact, but split up so the slow part can run without holding the lock.
+	// PlanCompaction only needs a read lock. The returned compaction is then staged without any lock,
+	// and ApplyCompaction swaps the staged files in under the write lock.
+	// Returns nullptr if there's nothing to compact.
+	//
+	virtual ITxHashSetCompaction::UPtr PlanCompaction(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const Chain::CPtr& pChain
+	) const = 0;
+
+	//
+	// Returns false if the TxHashSet was rewound past what was staged in the meantime, in which case the compaction is discarded.
 	//
-	virtual void Compact() = 0;
+	virtual bool ApplyCompaction(ITxHashSetCompaction& compaction) = 0;
 };
 
 typedef std::shared_ptr<ITxHashSet> ITxHashSetPtr;
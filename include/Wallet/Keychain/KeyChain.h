@@ -47,4 +47,9 @@ private:
 
 	PrivateExtKey m_masterKey;
 	SecretKey m_bulletProofNonce;
+
+	// Nonce hashes used for ENHANCED bulletproofs.
+	// These only depend on the master key, so they're calculated once rather than for every proof.
+	SecretKey m_privateNonceHash;
+	SecretKey m_rewindNonceHash;
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Crypto/Models/Hash.h>
+#include <cstdint>
+
+//
+// A chain tip that a wallet refresh completed at.
+// Checkpoints are used to skip refreshes when the tip hasn't changed,
+// and to find the fork point to roll back to when the chain reorgs.
+//
+class RefreshCheckpoint
+{
+public:
+	RefreshCheckpoint(const uint64_t height, const Hash& hash, const uint64_t restoreLeafIndex)
+		: m_height(height), m_hash(hash), m_restoreLeafIndex(restoreLeafIndex) { }
+
+	uint64_t GetHeight() const noexcept { return m_height; }
+	const Hash& GetHash() const noexcept { return m_hash; }
+
+	//
+	// The restore leaf index from before the refresh ran.
+	// Every leaf up to this index was already in the chain, so restoring can safely resume from here after rolling back to this checkpoint.
+	//
+	uint64_t GetRestoreLeafIndex() const noexcept { return m_restoreLeafIndex; }
+
+private:
+	uint64_t m_height;
+	Hash m_hash;
+	uint64_t m_restoreLeafIndex;
+};
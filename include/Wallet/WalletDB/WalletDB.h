@@ -1,6 +1,8 @@
 #pragma once
 
+#include <map>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <uuid.h>
@@ -11,6 +13,7 @@
 #include <Wallet/WalletDB/Models/SlateContextEntity.h>
 #include <Wallet/Models/Slate/Slate.h>
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
+#include <Wallet/WalletDB/Models/RefreshCheckpoint.h>
 #include <Wallet/WalletTx.h>
 
 class IWalletDB : public Traits::IBatchable
@@ -45,9 +48,28 @@ public:
 	void SaveOutput(const SecureVector& masterSeed, const OutputDataEntity& output) { AddOutputs(masterSeed, std::vector<OutputDataEntity>{ output }); }
 	virtual void AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs) = 0;
 	virtual std::vector<OutputDataEntity> GetOutputs(const SecureVector& masterSeed) const = 0;
+	virtual std::vector<OutputDataEntity> GetOutputs(const SecureVector& masterSeed, const std::vector<EOutputStatus>& statuses) const = 0;
+
+	// Returns the outputs with the given statuses that were confirmed at or above minBlockHeight.
+	virtual std::vector<OutputDataEntity> GetRecentOutputs(
+		const SecureVector& masterSeed,
+		const std::vector<EOutputStatus>& statuses,
+		const uint64_t minBlockHeight
+	) const = 0;
+	virtual std::vector<OutputDataEntity> GetOutputsByTxIds(const SecureVector& masterSeed, const std::unordered_set<uint32_t>& walletTxIds) const = 0;
+
+	// Returns the total amount of the outputs with each status, without loading the outputs themselves.
+	virtual std::map<EOutputStatus, uint64_t> GetOutputTotals(const SecureVector& masterSeed) const = 0;
 
 	virtual void AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx) = 0;
 	virtual std::vector<WalletTx> GetTransactions(const SecureVector& masterSeed) const = 0;
+
+	// Returns the transactions matching the given ids and types. An empty set matches everything.
+	virtual std::vector<WalletTx> GetTransactions(
+		const SecureVector& masterSeed,
+		const std::unordered_set<uint32_t>& ids,
+		const std::unordered_set<EWalletTxType>& types
+	) const = 0;
 	virtual std::unique_ptr<WalletTx> GetTransactionById(const SecureVector& masterSeed, const uint32_t walletTxId) const = 0;
 
 	virtual uint32_t GetNextTransactionId() = 0;
@@ -55,6 +77,12 @@ public:
 	virtual void UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight) = 0;
 	virtual uint64_t GetRestoreLeafIndex() const = 0;
 	virtual void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) = 0;
+
+	// Returns the refresh checkpoints, ordered from highest to lowest.
+	virtual std::vector<RefreshCheckpoint> GetRefreshCheckpoints() const = 0;
+	virtual void AddRefreshCheckpoint(const RefreshCheckpoint& checkpoint) = 0;
+	virtual void DeleteRefreshCheckpointsAbove(const uint64_t height) = 0;
+	virtual void DeleteRefreshCheckpointsBelow(const uint64_t height) = 0;
 };
 
 typedef std::shared_ptr<IWalletDB> IWalletDBPtr;
@@ -2,6 +2,7 @@
 
 #include <Wallet/WalletManager.h>
 #include <Wallet/Keychain/KeyChain.h>
+#include <Core/Global.h>
 #include "Handlers/ReceiveTxHandler.h"
 #include "Handlers/FinalizeTxHandler.h"
 #include "Handlers/CheckVersionHandler.h"
@@ -18,7 +19,8 @@ ForeignServer::UPtr ForeignServer::Create(
         EServerType::PUBLIC,
         std::nullopt,
         "/v2/foreign",
-        LoggerAPI::LogFile::WALLET
+        LoggerAPI::LogFile::WALLET,
+        Global::GetConfig().GetWalletServerOptions()
     );
 
     /*
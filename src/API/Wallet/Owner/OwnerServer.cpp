@@ -1,6 +1,7 @@
 #include <API/Wallet/Owner/OwnerServer.h>
 #include <Wallet/WalletManager.h>
 #include <Net/Tor/TorProcess.h>
+#include <Core/Global.h>
 
 // APIs
 #include "Handlers/CreateWalletHandler.h"
@@ -33,7 +34,8 @@ OwnerServer::UPtr OwnerServer::Create(const TorProcess::Ptr& pTorProcess, const
         EServerType::LOCAL,
         std::make_optional<uint16_t>((uint16_t)3421), // TODO: Read port from config (Use same port as v1 owner)
         "/v2",
-        LoggerAPI::LogFile::WALLET
+        LoggerAPI::LogFile::WALLET,
+        Global::GetConfig().GetWalletServerOptions()
     );
 
     /*
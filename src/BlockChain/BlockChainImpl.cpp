@@ -7,6 +7,7 @@
 #include "Processors/TxHashSetProcessor.h"
 #include "Processors/BlockProcessor.h"
 #include "ChainResyncer.h"
+#include "ChainCompactor.h"
 #include "CoinView.h"
 
 #include <Consensus.h>
@@ -21,14 +22,16 @@
 
 BlockChain::BlockChain(
 	std::shared_ptr<ITransactionPool> pTransactionPool,
-	std::shared_ptr<Locked<ChainState>> pChainState)
-	: m_pTransactionPool(pTransactionPool), m_pChainState(pChainState)
+	std::shared_ptr<Locked<ChainState>> pChainState,
+	std::unique_ptr<ChainCompactor>&& pCompactor)
+	: m_pTransactionPool(pTransactionPool), m_pChainState(pChainState), m_pCompactor(std::move(pCompactor))
 {
 
 }
 
 BlockChain::~BlockChain()
 {
+	m_pCompactor.reset();
 	Global::SetCoinView(nullptr);
 	m_pChainState.reset();
 	m_pTransactionPool.reset();
@@ -97,16 +100,19 @@ std::shared_ptr<BlockChain> BlockChain::Create(
 			if (pTxHashSet->GetFlushedBlockHeader()->GetHeight() < horizon) {
 				pTxHashSetManager->Write()->Close();
 			} else {
-				pTxHashSet->Compact();
+				pTxHashSet->Compact(pBatchDB.GetShared(), pChainStore->Read()->GetConfirmedChain());
 			}
 
 			pBatchTxHashSet->Commit();
 		}
 	}
 
+	pDatabase->Read()->WarmHeaderCache(pChainStore->Read()->GetCandidateChain());
+
 	return std::shared_ptr<BlockChain>(new BlockChain(
 		pTransactionPool,
-		pChainState
+		pChainState,
+		ChainCompactor::Create(config, pChainState)
 	));
 }
 
@@ -350,6 +356,10 @@ std::vector<BlockWithOutputs> BlockChain::GetOutputsByHeight(const uint64_t star
 {
 	auto pChainStateReader = m_pChainState->Read();
 	const uint64_t highestHeight = (std::min)(pChainStateReader->GetHeight(EChainType::CONFIRMED), maxHeight);
+	if (startHeight > highestHeight)
+	{
+		return {};
+	}
 
 	std::vector<BlockWithOutputs> blocksWithOutputs;
 	blocksWithOutputs.reserve(highestHeight - startHeight + 1);
@@ -2,6 +2,7 @@
 
 #include "ChainState.h"
 #include "ChainStore.h"
+#include "ChainCompactor.h"
 
 #include <TxPool/TransactionPool.h>
 #include <BlockChain/BlockChain.h>
@@ -67,9 +68,11 @@ public:
 private:
 	BlockChain(
 		std::shared_ptr<ITransactionPool> pTransactionPool,
-		std::shared_ptr<Locked<ChainState>> pChainState
+		std::shared_ptr<Locked<ChainState>> pChainState,
+		std::unique_ptr<ChainCompactor>&& pCompactor
 	);
 
 	std::shared_ptr<ITransactionPool> m_pTransactionPool;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
+	std::unique_ptr<ChainCompactor> m_pCompactor;
 };
@@ -0,0 +1,131 @@
+#include "ChainCompactor.h"
+
+#include <Common/Logger.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Core/Global.h>
+#include <PMMR/TxHashSet.h>
+#include <PMMR/TxHashSetManager.h>
+#include <algorithm>
+#include <chrono>
+
+ChainCompactor::~ChainCompactor()
+{
+	LOG_INFO("Shutting down chain compactor");
+	m_terminate = true;
+	ThreadUtil::Join(m_thread);
+}
+
+std::unique_ptr<ChainCompactor> ChainCompactor::Create(
+	const Config& config,
+	std::shared_ptr<Locked<ChainState>> pChainState)
+{
+	const uint64_t tipHeight = pChainState->Read()->GetHeight(EChainType::CONFIRMED);
+
+	auto pCompactor = std::unique_ptr<ChainCompactor>(new ChainCompactor(config, pChainState, tipHeight));
+	pCompactor->m_thread = std::thread(Thread_Compact, std::ref(*pCompactor.get()));
+
+	return pCompactor;
+}
+
+uint64_t ChainCompactor::GetPruneHeight(const Config& config, const uint64_t tipHeight)
+{
+	const uint64_t archiveDepth = config.GetChainDBArchiveDepth();
+	return tipHeight > archiveDepth ? tipHeight - archiveDepth : 0;
+}
+
+void ChainCompactor::Thread_Compact(ChainCompactor& compactor)
+{
+	LoggerAPI::SetThreadName("COMPACTOR");
+	LOG_TRACE("BEGIN");
+
+	auto lastCheckTime = std::chrono::system_clock::now();
+	while (!compactor.m_terminate && Global::IsRunning()) {
+		auto now = std::chrono::system_clock::now();
+		if (lastCheckTime + std::chrono::minutes(1) < now) {
+			lastCheckTime = now;
+
+			try {
+				const uint64_t tipHeight = compactor.m_pChainState->Read()->GetHeight(EChainType::CONFIRMED);
+
+				const uint64_t pruneHeight = GetPruneHeight(compactor.m_config, tipHeight);
+				if (pruneHeight > compactor.m_prunedHeight) {
+					compactor.PruneBlocks(pruneHeight);
+				}
+
+				const uint64_t horizon = Consensus::GetHorizonHeight(tipHeight);
+				// If the chain was rewound while the compaction was staged, it's retried on the next check.
+				if (horizon >= compactor.m_compactedHorizon + TXHASHSET_COMPACTION_INTERVAL) {
+					if (compactor.CompactTxHashSet()) {
+						compactor.m_compactedHorizon = horizon;
+					}
+				}
+			}
+			catch (std::exception& e) {
+				LOG_WARNING_F("Exception thrown: {}", e.what());
+			}
+		}
+
+		ThreadUtil::SleepFor(std::chrono::milliseconds(100));
+	}
+
+	LOG_TRACE("END");
+}
+
+void ChainCompactor::PruneBlocks(const uint64_t pruneHeight)
+{
+	std::vector<Hash> blockHashes;
+	{
+		auto pChain = m_pChainState->Read()->GetChainStore()->GetConfirmedChain();
+		const uint64_t endHeight = (std::min)(pruneHeight, pChain->GetHeight());
+		for (uint64_t height = m_prunedHeight; height < endHeight; height++) {
+			blockHashes.push_back(pChain->GetHash(height));
+		}
+	}
+
+	LOG_DEBUG_F("Removing {} blocks below height {}", blockHashes.size(), pruneHeight);
+
+	// Each batch takes the chain state lock separately, so block processing is never held up for long.
+	for (size_t i = 0; i < blockHashes.size() && !m_terminate; i += PRUNE_BATCH_SIZE) {
+		const size_t end = (std::min)(i + PRUNE_BATCH_SIZE, blockHashes.size());
+		std::vector<Hash> batchHashes(blockHashes.begin() + i, blockHashes.begin() + end);
+
+		auto pBatch = m_pChainState->BatchWrite();
+		pBatch->GetBlockDB()->RemoveBlocks(batchHashes);
+		pBatch->Commit();
+
+		m_prunedHeight += batchHashes.size();
+	}
+}
+
+bool ChainCompactor::CompactTxHashSet()
+{
+	// Planning only reads the TxHashSet, so block processing can continue alongside it.
+	ITxHashSetCompaction::UPtr pCompaction;
+	{
+		auto pReader = m_pChainState->Read();
+		auto pTxHashSet = pReader->GetTxHashSetManager()->GetTxHashSet();
+		if (pTxHashSet == nullptr) {
+			return true;
+		}
+
+		pCompaction = pTxHashSet->PlanCompaction(pReader->GetBlockDB().GetShared(), pReader->GetChainStore()->GetConfirmedChain());
+		if (pCompaction == nullptr) {
+			return true;
+		}
+	}
+
+	// Writing the compacted files is the slow part, and doesn't need any lock.
+	pCompaction->Stage();
+
+	// The write lock is only held to swap the staged files in.
+	auto pBatch = m_pChainState->BatchWrite();
+	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
+	if (pTxHashSet == nullptr) {
+		return false;
+	}
+
+	const bool applied = pTxHashSet->ApplyCompaction(*pCompaction);
+	pBatch->Commit();
+
+	return applied;
+}
\ No newline at end of file
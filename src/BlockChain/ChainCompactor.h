@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ChainState.h"
+
+#include <Consensus.h>
+#include <Core/Config.h>
+#include <Core/Traits/Lockable.h>
+#include <Crypto/Models/Hash.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//
+// Background job that reclaims disk space as the chain grows.
+// Full blocks and spent output records older than the archive depth are deleted,
+// and spent outputs & rangeproofs beyond the horizon are compacted out of the TxHashSet.
+// Work is done in small batches, and compacted TxHashSet files are written before taking the lock,
+// so the chain state is only ever locked briefly.
+//
+class ChainCompactor
+{
+public:
+	static std::unique_ptr<ChainCompactor> Create(
+		const Config& config,
+		std::shared_ptr<Locked<ChainState>> pChainState
+	);
+	~ChainCompactor();
+
+	//
+	// Returns the height below which full blocks are no longer kept.
+	//
+	static uint64_t GetPruneHeight(const Config& config, const uint64_t tipHeight);
+
+private:
+	ChainCompactor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState, const uint64_t tipHeight)
+		: m_config(config),
+		m_pChainState(pChainState),
+		m_prunedHeight(GetPruneHeight(config, tipHeight)),
+		m_compactedHorizon(Consensus::GetHorizonHeight(tipHeight)),
+		m_terminate(false) { }
+
+	static void Thread_Compact(ChainCompactor& compactor);
+
+	void PruneBlocks(const uint64_t pruneHeight);
+	// Returns false if the compaction was discarded because the TxHashSet changed while it was being staged.
+	bool CompactTxHashSet();
+
+	// Number of blocks removed per batch.
+	static constexpr size_t PRUNE_BATCH_SIZE = 500;
+
+	// Number of blocks the horizon must advance before the TxHashSet is compacted again.
+	static constexpr uint64_t TXHASHSET_COMPACTION_INTERVAL = Consensus::DAY_HEIGHT;
+
+	const Config& m_config;
+	std::shared_ptr<Locked<ChainState>> m_pChainState;
+
+	// Blocks below this height have already been removed.
+	uint64_t m_prunedHeight;
+
+	// Horizon at the time of the last TxHashSet compaction.
+	uint64_t m_compactedHorizon;
+
+	std::atomic<bool> m_terminate;
+	std::thread m_thread;
+};
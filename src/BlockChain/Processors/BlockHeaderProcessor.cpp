@@ -6,14 +6,27 @@
 #include <Core/Exceptions/BlockChainException.h>
 #include <BlockChain/BadBlocks.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <PMMR/HeaderMMR.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
 
 static const size_t SYNC_BATCH_SIZE = 128;
 
+static Metrics::Histogram& GetHeaderHistogram(const std::string& kind)
+{
+    return Metrics::GetHistogram(
+        "grinpp_header_process_seconds",
+        "Time to process a single relayed header, or a batch of up to 128 sync headers.",
+        "kind=\"" + kind + "\""
+    );
+}
+
 EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeaderPtr& pHeader)
 {
+    static Metrics::Histogram& singleHistogram = GetHeaderHistogram("single");
+    Metrics::ScopedTimer timer(singleHistogram);
+
     LOG_TRACE_F("Validating {}", *pHeader);
 
     if (BAD_BLOCKS.find(pHeader->GetHash()) != BAD_BLOCKS.end()) {
@@ -153,6 +166,13 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 
 EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(const std::vector<BlockHeaderPtr>& headers)
 {
+    static Metrics::Histogram& syncHistogram = GetHeaderHistogram("sync_batch");
+    static Metrics::Counter& validatedCounter = Metrics::GetCounter(
+        "grinpp_sync_headers_validated_total",
+        "Number of new sync headers validated."
+    );
+    Metrics::ScopedTimer timer(syncHistogram);
+
     auto pLockedState = m_pChainState->BatchWrite();
     auto pHeaderMMR = pLockedState->GetHeaderMMR();
     auto pChainStore = pLockedState->GetChainStore();
@@ -184,6 +204,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(const std::vec
 
     // Validate the headers.
     ValidateHeaders(pLockedState, newHeaders);
+    validatedCounter.Increment(newHeaders.size());
 
     // If total difficulty increases, accept sync chain as new candidate chain.
     if (newHeaders.back()->GetTotalDifficulty() <= totalDifficulty) {
@@ -7,15 +7,31 @@
 #include <Core/Exceptions/BadDataException.h>
 #include <Core/Validation/KernelSumValidator.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <algorithm>
 
+static Metrics::Histogram& GetStageHistogram(const std::string& stage)
+{
+	return Metrics::GetHistogram(
+		"grinpp_block_stage_seconds",
+		"Time spent in each stage of validating and applying a block.",
+		"stage=\"" + stage + "\""
+	);
+}
+
 BlockProcessor::BlockProcessor(const std::shared_ptr<Locked<ChainState>>& pChainState)
 	: m_pChainState(pChainState) { }
 
 EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock& block)
-{	
+{
+	static Metrics::Histogram& processHistogram = Metrics::GetHistogram(
+		"grinpp_block_process_seconds",
+		"Total time to process a block, including its header, whether or not it was added."
+	);
+	Metrics::ScopedTimer timer(processHistogram);
+
 	const uint64_t candidateHeight = m_pChainState->Read()->GetHeight(EChainType::CANDIDATE);
 	const uint64_t horizonHeight = Consensus::GetHorizonHeight(candidateHeight);
 
@@ -195,14 +211,29 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 		throw BLOCK_CHAIN_EXCEPTION("Previous header not found.");
 	}
 
-	if (pTxHashSet == nullptr || !pTxHashSet->ApplyBlock(pBlockDB, block)) {
-		throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to apply block {} to the TxHashSet.", block);
+	static Metrics::Histogram& applyHistogram = GetStageHistogram("apply");
+	static Metrics::Histogram& selfConsistentHistogram = GetStageHistogram("self_consistent");
+	static Metrics::Histogram& rootsHistogram = GetStageHistogram("roots");
+	static Metrics::Histogram& kernelSumsHistogram = GetStageHistogram("kernel_sums");
+	static Metrics::Histogram& storeHistogram = GetStageHistogram("store");
+
+	{
+		Metrics::ScopedTimer timer(applyHistogram);
+		if (pTxHashSet == nullptr || !pTxHashSet->ApplyBlock(pBlockDB, block)) {
+			throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to apply block {} to the TxHashSet.", block);
+		}
 	}
 
-	BlockValidator::VerifySelfConsistent(block);
+	{
+		Metrics::ScopedTimer timer(selfConsistentHistogram);
+		BlockValidator::VerifySelfConsistent(block);
+	}
 
-	if (!pTxHashSet->ValidateRoots(*block.GetHeader())) {
-		throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to validate TxHashSet roots for block {}.", block);
+	{
+		Metrics::ScopedTimer timer(rootsHistogram);
+		if (!pTxHashSet->ValidateRoots(*block.GetHeader())) {
+			throw BAD_DATA_EXCEPTION_F(EBanReason::BadBlock, "Failed to validate TxHashSet roots for block {}.", block);
+		}
 	}
 
 	std::unique_ptr<BlockSums> pPreviousBlockSums = pBlockDB->GetBlockSums(previousHash);
@@ -211,15 +242,23 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 		throw BLOCK_CHAIN_EXCEPTION("Failed to retrieve block sums.");
 	}
 
-	BlockSums blockSums = KernelSumValidator::ValidateKernelSums(
-		block.GetTransactionBody(),
-		0 - Consensus::REWARD,
-		block.GetTotalKernelOffset(),
-		std::make_optional(*pPreviousBlockSums)
-	);
+	std::optional<BlockSums> blockSumsOpt;
+	{
+		Metrics::ScopedTimer timer(kernelSumsHistogram);
+		blockSumsOpt = KernelSumValidator::ValidateKernelSums(
+			block.GetTransactionBody(),
+			0 - Consensus::REWARD,
+			block.GetTotalKernelOffset(),
+			std::make_optional(*pPreviousBlockSums)
+		);
+	}
+
+	{
+		Metrics::ScopedTimer timer(storeHistogram);
+		pBlockDB->AddBlockSums(block.GetHash(), blockSumsOpt.value());
+		pBlockDB->AddBlock(block);
+		pOrphanPool->RemoveOrphan(block.GetHeight(), block.GetHash());
+	}
 
-	pBlockDB->AddBlockSums(block.GetHash(), blockSums);
-	pBlockDB->AddBlock(block);
-	pOrphanPool->RemoveOrphan(block.GetHeight(), block.GetHash());
 	pTxPool->ReconcileBlock(pBlockDB, pTxHashSet, block);
 }
\ No newline at end of file
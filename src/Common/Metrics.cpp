@@ -0,0 +1,222 @@
+#include <Common/Metrics.h>
+#include <Common/Util/StringUtil.h>
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace Metrics;
+
+static uint32_t FloorLog2(const uint64_t value) noexcept
+{
+	assert(value != 0);
+
+#ifdef _MSC_VER
+	unsigned long index = 0;
+	_BitScanReverse64(&index, value);
+	return (uint32_t)index;
+#else
+	return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+}
+
+void Histogram::Observe(const std::chrono::nanoseconds& duration) noexcept
+{
+	const uint64_t nanos = duration.count() > 0 ? (uint64_t)duration.count() : 0;
+
+	m_buckets[GetBucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+size_t Histogram::GetBucket(const uint64_t nanos) noexcept
+{
+	if (nanos < (1ull << MIN_EXPONENT)) {
+		return 0;
+	}
+
+	const uint32_t exponent = FloorLog2(nanos);
+	if (exponent >= MAX_EXPONENT) {
+		return NUM_BUCKETS - 1;
+	}
+
+	// The bits just below the leading one pick the sub-bucket within the power of two.
+	const uint64_t subBucket = (nanos >> (exponent - SUB_BUCKET_BITS)) & ((1ull << SUB_BUCKET_BITS) - 1);
+	return 1 + ((size_t)(exponent - MIN_EXPONENT) << SUB_BUCKET_BITS) + (size_t)subBucket;
+}
+
+uint64_t Histogram::GetUpperBound(const size_t bucket) noexcept
+{
+	if (bucket == 0) {
+		return 1ull << MIN_EXPONENT;
+	}
+
+	if (bucket >= NUM_BUCKETS - 1) {
+		return UINT64_MAX;
+	}
+
+	const uint32_t exponent = MIN_EXPONENT + (uint32_t)((bucket - 1) >> SUB_BUCKET_BITS);
+	const uint64_t subBucket = (bucket - 1) & ((1ull << SUB_BUCKET_BITS) - 1);
+	return (1ull << exponent) + ((subBucket + 1) << (exponent - SUB_BUCKET_BITS));
+}
+
+namespace
+{
+	enum class EMetricType
+	{
+		COUNTER,
+		GAUGE,
+		HISTOGRAM
+	};
+
+	struct Family
+	{
+		EMetricType type;
+		std::string help;
+
+		// Keyed by labels, so the export is in a stable order.
+		std::map<std::string, std::unique_ptr<Counter>> counters;
+		std::map<std::string, std::unique_ptr<Gauge>> gauges;
+		std::map<std::string, std::unique_ptr<Histogram>> histograms;
+	};
+
+	struct Registry
+	{
+		std::mutex mutex;
+		std::map<std::string, Family> families;
+
+		static Registry& Instance()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		Family& GetFamily(const std::string& name, const std::string& help, const EMetricType type)
+		{
+			auto iter = families.find(name);
+			if (iter == families.end()) {
+				iter = families.emplace(name, Family{ type, help, {}, {}, {} }).first;
+			}
+
+			assert(iter->second.type == type);
+			return iter->second;
+		}
+	};
+
+	template<typename T>
+	T& GetOrCreate(std::map<std::string, std::unique_ptr<T>>& metrics, const std::string& labels)
+	{
+		std::unique_ptr<T>& pMetric = metrics[labels];
+		if (pMetric == nullptr) {
+			pMetric = std::make_unique<T>();
+		}
+
+		return *pMetric;
+	}
+
+	std::string WithLabels(const std::string& name, const std::string& labels, const std::string& extraLabel = "")
+	{
+		if (labels.empty() && extraLabel.empty()) {
+			return name;
+		}
+
+		const std::string separator = (labels.empty() || extraLabel.empty()) ? "" : ",";
+		return name + "{" + labels + separator + extraLabel + "}";
+	}
+
+	std::string ToSeconds(const uint64_t nanos)
+	{
+		return StringUtil::Format("{}", nanos / 1e9);
+	}
+}
+
+Counter& Metrics::GetCounter(const std::string& name, const std::string& help, const std::string& labels)
+{
+	Registry& registry = Registry::Instance();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+	return GetOrCreate(registry.GetFamily(name, help, EMetricType::COUNTER).counters, labels);
+}
+
+Gauge& Metrics::GetGauge(const std::string& name, const std::string& help, const std::string& labels)
+{
+	Registry& registry = Registry::Instance();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+	return GetOrCreate(registry.GetFamily(name, help, EMetricType::GAUGE).gauges, labels);
+}
+
+Histogram& Metrics::GetHistogram(const std::string& name, const std::string& help, const std::string& labels)
+{
+	Registry& registry = Registry::Instance();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+	return GetOrCreate(registry.GetFamily(name, help, EMetricType::HISTOGRAM).histograms, labels);
+}
+
+std::string Metrics::ExportPrometheus()
+{
+	Registry& registry = Registry::Instance();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+
+	std::string output;
+	for (const auto& entry : registry.families)
+	{
+		const std::string& name = entry.first;
+		const Family& family = entry.second;
+
+		static const char* TYPE_NAMES[] = { "counter", "gauge", "histogram" };
+		output += "# HELP " + name + " " + family.help + "\n";
+		output += "# TYPE " + name + " " + TYPE_NAMES[(size_t)family.type] + "\n";
+
+		switch (family.type)
+		{
+			case EMetricType::COUNTER:
+			{
+				for (const auto& counter : family.counters)
+				{
+					output += WithLabels(name, counter.first) + " " + std::to_string(counter.second->Get()) + "\n";
+				}
+
+				break;
+			}
+			case EMetricType::GAUGE:
+			{
+				for (const auto& gauge : family.gauges)
+				{
+					output += WithLabels(name, gauge.first) + " " + std::to_string(gauge.second->Get()) + "\n";
+				}
+
+				break;
+			}
+			case EMetricType::HISTOGRAM:
+			{
+				for (const auto& histogram : family.histograms)
+				{
+					// Observations can land while the buckets are being read, so the total reported
+					// alongside them must be at least the sum of the buckets to stay consistent.
+					uint64_t cumulative = 0;
+					for (size_t bucket = 0; bucket < Histogram::NUM_BUCKETS - 1; bucket++)
+					{
+						cumulative += histogram.second->GetBucketCount(bucket);
+						const std::string le = "le=\"" + ToSeconds(Histogram::GetUpperBound(bucket)) + "\"";
+						output += WithLabels(name + "_bucket", histogram.first, le) + " " + std::to_string(cumulative) + "\n";
+					}
+
+					cumulative += histogram.second->GetBucketCount(Histogram::NUM_BUCKETS - 1);
+					const uint64_t count = (std::max)(cumulative, histogram.second->GetCount());
+					output += WithLabels(name + "_bucket", histogram.first, "le=\"+Inf\"") + " " + std::to_string(count) + "\n";
+					output += WithLabels(name + "_sum", histogram.first) + " " + ToSeconds(histogram.second->GetSumNanos()) + "\n";
+					output += WithLabels(name + "_count", histogram.first) + " " + std::to_string(count) + "\n";
+				}
+
+				break;
+			}
+		}
+	}
+
+	return output;
+}
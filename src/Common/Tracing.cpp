@@ -0,0 +1,234 @@
+#include <Common/Tracing.h>
+#include <Common/Util/StringUtil.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace Tracing;
+using steady_clock = std::chrono::steady_clock;
+
+namespace
+{
+	struct Event
+	{
+		const char* name;
+		const char* argName;
+		uint64_t argValue;
+		steady_clock::time_point start;
+		steady_clock::duration duration;
+	};
+
+	struct ThreadBuffer
+	{
+		explicit ThreadBuffer(const uint64_t tid_) : tid(tid_) { }
+
+		const uint64_t tid;
+		std::atomic_bool exited{ false };
+
+		std::mutex mutex;
+		std::string threadName;
+		std::vector<Event> events;
+		uint64_t numRecorded{ 0 };
+	};
+
+	struct Registry
+	{
+		std::atomic_bool enabled{ false };
+		const steady_clock::time_point epoch{ steady_clock::now() };
+
+		std::mutex mutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		uint64_t nextTid{ 1 };
+
+		static Registry& Instance()
+		{
+			static Registry registry;
+			return registry;
+		}
+	};
+
+	// The registry shares ownership of each buffer, so a thread's spans can still be exported after it exits.
+	struct ThreadBufferHandle
+	{
+		std::shared_ptr<ThreadBuffer> pBuffer;
+
+		~ThreadBufferHandle()
+		{
+			if (pBuffer != nullptr) {
+				pBuffer->exited = true;
+			}
+		}
+	};
+
+	thread_local ThreadBufferHandle THREAD_BUFFER;
+
+	ThreadBuffer& GetThreadBuffer()
+	{
+		if (THREAD_BUFFER.pBuffer == nullptr) {
+			Registry& registry = Registry::Instance();
+			std::unique_lock<std::mutex> lock(registry.mutex);
+
+			const size_t numExited = std::count_if(
+				registry.buffers.cbegin(),
+				registry.buffers.cend(),
+				[](const std::shared_ptr<ThreadBuffer>& pBuffer) { return pBuffer->exited.load(); }
+			);
+			if (numExited >= MAX_EXITED_THREADS) {
+				registry.buffers.erase(std::find_if(
+					registry.buffers.cbegin(),
+					registry.buffers.cend(),
+					[](const std::shared_ptr<ThreadBuffer>& pBuffer) { return pBuffer->exited.load(); }
+				));
+			}
+
+			THREAD_BUFFER.pBuffer = std::make_shared<ThreadBuffer>(registry.nextTid++);
+			registry.buffers.push_back(THREAD_BUFFER.pBuffer);
+		}
+
+		return *THREAD_BUFFER.pBuffer;
+	}
+
+	void AppendEscaped(std::string& output, const char* str)
+	{
+		for (; *str != '\0'; str++)
+		{
+			const char c = *str;
+			if (c == '"' || c == '\\') {
+				output += '\\';
+				output += c;
+			} else if ((unsigned char)c < 0x20) {
+				output += StringUtil::Format("\\u{:04x}", (int)c);
+			} else {
+				output += c;
+			}
+		}
+	}
+
+	// Chrome trace timestamps are in microseconds.
+	std::string ToMicros(const steady_clock::duration& duration)
+	{
+		return StringUtil::Format("{:.3f}", std::chrono::duration<double, std::micro>(duration).count());
+	}
+}
+
+void Tracing::SetEnabled(const bool enabled)
+{
+	Registry& registry = Registry::Instance();
+	std::unique_lock<std::mutex> lock(registry.mutex);
+
+	if (enabled && !registry.enabled) {
+		auto iter = registry.buffers.begin();
+		while (iter != registry.buffers.end())
+		{
+			if ((*iter)->exited) {
+				iter = registry.buffers.erase(iter);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> bufferLock((*iter)->mutex);
+			(*iter)->events.clear();
+			(*iter)->numRecorded = 0;
+			++iter;
+		}
+	}
+
+	registry.enabled = enabled;
+}
+
+bool Tracing::IsEnabled() noexcept
+{
+	return Registry::Instance().enabled.load(std::memory_order_relaxed);
+}
+
+void Tracing::SetThreadName(const std::string& threadName)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	std::unique_lock<std::mutex> lock(buffer.mutex);
+	buffer.threadName = threadName;
+}
+
+void Tracing::Record(
+	const char* name,
+	const steady_clock::time_point& start,
+	const steady_clock::time_point& end,
+	const char* argName,
+	const uint64_t argValue) noexcept
+{
+	try
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		std::unique_lock<std::mutex> lock(buffer.mutex);
+
+		const Event event{ name, argName, argValue, start, end - start };
+		if (buffer.events.size() < BUFFER_CAPACITY) {
+			buffer.events.push_back(event);
+		} else {
+			buffer.events[buffer.numRecorded % BUFFER_CAPACITY] = event;
+		}
+
+		buffer.numRecorded++;
+	}
+	catch (...)
+	{
+		// Dropping a span beats failing the traced work.
+	}
+}
+
+std::string Tracing::ExportChromeJSON()
+{
+	Registry& registry = Registry::Instance();
+
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	{
+		std::unique_lock<std::mutex> lock(registry.mutex);
+		buffers = registry.buffers;
+	}
+
+	std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	auto beginEvent = [&output, &first]() {
+		output += first ? "\n" : ",\n";
+		first = false;
+	};
+
+	for (const std::shared_ptr<ThreadBuffer>& pBuffer : buffers)
+	{
+		std::unique_lock<std::mutex> lock(pBuffer->mutex);
+		const std::string tid = std::to_string(pBuffer->tid);
+
+		if (!pBuffer->threadName.empty()) {
+			beginEvent();
+			output += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"";
+			AppendEscaped(output, pBuffer->threadName.c_str());
+			output += "\"}}";
+		}
+
+		// Once the ring has wrapped, the oldest span is the one that will be overwritten next.
+		const size_t numEvents = pBuffer->events.size();
+		const size_t oldest = numEvents < BUFFER_CAPACITY ? 0 : (size_t)(pBuffer->numRecorded % BUFFER_CAPACITY);
+		for (size_t i = 0; i < numEvents; i++)
+		{
+			const Event& event = pBuffer->events[(oldest + i) % numEvents];
+
+			beginEvent();
+			output += "{\"name\":\"";
+			AppendEscaped(output, event.name);
+			output += "\",\"cat\":\"grinpp\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid;
+			output += ",\"ts\":" + ToMicros(event.start - registry.epoch);
+			output += ",\"dur\":" + ToMicros(event.duration);
+			if (event.argName != nullptr) {
+				output += ",\"args\":{\"";
+				AppendEscaped(output, event.argName);
+				output += "\":" + std::to_string(event.argValue) + "}";
+			}
+
+			output += "}";
+		}
+	}
+
+	output += "\n]}\n";
+	return output;
+}
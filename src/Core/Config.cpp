@@ -130,6 +130,7 @@ const fs::path& Config::GetChainPath() const noexcept { return m_pImpl->m_nodeCo
 const fs::path& Config::GetDatabasePath() const noexcept { return m_pImpl->m_nodeConfig.GetDatabasePath(); }
 const fs::path& Config::GetTxHashSetPath() const noexcept { return m_pImpl->m_nodeConfig.GetTxHashSetPath(); }
 uint16_t Config::GetRestAPIPort() const noexcept { return m_pImpl->m_nodeConfig.GetRestAPIPort(); }
+const ServerOptions& Config::GetRestAPIServerOptions() const noexcept { return m_pImpl->m_nodeConfig.GetRestAPIServerOptions(); }
 uint64_t Config::GetFeeBase() const noexcept { return m_pImpl->m_nodeConfig.GetFeeBase(); }
 
 //
@@ -180,11 +181,30 @@ uint16_t Config::GetEmbargoSeconds() const noexcept { return m_pImpl->m_nodeConf
 uint8_t Config::GetPatienceSeconds() const noexcept { return m_pImpl->m_nodeConfig.GetDandelion().GetPatienceSeconds(); }
 uint8_t Config::GetStemProbability() const noexcept { return m_pImpl->m_nodeConfig.GetDandelion().GetStemProbability(); }
 
+//
+// TxPool
+//
+uint64_t Config::GetMempoolMaxBytes() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetMempoolMaxBytes(); }
+uint64_t Config::GetMempoolMaxWeight() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetMempoolMaxWeight(); }
+uint64_t Config::GetStempoolMaxBytes() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetStempoolMaxBytes(); }
+uint64_t Config::GetStempoolMaxWeight() const noexcept { return m_pImpl->m_nodeConfig.GetTxPool().GetStempoolMaxWeight(); }
+
+//
+// Chain DB
+//
+uint64_t Config::GetChainDBBlockCacheBytes() const noexcept { return m_pImpl->m_nodeConfig.GetChainDB().GetBlockCacheBytes(); }
+uint64_t Config::GetChainDBHeaderCacheBytes() const noexcept { return m_pImpl->m_nodeConfig.GetChainDB().GetHeaderCacheBytes(); }
+int Config::GetChainDBBloomBitsPerKey() const noexcept { return m_pImpl->m_nodeConfig.GetChainDB().GetBloomBitsPerKey(); }
+const std::string& Config::GetChainDBBlockCompression() const noexcept { return m_pImpl->m_nodeConfig.GetChainDB().GetBlockCompression(); }
+uint64_t Config::GetChainDBWriteBufferBytes() const noexcept { return m_pImpl->m_nodeConfig.GetChainDB().GetWriteBufferBytes(); }
+uint64_t Config::GetChainDBArchiveDepth() const noexcept { return m_pImpl->m_nodeConfig.GetChainDB().GetArchiveDepth(); }
+
 //
 // Wallet
 //
 const fs::path& Config::GetWalletPath() const noexcept { return m_pImpl->m_walletConfig.GetWalletPath(); }
 uint32_t Config::GetOwnerPort() const noexcept { return m_pImpl->m_walletConfig.GetOwnerPort(); }
+const ServerOptions& Config::GetWalletServerOptions() const noexcept { return m_pImpl->m_walletConfig.GetServerOptions(); }
 uint32_t Config::GetPublicKeyVersion() const noexcept { return m_pImpl->m_walletConfig.GetPublicKeyVersion(); }
 uint32_t Config::GetPrivateKeyVersion() const noexcept { return m_pImpl->m_walletConfig.GetPrivateKeyVersion(); }
 
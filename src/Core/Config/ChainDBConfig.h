@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ConfigProps.h"
+
+#include <Common/Util/StringUtil.h>
+#include <Consensus.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <json/json.h>
+
+class ChainDBConfig
+{
+public:
+	// Size of the LRU block cache shared by all chain db tables.
+	uint64_t GetBlockCacheBytes() const { return m_blockCacheMB * 1024 * 1024; }
+
+	// Memory budget for deserialized headers kept in memory by the chain db.
+	uint64_t GetHeaderCacheBytes() const { return m_headerCacheMB * 1024 * 1024; }
+
+	// Bits per key of the bloom filters on the point-lookup tables. 0 disables them.
+	int GetBloomBitsPerKey() const { return m_bloomBitsPerKey; }
+
+	// Compression used for the BLOCK table: "NONE", "LZ4" or "ZSTD".
+	const std::string& GetBlockCompression() const { return m_blockCompression; }
+
+	// Size of each table's memtable before it's flushed to disk.
+	uint64_t GetWriteBufferBytes() const { return m_writeBufferMB * 1024 * 1024; }
+
+	// Number of most recent full blocks to keep. Never less than the cut-through horizon.
+	uint64_t GetArchiveDepth() const { return (std::max)(m_archiveDepth, (uint64_t)Consensus::CUT_THROUGH_HORIZON); }
+
+	//
+	// Constructor
+	//
+	ChainDBConfig(const Json::Value& json)
+	{
+		m_blockCacheMB = DEFAULT_BLOCK_CACHE_MB;
+		m_headerCacheMB = DEFAULT_HEADER_CACHE_MB;
+		m_bloomBitsPerKey = DEFAULT_BLOOM_BITS_PER_KEY;
+		m_blockCompression = DEFAULT_BLOCK_COMPRESSION;
+		m_writeBufferMB = DEFAULT_WRITE_BUFFER_MB;
+		m_archiveDepth = Consensus::CUT_THROUGH_HORIZON;
+
+		if (json.isMember(ConfigProps::ChainDB::CHAIN_DB))
+		{
+			const Json::Value& chainDBJSON = json[ConfigProps::ChainDB::CHAIN_DB];
+
+			if (chainDBJSON.isMember(ConfigProps::ChainDB::BLOCK_CACHE_MB))
+			{
+				m_blockCacheMB = chainDBJSON.get(ConfigProps::ChainDB::BLOCK_CACHE_MB, DEFAULT_BLOCK_CACHE_MB).asUInt64();
+			}
+
+			if (chainDBJSON.isMember(ConfigProps::ChainDB::HEADER_CACHE_MB))
+			{
+				m_headerCacheMB = chainDBJSON.get(ConfigProps::ChainDB::HEADER_CACHE_MB, DEFAULT_HEADER_CACHE_MB).asUInt64();
+			}
+
+			if (chainDBJSON.isMember(ConfigProps::ChainDB::BLOOM_BITS_PER_KEY))
+			{
+				m_bloomBitsPerKey = chainDBJSON.get(ConfigProps::ChainDB::BLOOM_BITS_PER_KEY, DEFAULT_BLOOM_BITS_PER_KEY).asInt();
+			}
+
+			if (chainDBJSON.isMember(ConfigProps::ChainDB::BLOCK_COMPRESSION))
+			{
+				m_blockCompression = StringUtil::ToUpper(chainDBJSON.get(ConfigProps::ChainDB::BLOCK_COMPRESSION, DEFAULT_BLOCK_COMPRESSION).asString());
+			}
+
+			if (chainDBJSON.isMember(ConfigProps::ChainDB::WRITE_BUFFER_MB))
+			{
+				m_writeBufferMB = chainDBJSON.get(ConfigProps::ChainDB::WRITE_BUFFER_MB, DEFAULT_WRITE_BUFFER_MB).asUInt64();
+			}
+
+			if (chainDBJSON.isMember(ConfigProps::ChainDB::ARCHIVE_DEPTH))
+			{
+				m_archiveDepth = chainDBJSON.get(ConfigProps::ChainDB::ARCHIVE_DEPTH, Consensus::CUT_THROUGH_HORIZON).asUInt64();
+			}
+		}
+	}
+
+private:
+	static constexpr Json::UInt64 DEFAULT_BLOCK_CACHE_MB = 128;
+	static constexpr Json::UInt64 DEFAULT_HEADER_CACHE_MB = 128;
+	static constexpr int DEFAULT_BLOOM_BITS_PER_KEY = 10;
+	static constexpr const char* DEFAULT_BLOCK_COMPRESSION = "LZ4";
+	static constexpr Json::UInt64 DEFAULT_WRITE_BUFFER_MB = 32;
+
+	uint64_t m_blockCacheMB;
+	uint64_t m_headerCacheMB;
+	int m_bloomBitsPerKey;
+	std::string m_blockCompression;
+	uint64_t m_writeBufferMB;
+	uint64_t m_archiveDepth;
+};
@@ -29,6 +29,28 @@ namespace ConfigProps
 		static const std::string STEM_PROBABILITY = "STEM_PROBABILITY";
 	}
 	
+	namespace TxPool
+	{
+		static const std::string TX_POOL = "TX_POOL";
+
+		static const std::string MEMPOOL_MAX_BYTES = "MEMPOOL_MAX_BYTES";
+		static const std::string MEMPOOL_MAX_WEIGHT = "MEMPOOL_MAX_WEIGHT";
+		static const std::string STEMPOOL_MAX_BYTES = "STEMPOOL_MAX_BYTES";
+		static const std::string STEMPOOL_MAX_WEIGHT = "STEMPOOL_MAX_WEIGHT";
+	}
+
+	namespace ChainDB
+	{
+		static const std::string CHAIN_DB = "CHAIN_DB";
+
+		static const std::string BLOCK_CACHE_MB = "BLOCK_CACHE_MB";
+		static const std::string HEADER_CACHE_MB = "HEADER_CACHE_MB";
+		static const std::string BLOOM_BITS_PER_KEY = "BLOOM_BITS_PER_KEY";
+		static const std::string BLOCK_COMPRESSION = "BLOCK_COMPRESSION";
+		static const std::string WRITE_BUFFER_MB = "WRITE_BUFFER_MB";
+		static const std::string ARCHIVE_DEPTH = "ARCHIVE_DEPTH";
+	}
+
 	namespace Server
 	{
 		static const std::string SERVER = "SERVER";
@@ -37,6 +59,19 @@ namespace ConfigProps
 		static const std::string OWNER_API_PORT = "OWNER_API_PORT";
 	}
 
+	namespace HTTP
+	{
+		static const std::string HTTP = "HTTP";
+
+		static const std::string THREADS = "THREADS";
+		static const std::string KEEP_ALIVE = "KEEP_ALIVE";
+		static const std::string KEEP_ALIVE_TIMEOUT_MS = "KEEP_ALIVE_TIMEOUT_MS";
+		static const std::string REQUEST_TIMEOUT_MS = "REQUEST_TIMEOUT_MS";
+		static const std::string CONNECTION_QUEUE = "CONNECTION_QUEUE";
+		static const std::string LISTEN_BACKLOG = "LISTEN_BACKLOG";
+		static const std::string ENDPOINT_LIMITS = "ENDPOINT_LIMITS";
+	}
+
 	namespace Logger
 	{
 		static const std::string LOGGER = "LOGGER";
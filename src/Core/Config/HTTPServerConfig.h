@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ConfigProps.h"
+
+#include <Net/Servers/ServerOptions.h>
+#include <algorithm>
+#include <json/json.h>
+
+class HTTPServerConfig
+{
+public:
+	const ServerOptions& GetOptions() const { return m_options; }
+
+	//
+	// Constructor
+	// Reads the HTTP section of the given node or wallet json, falling back to the given defaults.
+	//
+	HTTPServerConfig(const Json::Value& json, const ServerOptions& defaults)
+		: m_options(defaults)
+	{
+		if (json.isMember(ConfigProps::HTTP::HTTP))
+		{
+			const Json::Value& httpJSON = json[ConfigProps::HTTP::HTTP];
+
+			if (httpJSON.isMember(ConfigProps::HTTP::THREADS))
+			{
+				m_options.numThreads = (std::max)(httpJSON.get(ConfigProps::HTTP::THREADS, m_options.numThreads).asUInt(), 1u);
+			}
+
+			if (httpJSON.isMember(ConfigProps::HTTP::KEEP_ALIVE))
+			{
+				m_options.keepAlive = httpJSON.get(ConfigProps::HTTP::KEEP_ALIVE, m_options.keepAlive).asBool();
+			}
+
+			if (httpJSON.isMember(ConfigProps::HTTP::KEEP_ALIVE_TIMEOUT_MS))
+			{
+				m_options.keepAliveTimeoutMs = httpJSON.get(ConfigProps::HTTP::KEEP_ALIVE_TIMEOUT_MS, m_options.keepAliveTimeoutMs).asUInt();
+			}
+
+			if (httpJSON.isMember(ConfigProps::HTTP::REQUEST_TIMEOUT_MS))
+			{
+				m_options.requestTimeoutMs = httpJSON.get(ConfigProps::HTTP::REQUEST_TIMEOUT_MS, m_options.requestTimeoutMs).asUInt();
+			}
+
+			if (httpJSON.isMember(ConfigProps::HTTP::CONNECTION_QUEUE))
+			{
+				m_options.connectionQueue = httpJSON.get(ConfigProps::HTTP::CONNECTION_QUEUE, m_options.connectionQueue).asUInt();
+			}
+
+			if (httpJSON.isMember(ConfigProps::HTTP::LISTEN_BACKLOG))
+			{
+				m_options.listenBacklog = httpJSON.get(ConfigProps::HTTP::LISTEN_BACKLOG, m_options.listenBacklog).asUInt();
+			}
+
+			if (httpJSON.isMember(ConfigProps::HTTP::ENDPOINT_LIMITS))
+			{
+				const Json::Value& limitsJSON = httpJSON[ConfigProps::HTTP::ENDPOINT_LIMITS];
+				for (const std::string& uri : limitsJSON.getMemberNames())
+				{
+					// 0 removes a default limit
+					const uint32_t limit = limitsJSON[uri].asUInt();
+					if (limit == 0)
+					{
+						m_options.endpointLimits.erase(uri);
+					}
+					else
+					{
+						m_options.endpointLimits[uri] = limit;
+					}
+				}
+			}
+		}
+	}
+
+private:
+	ServerOptions m_options;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "ConfigProps.h"
+#include "ChainDBConfig.h"
+#include "HTTPServerConfig.h"
 #include "DandelionConfig.h"
 #include "P2PConfig.h"
+#include "TxPoolConfig.h"
 
 #include <Common/Util/FileUtil.h>
 #include <cstdint>
@@ -16,17 +19,24 @@ public:
 	//
 	P2PConfig& GetP2P() { return m_p2pConfig; }
 	const DandelionConfig& GetDandelion() const { return m_dandelion; }
+	const TxPoolConfig& GetTxPool() const { return m_txPool; }
+	const ChainDBConfig& GetChainDB() const { return m_chainDB; }
 	const fs::path& GetChainPath() const { return m_chainPath; }
 	const fs::path& GetDatabasePath() const { return m_databasePath; }
 	const fs::path& GetTxHashSetPath() const { return m_txHashSetPath; }
 	uint64_t GetFeeBase() const noexcept { return 500000; } // TODO: Read from config.
 	uint16_t GetRestAPIPort() const { return m_restAPIPort; }
+	const ServerOptions& GetRestAPIServerOptions() const { return m_restAPIServer.GetOptions(); }
 
 	//
 	// Constructor
 	//
 	NodeConfig(const Environment env, const Json::Value& json, const fs::path& dataPath)
-		: m_p2pConfig(env, json), m_dandelion(json)
+		: m_p2pConfig(env, json),
+		m_dandelion(json),
+		m_txPool(json),
+		m_chainDB(json),
+		m_restAPIServer(json.get(ConfigProps::Server::SERVER, Json::Value()), DefaultRestAPIServerOptions())
 	{
 		if (env == Environment::MAINNET) {
 			m_restAPIPort = 3413;
@@ -59,6 +69,21 @@ public:
 	}
 
 private:
+	static ServerOptions DefaultRestAPIServerOptions()
+	{
+		ServerOptions options;
+		options.numThreads = 32;
+
+		// Keep a few workers free for light requests like /v1/status.
+		options.endpointLimits = {
+			{ "/v1/chain/outputs/byheight", 2 },
+			{ "/v1/txhashset/outputs", 2 },
+			{ "/v1/txhashset/outputs/binary", 2 },
+			{ "/v1/blocks/", 4 }
+		};
+		return options;
+	}
+
 	fs::path m_chainPath;
 	fs::path m_databasePath;
 	fs::path m_txHashSetPath;
@@ -66,4 +91,7 @@ private:
 	uint16_t m_restAPIPort;
 	P2PConfig m_p2pConfig;
 	DandelionConfig m_dandelion;
+	TxPoolConfig m_txPool;
+	ChainDBConfig m_chainDB;
+	HTTPServerConfig m_restAPIServer;
 };
\ No newline at end of file
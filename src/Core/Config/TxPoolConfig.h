@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ConfigProps.h"
+
+#include <Consensus.h>
+#include <cstdint>
+#include <json/json.h>
+
+class TxPoolConfig
+{
+public:
+	// Maximum serialized size of all txs in the mempool before low fee txs are evicted.
+	uint64_t GetMempoolMaxBytes() const { return m_mempoolMaxBytes; }
+
+	// Maximum total weight of all txs in the mempool before low fee txs are evicted.
+	uint64_t GetMempoolMaxWeight() const { return m_mempoolMaxWeight; }
+
+	// Maximum serialized size of all txs in the stempool before low fee txs are evicted.
+	uint64_t GetStempoolMaxBytes() const { return m_stempoolMaxBytes; }
+
+	// Maximum total weight of all txs in the stempool before low fee txs are evicted.
+	uint64_t GetStempoolMaxWeight() const { return m_stempoolMaxWeight; }
+
+	//
+	// Constructor
+	//
+	TxPoolConfig(const Json::Value& json)
+	{
+		m_mempoolMaxBytes = DEFAULT_MEMPOOL_MAX_BYTES;
+		m_mempoolMaxWeight = DEFAULT_MEMPOOL_MAX_WEIGHT;
+		m_stempoolMaxBytes = DEFAULT_STEMPOOL_MAX_BYTES;
+		m_stempoolMaxWeight = DEFAULT_STEMPOOL_MAX_WEIGHT;
+
+		if (json.isMember(ConfigProps::TxPool::TX_POOL))
+		{
+			const Json::Value& txPoolJSON = json[ConfigProps::TxPool::TX_POOL];
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::MEMPOOL_MAX_BYTES))
+			{
+				m_mempoolMaxBytes = txPoolJSON.get(ConfigProps::TxPool::MEMPOOL_MAX_BYTES, DEFAULT_MEMPOOL_MAX_BYTES).asUInt64();
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::MEMPOOL_MAX_WEIGHT))
+			{
+				m_mempoolMaxWeight = txPoolJSON.get(ConfigProps::TxPool::MEMPOOL_MAX_WEIGHT, DEFAULT_MEMPOOL_MAX_WEIGHT).asUInt64();
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::STEMPOOL_MAX_BYTES))
+			{
+				m_stempoolMaxBytes = txPoolJSON.get(ConfigProps::TxPool::STEMPOOL_MAX_BYTES, DEFAULT_STEMPOOL_MAX_BYTES).asUInt64();
+			}
+
+			if (txPoolJSON.isMember(ConfigProps::TxPool::STEMPOOL_MAX_WEIGHT))
+			{
+				m_stempoolMaxWeight = txPoolJSON.get(ConfigProps::TxPool::STEMPOOL_MAX_WEIGHT, DEFAULT_STEMPOOL_MAX_WEIGHT).asUInt64();
+			}
+		}
+	}
+
+private:
+	// The weight limits fit 100 full blocks worth of txs in the mempool, and 25 in the stempool.
+	// The byte limits (200MB and 50MB) separately bound the memory held by each pool.
+	static constexpr Json::UInt64 DEFAULT_MEMPOOL_MAX_BYTES = 200 * 1024 * 1024;
+	static constexpr Json::UInt64 DEFAULT_MEMPOOL_MAX_WEIGHT = 100 * (Json::UInt64)Consensus::MAX_BLOCK_WEIGHT;
+	static constexpr Json::UInt64 DEFAULT_STEMPOOL_MAX_BYTES = 50 * 1024 * 1024;
+	static constexpr Json::UInt64 DEFAULT_STEMPOOL_MAX_WEIGHT = 25 * (Json::UInt64)Consensus::MAX_BLOCK_WEIGHT;
+
+	uint64_t m_mempoolMaxBytes;
+	uint64_t m_mempoolMaxWeight;
+	uint64_t m_stempoolMaxBytes;
+	uint64_t m_stempoolMaxWeight;
+};
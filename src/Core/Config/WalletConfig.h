@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ConfigProps.h"
+#include "HTTPServerConfig.h"
 
 #include <Core/Enums/Environment.h>
 #include <Common/Util/BitUtil.h>
@@ -13,6 +14,7 @@ class WalletConfig
 {
 public:
 	WalletConfig(const Json::Value& json, const Environment environment, const fs::path& dataPath)
+		: m_server(json.get(ConfigProps::Wallet::WALLET, Json::Value()), ServerOptions())
 	{
 		if (environment == Environment::MAINNET)
 		{
@@ -44,6 +46,7 @@ public:
 
 	const fs::path& GetWalletPath() const { return m_walletPath; }
 	uint32_t GetOwnerPort() const { return m_ownerPort; }
+	const ServerOptions& GetServerOptions() const { return m_server.GetOptions(); }
 	uint32_t GetPublicKeyVersion() const { return m_publicKeyVersion; }
 	uint32_t GetPrivateKeyVersion() const { return m_privateKeyVersion; }
 	uint32_t GetMinimumConfirmations() const { return m_minimumConfirmations; }
@@ -58,4 +61,5 @@ private:
 	uint32_t m_privateKeyVersion;
 	uint32_t m_minimumConfirmations;
 	uint32_t m_reuseAddress;
+	HTTPServerConfig m_server;
 };
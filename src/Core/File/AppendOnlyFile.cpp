@@ -70,6 +70,18 @@ void AppendOnlyFile::Discard() noexcept
 	m_buffer.clear();
 }
 
+void AppendOnlyFile::Replace(const fs::path& replacement)
+{
+	if (m_fileSize != m_bufferIndex || !m_buffer.empty())
+	{
+		throw FILE_EXCEPTION_F("Can't replace {} while it has unflushed changes", m_path);
+	}
+
+	m_pMappedFile.reset();
+	FileUtil::RenameFile(replacement, m_path);
+	Load();
+}
+
 uint64_t AppendOnlyFile::GetSize() const noexcept
 {
 	return m_bufferIndex + m_buffer.size();
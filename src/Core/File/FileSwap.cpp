@@ -0,0 +1,77 @@
+#include <Core/File/FileSwap.h>
+#include <Core/Exceptions/FileException.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/StringUtil.h>
+#include <Common/GrinStr.h>
+#include <Common/Logger.h>
+
+fs::path FileSwap::GetStagedPath(const fs::path& path)
+{
+	return GrinStr(path.u8string() + ".compact").ToPath();
+}
+
+void FileSwap::Begin(const fs::path& manifestPath, const std::vector<fs::path>& files)
+{
+	// Paths are stored relative to the manifest, so an interrupted swap can still be recovered if the data directory is moved.
+	std::string manifest;
+	for (const fs::path& file : files)
+	{
+		manifest += file.lexically_relative(manifestPath.parent_path()).u8string() + "\n";
+	}
+
+	FileUtil::SafeWriteToFile(manifestPath, std::vector<uint8_t>(manifest.cbegin(), manifest.cend()));
+}
+
+void FileSwap::Swap(const fs::path& path)
+{
+	FileUtil::RenameFile(GetStagedPath(path), path);
+}
+
+void FileSwap::End(const fs::path& manifestPath)
+{
+	if (!FileUtil::RemoveFile(manifestPath))
+	{
+		throw FILE_EXCEPTION_F("Failed to remove {}", manifestPath);
+	}
+}
+
+void FileSwap::Discard(const std::vector<fs::path>& files) noexcept
+{
+	for (const fs::path& file : files)
+	{
+		const fs::path stagedPath = GetStagedPath(file);
+		if (FileUtil::Exists(stagedPath))
+		{
+			FileUtil::RemoveFile(stagedPath);
+		}
+	}
+}
+
+void FileSwap::Recover(const fs::path& manifestPath, const std::vector<fs::path>& files)
+{
+	std::vector<uint8_t> manifest;
+	if (FileUtil::ReadFile(manifestPath, manifest))
+	{
+		LOG_WARNING_F("Completing interrupted swap from {}", manifestPath);
+
+		// Files that were already swapped no longer have a staged copy.
+		std::vector<std::string> lines = StringUtil::Split(std::string(manifest.cbegin(), manifest.cend()), "\n");
+		for (const std::string& line : lines)
+		{
+			if (line.empty())
+			{
+				continue;
+			}
+
+			const fs::path path = manifestPath.parent_path() / GrinStr(line).ToPath();
+			if (FileUtil::Exists(GetStagedPath(path)))
+			{
+				Swap(path);
+			}
+		}
+
+		End(manifestPath);
+	}
+
+	Discard(files);
+}
@@ -11,19 +11,25 @@
 // See: https://github.com/mimblewimble/docs/wiki/Validation-logic
 void TransactionValidator::Validate(const Transaction& transaction, const uint64_t block_height) const
 {
-	// Verify the transaction does not exceed the max weight
-	ValidateWeight(transaction.GetBody(), block_height);
+	// Verify the transaction does not exceed the max weight, and no output or kernel includes invalid features (coinbase)
+	ValidateForHeight(transaction, block_height);
 
 	// Validate the "transaction body"
 	TxBodyValidator().Validate(transaction.GetBody());
 
-	// Verify no output or kernel includes invalid features (coinbase)
-	ValidateFeatures(transaction.GetBody());
-
 	// Verify the big "sum": all inputs plus reward+fee, all output commitments, all kernels plus the kernel excess
 	ValidateKernelSums(transaction);
 }
 
+void TransactionValidator::ValidateForHeight(const Transaction& transaction, const uint64_t block_height) const
+{
+	// Verify the transaction does not exceed the max weight
+	ValidateWeight(transaction.GetBody(), block_height);
+
+	// Verify no output or kernel includes invalid features (coinbase)
+	ValidateFeatures(transaction.GetBody());
+}
+
 void TransactionValidator::ValidateWeight(const TransactionBody& body, const uint64_t block_height) const
 {
 	uint64_t weight = body.CalcWeight(block_height);
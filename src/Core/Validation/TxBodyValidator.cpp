@@ -16,8 +16,14 @@ void TxBodyValidator::Validate(const TransactionBody& body)
 	VerifyCutThrough(body);
 	VerifyRangeProofs(body.GetOutputs());
 	
-	if (!KernelSignatureValidator::BatchVerify(body.GetKernels())) {
-		throw BAD_DATA_EXCEPTION(EBanReason::BadTransaction, "Kernel signatures invalid");
+	// The body is rejected on the first failure, so only one invalid kernel is isolated.
+	const std::optional<size_t> invalidKernel = KernelSignatureValidator::FindFirstInvalid(body.GetKernels());
+	if (invalidKernel.has_value()) {
+		throw BAD_DATA_EXCEPTION_F(
+			EBanReason::BadTransaction,
+			"Kernel signature invalid: {}",
+			body.GetKernels()[invalidKernel.value()].GetExcessCommitment()
+		);
 	}
 }
 
@@ -74,7 +80,13 @@ void TxBodyValidator::VerifyRangeProofs(const std::vector<TransactionOutput>& ou
 		std::back_inserter(rangeProofs),
 		[](const TransactionOutput& output) { return std::make_pair(output.GetCommitment(), output.GetRangeProof()); }
 	);
-	if (!Crypto::VerifyRangeProofs(rangeProofs)) {
-		throw BAD_DATA_EXCEPTION(EBanReason::BadTransaction, "Range proofs invalid.");
+
+	const std::optional<size_t> invalidProof = Crypto::FindFirstInvalidRangeProof(rangeProofs);
+	if (invalidProof.has_value()) {
+		throw BAD_DATA_EXCEPTION_F(
+			EBanReason::BadTransaction,
+			"Range proof invalid for output: {}",
+			rangeProofs[invalidProof.value()].first
+		);
 	}
 }
\ No newline at end of file
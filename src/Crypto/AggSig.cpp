@@ -1,5 +1,6 @@
 #include "AggSig.h"
 #include "Pedersen.h"
+#include "ScratchSpacePool.h"
 
 #include <secp256k1-zkp/secp256k1_generator.h>
 #include <secp256k1-zkp/secp256k1_aggsig.h>
@@ -278,9 +279,8 @@ bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& sign
 		[](const Hash* pMessage) { return pMessage->data(); }
 	);
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-	const int verifyResult = secp256k1_schnorrsig_verify_batch(m_pContext, pScratchSpace, signaturePtrs.data(), messageData.data(), pubKeyPtrs.data(), signatures.size());
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	auto pScratch = ScratchSpacePool::GetInstance().Acquire(m_pContext, SCRATCH_SPACE_SIZE);
+	const int verifyResult = secp256k1_schnorrsig_verify_batch(m_pContext, pScratch->Get(), signaturePtrs.data(), messageData.data(), pubKeyPtrs.data(), signatures.size());
 
 	if (verifyResult == 1)
 	{
@@ -1,38 +1,36 @@
 #pragma once
 
-#include <caches/Cache.h>
+#include <Crypto/VerificationCache.h>
 #include <Crypto/Models/Commitment.h>
-#include <mutex>
+#include <Crypto/Models/RangeProof.h>
 
 class BulletProofsCache
 {
 public:
 	BulletProofsCache()
-		: m_bulletproofsCache(3000)
+		: m_bulletproofsCache(VerificationCache::RangeProofs())
 	{
 
 	}
 
-	void AddToCache(const Commitment& commitment)
+	void AddToCache(const Commitment& commitment, const RangeProof& rangeProof)
 	{
-		std::unique_lock<std::mutex> lock(m_mutex);
-
-		m_bulletproofsCache.Put(commitment, commitment);
+		m_bulletproofsCache.Add(GetKey(commitment, rangeProof));
 	}
 
-	bool WasAlreadyVerified(const Commitment& commitment) const
+	bool WasAlreadyVerified(const Commitment& commitment, const RangeProof& rangeProof) const
 	{
-		std::unique_lock<std::mutex> lock(m_mutex);
-
-		if (m_bulletproofsCache.Cached(commitment))
-		{
-			return m_bulletproofsCache.Get(commitment) == commitment;
-		}
-
-		return false;
+		return m_bulletproofsCache.Contains(GetKey(commitment, rangeProof));
 	}
 
 private:
-	mutable std::mutex m_mutex;
-	mutable LRUCache<Commitment, Commitment> m_bulletproofsCache;
-};
\ No newline at end of file
+	// The proof is part of the key, so a verified commitment can't be paired with a different proof.
+	static std::vector<uint8_t> GetKey(const Commitment& commitment, const RangeProof& rangeProof)
+	{
+		std::vector<uint8_t> key = commitment.GetVec();
+		key.insert(key.end(), rangeProof.GetProofBytes().cbegin(), rangeProof.GetProofBytes().cend());
+		return key;
+	}
+
+	VerificationCache& m_bulletproofsCache;
+};
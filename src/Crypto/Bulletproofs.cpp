@@ -1,5 +1,6 @@
 #include "Bulletproofs.h"
 #include "Pedersen.h"
+#include "ScratchSpacePool.h"
 
 #include <secp256k1-zkp/secp256k1_bulletproofs.h>
 #include <Common/Util/FunctionalUtil.h>
@@ -11,6 +12,28 @@ const uint64_t MAX_WIDTH = 1 << 20;
 const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
 const size_t MAX_GENERATORS = 256;
 
+// Verification allocates a small frame per proof, and the multi-exponentiation batches its points into
+// whatever space is left, so these bounds leave plenty of headroom. SCRATCH_SPACE_SIZE is what every batch
+// was verified with before sizing, so larger batches never get less than they used to.
+const size_t MIN_VERIFY_SCRATCH_SIZE = 16 * MAX_WIDTH;
+const size_t VERIFY_SCRATCH_PER_PROOF = MAX_WIDTH;
+
+static size_t GetVerifyScratchSize(const size_t numProofs)
+{
+	return (std::min)(MIN_VERIFY_SCRATCH_SIZE + (numProofs * VERIFY_SCRATCH_PER_PROOF), SCRATCH_SPACE_SIZE);
+}
+
+// Each thread gets its own clone of the shared context, so proving (which randomizes the context)
+// never has to block verification on other threads.
+struct ThreadContext
+{
+	ThreadContext(const secp256k1_context* pBaseContext)
+		: m_pContext(secp256k1_context_clone(pBaseContext)) { }
+	~ThreadContext() { secp256k1_context_destroy(m_pContext); }
+
+	secp256k1_context* m_pContext;
+};
+
 static Bulletproofs instance;
 
 Bulletproofs& Bulletproofs::GetInstance()
@@ -30,23 +53,30 @@ Bulletproofs::~Bulletproofs()
 	secp256k1_context_destroy(m_pContext);
 }
 
-bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const
+secp256k1_context* Bulletproofs::GetThreadContext() const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	thread_local ThreadContext context(m_pContext);
+	return context.m_pContext;
+}
 
-	const size_t numBits = 64;
+bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const
+{
 	const size_t proofLength = rangeProofs.front().second.GetProofBytes().size();
 
 	std::vector<Commitment> commitments;
 	commitments.reserve(rangeProofs.size());
 
+	std::vector<const RangeProof*> proofs;
+	proofs.reserve(rangeProofs.size());
+
 	std::vector<const unsigned char*> bulletproofPointers;
 	bulletproofPointers.reserve(rangeProofs.size());
 	for (const std::pair<Commitment, RangeProof>& rangeProof : rangeProofs)
 	{
-		if (!m_cache.WasAlreadyVerified(rangeProof.first))
+		if (!m_cache.WasAlreadyVerified(rangeProof.first, rangeProof.second))
 		{
 			commitments.push_back(rangeProof.first);
+			proofs.push_back(&rangeProof.second);
 			bulletproofPointers.emplace_back(rangeProof.second.GetProofBytes().data());
 		}
 	}
@@ -55,18 +85,13 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 		return true;
 	}
 
-	// array of generator multiplied by value in pedersen commitments (cannot be NULL)
-	std::vector<secp256k1_generator> valueGenerators;
-	for (size_t i = 0; i < commitments.size(); i++)
-	{
-		valueGenerators.push_back(secp256k1_generator_const_h);
-	}
+	secp256k1_context* pContext = GetThreadContext();
 
-	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, commitments);
+	// A scratch space that can't be allocated throws here, so a failed verification always means an invalid proof.
+	auto pScratch = ScratchSpacePool::GetInstance().Acquire(pContext, GetVerifyScratchSize(commitments.size()));
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-	const int result = secp256k1_bulletproof_rangeproof_verify_multi(m_pContext, pScratchSpace, m_pGenerators, bulletproofPointers.data(), commitments.size(), proofLength, NULL, commitmentPointers.data(), 1, numBits, valueGenerators.data(), NULL, NULL);
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*pContext, commitments);
+	const int result = VerifyMulti(pContext, pScratch->Get(), bulletproofPointers, proofLength, commitmentPointers);
 
 	Pedersen::CleanupCommitments(commitmentPointers);
 
@@ -75,20 +100,49 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 		return false;
 	}
 
-	for (const Commitment& commitment : commitments)
+	for (size_t i = 0; i < commitments.size(); i++)
 	{
-		m_cache.AddToCache(commitment);
+		m_cache.AddToCache(commitments[i], *proofs[i]);
 	}
 
 	return true;
 }
 
+int Bulletproofs::VerifyMulti(
+	secp256k1_context* pContext,
+	secp256k1_scratch_space* pScratch,
+	const std::vector<const unsigned char*>& proofs,
+	const size_t proofLength,
+	std::vector<secp256k1_pedersen_commitment*>& commitments) const
+{
+	const size_t numBits = 64;
+
+	// array of generator multiplied by value in pedersen commitments (cannot be NULL)
+	std::vector<secp256k1_generator> valueGenerators(proofs.size(), secp256k1_generator_const_h);
+
+	return secp256k1_bulletproof_rangeproof_verify_multi(
+		pContext,
+		pScratch,
+		m_pGenerators,
+		proofs.data(),
+		proofs.size(),
+		proofLength,
+		NULL,
+		commitments.data(),
+		1,
+		numBits,
+		valueGenerators.data(),
+		NULL,
+		NULL
+	);
+}
+
 RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretKey& key, const SecretKey& privateNonce, const SecretKey& rewindNonce, const ProofMessage& proofMessage) const
 {
-	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+	secp256k1_context* pContext = GetThreadContext();
 
 	const SecretKey randomSeed = CSPRNG::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
+	const int randomizeResult = secp256k1_context_randomize(pContext, randomSeed.data());
 	if (randomizeResult != 1) {
 		throw CryptoException("secp256k1_context_randomize failed with error: " + std::to_string(randomizeResult));
 	}
@@ -96,12 +150,12 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 	std::vector<uint8_t> proofBytes(MAX_PROOF_SIZE, 0);
 	size_t proofLen = MAX_PROOF_SIZE;
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
+	auto pScratch = ScratchSpacePool::GetInstance().Acquire(pContext, SCRATCH_SPACE_SIZE);
 
 	std::vector<const unsigned char*> blindingFactors({ key.data() });
 	int result = secp256k1_bulletproof_rangeproof_prove(
-		m_pContext,
-		pScratchSpace,
+		pContext,
+		pScratch->Get(),
 		m_pGenerators,
 		proofBytes.data(),
 		&proofLen,
@@ -121,7 +175,7 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 		0,
 		proofMessage.data()
 	);
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	pScratch.reset();
 
 	if (result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_bulletproof_rangeproof_prove failed with error: {}", result);
@@ -133,9 +187,8 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 
 std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(const Commitment& commitment, const RangeProof& rangeProof, const SecretKey& nonce) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
-
-	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, std::vector<Commitment>({ commitment }));
+	secp256k1_context* pContext = GetThreadContext();
+	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*pContext, std::vector<Commitment>({ commitment }));
 
 	if (!commitmentPointers.empty())
 	{
@@ -144,7 +197,7 @@ std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(const Commitment& commit
 		ProofMessage message;
 
 		int result = secp256k1_bulletproof_rangeproof_rewind(
-			m_pContext,
+			pContext,
 			&value,
 			blinding_factor.data(),
 			rangeProof.GetProofBytes().data(),
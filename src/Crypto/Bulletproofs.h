@@ -2,12 +2,12 @@
 
 #include "BulletProofsCache.h"
 
+#include <secp256k1-zkp/secp256k1_commitment.h>
 #include <Crypto/Models/Commitment.h>
 #include <Crypto/Models/RangeProof.h>
 #include <Crypto/Models/BlindingFactor.h>
 #include <Crypto/Models/ProofMessage.h>
 #include <Crypto/Models/RewoundProof.h>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
@@ -37,7 +37,16 @@ public:
 	) const;
 
 private:
-	mutable std::shared_mutex m_mutex;
+	secp256k1_context* GetThreadContext() const;
+	int VerifyMulti(
+		secp256k1_context* pContext,
+		secp256k1_scratch_space* pScratch,
+		const std::vector<const unsigned char*>& proofs,
+		const size_t proofLength,
+		std::vector<secp256k1_pedersen_commitment*>& commitments
+	) const;
+
+	// Only used to clone per-thread contexts. The generators are never modified after construction.
 	secp256k1_context* m_pContext;
 	secp256k1_bulletproof_generators* m_pGenerators;
 	mutable BulletProofsCache m_cache;
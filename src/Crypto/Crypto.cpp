@@ -1,5 +1,6 @@
 #include <Crypto/Crypto.h>
 #include <Core/Traits/Lockable.h>
+#include <Common/Util/BisectUtil.h>
 #include <cassert>
 
 #include "Context.h"
@@ -51,6 +52,25 @@ Commitment Crypto::AddCommitments(const std::vector<Commitment>& positive, const
 	return Pedersen::GetInstance().PedersenCommitSum(sanitizedPositive, sanitizedNegative);
 }
 
+Commitment Crypto::AddCommitments(
+	const uint64_t numCommitments,
+	const std::function<std::optional<Commitment>(const uint64_t)>& getCommitment)
+{
+	const Commitment zeroCommitment(CBigInteger<33>::ValueOf(0));
+
+	return Pedersen::GetInstance().PedersenCommitSum(
+		numCommitments,
+		[&zeroCommitment, &getCommitment](const uint64_t index) -> std::optional<Commitment> {
+			std::optional<Commitment> commitmentOpt = getCommitment(index);
+			if (commitmentOpt.has_value() && commitmentOpt.value() == zeroCommitment) {
+				return std::nullopt;
+			}
+
+			return commitmentOpt;
+		}
+	);
+}
+
 BlindingFactor Crypto::AddBlindingFactors(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative)
 {
 	BlindingFactor zeroBlindingFactor(ZERO_HASH);
@@ -111,6 +131,30 @@ bool Crypto::VerifyRangeProofs(const std::vector<std::pair<Commitment, RangeProo
 	return Bulletproofs::GetInstance().VerifyBulletproofs(rangeProofs);
 }
 
+std::optional<size_t> Crypto::FindFirstInvalidRangeProof(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs)
+{
+	return BisectUtil::FindFirstFailure(
+		rangeProofs.size(),
+		[&rangeProofs](const size_t begin, const size_t end) {
+			return Bulletproofs::GetInstance().VerifyBulletproofs(
+				std::vector<std::pair<Commitment, RangeProof>>(rangeProofs.cbegin() + begin, rangeProofs.cbegin() + end)
+			);
+		}
+	);
+}
+
+std::vector<size_t> Crypto::FindInvalidRangeProofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs)
+{
+	return BisectUtil::FindFailures(
+		rangeProofs.size(),
+		[&rangeProofs](const size_t begin, const size_t end) {
+			return Bulletproofs::GetInstance().VerifyBulletproofs(
+				std::vector<std::pair<Commitment, RangeProof>>(rangeProofs.cbegin() + begin, rangeProofs.cbegin() + end)
+			);
+		}
+	);
+}
+
 PublicKey Crypto::CalculatePublicKey(const SecretKey& privateKey)
 {
 	return PublicKeys::GetInstance().CalculatePublicKey(privateKey);
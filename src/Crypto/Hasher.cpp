@@ -117,4 +117,11 @@ uint64_t Hasher::SipHash24(const uint64_t k0, const uint64_t k1, const std::vect
 	const std::vector<uint64_t> key = { k0, k1 };
 
 	return siphash24(&key[0], &data[0], data.size());
+}
+
+uint64_t Hasher::SipHash24(const uint64_t k0, const uint64_t k1, const uint8_t* data, const size_t len)
+{
+	const uint64_t key[2] = { k0, k1 };
+
+	return siphash24(key, data, len);
 }
\ No newline at end of file
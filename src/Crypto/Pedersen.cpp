@@ -4,6 +4,12 @@
 #include <secp256k1-zkp/secp256k1_commitment.h>
 #include <Core/Exceptions/CryptoException.h>
 #include <Common/Logger.h>
+#include <atomic>
+#include <thread>
+
+// Sums with at least this many commitments are split across threads.
+static constexpr uint64_t PARALLEL_SUM_THRESHOLD = 8192;
+static constexpr uint64_t SUM_CHUNK_SIZE = 4096;
 
 static Pedersen instance;
 
@@ -45,38 +51,175 @@ Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive,
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
-	std::vector<secp256k1_pedersen_commitment*> positiveCommitments = Pedersen::ConvertCommitments(*m_pContext, positive);
-	std::vector<secp256k1_pedersen_commitment*> negativeCommitments = Pedersen::ConvertCommitments(*m_pContext, negative);
+	std::vector<secp256k1_pedersen_commitment> positiveCommitments;
+	if (positive.size() >= PARALLEL_SUM_THRESHOLD) {
+		auto positiveSumOpt = SumCommitmentsParallel(
+			positive.size(),
+			[&positive](const uint64_t index) { return std::make_optional<Commitment>(positive[index]); }
+		);
+		if (positiveSumOpt.has_value()) {
+			positiveCommitments.push_back(positiveSumOpt.value());
+		}
+	} else {
+		positiveCommitments = ParseCommitments(*m_pContext, positive);
+	}
+
+	std::vector<secp256k1_pedersen_commitment> negativeCommitments = ParseCommitments(*m_pContext, negative);
+
+	auto commitmentOpt = SumCommitments(*m_pContext, positiveCommitments, negativeCommitments);
+	if (!commitmentOpt.has_value())
+	{
+		LOG_ERROR("secp256k1_pedersen_commit_sum failed");
+		throw CryptoException("secp256k1_pedersen_commit_sum error");
+	}
+
+	return SerializeCommitment(commitmentOpt.value());
+}
+
+Commitment Pedersen::PedersenCommitSum(const uint64_t numCommitments, const std::function<std::optional<Commitment>(const uint64_t)>& getCommitment) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	auto commitmentOpt = SumCommitmentsParallel(numCommitments, getCommitment);
+	if (!commitmentOpt.has_value())
+	{
+		LOG_ERROR_F("secp256k1_pedersen_commit_sum failed for {} commitments", numCommitments);
+		throw CryptoException("secp256k1_pedersen_commit_sum error");
+	}
+
+	return SerializeCommitment(commitmentOpt.value());
+}
+
+std::optional<secp256k1_pedersen_commitment> Pedersen::SumCommitmentsParallel(
+	const uint64_t numCommitments,
+	const std::function<std::optional<Commitment>(const uint64_t)>& getCommitment) const
+{
+	const uint64_t numChunks = (numCommitments + SUM_CHUNK_SIZE - 1) / SUM_CHUNK_SIZE;
+	const size_t numThreads = (size_t)(std::min)(
+		(uint64_t)(std::max)(std::thread::hardware_concurrency(), 1u),
+		(std::max)(numChunks, (uint64_t)1)
+	);
+
+	// Each thread folds the chunks it claims into its own partial sum, parsing into a reused contiguous buffer.
+	std::vector<std::optional<secp256k1_pedersen_commitment>> partialSums(numThreads);
+	std::vector<std::exception_ptr> errors(numThreads);
+	std::atomic<uint64_t> nextChunk = 0;
+	std::atomic_bool failed = false;
+
+	auto sumChunks = [this, numCommitments, numChunks, &getCommitment, &partialSums, &errors, &nextChunk, &failed](const size_t threadIndex) {
+		try
+		{
+			std::vector<secp256k1_pedersen_commitment> commitments;
+			commitments.reserve(SUM_CHUNK_SIZE + 1);
+
+			for (uint64_t chunk = nextChunk++; chunk < numChunks && !failed; chunk = nextChunk++)
+			{
+				commitments.clear();
+				if (partialSums[threadIndex].has_value()) {
+					commitments.push_back(partialSums[threadIndex].value());
+				}
+
+				const uint64_t end = (std::min)(numCommitments, (chunk + 1) * SUM_CHUNK_SIZE);
+				for (uint64_t i = chunk * SUM_CHUNK_SIZE; i < end; i++)
+				{
+					std::optional<Commitment> commitmentOpt = getCommitment(i);
+					if (commitmentOpt.has_value()) {
+						commitments.push_back(ParseCommitment(*m_pContext, commitmentOpt.value()));
+					}
+				}
+
+				partialSums[threadIndex] = SumCommitments(*m_pContext, commitments, {});
+			}
+		}
+		catch (...)
+		{
+			errors[threadIndex] = std::current_exception();
+			failed = true;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < numThreads; i++)
+	{
+		threads.emplace_back(std::thread(sumChunks, i));
+	}
+
+	sumChunks(0);
+
+	for (auto& thread : threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+
+	for (const std::exception_ptr& pError : errors)
+	{
+		if (pError != nullptr) {
+			std::rethrow_exception(pError);
+		}
+	}
+
+	std::vector<secp256k1_pedersen_commitment> partials;
+	for (const auto& partialSumOpt : partialSums)
+	{
+		if (partialSumOpt.has_value()) {
+			partials.push_back(partialSumOpt.value());
+		}
+	}
+
+	return SumCommitments(*m_pContext, partials, {});
+}
+
+std::optional<secp256k1_pedersen_commitment> Pedersen::SumCommitments(
+	const secp256k1_context& context,
+	const std::vector<secp256k1_pedersen_commitment>& positive,
+	const std::vector<secp256k1_pedersen_commitment>& negative)
+{
+	std::vector<const secp256k1_pedersen_commitment*> positivePointers;
+	positivePointers.reserve(positive.size());
+	for (const secp256k1_pedersen_commitment& commitment : positive)
+	{
+		positivePointers.push_back(&commitment);
+	}
+
+	std::vector<const secp256k1_pedersen_commitment*> negativePointers;
+	negativePointers.reserve(negative.size());
+	for (const secp256k1_pedersen_commitment& commitment : negative)
+	{
+		negativePointers.push_back(&commitment);
+	}
 
 	secp256k1_pedersen_commitment commitment;
 	const int result = secp256k1_pedersen_commit_sum(
-		m_pContext,
+		&context,
 		&commitment,
-		positiveCommitments.empty() ? nullptr : &positiveCommitments[0],
-		positiveCommitments.size(),
-		negativeCommitments.empty() ? nullptr : &negativeCommitments[0],
-		negativeCommitments.size()
+		positivePointers.empty() ? nullptr : positivePointers.data(),
+		positivePointers.size(),
+		negativePointers.empty() ? nullptr : negativePointers.data(),
+		negativePointers.size()
 	);
 
-	Pedersen::CleanupCommitments(positiveCommitments);
-	Pedersen::CleanupCommitments(negativeCommitments);
-
-	if (result != 1)
-	{
-		LOG_ERROR_F("secp256k1_pedersen_commit_sum returned result: {}", result);
-		throw CryptoException("secp256k1_pedersen_commit_sum error");
+	// secp256k1_pedersen_commit_sum only fails when the sum is the point at infinity.
+	if (result != 1) {
+		return std::nullopt;
 	}
 
+	return std::make_optional(commitment);
+}
 
-	std::vector<unsigned char> serializedCommitment(33);
-	const int serializeResult = secp256k1_pedersen_commitment_serialize(m_pContext, &serializedCommitment[0], &commitment);
+Commitment Pedersen::SerializeCommitment(const secp256k1_pedersen_commitment& commitment) const
+{
+	Commitment serializedCommitment;
+	const int serializeResult = secp256k1_pedersen_commitment_serialize(m_pContext, serializedCommitment.data(), &commitment);
 	if (serializeResult != 1)
 	{
 		LOG_ERROR_F("secp256k1_pedersen_commitment_serialize returned result: {}", serializeResult);
 		throw CryptoException("secp256k1_pedersen_commitment_serialize error");
 	}
 
-	return Commitment(CBigInteger<33>(std::move(serializedCommitment)));
+	return serializedCommitment;
 }
 
 BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const
@@ -160,6 +303,30 @@ Commitment Pedersen::ToCommitment(const PublicKey& publicKey) const
 
 }
 
+secp256k1_pedersen_commitment Pedersen::ParseCommitment(const secp256k1_context& context, const Commitment& commitment)
+{
+	secp256k1_pedersen_commitment parsed;
+	const int parsed_result = secp256k1_pedersen_commitment_parse(&context, &parsed, commitment.data());
+	if (parsed_result != 1) {
+		LOG_ERROR_F("secp256k1_pedersen_commitment_parse failed with error {} for commitment {}", parsed_result, commitment);
+		throw CRYPTO_EXCEPTION_F("secp256k1_pedersen_commitment_parse failed with error: {}", parsed_result);
+	}
+
+	return parsed;
+}
+
+std::vector<secp256k1_pedersen_commitment> Pedersen::ParseCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments)
+{
+	std::vector<secp256k1_pedersen_commitment> parsedCommitments;
+	parsedCommitments.reserve(commitments.size());
+	for (const Commitment& commitment : commitments)
+	{
+		parsedCommitments.push_back(ParseCommitment(context, commitment));
+	}
+
+	return parsedCommitments;
+}
+
 std::vector<secp256k1_pedersen_commitment*> Pedersen::ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments)
 {
 	std::vector<secp256k1_pedersen_commitment*> convertedCommitments(commitments.size(), NULL);
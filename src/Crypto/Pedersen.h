@@ -6,6 +6,8 @@
 #include <Crypto/Models/SecretKey.h>
 #include <Crypto/Models/Commitment.h>
 #include <Crypto/Models/PublicKey.h>
+#include <functional>
+#include <optional>
 #include <shared_mutex>
 
 // Forward Declarations
@@ -20,6 +22,7 @@ public:
 
 	Commitment PedersenCommit(const uint64_t value, const BlindingFactor& blindingFactor) const;
 	Commitment PedersenCommitSum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative) const;
+	Commitment PedersenCommitSum(const uint64_t numCommitments, const std::function<std::optional<Commitment>(const uint64_t)>& getCommitment) const;
 	BlindingFactor PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const;
 
 	SecretKey BlindSwitch(const SecretKey& secretKey, const uint64_t amount) const;
@@ -30,6 +33,24 @@ public:
 	static void CleanupCommitments(std::vector<secp256k1_pedersen_commitment*>& commitments);
 
 private:
+	static secp256k1_pedersen_commitment ParseCommitment(const secp256k1_context& context, const Commitment& commitment);
+	static std::vector<secp256k1_pedersen_commitment> ParseCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments);
+
+	//
+	// Returns std::nullopt when the commitments sum to the point at infinity.
+	//
+	static std::optional<secp256k1_pedersen_commitment> SumCommitments(
+		const secp256k1_context& context,
+		const std::vector<secp256k1_pedersen_commitment>& positive,
+		const std::vector<secp256k1_pedersen_commitment>& negative
+	);
+	std::optional<secp256k1_pedersen_commitment> SumCommitmentsParallel(
+		const uint64_t numCommitments,
+		const std::function<std::optional<Commitment>(const uint64_t)>& getCommitment
+	) const;
+
+	Commitment SerializeCommitment(const secp256k1_pedersen_commitment& commitment) const;
+
 	mutable std::shared_mutex m_mutex;
 	secp256k1_context* m_pContext;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "ScratchSpacePool.h"
+
+#include <Core/Exceptions/CryptoException.h>
+
+// Scratch spaces are allocated lazily by the OS, so this bounds reserved address space more than resident memory.
+static const size_t MAX_POOLED_BYTES = 1024 * 1024 * 1024;
+
+static ScratchSpacePool instance;
+
+ScratchSpacePool& ScratchSpacePool::GetInstance()
+{
+	return instance;
+}
+
+ScratchSpacePool::~ScratchSpacePool()
+{
+	for (auto& entry : m_available)
+	{
+		secp256k1_scratch_space_destroy(entry.second);
+	}
+}
+
+std::unique_ptr<ScratchSpacePool::Handle> ScratchSpacePool::Acquire(const secp256k1_context* pContext, const size_t size)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto iter = m_available.lower_bound(size);
+		if (iter != m_available.end())
+		{
+			const size_t pooledSize = iter->first;
+			secp256k1_scratch_space* pScratch = iter->second;
+			m_available.erase(iter);
+			m_pooledBytes -= pooledSize;
+
+			return std::make_unique<Handle>(*this, pScratch, pooledSize);
+		}
+	}
+
+	secp256k1_scratch_space* pScratch = secp256k1_scratch_space_create(pContext, size);
+	if (pScratch == nullptr) {
+		throw CRYPTO_EXCEPTION_F("Failed to create scratch space of size {}", size);
+	}
+
+	return std::make_unique<Handle>(*this, pScratch, size);
+}
+
+void ScratchSpacePool::Release(secp256k1_scratch_space* pScratch, const size_t size)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if (m_pooledBytes + size <= MAX_POOLED_BYTES)
+		{
+			m_available.insert({ size, pScratch });
+			m_pooledBytes += size;
+			return;
+		}
+	}
+
+	secp256k1_scratch_space_destroy(pScratch);
+}
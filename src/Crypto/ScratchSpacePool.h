@@ -0,0 +1,45 @@
+#pragma once
+
+#include <secp256k1-zkp/secp256k1.h>
+#include <map>
+#include <memory>
+#include <mutex>
+
+//
+// Keeps secp256k1 scratch spaces around for reuse, so verifying or proving doesn't have to
+// allocate and free a large buffer on every call.
+// Scratch spaces are handed out by size, using the smallest pooled one that's big enough.
+//
+class ScratchSpacePool
+{
+public:
+	static ScratchSpacePool& GetInstance();
+	~ScratchSpacePool();
+
+	class Handle
+	{
+	public:
+		Handle(ScratchSpacePool& pool, secp256k1_scratch_space* pScratch, const size_t size)
+			: m_pool(pool), m_pScratch(pScratch), m_size(size) { }
+		Handle(const Handle&) = delete;
+		Handle& operator=(const Handle&) = delete;
+		~Handle() { m_pool.Release(m_pScratch, m_size); }
+
+		secp256k1_scratch_space* Get() const noexcept { return m_pScratch; }
+		size_t GetSize() const noexcept { return m_size; }
+
+	private:
+		ScratchSpacePool& m_pool;
+		secp256k1_scratch_space* m_pScratch;
+		size_t m_size;
+	};
+
+	std::unique_ptr<Handle> Acquire(const secp256k1_context* pContext, const size_t size);
+
+private:
+	void Release(secp256k1_scratch_space* pScratch, const size_t size);
+
+	std::mutex m_mutex;
+	std::multimap<size_t, secp256k1_scratch_space*> m_available;
+	size_t m_pooledBytes{ 0 };
+};
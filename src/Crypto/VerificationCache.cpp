@@ -0,0 +1,98 @@
+#include <Crypto/VerificationCache.h>
+#include <Crypto/CSPRNG.h>
+
+#include "ThirdParty/siphash.h"
+
+#include <algorithm>
+#include <cstring>
+
+// 4MB worth of fingerprints, enough for several hours of mempool traffic.
+static const size_t KERNEL_CACHE_ENTRIES = 1 << 19;
+
+// 4MB worth of fingerprints, enough to cover every output in the mempool plus a few days of blocks.
+static const size_t RANGEPROOF_CACHE_ENTRIES = 1 << 19;
+
+VerificationCache& VerificationCache::KernelSignatures()
+{
+	static VerificationCache cache(KERNEL_CACHE_ENTRIES);
+	return cache;
+}
+
+VerificationCache& VerificationCache::RangeProofs()
+{
+	static VerificationCache cache(RANGEPROOF_CACHE_ENTRIES);
+	return cache;
+}
+
+VerificationCache::VerificationCache(const size_t numEntries)
+	: m_numBuckets((std::max)(numEntries / SLOTS_PER_BUCKET, (size_t)1)),
+	m_pSlots(new std::atomic<uint64_t>[m_numBuckets * SLOTS_PER_BUCKET])
+{
+	for (size_t i = 0; i < m_numBuckets * SLOTS_PER_BUCKET; i++)
+	{
+		m_pSlots[i].store(0, std::memory_order_relaxed);
+	}
+
+	const SecureVector randomBytes = CSPRNG::GenerateRandomBytes(sizeof(m_sipKey));
+	memcpy(m_sipKey, randomBytes.data(), sizeof(m_sipKey));
+}
+
+bool VerificationCache::Contains(const std::vector<uint8_t>& key) const noexcept
+{
+	const uint64_t fingerprint = Fingerprint(key);
+	const std::atomic<uint64_t>* pBucket = GetBucket(fingerprint);
+
+	for (size_t i = 0; i < SLOTS_PER_BUCKET; i++)
+	{
+		if (pBucket[i].load(std::memory_order_relaxed) == fingerprint)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void VerificationCache::Add(const std::vector<uint8_t>& key) noexcept
+{
+	const uint64_t fingerprint = Fingerprint(key);
+	std::atomic<uint64_t>* pBucket = GetBucket(fingerprint);
+
+	for (size_t i = 0; i < SLOTS_PER_BUCKET; i++)
+	{
+		uint64_t current = pBucket[i].load(std::memory_order_relaxed);
+		if (current == fingerprint)
+		{
+			return;
+		}
+
+		if (current == 0 && pBucket[i].compare_exchange_strong(current, fingerprint, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	// Bucket is full, so overwrite a slot chosen by the upper half of the fingerprint.
+	pBucket[(fingerprint >> 32) % SLOTS_PER_BUCKET].store(fingerprint, std::memory_order_relaxed);
+}
+
+void VerificationCache::Clear() noexcept
+{
+	for (size_t i = 0; i < m_numBuckets * SLOTS_PER_BUCKET; i++)
+	{
+		m_pSlots[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+uint64_t VerificationCache::Fingerprint(const std::vector<uint8_t>& key) const noexcept
+{
+	const uint64_t fingerprint = siphash24(m_sipKey, key.data(), key.size());
+
+	// 0 marks an empty slot.
+	return fingerprint == 0 ? 1 : fingerprint;
+}
+
+std::atomic<uint64_t>* VerificationCache::GetBucket(const uint64_t fingerprint) const noexcept
+{
+	return &m_pSlots[(fingerprint % m_numBuckets) * SLOTS_PER_BUCKET];
+}
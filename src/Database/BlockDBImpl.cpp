@@ -6,9 +6,17 @@
 #include <Core/Models/FullBlock.h>
 #include <Core/Models/BlockSums.h>
 #include <Core/Models/OutputLocation.h>
+#include <Core/Serialization/ByteBuffer.h>
 #include <Database/DatabaseException.h>
 #include <Common/Logger.h>
 #include <Common/Util/StringUtil.h>
+#include <Common/Util/ThreadUtil.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/table.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <utility>
 #include <string>
 #include <filesystem.h>
@@ -17,8 +25,12 @@ using namespace rocksdb;
 
 
 BlockDB::BlockDB(const Config& config, std::unique_ptr<RocksDB>&& pRocksDB)
-	: m_config(config), m_pRocksDB(std::move(pRocksDB)), m_blockHeadersCache(128)
+	: m_config(config),
+	m_pRocksDB(std::move(pRocksDB)),
+	m_blockHeadersCache(config.GetChainDBHeaderCacheBytes()),
+	m_outputPositionsCleared(false)
 {
+	LoadOutputPositions();
 }
 
 BlockDB::~BlockDB()
@@ -26,19 +38,83 @@ BlockDB::~BlockDB()
 	m_pRocksDB.reset();
 }
 
+static CompressionType ParseCompression(const std::string& compression)
+{
+	if (compression == "LZ4")
+	{
+		return kLZ4Compression;
+	}
+	else if (compression == "ZSTD")
+	{
+		return kZSTD;
+	}
+	else if (compression != "NONE")
+	{
+		LOG_WARNING_F("Unknown chain db compression {}. Compression will be disabled.", compression);
+	}
+
+	return kNoCompression;
+}
+
+//
+// Builds the options for a table, sharing the block cache between all tables.
+// Tables with small values that are mostly read by key use small blocks with bloom filters.
+// Tables with large values (blocks & spent outputs) use larger, compressed blocks.
+//
+static ColumnFamilyOptions BuildTableOptions(const Config& config, const std::shared_ptr<Cache>& pBlockCache, const bool largeValues)
+{
+	BlockBasedTableOptions tableOptions;
+	tableOptions.block_cache = pBlockCache;
+	tableOptions.cache_index_and_filter_blocks = true;
+	tableOptions.pin_l0_filter_and_index_blocks_in_cache = true;
+	tableOptions.format_version = 4;
+
+	if (config.GetChainDBBloomBitsPerKey() > 0)
+	{
+		tableOptions.filter_policy.reset(NewBloomFilterPolicy(config.GetChainDBBloomBitsPerKey(), false));
+	}
+
+	ColumnFamilyOptions options;
+	options.write_buffer_size = config.GetChainDBWriteBufferBytes();
+	options.level_compaction_dynamic_level_bytes = true;
+
+	if (largeValues)
+	{
+		tableOptions.block_size = 64 * 1024;
+		options.compression = ParseCompression(config.GetChainDBBlockCompression());
+	}
+	else
+	{
+		tableOptions.data_block_index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+		options.memtable_whole_key_filtering = true;
+		options.memtable_prefix_bloom_size_ratio = 0.02;
+		options.compression = kNoCompression;
+	}
+
+	options.table_factory.reset(NewBlockBasedTableFactory(tableOptions));
+	return options;
+}
+
 std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 {
 	fs::path dbPath = config.GetDatabasePath() / "CHAIN/";
 
-	ColumnFamilyDescriptor BLOCK_COLUMN = ColumnFamilyDescriptor("BLOCK", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor HEADER_COLUMN = ColumnFamilyDescriptor("HEADER", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor BLOCK_SUMS_COLUMN = ColumnFamilyDescriptor("BLOCK_SUMS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor SPENT_OUTPUTS_COLUMN = ColumnFamilyDescriptor("SPENT_OUTPUTS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
+	std::shared_ptr<Cache> pBlockCache = NewLRUCache(config.GetChainDBBlockCacheBytes());
+	const ColumnFamilyOptions pointLookupOptions = BuildTableOptions(config, pBlockCache, false);
+	const ColumnFamilyOptions largeValueOptions = BuildTableOptions(config, pBlockCache, true);
+
+	ColumnFamilyDescriptor BLOCK_COLUMN = ColumnFamilyDescriptor("BLOCK", largeValueOptions);
+	ColumnFamilyDescriptor HEADER_COLUMN = ColumnFamilyDescriptor("HEADER", pointLookupOptions);
+	ColumnFamilyDescriptor BLOCK_SUMS_COLUMN = ColumnFamilyDescriptor("BLOCK_SUMS", pointLookupOptions);
+	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", pointLookupOptions);
+	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", pointLookupOptions);
+	ColumnFamilyDescriptor SPENT_OUTPUTS_COLUMN = ColumnFamilyDescriptor("SPENT_OUTPUTS", largeValueOptions);
+
+	Options options = RocksDBFactory::DefaultOptions();
+	options.IncreaseParallelism((int)std::max(std::thread::hardware_concurrency(), 2u));
 
 	std::vector<ColumnFamilyDescriptor> tableNames = { ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN, SPENT_OUTPUTS_COLUMN };
-	std::unique_ptr<RocksDB> pRocksDB = RocksDBFactory::Open(dbPath, tableNames);
+	std::unique_ptr<RocksDB> pRocksDB = RocksDBFactory::Open(dbPath, tableNames, options);
 	pRocksDB->DeleteAll("INPUT_BITMAP");
 
 	return std::make_shared<BlockDB>(config, std::move(pRocksDB));
@@ -50,15 +126,37 @@ void BlockDB::Commit()
 
 	for (auto pHeader : m_uncommitted)
 	{
-		m_blockHeadersCache.Put(pHeader->GetHash(), pHeader);
+		m_blockHeadersCache.Put(pHeader);
 	}
 
 	m_uncommitted.clear();
+
+	if (m_outputPositionsCleared)
+	{
+		m_outputPositions.Clear();
+		m_outputPositionsCleared = false;
+	}
+
+	for (const auto& entry : m_uncommittedOutputs)
+	{
+		if (entry.second.has_value())
+		{
+			m_outputPositions.Put(entry.first, entry.second.value());
+		}
+		else
+		{
+			m_outputPositions.Remove(entry.first);
+		}
+	}
+
+	m_uncommittedOutputs.clear();
 }
 
 void BlockDB::Rollback() noexcept
 {
 	m_uncommitted.clear();
+	m_uncommittedOutputs.clear();
+	m_outputPositionsCleared = false;
 	m_pRocksDB->Rollback();
 }
 
@@ -122,46 +220,128 @@ void BlockDB::MigrateBlocks()
 	//}
 }
 
+// Reads the height from a serialized block without deserializing the rest of it.
+// Blocks start with their header, which begins with version (u16) and height (u64).
+static uint64_t ReadBlockHeight(const rocksdb::Slice& value)
+{
+	if (value.size() < 10) {
+		throw DATABASE_EXCEPTION("Block too short");
+	}
+
+	ByteBuffer byteBuffer(std::vector<uint8_t>((const uint8_t*)value.data(), (const uint8_t*)value.data() + 10));
+	byteBuffer.ReadU16();
+	return byteBuffer.ReadU64();
+}
+
 void BlockDB::Compact(const std::shared_ptr<const Chain>& pChain)
 {
-	std::vector<std::string> blocks_to_remove;
+	const uint64_t tipHeight = pChain->GetHeight();
+	const uint64_t archiveDepth = m_config.GetChainDBArchiveDepth();
+	const uint64_t pruneHeight = tipHeight > archiveDepth ? tipHeight - archiveDepth : 0;
+	if (pruneHeight == 0) {
+		return;
+	}
 
-	const uint64_t horizon = Consensus::GetHorizonHeight(pChain->GetHeight());
+	std::vector<std::string> blocks_to_remove;
 	auto iter = m_pRocksDB->GetIterator("BLOCK");
 	for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
 		rocksdb::Slice key = iter->key();
 		try {
-			auto pBlock = m_pRocksDB->Get<FullBlock>("BLOCK", key);
-			if (pBlock->GetHeight() < horizon) {
+			if (ReadBlockHeight(iter->value()) < pruneHeight) {
 				blocks_to_remove.push_back(key.ToString());
 			}
 		}
 		catch (std::exception& e) {
-			LOG_DEBUG_F("Failed to deserialize block {}. Error: {}", key.ToString(true), e.what());
+			LOG_DEBUG_F("Failed to read block {}. Error: {}", key.ToString(true), e.what());
 			blocks_to_remove.push_back(key.ToString());
 		}
 	}
 
+	std::vector<std::string> spent_to_remove;
+	auto spentIter = m_pRocksDB->GetIterator("SPENT_OUTPUTS");
+	for (spentIter->SeekToFirst(); spentIter->Valid(); spentIter->Next()) {
+		rocksdb::Slice key = spentIter->key();
+		if (key.size() != 32) {
+			spent_to_remove.push_back(key.ToString());
+			continue;
+		}
+
+		auto pHeader = GetBlockHeader(Hash((const uint8_t*)key.data()));
+		if (pHeader == nullptr || pHeader->GetHeight() < pruneHeight) {
+			spent_to_remove.push_back(key.ToString());
+		}
+	}
+
+	LOG_INFO_F(
+		"Removing {} blocks and {} spent output records below height {}",
+		blocks_to_remove.size(), spent_to_remove.size(), pruneHeight
+	);
+
 	m_pRocksDB->Delete("BLOCK", blocks_to_remove);
+	m_pRocksDB->Delete("SPENT_OUTPUTS", spent_to_remove);
+}
+
+void BlockDB::RemoveBlocks(const std::vector<Hash>& blockHashes)
+{
+	std::vector<std::string> keys;
+	keys.reserve(blockHashes.size());
+	for (const Hash& hash : blockHashes)
+	{
+		keys.push_back(std::string((const char*)hash.data(), hash.size()));
+	}
+
+	m_pRocksDB->Delete("BLOCK", keys);
+	m_pRocksDB->Delete("SPENT_OUTPUTS", keys);
 }
 
 BlockHeaderPtr BlockDB::GetBlockHeader(const Hash& hash) const
 {
-	if (m_blockHeadersCache.Cached(hash))
+	BlockHeaderPtr pCached = m_blockHeadersCache.Get(hash);
+	if (pCached != nullptr)
 	{
-		return m_blockHeadersCache.Get(hash);
+		return pCached;
 	}
 
 	rocksdb::Slice key((const char*)hash.data(), hash.size());
 	auto pBlockHeader = m_pRocksDB->Get<BlockHeader>("HEADER", key);
 	if (pBlockHeader != nullptr)
 	{
-		return std::shared_ptr<BlockHeader>(std::move(pBlockHeader));
+		BlockHeaderPtr pHeader = std::shared_ptr<BlockHeader>(std::move(pBlockHeader));
+
+		// Headers read from an uncommitted batch are only cached once the batch is committed.
+		if (!m_pRocksDB->IsTransactional())
+		{
+			m_blockHeadersCache.Put(pHeader);
+		}
+
+		return pHeader;
 	}
 
 	return nullptr;
 }
 
+void BlockDB::WarmHeaderCache(const std::shared_ptr<const Chain>& pChain) const
+{
+	const uint64_t tipHeight = pChain->GetHeight();
+	const uint64_t numHeaders = std::min<uint64_t>(m_blockHeadersCache.GetCapacity(), tipHeight + 1);
+
+	LOG_INFO_F("Loading {} headers into the header cache", numHeaders);
+
+	// Oldest first, so the tip ends up as the most recently used entry.
+	for (uint64_t height = tipHeight + 1 - numHeaders; height <= tipHeight; height++)
+	{
+		const Hash& hash = pChain->GetHash(height);
+		rocksdb::Slice key((const char*)hash.data(), hash.size());
+		auto pBlockHeader = m_pRocksDB->Get<BlockHeader>("HEADER", key);
+		if (pBlockHeader != nullptr)
+		{
+			m_blockHeadersCache.Put(std::shared_ptr<BlockHeader>(std::move(pBlockHeader)));
+		}
+	}
+
+	LOG_INFO("Finished loading header cache");
+}
+
 void BlockDB::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 {
 	LOG_TRACE_F("Adding header {}", *pBlockHeader);
@@ -176,7 +356,7 @@ void BlockDB::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 	}
 	else
 	{
-		m_blockHeadersCache.Put(pBlockHeader->GetHash(), pBlockHeader);
+		m_blockHeadersCache.Put(pBlockHeader);
 	}
 }
 
@@ -196,6 +376,18 @@ void BlockDB::AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders)
 
 	m_pRocksDB->Put("HEADER", entries);
 
+	for (auto pBlockHeader : blockHeaders)
+	{
+		if (m_pRocksDB->IsTransactional())
+		{
+			m_uncommitted.push_back(pBlockHeader);
+		}
+		else
+		{
+			m_blockHeadersCache.Put(pBlockHeader);
+		}
+	}
+
 	LOG_TRACE("Finished adding headers.");
 }
 
@@ -247,12 +439,65 @@ void BlockDB::AddOutputPosition(const Commitment& outputCommitment, const Output
 	rocksdb::Slice key((const char*)outputCommitment.data(), outputCommitment.size());
 
 	m_pRocksDB->Put("OUTPUT_POS", DBEntry<OutputLocation>(key, location));
+
+	if (m_pRocksDB->IsTransactional())
+	{
+		m_uncommittedOutputs.insert_or_assign(outputCommitment, std::make_optional(location));
+	}
+	else
+	{
+		m_outputPositions.Put(outputCommitment, location);
+	}
+}
+
+void BlockDB::AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>& outputPositions)
+{
+	if (outputPositions.empty())
+	{
+		return;
+	}
+
+	std::vector<DBEntry<OutputLocation>> entries;
+	entries.reserve(outputPositions.size());
+
+	for (const auto& outputPosition : outputPositions)
+	{
+		rocksdb::Slice key((const char*)outputPosition.first.data(), outputPosition.first.size());
+		entries.push_back(DBEntry<OutputLocation>(key, outputPosition.second));
+	}
+
+	m_pRocksDB->Put("OUTPUT_POS", entries);
+
+	for (const auto& outputPosition : outputPositions)
+	{
+		if (m_pRocksDB->IsTransactional())
+		{
+			m_uncommittedOutputs.insert_or_assign(outputPosition.first, std::make_optional(outputPosition.second));
+		}
+		else
+		{
+			m_outputPositions.Put(outputPosition.first, outputPosition.second);
+		}
+	}
 }
 
 std::unique_ptr<OutputLocation> BlockDB::GetOutputPosition(const Commitment& outputCommitment) const
 {
-	rocksdb::Slice key((const char*)outputCommitment.data(), outputCommitment.size());
-	return m_pRocksDB->Get<OutputLocation>("OUTPUT_POS", key);
+	if (m_pRocksDB->IsTransactional())
+	{
+		auto iter = m_uncommittedOutputs.find(outputCommitment);
+		if (iter != m_uncommittedOutputs.end())
+		{
+			return iter->second.has_value() ? std::make_unique<OutputLocation>(iter->second.value()) : nullptr;
+		}
+
+		if (m_outputPositionsCleared)
+		{
+			return nullptr;
+		}
+	}
+
+	return m_outputPositions.Get(outputCommitment);
 }
 
 void BlockDB::RemoveOutputPositions(const std::vector<Commitment>& outputCommitments)
@@ -265,6 +510,18 @@ void BlockDB::RemoveOutputPositions(const std::vector<Commitment>& outputCommitm
 	);
 
 	m_pRocksDB->Delete("OUTPUT_POS", keys);
+
+	for (const Commitment& commitment : outputCommitments)
+	{
+		if (m_pRocksDB->IsTransactional())
+		{
+			m_uncommittedOutputs.insert_or_assign(commitment, std::nullopt);
+		}
+		else
+		{
+			m_outputPositions.Remove(commitment);
+		}
+	}
 }
 
 void BlockDB::ClearOutputPositions()
@@ -272,6 +529,113 @@ void BlockDB::ClearOutputPositions()
 	LOG_WARNING("Deleting all output positions.");
 
 	m_pRocksDB->DeleteAll("OUTPUT_POS");
+
+	m_uncommittedOutputs.clear();
+	if (m_pRocksDB->IsTransactional())
+	{
+		m_outputPositionsCleared = true;
+	}
+	else
+	{
+		m_outputPositions.Clear();
+	}
+}
+
+//
+// Loads OUTPUT_POS into memory. The table is split into ranges by the commitments' first 2 bytes,
+// which are read in parallel. Pedersen commitments always start with 0x08 or 0x09,
+// so only that part of the keyspace is split, and the rest is read as one range.
+//
+void BlockDB::LoadOutputPositions()
+{
+	LOG_INFO("Loading output positions");
+
+	static constexpr uint16_t FIRST_PREFIX = 0x0800;
+	static constexpr uint16_t END_PREFIX = 0x0A00;
+	static constexpr uint16_t PREFIXES_PER_RANGE = 8;
+
+	struct PrefixRange
+	{
+		std::string lower; // Empty for the start of the table.
+		std::string upper; // Empty for the end of the table.
+	};
+
+	auto toKey = [](const uint16_t prefix) {
+		return std::string({ (char)(prefix >> 8), (char)(prefix & 0xFF) });
+	};
+
+	std::vector<PrefixRange> ranges;
+	ranges.push_back({ "", toKey(FIRST_PREFIX) });
+	for (uint16_t prefix = FIRST_PREFIX; prefix < END_PREFIX; prefix += PREFIXES_PER_RANGE)
+	{
+		ranges.push_back({ toKey(prefix), toKey(prefix + PREFIXES_PER_RANGE) });
+	}
+	ranges.push_back({ toKey(END_PREFIX), "" });
+
+	std::vector<std::vector<std::pair<Commitment, OutputLocation>>> results(ranges.size());
+	std::atomic<size_t> nextRange(0);
+	std::atomic<bool> failed(false);
+
+	auto loadRanges = [this, &ranges, &results, &nextRange, &failed]() {
+		try
+		{
+			for (size_t i = nextRange++; i < ranges.size(); i = nextRange++)
+			{
+				auto iter = m_pRocksDB->GetIterator("OUTPUT_POS");
+				if (ranges[i].lower.empty())
+				{
+					iter->SeekToFirst();
+				}
+				else
+				{
+					iter->Seek(ranges[i].lower);
+				}
+
+				for (; iter->Valid(); iter->Next())
+				{
+					const rocksdb::Slice key = iter->key();
+					if (!ranges[i].upper.empty() && key.compare(ranges[i].upper) >= 0)
+					{
+						break;
+					}
+
+					const rocksdb::Slice value = iter->value();
+					ByteBuffer keyBuffer(std::vector<uint8_t>(key.data(), key.data() + key.size()));
+					ByteBuffer valueBuffer(std::vector<uint8_t>(value.data(), value.data() + value.size()));
+					results[i].emplace_back(Commitment::Deserialize(keyBuffer), OutputLocation::Deserialize(valueBuffer));
+				}
+			}
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Failed to load output positions. Error: {}", e.what());
+			failed = true;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	const size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	for (size_t i = 0; i < numThreads; i++)
+	{
+		threads.emplace_back(std::thread(loadRanges));
+	}
+
+	ThreadUtil::JoinAll(threads);
+
+	if (failed)
+	{
+		throw DATABASE_EXCEPTION("Failed to load output positions");
+	}
+
+	for (const auto& rangeResults : results)
+	{
+		for (const auto& entry : rangeResults)
+		{
+			m_outputPositions.Put(entry.first, entry.second);
+		}
+	}
+
+	LOG_INFO_F("Loaded {} output positions", m_outputPositions.GetSize());
 }
 
 void BlockDB::AddSpentPositions(const Hash& blockHash, const std::vector<SpentOutput>& outputPositions)
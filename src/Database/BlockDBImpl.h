@@ -2,8 +2,11 @@
 
 #include <Database/BlockDb.h>
 #include <Core/Config.h>
-#include <caches/Cache.h>
+#include "HeaderCache.h"
+#include "OutputPositionIndex.h"
+
 #include <mutex>
+#include <optional>
 #include <set>
 
 // Forward Declarations
@@ -29,6 +32,7 @@ public:
 	void Compact(const std::shared_ptr<const Chain>& pChain) final;
 
 	BlockHeaderPtr GetBlockHeader(const Hash& hash) const final;
+	void WarmHeaderCache(const std::shared_ptr<const Chain>& pChain) const final;
 
 	void AddBlockHeader(BlockHeaderPtr pBlockHeader) final;
 	void AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) final;
@@ -36,12 +40,14 @@ public:
 	void AddBlock(const FullBlock& block) final;
 	std::unique_ptr<FullBlock> GetBlock(const Hash& hash) const final;
 	void ClearBlocks() final;
+	void RemoveBlocks(const std::vector<Hash>& blockHashes) final;
 
 	void AddBlockSums(const Hash& blockHash, const BlockSums& blockSums) final;
 	std::unique_ptr<BlockSums> GetBlockSums(const Hash& blockHash) const final;
 	void ClearBlockSums() final;
 
 	void AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location) final;
+	void AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>& outputPositions) final;
 	std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const final;
 	void RemoveOutputPositions(const std::vector<Commitment>& outputCommitments) final;
 	void ClearOutputPositions() final;
@@ -51,9 +57,17 @@ public:
 	void ClearSpentPositions() final;
 
 private:
+	void LoadOutputPositions();
+
 	const Config& m_config;
 	std::unique_ptr<RocksDB> m_pRocksDB;
-	FIFOCache<Hash, BlockHeaderPtr> m_blockHeadersCache;
+	mutable HeaderCache m_blockHeadersCache;
 
 	std::vector<BlockHeaderPtr> m_uncommitted;
+
+	// Every row of OUTPUT_POS, kept in memory. Changes made during a batch are held
+	// in m_uncommittedOutputs (nullopt means removed) until the batch is committed.
+	OutputPositionIndex m_outputPositions;
+	std::unordered_map<Commitment, std::optional<OutputLocation>> m_uncommittedOutputs;
+	bool m_outputPositionsCleared;
 };
\ No newline at end of file
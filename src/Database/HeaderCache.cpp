@@ -0,0 +1,66 @@
+#include "HeaderCache.h"
+
+#include <algorithm>
+
+HeaderCache::HeaderCache(const size_t maxBytes)
+	: m_entriesPerShard(std::max<size_t>(maxBytes / (APPROX_ENTRY_BYTES * NUM_SHARDS), 1))
+{
+
+}
+
+BlockHeaderPtr HeaderCache::Get(const Hash& hash) const
+{
+	Shard& shard = GetShard(hash);
+	std::unique_lock<std::mutex> lock(shard.mutex);
+
+	auto iter = shard.entries.find(hash);
+	if (iter == shard.entries.end())
+	{
+		return nullptr;
+	}
+
+	shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+	return *iter->second;
+}
+
+void HeaderCache::Put(const BlockHeaderPtr& pHeader)
+{
+	const Hash& hash = pHeader->GetHash();
+	Shard& shard = GetShard(hash);
+	std::unique_lock<std::mutex> lock(shard.mutex);
+
+	auto iter = shard.entries.find(hash);
+	if (iter != shard.entries.end())
+	{
+		*iter->second = pHeader;
+		shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+		return;
+	}
+
+	if (shard.entries.size() >= m_entriesPerShard)
+	{
+		shard.entries.erase(shard.lru.back()->GetHash());
+		shard.lru.pop_back();
+	}
+
+	shard.lru.push_front(pHeader);
+	shard.entries.insert({ hash, shard.lru.begin() });
+}
+
+size_t HeaderCache::GetSize() const
+{
+	size_t size = 0;
+	for (Shard& shard : m_shards)
+	{
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		size += shard.entries.size();
+	}
+
+	return size;
+}
+
+HeaderCache::Shard& HeaderCache::GetShard(const Hash& hash) const
+{
+	// Header hashes are uniformly distributed, so the first bytes make a good shard index.
+	return m_shards[(((size_t)hash[0] << 8) | hash[1]) % NUM_SHARDS];
+}
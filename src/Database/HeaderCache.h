@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Core/Models/BlockHeader.h>
+#include <Crypto/Models/Hash.h>
+#include <array>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+//
+// Thread-safe LRU cache of deserialized block headers.
+// Entries are spread across independently locked shards by hash,
+// so concurrent readers rarely contend on the same mutex.
+//
+class HeaderCache
+{
+public:
+	// Approximate in-memory size of a cached header, including its proof nonces & bookkeeping.
+	static constexpr size_t APPROX_ENTRY_BYTES = sizeof(BlockHeader) + (42 * sizeof(uint64_t)) + 128;
+
+	HeaderCache(const size_t maxBytes);
+
+	BlockHeaderPtr Get(const Hash& hash) const;
+	void Put(const BlockHeaderPtr& pHeader);
+
+	size_t GetCapacity() const noexcept { return m_entriesPerShard * NUM_SHARDS; }
+	size_t GetSize() const;
+
+private:
+	static constexpr size_t NUM_SHARDS = 32;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::list<BlockHeaderPtr> lru; // Most recently used at the front.
+		std::unordered_map<Hash, std::list<BlockHeaderPtr>::iterator> entries;
+	};
+
+	Shard& GetShard(const Hash& hash) const;
+
+	size_t m_entriesPerShard;
+	mutable std::array<Shard, NUM_SHARDS> m_shards;
+};
@@ -0,0 +1,161 @@
+#include "OutputPositionIndex.h"
+
+#include <Crypto/CSPRNG.h>
+#include <Crypto/Hasher.h>
+#include <algorithm>
+#include <cstring>
+
+// Grow once the table is 3/4 full to keep probe sequences short.
+static constexpr size_t MAX_LOAD_NUMERATOR = 3;
+static constexpr size_t MAX_LOAD_DENOMINATOR = 4;
+
+static size_t RoundUpToPowerOfTwo(const size_t value)
+{
+	size_t result = 1;
+	while (result < value)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
+OutputPositionIndex::OutputPositionIndex(const size_t initialCapacity)
+	: m_slots(RoundUpToPowerOfTwo(std::max<size_t>(initialCapacity, 16))),
+	m_mask(m_slots.size() - 1),
+	m_size(0)
+{
+	const SecureVector randomBytes = CSPRNG::GenerateRandomBytes(2 * sizeof(uint64_t));
+	std::memcpy(&m_sipKey0, randomBytes.data(), sizeof(uint64_t));
+	std::memcpy(&m_sipKey1, randomBytes.data() + sizeof(uint64_t), sizeof(uint64_t));
+}
+
+std::unique_ptr<OutputLocation> OutputPositionIndex::Get(const Commitment& commitment) const
+{
+	const size_t slotIdx = Find(ToBytes(commitment));
+	if (slotIdx == m_slots.size())
+	{
+		return nullptr;
+	}
+
+	const Slot& slot = m_slots[slotIdx];
+	return std::make_unique<OutputLocation>(LeafIndex::At(slot.leafIndex), slot.blockHeight);
+}
+
+void OutputPositionIndex::Put(const Commitment& commitment, const OutputLocation& location)
+{
+	if ((m_size + 1) * MAX_LOAD_DENOMINATOR > m_slots.size() * MAX_LOAD_NUMERATOR)
+	{
+		Grow();
+	}
+
+	const CommitmentBytes bytes = ToBytes(commitment);
+
+	size_t slotIdx = GetHome(bytes);
+	while (m_slots[slotIdx].occupied && m_slots[slotIdx].commitment != bytes)
+	{
+		slotIdx = (slotIdx + 1) & m_mask;
+	}
+
+	Slot& slot = m_slots[slotIdx];
+	if (!slot.occupied)
+	{
+		slot.occupied = true;
+		slot.commitment = bytes;
+		m_size++;
+	}
+
+	slot.leafIndex = location.GetLeafIndex().Get();
+	slot.blockHeight = location.GetBlockHeight();
+}
+
+void OutputPositionIndex::Remove(const Commitment& commitment)
+{
+	size_t holeIdx = Find(ToBytes(commitment));
+	if (holeIdx == m_slots.size())
+	{
+		return;
+	}
+
+	m_slots[holeIdx].occupied = false;
+	m_size--;
+
+	// Backward-shift deletion: move later entries of the probe sequence into the hole,
+	// so lookups never need tombstones.
+	size_t slotIdx = (holeIdx + 1) & m_mask;
+	while (m_slots[slotIdx].occupied)
+	{
+		const size_t homeIdx = GetHome(m_slots[slotIdx].commitment);
+		const size_t distanceFromHome = (slotIdx - homeIdx) & m_mask;
+		const size_t distanceFromHole = (slotIdx - holeIdx) & m_mask;
+		if (distanceFromHome >= distanceFromHole)
+		{
+			m_slots[holeIdx] = m_slots[slotIdx];
+			m_slots[slotIdx].occupied = false;
+			holeIdx = slotIdx;
+		}
+
+		slotIdx = (slotIdx + 1) & m_mask;
+	}
+}
+
+void OutputPositionIndex::Clear()
+{
+	for (Slot& slot : m_slots)
+	{
+		slot.occupied = false;
+	}
+
+	m_size = 0;
+}
+
+OutputPositionIndex::CommitmentBytes OutputPositionIndex::ToBytes(const Commitment& commitment)
+{
+	CommitmentBytes bytes;
+	std::memcpy(bytes.data(), commitment.data(), bytes.size());
+	return bytes;
+}
+
+size_t OutputPositionIndex::GetHome(const CommitmentBytes& commitment) const noexcept
+{
+	return (size_t)Hasher::SipHash24(m_sipKey0, m_sipKey1, commitment.data(), commitment.size()) & m_mask;
+}
+
+size_t OutputPositionIndex::Find(const CommitmentBytes& commitment) const noexcept
+{
+	size_t slotIdx = GetHome(commitment);
+	while (m_slots[slotIdx].occupied)
+	{
+		if (m_slots[slotIdx].commitment == commitment)
+		{
+			return slotIdx;
+		}
+
+		slotIdx = (slotIdx + 1) & m_mask;
+	}
+
+	return m_slots.size();
+}
+
+void OutputPositionIndex::Grow()
+{
+	std::vector<Slot> oldSlots(m_slots.size() * 2);
+	oldSlots.swap(m_slots);
+	m_mask = m_slots.size() - 1;
+	m_size = 0;
+
+	for (const Slot& slot : oldSlots)
+	{
+		if (slot.occupied)
+		{
+			size_t slotIdx = GetHome(slot.commitment);
+			while (m_slots[slotIdx].occupied)
+			{
+				slotIdx = (slotIdx + 1) & m_mask;
+			}
+
+			m_slots[slotIdx] = slot;
+			m_size++;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Crypto/Models/Commitment.h>
+#include <Core/Models/OutputLocation.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//
+// In-memory copy of the OUTPUT_POS table, used to answer unspent output lookups without touching RocksDB.
+// Open-addressing hash table with linear probing. Commitments are chosen by whoever creates the output,
+// so slots are picked by a SipHash of the commitment with a random per-instance key, which keeps
+// attackers from grinding commitments that pile up into long probe chains.
+// Full commitments are stored alongside each entry, so colliding hashes can't cause false positives.
+//
+// Not thread-safe for writes. Lookups may run concurrently with each other, but not with Put/Remove.
+//
+class OutputPositionIndex
+{
+public:
+	OutputPositionIndex(const size_t initialCapacity = 1 << 16);
+
+	std::unique_ptr<OutputLocation> Get(const Commitment& commitment) const;
+	void Put(const Commitment& commitment, const OutputLocation& location);
+	void Remove(const Commitment& commitment);
+	void Clear();
+
+	size_t GetSize() const noexcept { return m_size; }
+
+private:
+	using CommitmentBytes = std::array<uint8_t, 33>;
+
+	struct Slot
+	{
+		CommitmentBytes commitment;
+		bool occupied;
+		uint64_t leafIndex;
+		uint64_t blockHeight;
+	};
+
+	static CommitmentBytes ToBytes(const Commitment& commitment);
+	size_t GetHome(const CommitmentBytes& commitment) const noexcept;
+	size_t Find(const CommitmentBytes& commitment) const noexcept;
+	void Grow();
+
+	std::vector<Slot> m_slots;
+	size_t m_mask;
+	size_t m_size;
+	uint64_t m_sipKey0;
+	uint64_t m_sipKey1;
+};
@@ -5,13 +5,15 @@
 #include <Core/Traits/Batchable.h>
 #include <Database/DatabaseException.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <Core/Serialization/ByteBuffer.h>
 
 #include <rocksdb/db.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/options.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
-#include <rocksdb/utilities/transaction.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
+#include <rocksdb/write_batch.h>
 #include <filesystem.h>
 #include <cassert>
 #include <memory>
@@ -25,7 +27,7 @@ public:
 
 	virtual ~RocksDB()
 	{
-		m_pTransaction.reset();
+		m_pBatch.reset();
 
 		for (RocksDBTable& table : m_tables)
 		{
@@ -36,7 +38,7 @@ public:
 		m_pTransactionDB.reset();
 	}
 
-	bool IsTransactional() const noexcept { return m_pTransaction != nullptr; }
+	bool IsTransactional() const noexcept { return m_pBatch != nullptr; }
 
 	std::unique_ptr<rocksdb::Iterator> GetIterator(const RocksDBTable& table) const
 	{
@@ -54,13 +56,16 @@ public:
 	{
 		rocksdb::Status status;
 		std::string itemStr;
-		if (m_pTransaction != nullptr)
 		{
-			status = m_pTransaction->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
-		}
-		else
-		{
-			status = m_pTransactionDB->GetBaseDB()->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
+			Metrics::ScopedTimer timer(GetLatencyHistogram(EOperation::GET));
+			if (m_pBatch != nullptr)
+			{
+				status = m_pBatch->GetFromBatchAndDB(m_pTransactionDB->GetBaseDB(), rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
+			}
+			else
+			{
+				status = m_pTransactionDB->GetBaseDB()->Get(rocksdb::ReadOptions(), table.GetHandle(), key, &itemStr);
+			}
 		}
 
 		if (status.ok())
@@ -100,13 +105,14 @@ public:
 		rocksdb::Status status;
 		std::vector<unsigned char> serialized = entry.SerializeValue();
 		rocksdb::Slice value((const char*)serialized.data(), serialized.size());
-		if (m_pTransaction != nullptr)
+		if (m_pBatch != nullptr)
 		{
-			status = m_pTransaction->Put(table.GetHandle(), entry.key, value);
+			status = m_pBatch->Put(table.GetHandle(), entry.key, value);
 		}
 		else
 		{
-			status = m_pTransactionDB->Put(rocksdb::WriteOptions(), table.GetHandle(), entry.key, value);
+			Metrics::ScopedTimer timer(GetLatencyHistogram(EOperation::PUT));
+			status = m_pTransactionDB->GetBaseDB()->Put(rocksdb::WriteOptions(), table.GetHandle(), entry.key, value);
 		}
 
 		if (status.ok())
@@ -138,11 +144,9 @@ public:
 	{
 		assert(!entries.empty());
 
-		std::shared_ptr<rocksdb::Transaction> pTempTransaction = nullptr;
-		if (m_pTransaction == nullptr)
-		{
-			pTempTransaction = std::shared_ptr<rocksdb::Transaction>(m_pTransactionDB->BeginTransaction(rocksdb::WriteOptions()));
-		}
+		// Outside of a batch, the entries are still written atomically through a single WriteBatch.
+		rocksdb::WriteBatch tempBatch;
+		rocksdb::WriteBatchBase* pBatch = m_pBatch != nullptr ? (rocksdb::WriteBatchBase*)m_pBatch.get() : &tempBatch;
 
 		rocksdb::Status status;
 
@@ -150,14 +154,7 @@ public:
 		{
 			std::vector<unsigned char> serialized = entry.SerializeValue();
 			rocksdb::Slice value((const char*)serialized.data(), serialized.size());
-			if (m_pTransaction != nullptr)
-			{
-				status = m_pTransaction->Put(table.GetHandle(), entry.key, value);
-			}
-			else
-			{
-				status = pTempTransaction->Put(table.GetHandle(), entry.key, value);
-			}
+			status = pBatch->Put(table.GetHandle(), entry.key, value);
 
 			if (!status.ok())
 			{
@@ -171,8 +168,9 @@ public:
 			}
 		}
 
-		if (pTempTransaction != nullptr) {
-			pTempTransaction->Commit();
+		if (m_pBatch == nullptr)
+		{
+			Write(&tempBatch);
 		}
 	}
 
@@ -188,9 +186,9 @@ public:
 		LOG_TRACE_F("Deleting {} from table {}", key.ToString(true), table);
 
 		rocksdb::Status status;
-		if (m_pTransaction != nullptr)
+		if (m_pBatch != nullptr)
 		{
-			status = m_pTransaction->Delete(table.GetHandle(), key);
+			status = m_pBatch->Delete(table.GetHandle(), key);
 		}
 		else
 		{
@@ -216,11 +214,29 @@ public:
 
 	void Delete(const std::string& tableName, const std::vector<std::string>& keys)
 	{
-		// FUTURE: Use a WriteBatch
 		const RocksDBTable& table = GetTable(tableName);
-		for (const rocksdb::Slice& key : keys)
+
+		rocksdb::WriteBatch tempBatch;
+		rocksdb::WriteBatchBase* pBatch = m_pBatch != nullptr ? (rocksdb::WriteBatchBase*)m_pBatch.get() : &tempBatch;
+
+		for (const std::string& key : keys)
+		{
+			const rocksdb::Status status = pBatch->Delete(table.GetHandle(), key);
+			if (!status.ok())
+			{
+				LOG_ERROR(
+					"Error while attempting to delete {} from table {}. Error: {}",
+					rocksdb::Slice(key).ToString(true),
+					table,
+					status.getState()
+				);
+				throw DATABASE_EXCEPTION("Delete Failed");
+			}
+		}
+
+		if (m_pBatch == nullptr)
 		{
-			Delete(table, key);
+			Write(&tempBatch);
 		}
 	}
 
@@ -228,42 +244,24 @@ public:
 	{
 		LOG_WARNING_F("Deleting all rows from table {}", table);
 
-		rocksdb::Status status;
-		if (m_pTransaction != nullptr)
+		// Keys are collected first, since modifying a WriteBatchWithIndex invalidates its iterators.
+		std::vector<std::string> keys;
+		std::unique_ptr<rocksdb::Iterator> it(m_pTransactionDB->GetBaseDB()->NewIterator(rocksdb::ReadOptions(), table.GetHandle()));
+		if (m_pBatch != nullptr)
 		{
-			std::unique_ptr<rocksdb::Iterator> it(m_pTransaction->GetIterator(rocksdb::ReadOptions(), table.GetHandle()));
-			for (it->SeekToFirst(); it->Valid(); it->Next())
-			{
-				status = m_pTransaction->Delete(table.GetHandle(), it->key());
-				if (!status.ok())
-				{
-					LOG_ERROR(
-						"Error while attempting to delete {} from table {}. Error: {}",
-						it->key().data(),
-						table,
-						status.getState()
-					);
-					throw DATABASE_EXCEPTION("DeleteAll Failed");
-				}
-			}
+			it = std::unique_ptr<rocksdb::Iterator>(m_pBatch->NewIteratorWithBase(table.GetHandle(), it.release()));
 		}
-		else
+
+		for (it->SeekToFirst(); it->Valid(); it->Next())
 		{
-			std::unique_ptr<rocksdb::Iterator> it(m_pTransactionDB->NewIterator(rocksdb::ReadOptions(), table.GetHandle()));
-			for (it->SeekToFirst(); it->Valid(); it->Next())
-			{
-				status = m_pTransactionDB->Delete(rocksdb::WriteOptions(), table.GetHandle(), it->key());
-				if (!status.ok())
-				{
-					LOG_ERROR(
-						"Error while attempting to delete {} from table {}. Error: {}",
-						it->key().data(),
-						table,
-						status.getState()
-					);
-					throw DATABASE_EXCEPTION("DeleteAll Failed");
-				}
-			}
+			keys.push_back(it->key().ToString());
+		}
+
+		it.reset();
+
+		if (!keys.empty())
+		{
+			Delete(table.GetName(), keys);
 		}
 	}
 
@@ -274,42 +272,63 @@ public:
 
 	void Commit() final
 	{
-		//assert(m_pTransaction != nullptr);
-		if (m_pTransaction != nullptr) {
-			const rocksdb::Status status = m_pTransaction->Commit();
-			if (!status.ok()) {
-				LOG_ERROR_F("Transaction::Commit failed with error {}", status.getState());
-				throw DATABASE_EXCEPTION_F("Transaction::Commit Failed with error {}", status.getState());
-			}
+		if (m_pBatch != nullptr && m_pBatch->GetWriteBatch()->Count() > 0) {
+			Write(m_pBatch->GetWriteBatch());
+			m_pBatch->Clear();
 		}
 	}
 
 	void Rollback() noexcept final
 	{
-		assert(m_pTransaction != nullptr);
+		assert(m_pBatch != nullptr);
 
-		const rocksdb::Status status = m_pTransaction->Rollback();
-		if (!status.ok())
-		{
-			LOG_ERROR_F("Transaction::Rollback failed with error ({})", status.getState());
-		}
+		m_pBatch->Clear();
 	}
 
 	void OnInitWrite(const bool batch) final
 	{
 		if (batch) {
-			m_pTransaction = std::unique_ptr<rocksdb::Transaction>(
-				m_pTransactionDB->BeginTransaction(rocksdb::WriteOptions())
-			);
+			// Indexed so reads made during the batch see its uncommitted writes.
+			m_pBatch = std::make_unique<rocksdb::WriteBatchWithIndex>(rocksdb::BytewiseComparator(), 0, true);
 		}
 	}
 
 	void OnEndWrite() final
 	{
-		m_pTransaction.reset();
+		m_pBatch.reset();
 	}
 
 private:
+	enum class EOperation
+	{
+		GET,
+		PUT,
+		WRITE
+	};
+
+	// Only time spent in RocksDB itself is observed. Puts into a pending batch are in-memory, so they're
+	// covered by the batch's write instead.
+	static Metrics::Histogram& GetLatencyHistogram(const EOperation operation)
+	{
+		static const std::string NAME = "grinpp_db_operation_seconds";
+		static const std::string HELP = "Time spent in RocksDB reads, unbatched puts, and batch writes.";
+		static Metrics::Histogram& getHistogram = Metrics::GetHistogram(NAME, HELP, "op=\"get\"");
+		static Metrics::Histogram& putHistogram = Metrics::GetHistogram(NAME, HELP, "op=\"put\"");
+		static Metrics::Histogram& writeHistogram = Metrics::GetHistogram(NAME, HELP, "op=\"write\"");
+
+		switch (operation)
+		{
+			case EOperation::GET:
+				return getHistogram;
+			case EOperation::PUT:
+				return putHistogram;
+			case EOperation::WRITE:
+				break;
+		}
+
+		return writeHistogram;
+	}
+
 	const RocksDBTable& GetTable(const std::string& name) const
 	{
 		for (const RocksDBTable& table : m_tables)
@@ -324,8 +343,19 @@ private:
 		throw DATABASE_EXCEPTION_F("Database table {} not found", name);
 	}
 
+	void Write(rocksdb::WriteBatch* pBatch)
+	{
+		Metrics::ScopedTimer timer(GetLatencyHistogram(EOperation::WRITE));
+		const rocksdb::Status status = m_pTransactionDB->GetBaseDB()->Write(rocksdb::WriteOptions(), pBatch);
+		if (!status.ok())
+		{
+			LOG_ERROR_F("DB::Write failed with error {}", status.getState());
+			throw DATABASE_EXCEPTION_F("DB::Write failed with error {}", status.getState());
+		}
+	}
+
 	std::shared_ptr<rocksdb::OptimisticTransactionDB> m_pTransactionDB;
 	std::vector<RocksDBTable> m_tables;
 
-	std::unique_ptr<rocksdb::Transaction> m_pTransaction;
+	std::unique_ptr<rocksdb::WriteBatchWithIndex> m_pBatch;
 };
\ No newline at end of file
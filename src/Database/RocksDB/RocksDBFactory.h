@@ -17,12 +17,19 @@ public:
 	//
     static std::unique_ptr<RocksDB> Open(const fs::path& dbPath, const std::vector<rocksdb::ColumnFamilyDescriptor>& tableNames)
     {
-		fs::create_directories(dbPath);
+		return Open(dbPath, tableNames, DefaultOptions());
+    }
 
-		rocksdb::Options options;
-		options.IncreaseParallelism();
-		options.create_if_missing = true;
-		options.compression = rocksdb::kNoCompression;
+	//
+	// tableNames - First table name is the default table, so must be empty
+	// options - DB-wide options. Per-table options come from the descriptors.
+	//
+    static std::unique_ptr<RocksDB> Open(
+		const fs::path& dbPath,
+		const std::vector<rocksdb::ColumnFamilyDescriptor>& tableNames,
+		const rocksdb::Options& options)
+    {
+		fs::create_directories(dbPath);
 
 		std::vector<rocksdb::ColumnFamilyDescriptor> columnDescriptors = CreateDescriptors(options, dbPath, tableNames);
 
@@ -39,6 +46,16 @@ public:
 		return std::make_unique<RocksDB>(std::shared_ptr<rocksdb::OptimisticTransactionDB>(pTransactionDB), tables);
     }
 
+	static rocksdb::Options DefaultOptions()
+	{
+		rocksdb::Options options;
+		options.IncreaseParallelism();
+		options.create_if_missing = true;
+		options.compression = rocksdb::kNoCompression;
+
+		return options;
+	}
+
 private:
 	static std::vector<rocksdb::ColumnFamilyDescriptor> CreateDescriptors(
 		const rocksdb::Options& options,
@@ -93,8 +110,6 @@ private:
 			}
 			else
 			{
-				rocksdb::ColumnFamilyOptions columnFamilyOptions;
-				columnFamilyOptions.OptimizeForPointLookup(1024); // TODO: Pass in options
 				rocksdb::ColumnFamilyHandle* pHandle;
 
 				rocksdb::Status status = pTxDB->GetBaseDB()->CreateColumnFamily(tableNames[i].options, tableNames[i].name, &pHandle);
@@ -1,22 +1,31 @@
 #include <Net/Servers/Server.h>
 #include <Common/Logger.h>
 #include <Net/Clients/HTTP/HTTPException.h>
+#include <Net/Util/HTTPUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <Common/Compat.h>
 
 #include <civetweb.h>
 
-std::shared_ptr<Server> Server::Create(const EServerType type, const std::optional<uint16_t>& port)
+std::shared_ptr<Server> Server::Create(const EServerType type, const std::optional<uint16_t>& port, const ServerOptions& options)
 {
 	std::string listenerAddr = type == EServerType::LOCAL ? "127.0.0.1" : "0.0.0.0";
 	std::string listeningPort = StringUtil::Format("{}:{}", listenerAddr, port.value_or(0));
 
+	const std::string numThreads = std::to_string(options.numThreads);
+	const std::string keepAliveTimeout = std::to_string(options.keepAliveTimeoutMs);
+	const std::string requestTimeout = std::to_string(options.requestTimeoutMs);
+	const std::string connectionQueue = std::to_string(options.connectionQueue);
+	const std::string listenBacklog = std::to_string(options.listenBacklog);
+
 	const char* pOptions[] = {
-		"num_threads", "10", // TODO: this could be a parameter or adjust it depending on the OS
+		"num_threads", numThreads.c_str(),
 		"listening_ports", listeningPort.c_str(),
-		"enable_keep_alive", "no",
-		"keep_alive_timeout_ms", "no",
-		"request_timeout_ms", "120000",
+		"enable_keep_alive", options.keepAlive ? "yes" : "no",
+		"keep_alive_timeout_ms", keepAliveTimeout.c_str(),
+		"request_timeout_ms", requestTimeout.c_str(),
+		"connection_queue", connectionQueue.c_str(),
+		"listen_backlog", listenBacklog.c_str(),
 		NULL
 	};
 
@@ -36,7 +45,7 @@ std::shared_ptr<Server> Server::Create(const EServerType type, const std::option
 		throw HTTP_EXCEPTION("mg_get_server_ports failed.");
 	}
 
-	return std::shared_ptr<Server>(new Server(pCivetContext, (uint16_t)ports.port));
+	return std::shared_ptr<Server>(new Server(pCivetContext, (uint16_t)ports.port, options));
 }
 
 Server::~Server()
@@ -54,5 +63,40 @@ Server::~Server()
 
 void Server::AddListener(const std::string& uri, mg_request_handler handler, void* pCallbackData) noexcept
 {
-	mg_set_request_handler(m_pContext, uri.c_str(), handler, pCallbackData);
+	auto iter = m_options.endpointLimits.find(uri);
+	if (iter == m_options.endpointLimits.end())
+	{
+		mg_set_request_handler(m_pContext, uri.c_str(), handler, pCallbackData);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_listenersMutex);
+	m_limitedListeners.push_back(std::make_unique<LimitedListener>(handler, pCallbackData, iter->second));
+	mg_set_request_handler(m_pContext, uri.c_str(), LimitedHandler, m_limitedListeners.back().get());
+}
+
+int Server::LimitedHandler(struct mg_connection* conn, void* pLimitedListener)
+{
+	LimitedListener* pListener = (LimitedListener*)pLimitedListener;
+	assert(pListener != nullptr);
+
+	if (pListener->numActive.fetch_add(1) >= pListener->maxActive)
+	{
+		pListener->numActive--;
+		return HTTPUtil::BuildServiceUnavailableResponse(conn, "Too many concurrent requests. Try again later.");
+	}
+
+	int status = 0;
+	try
+	{
+		status = pListener->handler(conn, pListener->pCallbackData);
+	}
+	catch (...)
+	{
+		pListener->numActive--;
+		throw;
+	}
+
+	pListener->numActive--;
+	return status;
 }
\ No newline at end of file
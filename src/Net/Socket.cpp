@@ -174,6 +174,7 @@ bool Socket::SendSync(const std::vector<uint8_t>& message, const bool incrementC
     }
 
     const size_t bytesWritten = asio::write(*m_pSocket, asio::buffer(message.data(), message.size()), m_errorCode);
+    RateCounter::AddBytesSent(bytesWritten);
     if (m_errorCode && m_errorCode.value() != EAGAIN && m_errorCode.value() != EWOULDBLOCK) {
         ThrowSocketException(m_errorCode);
     }
@@ -202,9 +203,10 @@ void Socket::SendAsync(const std::vector<uint8_t>& message)
     }
 }
 
-void Socket::HandleSent(const asio::error_code& ec, size_t)
+void Socket::HandleSent(const asio::error_code& ec, size_t bytes_transferred)
 {
     m_rateCounter.AddMessageSent();
+    RateCounter::AddBytesSent(bytes_transferred);
 
     if (!m_writeQueue.empty()) {
         m_writeQueue.pop_front();
@@ -242,7 +244,9 @@ std::vector<uint8_t> Socket::ReceiveSync(const size_t num_bytes, const bool incr
     size_t numTries = 0;
     size_t bytesRead = 0;
     while (numTries++ < 5) {
-        bytesRead += asio::read(*m_pSocket, asio::buffer(bytes.data() + bytesRead, num_bytes - bytesRead), m_errorCode);
+        const size_t bytesReadNow = asio::read(*m_pSocket, asio::buffer(bytes.data() + bytesRead, num_bytes - bytesRead), m_errorCode);
+        RateCounter::AddBytesReceived(bytesReadNow);
+        bytesRead += bytesReadNow;
         if (m_errorCode && m_errorCode.value() != EAGAIN && m_errorCode.value() != EWOULDBLOCK) {
             ThrowSocketException(m_errorCode);
         }
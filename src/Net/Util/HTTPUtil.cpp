@@ -4,9 +4,34 @@
 #include <Common/Util/StringUtil.h>
 #include <Core/Exceptions/DeserializationException.h>
 #include <Common/Compat.h>
+#include <Common/Logger.h>
 
 #include <civetweb.h>
 
+// Mirrors civetweb's keep-alive decision, so the Connection header matches what the server actually does.
+static const char* GetConnectionHeader(mg_connection* conn)
+{
+	const char* pKeepAlive = mg_get_option(mg_get_context(conn), "enable_keep_alive");
+	if (pKeepAlive == nullptr || std::string(pKeepAlive) != "yes")
+	{
+		return "close";
+	}
+
+	const char* pConnectionHeader = mg_get_header(conn, "Connection");
+	if (pConnectionHeader != nullptr)
+	{
+		return StringUtil::ToLower(pConnectionHeader).find("keep-alive") != std::string::npos ? "keep-alive" : "close";
+	}
+
+	const struct mg_request_info* req_info = mg_get_request_info(conn);
+	if (req_info == nullptr || req_info->http_version == nullptr || std::string(req_info->http_version) != "1.1")
+	{
+		return "close";
+	}
+
+	return "keep-alive";
+}
+
 // Strips away the base URI and any query strings.
 // Ex: Given "/v1/blocks/<hash>?compact" and baseURI "/v1/blocks/", this would return <hash>.
 std::string HTTPUtil::GetURIParam(mg_connection* conn, const std::string& baseURI)
@@ -148,7 +173,8 @@ int HTTPUtil::BuildSuccessResponse(mg_connection* conn, const std::string& respo
 		mg_printf(conn,
 			"HTTP/1.1 200 OK\r\n"
 			"Content-Length: 0\r\n"
-			"Connection: close\r\n\r\n");
+			"Connection: %s\r\n\r\n",
+			GetConnectionHeader(conn));
 	}
 	else
 	{
@@ -156,8 +182,9 @@ int HTTPUtil::BuildSuccessResponse(mg_connection* conn, const std::string& respo
 			"HTTP/1.1 200 OK\r\n"
 			"Content-Length: %lu\r\n"
 			"Content-Type: application/json\r\n"
-			"Connection: close\r\n\r\n",
-			len);
+			"Connection: %s\r\n\r\n",
+			len,
+			GetConnectionHeader(conn));
 	}
 
 	mg_write(conn, response.c_str(), len);
@@ -165,6 +192,91 @@ int HTTPUtil::BuildSuccessResponse(mg_connection* conn, const std::string& respo
 	return 200;
 }
 
+int HTTPUtil::BuildSuccessResponseBinary(mg_connection* conn, const std::vector<uint8_t>& response)
+{
+	assert(conn != nullptr);
+
+	unsigned long len = (unsigned long)response.size();
+
+	mg_printf(conn,
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Length: %lu\r\n"
+		"Content-Type: application/octet-stream\r\n"
+		"Connection: %s\r\n\r\n",
+		len,
+		GetConnectionHeader(conn));
+
+	mg_write(conn, response.data(), len);
+
+	return 200;
+}
+
+int HTTPUtil::BuildSuccessResponseText(mg_connection* conn, const std::string& response, const std::string& contentType)
+{
+	assert(conn != nullptr);
+
+	unsigned long len = (unsigned long)response.size();
+
+	mg_printf(conn,
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Length: %lu\r\n"
+		"Content-Type: %s\r\n"
+		"Connection: %s\r\n\r\n",
+		len,
+		contentType.c_str(),
+		GetConnectionHeader(conn));
+
+	mg_write(conn, response.c_str(), len);
+
+	return 200;
+}
+
+int HTTPUtil::BuildChunkedJSONResponse(
+	mg_connection* conn,
+	const std::function<void(JsonStreamWriter&)>& writeBody,
+	const std::vector<std::pair<std::string, std::string>>& headers)
+{
+	assert(conn != nullptr);
+
+	std::string extraHeaders;
+	for (const auto& header : headers)
+	{
+		extraHeaders += header.first + ": " + header.second + "\r\n";
+	}
+
+	mg_printf(conn,
+		"HTTP/1.1 200 OK\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Content-Type: application/json\r\n"
+		"%s"
+		"Connection: %s\r\n\r\n",
+		extraHeaders.c_str(),
+		GetConnectionHeader(conn));
+
+	try
+	{
+		JsonStreamWriter writer([conn](const std::string& chunk) {
+			if (mg_send_chunk(conn, chunk.c_str(), (unsigned int)chunk.size()) < 0)
+			{
+				throw HTTP_EXCEPTION("Failed to send chunk");
+			}
+		});
+
+		writeBody(writer);
+		writer.Flush();
+
+		// Zero-length chunk terminates the response
+		mg_send_chunk(conn, "", 0);
+	}
+	catch (std::exception& e)
+	{
+		// Without the terminating chunk, the client sees the response as incomplete.
+		LOG_ERROR_F("Aborting chunked response. Error: {}", e.what());
+	}
+
+	return 200;
+}
+
 int HTTPUtil::BuildBadRequestResponse(mg_connection* conn, const std::string& response)
 {
 	assert(conn != nullptr);
@@ -175,8 +287,9 @@ int HTTPUtil::BuildBadRequestResponse(mg_connection* conn, const std::string& re
 		"HTTP/1.1 400 Bad Request\r\n"
 		"Content-Length: %lu\r\n"
 		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
+		"Connection: %s\r\n\r\n",
+		len,
+		GetConnectionHeader(conn));
 
 	mg_write(conn, response.c_str(), len);
 
@@ -193,8 +306,9 @@ int HTTPUtil::BuildConflictResponse(mg_connection* conn, const std::string& resp
 		"HTTP/1.1 409 Conflict\r\n"
 		"Content-Length: %lu\r\n"
 		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
+		"Connection: %s\r\n\r\n",
+		len,
+		GetConnectionHeader(conn));
 
 	mg_write(conn, response.c_str(), len);
 
@@ -207,6 +321,7 @@ int HTTPUtil::BuildUnauthorizedResponse(mg_connection* conn, const std::string&
 
 	unsigned long len = (unsigned long)response.size();
 
+	// Clients that failed to authenticate aren't allowed to hold on to a connection.
 	mg_printf(conn,
 		"HTTP/1.1 401 Unauthorized\r\n"
 		"Content-Length: %lu\r\n"
@@ -219,6 +334,26 @@ int HTTPUtil::BuildUnauthorizedResponse(mg_connection* conn, const std::string&
 	return 401;
 }
 
+int HTTPUtil::BuildServiceUnavailableResponse(mg_connection* conn, const std::string& response)
+{
+	assert(conn != nullptr);
+
+	unsigned long len = (unsigned long)response.size();
+
+	mg_printf(conn,
+		"HTTP/1.1 503 Service Unavailable\r\n"
+		"Content-Length: %lu\r\n"
+		"Content-Type: text/plain\r\n"
+		"Retry-After: 1\r\n"
+		"Connection: %s\r\n\r\n",
+		len,
+		GetConnectionHeader(conn));
+
+	mg_write(conn, response.c_str(), len);
+
+	return 503;
+}
+
 int HTTPUtil::BuildNotFoundResponse(mg_connection* conn, const std::string& response)
 {
 	assert(conn != nullptr);
@@ -229,8 +364,9 @@ int HTTPUtil::BuildNotFoundResponse(mg_connection* conn, const std::string& resp
 		"HTTP/1.1 404 Not Found\r\n"
 		"Content-Length: %lu\r\n"
 		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
+		"Connection: %s\r\n\r\n",
+		len,
+		GetConnectionHeader(conn));
 
 	mg_write(conn, response.c_str(), len);
 
@@ -247,8 +383,9 @@ int HTTPUtil::BuildInternalErrorResponse(mg_connection* conn, const std::string&
 		"HTTP/1.1 500 Internal Server Error\r\n"
 		"Content-Length: %lu\r\n"
 		"Content-Type: text/plain\r\n"
-		"Connection: close\r\n\r\n",
-		len);
+		"Connection: %s\r\n\r\n",
+		len,
+		GetConnectionHeader(conn));
 
 	mg_write(conn, response.c_str(), len);
 
@@ -0,0 +1,106 @@
+#include <Net/Util/JsonStreamWriter.h>
+#include <Net/Clients/HTTP/HTTPException.h>
+
+JsonStreamWriter::JsonStreamWriter(const Sink& sink, const size_t chunkSize)
+	: m_sink(sink), m_chunkSize(chunkSize), m_awaitingValue(false)
+{
+	m_buffer.reserve(chunkSize);
+	m_builder["indentation"] = ""; // Removes whitespaces
+}
+
+void JsonStreamWriter::BeginObject()
+{
+	BeginValue();
+	m_scopes.push_back(Scope{ false, 0 });
+	Append("{");
+}
+
+void JsonStreamWriter::EndObject()
+{
+	if (m_scopes.empty() || m_scopes.back().isArray || m_awaitingValue)
+	{
+		throw HTTP_EXCEPTION("Unexpected end of object");
+	}
+
+	m_scopes.pop_back();
+	Append("}");
+}
+
+void JsonStreamWriter::BeginArray()
+{
+	BeginValue();
+	m_scopes.push_back(Scope{ true, 0 });
+	Append("[");
+}
+
+void JsonStreamWriter::EndArray()
+{
+	if (m_scopes.empty() || !m_scopes.back().isArray)
+	{
+		throw HTTP_EXCEPTION("Unexpected end of array");
+	}
+
+	m_scopes.pop_back();
+	Append("]");
+}
+
+void JsonStreamWriter::Key(const std::string& name)
+{
+	if (m_scopes.empty() || m_scopes.back().isArray || m_awaitingValue)
+	{
+		throw HTTP_EXCEPTION("Unexpected key: " + name);
+	}
+
+	if (m_scopes.back().numEntries++ > 0)
+	{
+		Append(",");
+	}
+
+	Append(Json::writeString(m_builder, Json::Value(name)));
+	Append(":");
+	m_awaitingValue = true;
+}
+
+void JsonStreamWriter::Write(const Json::Value& value)
+{
+	BeginValue();
+	Append(Json::writeString(m_builder, value));
+}
+
+void JsonStreamWriter::Flush()
+{
+	if (!m_buffer.empty())
+	{
+		m_sink(m_buffer);
+		m_buffer.clear();
+	}
+}
+
+void JsonStreamWriter::BeginValue()
+{
+	if (m_awaitingValue)
+	{
+		m_awaitingValue = false;
+	}
+	else if (!m_scopes.empty())
+	{
+		if (!m_scopes.back().isArray)
+		{
+			throw HTTP_EXCEPTION("Object members must have a key");
+		}
+
+		if (m_scopes.back().numEntries++ > 0)
+		{
+			Append(",");
+		}
+	}
+}
+
+void JsonStreamWriter::Append(const std::string& str)
+{
+	m_buffer.append(str);
+	if (m_buffer.size() >= m_chunkSize)
+	{
+		Flush();
+	}
+}
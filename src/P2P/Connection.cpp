@@ -8,10 +8,28 @@
 #include <Net/SocketException.h>
 #include <Common/Util/ThreadUtil.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
+#include <array>
 #include <thread>
 #include <chrono>
 #include <memory>
 
+// Span names must outlive the trace, so each message type's name is built once.
+static const char* GetSpanName(const MessageTypes::EMessageType messageType)
+{
+    static const std::array<std::string, MessageTypes::KernelSegment + 1> names = []() {
+        std::array<std::string, MessageTypes::KernelSegment + 1> result;
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            result[i] = "Connection::Process" + MessageTypes::ToString((MessageTypes::EMessageType)i);
+        }
+
+        return result;
+    }();
+
+    return (size_t)messageType < names.size() ? names[(size_t)messageType].c_str() : "Connection::ProcessUnknown";
+}
+
 void Connection::Connect()
 {
     std::thread connect_thr(Thread_Connect, shared_from_this());
@@ -84,8 +102,11 @@ void Connection::Thread_Connect(std::shared_ptr<Connection> pConnection)
         pConnection->GetSocket()->SetDefaultOptions();
         pConnection->GetSocket()->SetBlocking(true);
         
-        HandShake(pConnection->m_connectionManager, pConnection->m_pSyncStatus)
-            .PerformHandshake(pConnection->m_pSocket, pConnection->m_connectedPeer);
+        {
+            Tracing::Span span("Connection::Handshake");
+            HandShake(pConnection->m_connectionManager, pConnection->m_pSyncStatus)
+                .PerformHandshake(pConnection->m_pSocket, pConnection->m_connectedPeer);
+        }
 
         pConnection->m_lastPing = system_clock::now();
         pConnection->m_lastReceived = system_clock::now();
@@ -144,6 +165,7 @@ void Connection::HandleConnected(const asio::error_code& ec)
 void Connection::HandleReceivedHeader(const asio::error_code& ec, const size_t bytes_received)
 {
     std::unique_lock<std::mutex> write_lock(m_mutex);
+    RateCounter::AddBytesReceived(bytes_received);
 
     if (!ec && m_pSocket->IsOpen() && bytes_received == 11) {
         assert(m_received.size() == 11);
@@ -176,6 +198,7 @@ void Connection::HandleReceivedHeader(const asio::error_code& ec, const size_t b
 void Connection::HandleReceivedBody(MessageHeader msg_header, const asio::error_code& ec, const size_t bytes_received)
 {
     std::unique_lock<std::mutex> write_lock(m_mutex);
+    RateCounter::AddBytesReceived(bytes_received);
 
     if (!ec && m_pSocket->IsOpen() && bytes_received == msg_header.GetLength()) {
         assert(m_received.size() == msg_header.GetLength());
@@ -193,6 +216,7 @@ void Connection::HandleReceivedBody(MessageHeader msg_header, const asio::error_
 
             auto pMessageProcessor = m_pMessageProcessor.lock();
             if (pMessageProcessor != nullptr) {
+                Tracing::Span span(GetSpanName(type), "bytes", msg_header.GetLength());
                 RawMessage message(std::move(msg_header), std::move(m_received));
                 pMessageProcessor->ProcessMessage(shared_from_this(), message);
             }
@@ -40,6 +40,8 @@
 #include <Common/Util/FileUtil.h>
 #include <BlockChain/BlockChain.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <array>
 #include <thread>
 #include <fstream>
 
@@ -62,9 +64,29 @@ MessageProcessor::MessageProcessor(
 
 }
 
+static Metrics::Histogram& GetMessageHistogram(const EMessageType messageType)
+{
+    static const std::array<Metrics::Histogram*, KernelSegment + 1> histograms = []() {
+        std::array<Metrics::Histogram*, KernelSegment + 1> result;
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            result[i] = &Metrics::GetHistogram(
+                "grinpp_p2p_message_seconds",
+                "Time spent processing each type of received P2P message.",
+                "type=\"" + MessageTypes::ToString((EMessageType)i) + "\""
+            );
+        }
+
+        return result;
+    }();
+
+    return *histograms[(size_t)messageType < histograms.size() ? (size_t)messageType : (size_t)Error];
+}
+
 void MessageProcessor::ProcessMessage(const std::shared_ptr<Connection>& pConnection, const RawMessage& rawMessage)
 {
     const EMessageType messageType = rawMessage.GetMessageHeader().GetMessageType();
+    Metrics::ScopedTimer timer(GetMessageHistogram(messageType));
 
     try
     {
@@ -4,6 +4,7 @@
 
 #include <Common/Util/ThreadUtil.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <BlockChain/BlockChain.h>
 
 BlockPipe::BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain)
@@ -38,6 +39,7 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 		std::vector<BlockEntry> blocksToProcess = pipeline.m_blocksToProcess.copy_front(8); // TODO: Use number of CPU threads.
 		if (!blocksToProcess.empty())
 		{
+			Tracing::Span span("BlockPipe::ProcessBatch", "blocks", blocksToProcess.size());
 			if (blocksToProcess.size() == 1)
 			{
 				ProcessNewBlock(pipeline, blocksToProcess.front());
@@ -66,6 +68,8 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 
 void BlockPipe::ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntry)
 {
+	Tracing::Span span("BlockPipe::ProcessNewBlock", "height", blockEntry.m_block.GetHeight());
+
 	try
 	{
 		const EBlockChainStatus status = pipeline.m_pBlockChain->AddBlock(blockEntry.m_block);
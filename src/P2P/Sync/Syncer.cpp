@@ -6,6 +6,7 @@
 #include <BlockChain/BlockChain.h>
 #include <P2P/SyncStatus.h>
 #include <Common/Logger.h>
+#include <Common/Tracing.h>
 #include <Common/Util/ThreadUtil.h>
 #include <Core/Global.h>
 
@@ -65,7 +66,13 @@ void Syncer::Thread_Sync(Syncer& syncer)
 
             if (pStatus->GetNumActiveConnections() >= Global::GetConfig().GetMinSyncPeers()) {
                 // Sync Headers
-                if (headerSyncer.SyncHeaders(*pStatus, !headers_synced)) {
+                bool syncing_headers = false;
+                {
+                    Tracing::Span span("Syncer::SyncHeaders");
+                    syncing_headers = headerSyncer.SyncHeaders(*pStatus, !headers_synced);
+                }
+
+                if (syncing_headers) {
                     if (pStatus->GetStatus() != ESyncStatus::SYNCING_TXHASHSET && pStatus->GetStatus() != ESyncStatus::PROCESSING_TXHASHSET) {
                         pStatus->UpdateStatus(ESyncStatus::SYNCING_HEADERS);
                     }
@@ -75,12 +82,24 @@ void Syncer::Thread_Sync(Syncer& syncer)
                 }
 
                 // Sync State (TxHashSet)
-                if (stateSyncer.SyncState(*pStatus)) {
+                bool syncing_state = false;
+                {
+                    Tracing::Span span("Syncer::SyncState");
+                    syncing_state = stateSyncer.SyncState(*pStatus);
+                }
+
+                if (syncing_state) {
                     continue;
                 }
 
                 // Sync Blocks
-                if (blockSyncer.SyncBlocks(*pStatus, !blocks_synced)) {
+                bool syncing_blocks = false;
+                {
+                    Tracing::Span span("Syncer::SyncBlocks");
+                    syncing_blocks = blockSyncer.SyncBlocks(*pStatus, !blocks_synced);
+                }
+
+                if (syncing_blocks) {
                     pStatus->UpdateStatus(ESyncStatus::SYNCING_BLOCKS);
                     continue;
                 } else {
@@ -27,6 +27,11 @@ std::shared_ptr<PruneList> PruneList::Load(const fs::path& filePath)
 }
 
 void PruneList::Flush()
+{
+    Flush(m_filePath);
+}
+
+void PruneList::Flush(const fs::path& filePath)
 {
     // Run the optimization step on the bitmap.
     m_prunedRoots.runOptimize();
@@ -37,7 +42,7 @@ void PruneList::Flush()
         std::vector<unsigned char> buffer(size);
         m_prunedRoots.write((char*)buffer.data());
 
-        FileUtil::SafeWriteToFile(m_filePath, buffer);
+        FileUtil::SafeWriteToFile(filePath, buffer);
 
         // Rebuild our "shift caches" here as we are flushing changes to disk
         // and the contents of our prune_list has likely changed.
@@ -17,8 +17,16 @@ public:
 
 	static PruneList::Ptr Load(const fs::path& filePath);
 
+	// Returns an in-memory copy that can be modified without affecting this prune list.
+	PruneList::Ptr Copy() const { return PruneList::Ptr(new PruneList(*this)); }
+
 	void Flush();
 
+	// Writes the prune list to the given file instead of its own, e.g. to stage it before it replaces the original.
+	void Flush(const fs::path& filePath);
+
+	const fs::path& GetPath() const noexcept { return m_filePath; }
+
 	// Adds the node to the prune list.
 	// Compacts if pruning the node means a parent can get pruned as well.
 	void Add(const Index& mmrIndex);
@@ -9,12 +9,15 @@
 #include "MMRHashUtil.h"
 
 #include <Core/File/DataFile.h>
+#include <Core/File/FileSwap.h>
 #include <Roaring.h>
 #include <Core/Exceptions/TxHashSetException.h>
 #include <Core/Serialization/Serializer.h>
 #include <Core/Serialization/ByteBuffer.h>
 #include <Core/Traits/Lockable.h>
 #include <Common/Logger.h>
+#include <unordered_set>
+#include <vector>
 
 template<size_t DATA_SIZE, class DATA_TYPE>
 class PruneableMMR : public MMR, public Traits::IBatchable
@@ -28,7 +31,9 @@ public:
 		: m_pHashFile(pHashFile),
 		m_pLeafSet(pLeafSet),
 		m_pPruneList(pPruneList),
-		m_pDataFile(pDataFile)
+		m_pDataFile(pDataFile),
+		m_rewound(false),
+		m_numRewinds(0)
 	{
 
 	}
@@ -69,7 +74,12 @@ public:
 		SetDirty(true);
 
 		LeafIndex next_leaf = LeafIndex::At(num_leaves);
-		m_pHashFile->Rewind(next_leaf.GetPosition() - m_pPruneList->GetShift(next_leaf.GetIndex() - 1));
+		const uint64_t hashFileSize = next_leaf.GetPosition() - m_pPruneList->GetShift(next_leaf.GetIndex() - 1);
+		if (hashFileSize < m_pHashFile->GetSize()) {
+			m_rewound = true;
+		}
+
+		m_pHashFile->Rewind(hashFileSize);
 		m_pDataFile->Rewind(num_leaves - m_pPruneList->GetLeafShift(next_leaf.GetIndex() - 1));
 		m_pLeafSet->Rewind(num_leaves, leavesToAdd);
 	}
@@ -135,6 +145,159 @@ public:
 		return std::unique_ptr<DATA_TYPE>(nullptr);
 	}
 
+	//
+	// A compaction that prunes the leaves spent before the cutoff, except for those in leavesToKeep,
+	// which were spent in blocks that can still be rewound.
+	// It's planned against the committed MMR, then the compacted hash & data files and prune list are staged alongside the originals,
+	// and finally the staged files are swapped in. Only planning and swapping need the MMR to be locked.
+	//
+	class Compaction
+	{
+	public:
+		//
+		// Writes the compacted files. Only reads the part of the files that was committed when the compaction was planned,
+		// so this doesn't need any lock.
+		//
+		void Stage()
+		{
+			HashFile::StageCompaction(m_hashPath, m_keepHashes);
+			DataFile<DATA_SIZE>::StageCompaction(m_dataPath, m_keepData);
+			m_pPruneList->Flush(FileSwap::GetStagedPath(m_pruneListPath));
+		}
+
+		//
+		// The files that get replaced by their staged copies.
+		//
+		std::vector<fs::path> GetFiles() const { return { m_hashPath, m_dataPath, m_pruneListPath }; }
+
+	private:
+		friend class PruneableMMR;
+
+		Compaction(
+			PruneList::Ptr pPruneList,
+			std::vector<bool>&& keepHashes,
+			std::vector<bool>&& keepData,
+			const fs::path& hashPath,
+			const fs::path& dataPath,
+			const fs::path& pruneListPath,
+			const uint64_t numRewinds)
+			: m_pPruneList(pPruneList),
+			m_keepHashes(std::move(keepHashes)),
+			m_keepData(std::move(keepData)),
+			m_hashPath(hashPath),
+			m_dataPath(dataPath),
+			m_pruneListPath(pruneListPath),
+			m_numRewinds(numRewinds) { }
+
+		PruneList::Ptr m_pPruneList;
+		std::vector<bool> m_keepHashes;
+		std::vector<bool> m_keepData;
+		fs::path m_hashPath;
+		fs::path m_dataPath;
+		fs::path m_pruneListPath;
+		uint64_t m_numRewinds;
+	};
+
+	//
+	// Plans the compaction. Returns nullptr if there's nothing to prune.
+	// Must not be called while there are uncommitted changes.
+	//
+	std::unique_ptr<Compaction> PlanCompaction(const uint64_t cutoffLeaves, const std::unordered_set<uint64_t>& leavesToKeep) const
+	{
+		if (IsDirty()) {
+			throw TXHASHSET_EXCEPTION("Unable to compact MMR with uncommitted changes");
+		}
+
+		const uint64_t size = GetSize();
+
+		PruneList::Ptr pNewPruneList = m_pPruneList->Copy();
+		uint64_t numPruned = 0;
+		for (LeafIndex leaf_idx = LeafIndex::At(0); leaf_idx < cutoffLeaves && leaf_idx.GetPosition() < size; ++leaf_idx) {
+			if (m_pLeafSet->Contains(leaf_idx) || m_pPruneList->IsPruned(leaf_idx.GetIndex())) {
+				continue;
+			}
+
+			if (leavesToKeep.find(leaf_idx.Get()) == leavesToKeep.end()) {
+				pNewPruneList->Add(leaf_idx.GetIndex());
+				++numPruned;
+			}
+		}
+
+		if (numPruned == 0) {
+			return nullptr;
+		}
+
+		// Entries that were already compacted aren't in the files. Of the rest, keep everything not compacted by the new prune list.
+		std::vector<bool> keepHashes;
+		keepHashes.reserve(m_pHashFile->GetSize());
+		std::vector<bool> keepData;
+		keepData.reserve(m_pDataFile->GetSize());
+
+		for (Index mmr_idx = Index::At(0); mmr_idx < size; mmr_idx++) {
+			if (m_pPruneList->IsCompacted(mmr_idx)) {
+				continue;
+			}
+
+			const bool keep = !pNewPruneList->IsCompacted(mmr_idx);
+			keepHashes.push_back(keep);
+			if (mmr_idx.IsLeaf()) {
+				keepData.push_back(keep);
+			}
+		}
+
+		if (keepHashes.size() != m_pHashFile->GetSize() || keepData.size() != m_pDataFile->GetSize()) {
+			LOG_ERROR_F(
+				"MMR files don't match prune list. Hashes: {}/{}, Data: {}/{}",
+				keepHashes.size(), m_pHashFile->GetSize(), keepData.size(), m_pDataFile->GetSize()
+			);
+			throw TXHASHSET_EXCEPTION("MMR files don't match prune list");
+		}
+
+		LOG_INFO_F("Planned MMR compaction: pruning {} leaves", numPruned);
+
+		return std::unique_ptr<Compaction>(new Compaction(
+			pNewPruneList,
+			std::move(keepHashes),
+			std::move(keepData),
+			m_pHashFile->GetPath(),
+			m_pDataFile->GetPath(),
+			m_pPruneList->GetPath(),
+			m_numRewinds
+		));
+	}
+
+	//
+	// Completes the staged files with anything appended since the compaction was planned.
+	// Returns false if a rewind was committed since then, since the staged files may no longer match the MMR.
+	// Must not be called while there are uncommitted changes.
+	//
+	bool FinishCompaction(const Compaction& compaction) const
+	{
+		if (IsDirty()) {
+			throw TXHASHSET_EXCEPTION("Unable to compact MMR with uncommitted changes");
+		}
+
+		if (compaction.m_numRewinds != m_numRewinds) {
+			LOG_INFO("MMR was rewound since compaction was planned");
+			return false;
+		}
+
+		m_pHashFile->AppendToStaged(compaction.m_keepHashes.size());
+		m_pDataFile->AppendToStaged(compaction.m_keepData.size());
+		return true;
+	}
+
+	//
+	// Replaces the files with their finished, staged copies.
+	//
+	void SwapCompaction(const Compaction& compaction)
+	{
+		m_pHashFile->SwapStaged();
+		m_pDataFile->SwapStaged();
+		FileSwap::Swap(compaction.m_pruneListPath);
+		m_pPruneList = compaction.m_pPruneList;
+	}
+
 	void Commit() final
 	{
 		if (IsDirty())
@@ -144,6 +307,11 @@ public:
 			m_pDataFile->Commit();
 			m_pLeafSet->Commit();
 			SetDirty(false);
+
+			if (m_rewound) {
+				++m_numRewinds;
+				m_rewound = false;
+			}
 		}
 	}
 
@@ -156,6 +324,7 @@ public:
 			m_pDataFile->Rollback();
 			m_pLeafSet->Rollback();
 			SetDirty(false);
+			m_rewound = false;
 		}
 	}
 
@@ -164,4 +333,10 @@ private:
 	std::shared_ptr<LeafSet> m_pLeafSet;
 	std::shared_ptr<PruneList> m_pPruneList;
 	std::shared_ptr<DataFile<DATA_SIZE>> m_pDataFile;
+
+	// Whether the uncommitted changes remove anything that was there before.
+	bool m_rewound;
+
+	// Number of commits that included such a rewind, so compactions can tell whether the files changed under them.
+	uint64_t m_numRewinds;
 };
\ No newline at end of file
@@ -9,9 +9,15 @@
 #include <Common/Util/StringUtil.h>
 #include <BlockChain/BlockChain.h>
 #include <Database/BlockDb.h>
+#include <Database/DatabaseException.h>
+#include <Core/File/FileSwap.h>
 #include <Common/Logger.h>
 #include <P2P/SyncStatus.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <thread>
+#include <unordered_set>
 
 TxHashSet::TxHashSet(
 	std::shared_ptr<KernelMMR> pKernelMMR,
@@ -229,30 +235,144 @@ TxHashSetRoots TxHashSet::GetRoots(const std::shared_ptr<const IBlockDB>& pBlock
 	);
 }
 
+// An exception escaping a std::thread calls std::terminate, so workers store theirs to be rethrown once joined.
+static void RethrowFirst(const std::vector<std::exception_ptr>& errors)
+{
+	for (const std::exception_ptr& pError : errors)
+	{
+		if (pError != nullptr) {
+			std::rethrow_exception(pError);
+		}
+	}
+}
+
+//
+// Rebuilds the output positions of every unspent output in the output PMMR.
+// Headers are loaded and outputs are read from the PMMR in parallel, partitioned into
+// ranges of heights with roughly equal numbers of outputs. Each range is then written in a single WriteBatch.
+//
 void TxHashSet::SaveOutputPositions(const Chain::CPtr& pChain, std::shared_ptr<IBlockDB> pBlockDB) const
 {
-	LeafIndex leaf_idx = LeafIndex::At(0);
-	for (uint64_t height = 0; height <= m_pBlockHeader->GetHeight(); height++) {
-		auto pIndex = pChain->GetByHeight(height);
-		if (pIndex == nullptr) {
-			continue;
+	const uint64_t tipHeight = m_pBlockHeader->GetHeight();
+	const size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+	LOG_INFO_F("Saving output positions up to height {}", tipHeight);
+
+	// numOutputs[height] is the number of outputs in the MMR after the block at that height.
+	// A missing header is treated as a block without outputs, so its outputs are attributed to the next block.
+	std::vector<uint64_t> numOutputs(tipHeight + 1, 0);
+	std::vector<uint8_t> found(tipHeight + 1, 0);
+	{
+		std::atomic<uint64_t> nextHeight(0);
+		std::atomic_bool failed(false);
+		std::vector<std::exception_ptr> errors(numThreads);
+		auto loadHeaders = [&pChain, &pBlockDB, &numOutputs, &found, &nextHeight, &failed, &errors, tipHeight](const size_t threadIndex) {
+			try
+			{
+				static constexpr uint64_t HEADERS_PER_TASK = 1000;
+				for (uint64_t start = nextHeight.fetch_add(HEADERS_PER_TASK); start <= tipHeight && !failed; start = nextHeight.fetch_add(HEADERS_PER_TASK)) {
+					const uint64_t end = std::min(start + HEADERS_PER_TASK - 1, tipHeight);
+					for (uint64_t height = start; height <= end; height++) {
+						auto pIndex = pChain->GetByHeight(height);
+						if (pIndex == nullptr) {
+							continue;
+						}
+
+						auto pHeader = pBlockDB->GetBlockHeader(pIndex->GetHash());
+						if (pHeader != nullptr) {
+							numOutputs[height] = pHeader->GetNumOutputs();
+							found[height] = 1;
+						}
+					}
+				}
+			}
+			catch (...)
+			{
+				errors[threadIndex] = std::current_exception();
+				failed = true;
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < numThreads; i++) {
+			threads.emplace_back(std::thread(loadHeaders, i));
 		}
 
-		auto pHeader = pBlockDB->GetBlockHeader(pIndex->GetHash());
-		if (pHeader == nullptr) {
-			continue;
+		ThreadUtil::JoinAll(threads);
+		RethrowFirst(errors);
+	}
+
+	for (uint64_t height = 1; height <= tipHeight; height++) {
+		if (!found[height]) {
+			numOutputs[height] = numOutputs[height - 1];
 		}
+	}
 
-		while (leaf_idx < pHeader->GetNumOutputs()) {
-			std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(leaf_idx);
-			if (pOutput != nullptr) {
-				OutputLocation location(leaf_idx, pHeader->GetHeight());
-				pBlockDB->AddOutputPosition(pOutput->GetCommitment(), location);
+	// Split the heights into ranges of roughly equal numbers of outputs.
+	struct HeightRange
+	{
+		uint64_t first;
+		uint64_t last;
+	};
+
+	const uint64_t totalOutputs = numOutputs[tipHeight];
+	const uint64_t outputsPerRange = std::max<uint64_t>(totalOutputs / (numThreads * 8), 10'000);
+
+	std::vector<HeightRange> ranges;
+	uint64_t rangeStart = 0;
+	for (uint64_t height = 0; height <= tipHeight; height++) {
+		const uint64_t firstLeaf = rangeStart == 0 ? 0 : numOutputs[rangeStart - 1];
+		if (height == tipHeight || numOutputs[height] - firstLeaf >= outputsPerRange) {
+			ranges.push_back({ rangeStart, height });
+			rangeStart = height + 1;
+		}
+	}
+
+	std::vector<std::vector<std::pair<Commitment, OutputLocation>>> results(ranges.size());
+	{
+		std::atomic<size_t> nextRange(0);
+		std::atomic_bool failed(false);
+		std::vector<std::exception_ptr> errors(numThreads);
+		auto readOutputs = [this, &ranges, &results, &numOutputs, &nextRange, &failed, &errors](const size_t threadIndex) {
+			try
+			{
+				for (size_t i = nextRange++; i < ranges.size() && !failed; i = nextRange++) {
+					LeafIndex leaf_idx = LeafIndex::At(ranges[i].first == 0 ? 0 : numOutputs[ranges[i].first - 1]);
+					for (uint64_t height = ranges[i].first; height <= ranges[i].last; height++) {
+						while (leaf_idx < numOutputs[height]) {
+							std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(leaf_idx);
+							if (pOutput != nullptr) {
+								results[i].emplace_back(pOutput->GetCommitment(), OutputLocation(leaf_idx, height));
+							}
+
+							++leaf_idx;
+						}
+					}
+				}
 			}
+			catch (...)
+			{
+				errors[threadIndex] = std::current_exception();
+				failed = true;
+			}
+		};
 
-			++leaf_idx;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < numThreads; i++) {
+			threads.emplace_back(std::thread(readOutputs, i));
 		}
+
+		ThreadUtil::JoinAll(threads);
+		RethrowFirst(errors);
+	}
+
+	for (auto& rangeResults : results) {
+		pBlockDB->AddOutputPositions(rangeResults);
+		rangeResults.clear();
+		rangeResults.shrink_to_fit();
 	}
+
+	LOG_INFO("Finished saving output positions");
 }
 
 std::vector<Hash> TxHashSet::GetLastKernelHashes(const uint64_t numberOfKernels) const
@@ -386,7 +506,121 @@ void TxHashSet::Rollback() noexcept
 	m_pBlockHeader = m_pBlockHeaderBackup;
 }
 
-void TxHashSet::Compact()
+// Lists the files being swapped in by a compaction, so it can be completed if interrupted.
+static fs::path GetCompactionManifestPath(const fs::path& txHashSetPath)
+{
+	return txHashSetPath / "compaction.manifest";
+}
+
+void TxHashSet::Compact(std::shared_ptr<const IBlockDB> pBlockDB, const Chain::CPtr& pChain)
+{
+	ITxHashSetCompaction::UPtr pCompaction = PlanCompaction(pBlockDB, pChain);
+	if (pCompaction != nullptr) {
+		pCompaction->Stage();
+		ApplyCompaction(*pCompaction);
+	}
+}
+
+ITxHashSetCompaction::UPtr TxHashSet::PlanCompaction(std::shared_ptr<const IBlockDB> pBlockDB, const Chain::CPtr& pChain) const
+{
+	const uint64_t tipHeight = m_pBlockHeader->GetHeight();
+	const uint64_t horizon = Consensus::GetHorizonHeight(tipHeight);
+	if (horizon == 0 || horizon > pChain->GetHeight() || !pChain->IsOnChain(m_pBlockHeader)) {
+		return nullptr;
+	}
+
+	auto pHorizonHeader = pBlockDB->GetBlockHeader(pChain->GetHash(horizon));
+	if (pHorizonHeader == nullptr) {
+		LOG_WARNING_F("Header not found at horizon {}. Skipping compaction.", horizon);
+		return nullptr;
+	}
+
+	// Outputs spent above the horizon get restored when rewinding, so they can't be pruned yet.
+	std::unordered_set<uint64_t> leavesToKeep;
+	try
+	{
+		for (uint64_t height = horizon + 1; height <= tipHeight; height++) {
+			for (const auto& spent : pBlockDB->GetSpentPositions(pChain->GetHash(height))) {
+				leavesToKeep.insert(spent.second.GetLeafIndex().Get());
+			}
+		}
+	}
+	catch (DatabaseException& e)
+	{
+		LOG_WARNING_F("Spent positions unavailable above horizon. Skipping compaction. Error: {}", e.what());
+		return nullptr;
+	}
+
+	LOG_INFO_F("Planning TxHashSet compaction at horizon {}", horizon);
+
+	auto pOutputCompaction = m_pOutputPMMR->PlanCompaction(pHorizonHeader->GetNumOutputs(), leavesToKeep);
+	auto pRangeProofCompaction = m_pRangeProofPMMR->PlanCompaction(pHorizonHeader->GetNumOutputs(), leavesToKeep);
+	if (pOutputCompaction == nullptr && pRangeProofCompaction == nullptr) {
+		return nullptr;
+	}
+
+	return std::make_unique<TxHashSetCompaction>(
+		m_pOutputPMMR,
+		GetCompactionManifestPath(Global::GetConfig().GetTxHashSetPath()),
+		std::move(pOutputCompaction),
+		std::move(pRangeProofCompaction)
+	);
+}
+
+bool TxHashSet::ApplyCompaction(ITxHashSetCompaction& compaction)
+{
+	const TxHashSetCompaction& txHashSetCompaction = dynamic_cast<const TxHashSetCompaction&>(compaction);
+	const std::vector<fs::path> files = txHashSetCompaction.GetFiles();
+	const auto* pOutputCompaction = txHashSetCompaction.GetOutputCompaction();
+	const auto* pRangeProofCompaction = txHashSetCompaction.GetRangeProofCompaction();
+
+	if (!txHashSetCompaction.IsPlannedFor(m_pOutputPMMR)) {
+		LOG_WARNING("TxHashSet was replaced while compaction was staged. Discarding compaction.");
+		FileSwap::Discard(files);
+		return false;
+	}
+
+	try
+	{
+		const bool finished = (pOutputCompaction == nullptr || m_pOutputPMMR->FinishCompaction(*pOutputCompaction))
+			&& (pRangeProofCompaction == nullptr || m_pRangeProofPMMR->FinishCompaction(*pRangeProofCompaction));
+		if (!finished) {
+			LOG_WARNING("TxHashSet changed while compaction was staged. Discarding compaction.");
+			FileSwap::Discard(files);
+			return false;
+		}
+	}
+	catch (std::exception&)
+	{
+		FileSwap::Discard(files);
+		throw;
+	}
+
+	// All files are swapped as one. Once the manifest is written, an interrupted swap gets completed on startup.
+	FileSwap::Begin(txHashSetCompaction.GetManifestPath(), files);
+
+	if (pOutputCompaction != nullptr) {
+		m_pOutputPMMR->SwapCompaction(*pOutputCompaction);
+	}
+
+	if (pRangeProofCompaction != nullptr) {
+		m_pRangeProofPMMR->SwapCompaction(*pRangeProofCompaction);
+	}
+
+	FileSwap::End(txHashSetCompaction.GetManifestPath());
+
+	LOG_INFO("Finished compacting TxHashSet");
+	return true;
+}
+
+void TxHashSet::RecoverCompaction(const fs::path& txHashSetPath)
 {
-	// TODO: Implement
+	std::vector<fs::path> files;
+	for (const std::string mmr : { "output", "rangeproof" }) {
+		for (const std::string file : { "pmmr_hash.bin", "pmmr_data.bin", "pmmr_prun.bin" }) {
+			files.push_back(txHashSetPath / mmr / file);
+		}
+	}
+
+	FileSwap::Recover(GetCompactionManifestPath(txHashSetPath), files);
 }
\ No newline at end of file
@@ -9,6 +9,70 @@
 #include <shared_mutex>
 #include <string>
 
+class TxHashSetCompaction : public ITxHashSetCompaction
+{
+public:
+	TxHashSetCompaction(
+		const std::shared_ptr<const OutputPMMR>& pOutputPMMR,
+		const fs::path& manifestPath,
+		std::unique_ptr<OutputPMMR::Compaction>&& pOutputCompaction,
+		std::unique_ptr<RangeProofPMMR::Compaction>&& pRangeProofCompaction)
+		: m_pOutputPMMR(pOutputPMMR),
+		m_manifestPath(manifestPath),
+		m_pOutputCompaction(std::move(pOutputCompaction)),
+		m_pRangeProofCompaction(std::move(pRangeProofCompaction)) { }
+
+	void Stage() final
+	{
+		try
+		{
+			if (m_pOutputCompaction != nullptr) {
+				m_pOutputCompaction->Stage();
+			}
+
+			if (m_pRangeProofCompaction != nullptr) {
+				m_pRangeProofCompaction->Stage();
+			}
+		}
+		catch (std::exception&)
+		{
+			FileSwap::Discard(GetFiles());
+			throw;
+		}
+	}
+
+	std::vector<fs::path> GetFiles() const
+	{
+		std::vector<fs::path> files;
+		if (m_pOutputCompaction != nullptr) {
+			std::vector<fs::path> outputFiles = m_pOutputCompaction->GetFiles();
+			files.insert(files.end(), outputFiles.cbegin(), outputFiles.cend());
+		}
+
+		if (m_pRangeProofCompaction != nullptr) {
+			std::vector<fs::path> rangeProofFiles = m_pRangeProofCompaction->GetFiles();
+			files.insert(files.end(), rangeProofFiles.cbegin(), rangeProofFiles.cend());
+		}
+
+		return files;
+	}
+
+	// Whether the compaction was planned against the given MMR, rather than one that has since been replaced, e.g. by a resync.
+	bool IsPlannedFor(const std::shared_ptr<const OutputPMMR>& pOutputPMMR) const { return m_pOutputPMMR.lock() == pOutputPMMR; }
+
+	const fs::path& GetManifestPath() const noexcept { return m_manifestPath; }
+
+	// Either is null if that MMR has nothing to compact.
+	const OutputPMMR::Compaction* GetOutputCompaction() const noexcept { return m_pOutputCompaction.get(); }
+	const RangeProofPMMR::Compaction* GetRangeProofCompaction() const noexcept { return m_pRangeProofCompaction.get(); }
+
+private:
+	std::weak_ptr<const OutputPMMR> m_pOutputPMMR;
+	fs::path m_manifestPath;
+	std::unique_ptr<OutputPMMR::Compaction> m_pOutputCompaction;
+	std::unique_ptr<RangeProofPMMR::Compaction> m_pRangeProofCompaction;
+};
+
 class TxHashSet : public ITxHashSet
 {
 public:
@@ -39,7 +103,15 @@ public:
 	void Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& header) final;
 	void Commit() final;
 	void Rollback() noexcept final;
-	void Compact() final;
+	void Compact(std::shared_ptr<const IBlockDB> pBlockDB, const Chain::CPtr& pChain) final;
+	ITxHashSetCompaction::UPtr PlanCompaction(std::shared_ptr<const IBlockDB> pBlockDB, const Chain::CPtr& pChain) const final;
+	bool ApplyCompaction(ITxHashSetCompaction& compaction) final;
+
+	//
+	// Finishes swapping in an interrupted compaction, or discards one that was never swapped in.
+	// Must be called before the MMRs are loaded.
+	//
+	static void RecoverCompaction(const fs::path& txHashSetPath);
 
 	std::shared_ptr<KernelMMR> GetKernelMMR() { return m_pKernelMMR; }
 	std::shared_ptr<OutputPMMR> GetOutputPMMR() { return m_pOutputPMMR; }
@@ -22,6 +22,8 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::Open(const BlockHeaderPtr& pConfir
 {
 	Close();
 
+	TxHashSet::RecoverCompaction(Global::GetConfig().GetTxHashSetPath());
+
 	std::shared_ptr<KernelMMR> pKernelMMR;
 	std::shared_ptr<OutputPMMR> pOutputPMMR;
 	std::shared_ptr<RangeProofPMMR> pRangeProofPMMR;
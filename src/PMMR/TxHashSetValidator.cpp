@@ -10,11 +10,25 @@
 #include <Core/Validation/KernelSumValidator.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
+#include <Common/Tracing.h>
 #include <BlockChain/BlockChain.h>
 #include <thread>
 
+// Validation only runs once per state sync, so phases are looked up as they're needed.
+static Metrics::Histogram& GetPhaseHistogram(const std::string& phase)
+{
+	return Metrics::GetHistogram(
+		"grinpp_txhashset_validation_seconds",
+		"Time spent in each phase of validating a downloaded TxHashSet.",
+		"phase=\"" + phase + "\""
+	);
+}
+
 std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
 {
+	Tracing::Span validateSpan("TxHashSetValidator::Validate", "height", blockHeader.GetHeight());
+
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
 	std::shared_ptr<const OutputPMMR> pOutputPMMR = txHashSet.GetOutputPMMR();
 	std::shared_ptr<const RangeProofPMMR> pRangeProofPMMR = txHashSet.GetRangeProofPMMR();
@@ -29,17 +43,22 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	syncStatus.UpdateProcessingStatus(5);
 
 	// Validate MMR hashes in parallel
-	std::vector<std::thread> threads;
 	std::atomic_bool mmrHashesValidated = true;
-	threads.emplace_back(std::thread([this, pKernelMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pKernelMMR)) { mmrHashesValidated = false; }}));
-	threads.emplace_back(std::thread([this, pOutputPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pOutputPMMR)) { mmrHashesValidated = false; }}));
-	threads.emplace_back(std::thread([this, pRangeProofPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pRangeProofPMMR)) { mmrHashesValidated = false; }}));
-
-	for (auto& thread : threads)
 	{
-		if (thread.joinable())
+		Metrics::ScopedTimer timer(GetPhaseHistogram("mmr_hashes"));
+		Tracing::Span span("TxHashSetValidator::ValidateMMRHashes");
+
+		std::vector<std::thread> threads;
+		threads.emplace_back(std::thread([this, pKernelMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pKernelMMR)) { mmrHashesValidated = false; }}));
+		threads.emplace_back(std::thread([this, pOutputPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pOutputPMMR)) { mmrHashesValidated = false; }}));
+		threads.emplace_back(std::thread([this, pRangeProofPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pRangeProofPMMR)) { mmrHashesValidated = false; }}));
+
+		for (auto& thread : threads)
 		{
-			thread.join();
+			if (thread.joinable())
+			{
+				thread.join();
+			}
 		}
 	}
 
@@ -52,20 +71,28 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	syncStatus.UpdateProcessingStatus(10);
 
 	// Validate root for each MMR matches blockHeader
-	if (!txHashSet.ValidateRoots(blockHeader))
 	{
-		LOG_ERROR("Invalid MMR roots");
-		return std::unique_ptr<BlockSums>(nullptr);
+		Metrics::ScopedTimer timer(GetPhaseHistogram("roots"));
+		Tracing::Span span("TxHashSetValidator::ValidateRoots");
+		if (!txHashSet.ValidateRoots(blockHeader))
+		{
+			LOG_ERROR("Invalid MMR roots");
+			return std::unique_ptr<BlockSums>(nullptr);
+		}
 	}
 
 	syncStatus.UpdateProcessingStatus(15);
 
 	// Validate the full kernel history (kernel MMR root for every block header).
 	LOG_DEBUG("Validating kernel history");
-	if (!ValidateKernelHistory(*txHashSet.GetKernelMMR(), blockHeader, syncStatus))
 	{
-		LOG_ERROR("Invalid kernel history");
-		return std::unique_ptr<BlockSums>(nullptr);
+		Metrics::ScopedTimer timer(GetPhaseHistogram("kernel_history"));
+		Tracing::Span span("TxHashSetValidator::ValidateKernelHistory");
+		if (!ValidateKernelHistory(*txHashSet.GetKernelMMR(), blockHeader, syncStatus))
+		{
+			LOG_ERROR("Invalid kernel history");
+			return std::unique_ptr<BlockSums>(nullptr);
+		}
 	}
 
 	syncStatus.UpdateProcessingStatus(25);
@@ -77,6 +104,8 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	std::unique_ptr<BlockSums> pBlockSums = nullptr;
 	try
 	{
+		Metrics::ScopedTimer timer(GetPhaseHistogram("kernel_sums"));
+		Tracing::Span span("TxHashSetValidator::ValidateKernelSums");
 		pBlockSums = std::make_unique<BlockSums>(ValidateKernelSums(txHashSet, blockHeader));
 	}
 	catch (...)
@@ -90,10 +119,14 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	// Validate the rangeproof associated with each unspent output.
 	LOG_DEBUG("Validating range proofs");
 	LoggerAPI::Flush();
-	if (!ValidateRangeProofs(txHashSet, syncStatus))
 	{
-		LOG_ERROR("Failed to verify rangeproofs");
-		return std::unique_ptr<BlockSums>(nullptr);
+		Metrics::ScopedTimer timer(GetPhaseHistogram("rangeproofs"));
+		Tracing::Span span("TxHashSetValidator::ValidateRangeProofs");
+		if (!ValidateRangeProofs(txHashSet, syncStatus))
+		{
+			LOG_ERROR("Failed to verify rangeproofs");
+			return std::unique_ptr<BlockSums>(nullptr);
+		}
 	}
 
 	syncStatus.UpdateProcessingStatus(70);
@@ -101,10 +134,14 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	// Validate kernel signatures
 	LOG_DEBUG("Validating kernel signatures");
 	LoggerAPI::Flush();
-	if (!ValidateKernelSignatures(*txHashSet.GetKernelMMR(), syncStatus))
 	{
-		LOG_ERROR("Failed to verify kernel signatures");
-		return std::unique_ptr<BlockSums>(nullptr);
+		Metrics::ScopedTimer timer(GetPhaseHistogram("kernel_signatures"));
+		Tracing::Span span("TxHashSetValidator::ValidateKernelSignatures");
+		if (!ValidateKernelSignatures(*txHashSet.GetKernelMMR(), syncStatus))
+		{
+			LOG_ERROR("Failed to verify kernel signatures");
+			return std::unique_ptr<BlockSums>(nullptr);
+		}
 	}
 
 	LOG_DEBUG("Success");
@@ -141,6 +178,8 @@ bool TxHashSetValidator::ValidateSizes(TxHashSet& txHashSet, const BlockHeader&
 // TODO: This probably belongs in MMRHashUtil.
 bool TxHashSetValidator::ValidateMMRHashes(std::shared_ptr<const MMR> pMMR) const
 {
+	Tracing::Span span("TxHashSetValidator::HashMMR", "size", pMMR->GetSize());
+
 	try
     {
         const uint64_t size = pMMR->GetSize();
@@ -202,30 +241,38 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 	// Calculate overage
 	const int64_t overage = 0 - (Consensus::REWARD * (1 + blockHeader.GetHeight()));
 
-	// Determine output commitments
+	// Sum the output commitments, streaming them directly from the PMMR.
 	std::shared_ptr<const OutputPMMR> pOutputPMMR = txHashSet.GetOutputPMMR();
-	std::vector<Commitment> outputCommitments;
-	for (LeafIndex output_idx = LeafIndex::At(0); output_idx < blockHeader.GetNumOutputs(); output_idx++) {
-		std::unique_ptr<OutputIdentifier> pOutput = pOutputPMMR->GetAt(output_idx);
-		if (pOutput != nullptr) {
-			outputCommitments.push_back(pOutput->GetCommitment());
+	const Commitment outputSum = Crypto::AddCommitments(
+		blockHeader.GetNumOutputs(),
+		[&pOutputPMMR](const uint64_t leafIndex) -> std::optional<Commitment> {
+			std::unique_ptr<OutputIdentifier> pOutput = pOutputPMMR->GetAt(LeafIndex::At(leafIndex));
+			if (pOutput == nullptr) {
+				return std::nullopt;
+			}
+
+			return std::make_optional(pOutput->GetCommitment());
 		}
-	}
+	);
 
-	// Determine kernel excess commitments
+	// Sum the kernel excess commitments
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
-	std::vector<Commitment> excessCommitments;
-	for (LeafIndex kernel_idx = LeafIndex::At(0); kernel_idx < blockHeader.GetNumKernels(); kernel_idx++) {
-		std::unique_ptr<TransactionKernel> pKernel = pKernelMMR->GetKernelAt(kernel_idx);
-		if (pKernel != nullptr) {
-			excessCommitments.push_back(pKernel->GetExcessCommitment());
+	const Commitment excessSum = Crypto::AddCommitments(
+		blockHeader.GetNumKernels(),
+		[&pKernelMMR](const uint64_t leafIndex) -> std::optional<Commitment> {
+			std::unique_ptr<TransactionKernel> pKernel = pKernelMMR->GetKernelAt(LeafIndex::At(leafIndex));
+			if (pKernel == nullptr) {
+				return std::nullopt;
+			}
+
+			return std::make_optional(pKernel->GetExcessCommitment());
 		}
-	}
+	);
 
 	return KernelSumValidator::ValidateKernelSums(
 		std::vector<Commitment>(),
-		outputCommitments,
-		excessCommitments,
+		std::vector<Commitment>{ outputSum },
+		std::vector<Commitment>{ excessSum },
 		overage,
 		blockHeader.GetOffset(),
 		std::nullopt
@@ -235,6 +282,7 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& syncStatus) const
 {
 	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
+	std::vector<LeafIndex> leafIndices;
 
 	size_t i = 0;
 	LOG_INFO("BEGIN");
@@ -252,16 +300,18 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 			}
 
 			rangeProofs.emplace_back(std::make_pair(pOutput->GetCommitment(), *pRangeProof));
+			leafIndices.push_back(leaf_idx);
 			++i;
 
 			if (rangeProofs.size() >= 1000)
 			{
-				if (!Crypto::VerifyRangeProofs(rangeProofs))
+				if (!VerifyRangeProofBatch(rangeProofs, leafIndices))
 				{
 					return false;
 				}
 
 				rangeProofs.clear();
+				leafIndices.clear();
 
 				syncStatus.UpdateProcessingStatus((uint8_t)(40 + ((30.0 * leaf_idx.GetPosition()) / outputMMRSize)));
 			}
@@ -270,7 +320,7 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 
 	if (!rangeProofs.empty())
 	{
-		if (!Crypto::VerifyRangeProofs(rangeProofs))
+		if (!VerifyRangeProofBatch(rangeProofs, leafIndices))
 		{
 			return false;
 		}
@@ -280,9 +330,25 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 	return true;
 }
 
+bool TxHashSetValidator::VerifyRangeProofBatch(
+	const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs,
+	const std::vector<LeafIndex>& leafIndices) const
+{
+	Tracing::Span span("TxHashSetValidator::VerifyRangeProofBatch", "first_leaf", leafIndices.front().Get());
+
+	const std::vector<size_t> invalidProofs = Crypto::FindInvalidRangeProofs(rangeProofs);
+	for (const size_t index : invalidProofs)
+	{
+		LOG_ERROR_F("Invalid rangeproof for output {} at leaf index ({})", rangeProofs[index].first, leafIndices[index]);
+	}
+
+	return invalidProofs.empty();
+}
+
 bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, SyncStatus& syncStatus) const
 {
 	std::vector<TransactionKernel> kernels;
+	uint64_t firstLeafIndex = 0;
 
 	const uint64_t num_kernels = kernelMMR.GetNumKernels();
 	for (LeafIndex leaf_idx = LeafIndex::At(0); leaf_idx < num_kernels; leaf_idx++) {
@@ -291,10 +357,14 @@ bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, Sy
 			return false;
 		}
 
+		if (kernels.empty()) {
+			firstLeafIndex = leaf_idx.Get();
+		}
+
 		kernels.push_back(*pKernel);
 
 		if (kernels.size() >= 2000) {
-			if (!KernelSignatureValidator::BatchVerify(kernels)) {
+			if (!VerifyKernelSignatureBatch(kernels, firstLeafIndex)) {
 				return false;
 			}
 
@@ -304,9 +374,19 @@ bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, Sy
 		}
 	}
 
-	if (!KernelSignatureValidator::BatchVerify(kernels)) {
-		return false;
+	return VerifyKernelSignatureBatch(kernels, firstLeafIndex);
+}
+
+bool TxHashSetValidator::VerifyKernelSignatureBatch(const std::vector<TransactionKernel>& kernels, const uint64_t firstLeafIndex) const
+{
+	Tracing::Span span("TxHashSetValidator::VerifyKernelSignatureBatch", "first_leaf", firstLeafIndex);
+
+	// Kernels are read sequentially, so each kernel's leaf index is its offset from the start of the batch.
+	const std::vector<size_t> invalidKernels = KernelSignatureValidator::FindInvalid(kernels);
+	for (const size_t index : invalidKernels)
+	{
+		LOG_ERROR_F("Invalid signature for kernel {} at leaf index ({})", kernels[index].GetExcessCommitment(), firstLeafIndex + index);
 	}
 
-	return true;
-}
\ No newline at end of file
+	return invalidKernels.empty();
+}
@@ -2,6 +2,9 @@
 
 #include <Core/Models/BlockHeader.h>
 #include <Core/Models/BlockSums.h>
+#include <Core/Models/TransactionKernel.h>
+#include <Crypto/Models/RangeProof.h>
+#include <PMMR/Common/LeafIndex.h>
 #include <P2P/SyncStatus.h>
 #include "Common/HashFile.h"
 
@@ -44,10 +47,20 @@ private:
 		SyncStatus& syncStatus
 	) const;
 
+	bool VerifyRangeProofBatch(
+		const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs,
+		const std::vector<LeafIndex>& leafIndices
+	) const;
+
 	bool ValidateKernelSignatures(
 		const KernelMMR& kernelMMR,
 		SyncStatus& syncStatus
 	) const;
 
+	bool VerifyKernelSignatureBatch(
+		const std::vector<TransactionKernel>& kernels,
+		const uint64_t firstLeafIndex
+	) const;
+
 	const IBlockChain& m_blockChain;
 };
\ No newline at end of file
@@ -88,24 +88,20 @@ public:
     }
 };
 
-// fills buffer with EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
-// return siphash output for given edge
-template <int rotE = 21>
-static uint64_t sipblock(siphash_keys& keys, const word_t edge, uint64_t* buf)
+// return siphash output for given edge, from the raw outputs of its block (see SipHashLanes::SipBlocks)
+static uint64_t sipblock(const uint64_t* buf, const word_t edge)
 {
-    siphash_state<rotE> shs(keys);
-    word_t edge0 = edge & ~EDGE_BLOCK_MASK;
-    for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
-    {
-        shs.hash24(edge0 + i);
-        buf[i] = shs.xor_lanes();
-    }
-
     const uint64_t last = buf[EDGE_BLOCK_MASK];
-    for (uint32_t i = 0; i < EDGE_BLOCK_MASK; i++)
+    const word_t idx = edge & EDGE_BLOCK_MASK;
+
+    return idx == EDGE_BLOCK_MASK ? last : (buf[idx] ^ last);
+}
+
+// block start for each edge, so the blocks of a whole proof can be hashed together
+static void sipblock_starts(const word_t edges[PROOFSIZE], word_t starts[PROOFSIZE])
+{
+    for (uint32_t n = 0; n < PROOFSIZE; n++)
     {
-        buf[i] ^= last;
+        starts[n] = edges[n] & ~(word_t)EDGE_BLOCK_MASK;
     }
-
-    return buf[edge & EDGE_BLOCK_MASK];
-}
\ No newline at end of file
+}
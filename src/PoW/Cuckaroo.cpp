@@ -1,5 +1,6 @@
 #include "Cuckaroo.h"
 #include "Common.h"
+#include "SipHashLanes.h"
 
 #include <Crypto/Hasher.h>
 
@@ -7,7 +8,8 @@
 int verify_cuckaroo(const uint64_t edges[PROOFSIZE], siphash_keys& keys, const uint8_t edgeBits)
 {
     uint64_t xor0 = 0, xor1 = 0;
-    uint64_t sips[EDGE_BLOCK_SIZE];
+    uint64_t sips[PROOFSIZE][EDGE_BLOCK_SIZE];
+    word_t starts[PROOFSIZE];
     uint64_t uvs[2 * PROOFSIZE];
 
     // number of edges
@@ -25,8 +27,15 @@ int verify_cuckaroo(const uint64_t edges[PROOFSIZE], siphash_keys& keys, const u
         if (n && edges[n] <= edges[n - 1]) {
             return POW_TOO_SMALL;
         }
+    }
+
+    // hash the blocks of all proof edges together
+    sipblock_starts(edges, starts);
+    SipHashLanes::SipBlocks(keys, starts, PROOFSIZE, sips);
 
-        uint64_t edge = sipblock(keys, edges[n], sips);
+    for (uint32_t n = 0; n < PROOFSIZE; n++)
+    {
+        uint64_t edge = sipblock(sips[n], edges[n]);
         xor0 ^= uvs[2 * n] = edge & edgeMask;
         xor1 ^= uvs[2 * n + 1] = (edge >> 32) & edgeMask;
     }
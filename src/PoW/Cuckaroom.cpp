@@ -1,5 +1,6 @@
 #include "Cuckaroom.h"
 #include "Common.h"
+#include "SipHashLanes.h"
 
 #include <Crypto/Hasher.h>
 
@@ -15,32 +16,24 @@
 #define NODEMASK ((word_t)NNODES - 1)
 
 
-// fills buffer with EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
-// return siphash output for given edge
-uint64_t cuckaroom_sipblock(siphash_keys& keys, const word_t edge, uint64_t* buf)
+// return siphash output for given edge, from the raw outputs of its block (see SipHashLanes::SipBlocks)
+uint64_t cuckaroom_sipblock(const uint64_t* buf, const word_t edge)
 {
-	siphash_state<> shs(keys);
-	word_t edge0 = edge & ~EDGE_BLOCK_MASK;
-
-	for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
-	{
-		shs.hash24(edge0 + i);
-		buf[i] = shs.xor_lanes();
-	}
-
-	for (uint32_t i = EDGE_BLOCK_MASK; i; i--)
+	uint64_t hash = buf[EDGE_BLOCK_MASK];
+	for (uint32_t i = EDGE_BLOCK_MASK; i > (edge & EDGE_BLOCK_MASK); i--)
 	{
-		buf[i - 1] ^= buf[i];
+		hash ^= buf[i - 1];
 	}
 
-	return buf[edge & EDGE_BLOCK_MASK];
+	return hash;
 }
 
 // verify that edges are ascending and form a cycle in header-generated graph
 int verify_cuckaroom(const word_t edges[PROOFSIZE], siphash_keys& keys)
 {
 	word_t xorfrom = 0, xorto = 0;
-	uint64_t sips[EDGE_BLOCK_SIZE];
+	uint64_t sips[PROOFSIZE][EDGE_BLOCK_SIZE];
+	word_t starts[PROOFSIZE];
 	word_t from[PROOFSIZE], to[PROOFSIZE], visited[PROOFSIZE];
 
 	for (uint32_t n = 0; n < PROOFSIZE; n++)
@@ -52,8 +45,15 @@ int verify_cuckaroom(const word_t edges[PROOFSIZE], siphash_keys& keys)
 		if (n && edges[n] <= edges[n - 1]) {
 			return POW_TOO_SMALL;
 		}
+	}
+
+	// hash the blocks of all proof edges together
+	sipblock_starts(edges, starts);
+	SipHashLanes::SipBlocks(keys, starts, PROOFSIZE, sips);
 
-		uint64_t edge = cuckaroom_sipblock(keys, edges[n], sips);
+	for (uint32_t n = 0; n < PROOFSIZE; n++)
+	{
+		uint64_t edge = cuckaroom_sipblock(sips[n], edges[n]);
 		xorfrom ^= from[n] = edge & EDGEMASK;
 		xorto ^= to[n] = (edge >> 32) & EDGEMASK;
 		visited[n] = false;
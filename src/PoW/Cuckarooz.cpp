@@ -1,5 +1,6 @@
 #include "Cuckarooz.h"
 #include "Common.h"
+#include "SipHashLanes.h"
 
 #include <Crypto/Hasher.h>
 
@@ -14,31 +15,24 @@
 // used to mask siphash output
 #define NODEMASK ((word_t)NNODES - 1)
 
-// fills buffer with EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
-// return siphash output for given edge
-uint64_t cuckarooz_sipblock(siphash_keys& keys, const word_t edge, uint64_t* buf)
+// return siphash output for given edge, from the raw outputs of its block (see SipHashLanes::SipBlocks)
+uint64_t cuckarooz_sipblock(const uint64_t* buf, const word_t edge)
 {
-    siphash_state<> shs(keys);
-    word_t edge0 = edge & ~EDGE_BLOCK_MASK;
-    for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+    uint64_t hash = buf[EDGE_BLOCK_MASK];
+    for (uint32_t i = EDGE_BLOCK_MASK; i > (edge & EDGE_BLOCK_MASK); i--)
     {
-        shs.hash24(edge0 + i);
-        buf[i] = shs.xor_lanes();
+        hash ^= buf[i - 1];
     }
 
-    for (uint32_t i = EDGE_BLOCK_MASK; i; i--)
-    {
-        buf[i - 1] ^= buf[i];
-    }
-
-    return buf[edge & EDGE_BLOCK_MASK];
+    return hash;
 }
 
 // verify that edges are ascending and form a cycle in header-generated graph
 int verify_cuckarooz(const word_t edges[PROOFSIZE], siphash_keys& keys)
 {
     word_t xoruv = 0;
-    uint64_t sips[EDGE_BLOCK_SIZE];
+    uint64_t sips[PROOFSIZE][EDGE_BLOCK_SIZE];
+    word_t starts[PROOFSIZE];
     word_t uv[2 * PROOFSIZE];
 
     for (uint32_t n = 0; n < PROOFSIZE; n++)
@@ -50,8 +44,15 @@ int verify_cuckarooz(const word_t edges[PROOFSIZE], siphash_keys& keys)
         if (n && edges[n] <= edges[n - 1]) {
             return POW_TOO_SMALL;
         }
+    }
 
-        uint64_t edge = cuckarooz_sipblock(keys, edges[n], sips);
+    // hash the blocks of all proof edges together
+    sipblock_starts(edges, starts);
+    SipHashLanes::SipBlocks(keys, starts, PROOFSIZE, sips);
+
+    for (uint32_t n = 0; n < PROOFSIZE; n++)
+    {
+        uint64_t edge = cuckarooz_sipblock(sips[n], edges[n]);
         xoruv ^= uv[2 * n] = edge & NODEMASK;
         xoruv ^= uv[2 * n + 1] = (edge >> 32) & NODEMASK;
     }
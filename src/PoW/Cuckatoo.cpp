@@ -1,20 +1,13 @@
 #include "Cuckatoo.h"
 #include "Common.h"
+#include "SipHashLanes.h"
 
 #include <Crypto/Hasher.h>
 
-// generate edge endpoint in cuck(at)oo graph without partition bit
-word_t sipnode(siphash_keys* keys, word_t edge, uint32_t uorv, const word_t edgeMask)
-{
-    siphash_state v(*keys);
-    v.hash24(2 * edge + uorv);
-    return v.xor_lanes() & edgeMask;
-}
-
 // verify that edges are ascending and form a cycle in header-generated graph
 int verify_cuckatoo(const word_t edges[PROOFSIZE], siphash_keys* keys, const uint8_t edgeBits)
 {
-    word_t uvs[2 * PROOFSIZE], xor0, xor1;
+    word_t nonces[2 * PROOFSIZE], uvs[2 * PROOFSIZE], xor0, xor1;
     xor0 = xor1 = (PROOFSIZE / 2) & 1;
 
     // number of edges
@@ -33,8 +26,18 @@ int verify_cuckatoo(const word_t edges[PROOFSIZE], siphash_keys* keys, const uin
             return POW_TOO_SMALL;
         }
 
-        xor0 ^= uvs[2 * n] = sipnode(keys, edges[n], 0, edgeMask);
-        xor1 ^= uvs[2 * n + 1] = sipnode(keys, edges[n], 1, edgeMask);
+        // generate edge endpoints in cuck(at)oo graph without partition bit
+        nonces[2 * n] = 2 * edges[n];
+        nonces[2 * n + 1] = 2 * edges[n] + 1;
+    }
+
+    // hash the endpoints of all proof edges together
+    SipHashLanes::SipNodes(*keys, nonces, 2 * PROOFSIZE, uvs);
+
+    for (uint32_t n = 0; n < PROOFSIZE; n++)
+    {
+        xor0 ^= uvs[2 * n] &= edgeMask;
+        xor1 ^= uvs[2 * n + 1] &= edgeMask;
     }
 
     // optional check for obviously bad proofs
@@ -0,0 +1,281 @@
+#include "SipHashLanes.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIPHASH_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SIPHASH_NEON
+#include <arm_neon.h>
+#endif
+
+//
+// Scalar
+//
+template<int rotE>
+static void SipBlocksScalar(const siphash_keys& keys, const word_t* pBlockStarts, const size_t numBlocks, uint64_t (*pBuffers)[EDGE_BLOCK_SIZE])
+{
+	for (size_t b = 0; b < numBlocks; b++)
+	{
+		siphash_state<rotE> shs(keys);
+		for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+		{
+			shs.hash24(pBlockStarts[b] + i);
+			pBuffers[b][i] = shs.xor_lanes();
+		}
+	}
+}
+
+static void SipNodesScalar(const siphash_keys& keys, const word_t* pNonces, const size_t numNonces, uint64_t* pHashes)
+{
+	for (size_t n = 0; n < numNonces; n++)
+	{
+		siphash_state<> shs(keys);
+		shs.hash24(pNonces[n]);
+		pHashes[n] = shs.xor_lanes();
+	}
+}
+
+//
+// AVX2: 4 lanes
+//
+#ifdef SIPHASH_AVX2
+#define ROTL_AVX2(x, b) _mm256_or_si256(_mm256_slli_epi64(x, b), _mm256_srli_epi64(x, 64 - (b)))
+#define ROTL32_AVX2(x) _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1))
+#define SIPROUND_AVX2 \
+	v0 = _mm256_add_epi64(v0, v1); v2 = _mm256_add_epi64(v2, v3); v1 = ROTL_AVX2(v1, 13); \
+	v3 = ROTL_AVX2(v3, 16); v1 = _mm256_xor_si256(v1, v0); v3 = _mm256_xor_si256(v3, v2); \
+	v0 = ROTL32_AVX2(v0); v2 = _mm256_add_epi64(v2, v1); v0 = _mm256_add_epi64(v0, v3); \
+	v1 = ROTL_AVX2(v1, 17); v3 = ROTL_AVX2(v3, rotE); \
+	v1 = _mm256_xor_si256(v1, v2); v3 = _mm256_xor_si256(v3, v0); v2 = ROTL32_AVX2(v2);
+#define HASH24_AVX2(nonce) \
+	v3 = _mm256_xor_si256(v3, nonce); \
+	SIPROUND_AVX2 SIPROUND_AVX2 \
+	v0 = _mm256_xor_si256(v0, nonce); \
+	v2 = _mm256_xor_si256(v2, _mm256_set1_epi64x(0xff)); \
+	SIPROUND_AVX2 SIPROUND_AVX2 SIPROUND_AVX2 SIPROUND_AVX2
+#define XOR_LANES_AVX2 _mm256_xor_si256(_mm256_xor_si256(v0, v1), _mm256_xor_si256(v2, v3))
+
+template<int rotE>
+AVX2_TARGET static void SipBlocksAVX2(const siphash_keys& keys, const word_t* pBlockStarts, const size_t numBlocks, uint64_t (*pBuffers)[EDGE_BLOCK_SIZE])
+{
+	size_t b = 0;
+	for (; b + 4 <= numBlocks; b += 4)
+	{
+		__m256i v0 = _mm256_set1_epi64x((int64_t)keys.k0);
+		__m256i v1 = _mm256_set1_epi64x((int64_t)keys.k1);
+		__m256i v2 = _mm256_set1_epi64x((int64_t)keys.k2);
+		__m256i v3 = _mm256_set1_epi64x((int64_t)keys.k3);
+		__m256i nonce = _mm256_set_epi64x(
+			(int64_t)pBlockStarts[b + 3],
+			(int64_t)pBlockStarts[b + 2],
+			(int64_t)pBlockStarts[b + 1],
+			(int64_t)pBlockStarts[b]
+		);
+		const __m256i one = _mm256_set1_epi64x(1);
+
+		alignas(32) uint64_t hashes[4];
+		for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+		{
+			HASH24_AVX2(nonce)
+			_mm256_store_si256((__m256i*)hashes, XOR_LANES_AVX2);
+			pBuffers[b][i] = hashes[0];
+			pBuffers[b + 1][i] = hashes[1];
+			pBuffers[b + 2][i] = hashes[2];
+			pBuffers[b + 3][i] = hashes[3];
+
+			nonce = _mm256_add_epi64(nonce, one);
+		}
+	}
+
+	SipBlocksScalar<rotE>(keys, pBlockStarts + b, numBlocks - b, pBuffers + b);
+}
+
+AVX2_TARGET static void SipNodesAVX2(const siphash_keys& keys, const word_t* pNonces, const size_t numNonces, uint64_t* pHashes)
+{
+	constexpr int rotE = 21;
+
+	size_t n = 0;
+	for (; n + 4 <= numNonces; n += 4)
+	{
+		__m256i v0 = _mm256_set1_epi64x((int64_t)keys.k0);
+		__m256i v1 = _mm256_set1_epi64x((int64_t)keys.k1);
+		__m256i v2 = _mm256_set1_epi64x((int64_t)keys.k2);
+		__m256i v3 = _mm256_set1_epi64x((int64_t)keys.k3);
+		const __m256i nonce = _mm256_loadu_si256((const __m256i*)(pNonces + n));
+
+		HASH24_AVX2(nonce)
+		_mm256_storeu_si256((__m256i*)(pHashes + n), XOR_LANES_AVX2);
+	}
+
+	SipNodesScalar(keys, pNonces + n, numNonces - n, pHashes + n);
+}
+
+static bool HasAVX2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+
+	// AVX2 also requires the OS to save the YMM registers.
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+//
+// NEON: 2 lanes
+//
+#ifdef SIPHASH_NEON
+#define ROTL_NEON(x, b) vorrq_u64(vshlq_n_u64(x, b), vshrq_n_u64(x, 64 - (b)))
+#define ROTL32_NEON(x) vreinterpretq_u64_u32(vrev64q_u32(vreinterpretq_u32_u64(x)))
+#define SIPROUND_NEON \
+	v0 = vaddq_u64(v0, v1); v2 = vaddq_u64(v2, v3); v1 = ROTL_NEON(v1, 13); \
+	v3 = ROTL_NEON(v3, 16); v1 = veorq_u64(v1, v0); v3 = veorq_u64(v3, v2); \
+	v0 = ROTL32_NEON(v0); v2 = vaddq_u64(v2, v1); v0 = vaddq_u64(v0, v3); \
+	v1 = ROTL_NEON(v1, 17); v3 = ROTL_NEON(v3, rotE); \
+	v1 = veorq_u64(v1, v2); v3 = veorq_u64(v3, v0); v2 = ROTL32_NEON(v2);
+#define HASH24_NEON(nonce) \
+	v3 = veorq_u64(v3, nonce); \
+	SIPROUND_NEON SIPROUND_NEON \
+	v0 = veorq_u64(v0, nonce); \
+	v2 = veorq_u64(v2, vdupq_n_u64(0xff)); \
+	SIPROUND_NEON SIPROUND_NEON SIPROUND_NEON SIPROUND_NEON
+#define XOR_LANES_NEON veorq_u64(veorq_u64(v0, v1), veorq_u64(v2, v3))
+
+template<int rotE>
+static void SipBlocksNEON(const siphash_keys& keys, const word_t* pBlockStarts, const size_t numBlocks, uint64_t (*pBuffers)[EDGE_BLOCK_SIZE])
+{
+	size_t b = 0;
+	for (; b + 2 <= numBlocks; b += 2)
+	{
+		uint64x2_t v0 = vdupq_n_u64(keys.k0);
+		uint64x2_t v1 = vdupq_n_u64(keys.k1);
+		uint64x2_t v2 = vdupq_n_u64(keys.k2);
+		uint64x2_t v3 = vdupq_n_u64(keys.k3);
+		const uint64_t starts[2] = { pBlockStarts[b], pBlockStarts[b + 1] };
+		uint64x2_t nonce = vld1q_u64(starts);
+		const uint64x2_t one = vdupq_n_u64(1);
+
+		for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+		{
+			HASH24_NEON(nonce)
+			const uint64x2_t hashes = XOR_LANES_NEON;
+			pBuffers[b][i] = vgetq_lane_u64(hashes, 0);
+			pBuffers[b + 1][i] = vgetq_lane_u64(hashes, 1);
+
+			nonce = vaddq_u64(nonce, one);
+		}
+	}
+
+	SipBlocksScalar<rotE>(keys, pBlockStarts + b, numBlocks - b, pBuffers + b);
+}
+
+static void SipNodesNEON(const siphash_keys& keys, const word_t* pNonces, const size_t numNonces, uint64_t* pHashes)
+{
+	constexpr int rotE = 21;
+
+	size_t n = 0;
+	for (; n + 2 <= numNonces; n += 2)
+	{
+		uint64x2_t v0 = vdupq_n_u64(keys.k0);
+		uint64x2_t v1 = vdupq_n_u64(keys.k1);
+		uint64x2_t v2 = vdupq_n_u64(keys.k2);
+		uint64x2_t v3 = vdupq_n_u64(keys.k3);
+		const uint64x2_t nonce = vld1q_u64((const uint64_t*)(pNonces + n));
+
+		HASH24_NEON(nonce)
+		vst1q_u64((uint64_t*)(pHashes + n), XOR_LANES_NEON);
+	}
+
+	SipNodesScalar(keys, pNonces + n, numNonces - n, pHashes + n);
+}
+#endif
+
+enum class ESipHashImpl { SCALAR, AVX2, NEON };
+
+static ESipHashImpl SelectImplementation()
+{
+#if defined(SIPHASH_AVX2)
+	if (HasAVX2()) {
+		return ESipHashImpl::AVX2;
+	}
+#elif defined(SIPHASH_NEON)
+	return ESipHashImpl::NEON;
+#endif
+
+	return ESipHashImpl::SCALAR;
+}
+
+static ESipHashImpl GetImpl()
+{
+	static const ESipHashImpl impl = SelectImplementation();
+	return impl;
+}
+
+template<int rotE>
+void SipHashLanes::SipBlocks(const siphash_keys& keys, const word_t* pBlockStarts, const size_t numBlocks, uint64_t (*pBuffers)[EDGE_BLOCK_SIZE])
+{
+	switch (GetImpl())
+	{
+#if defined(SIPHASH_AVX2)
+		case ESipHashImpl::AVX2:
+			return SipBlocksAVX2<rotE>(keys, pBlockStarts, numBlocks, pBuffers);
+#elif defined(SIPHASH_NEON)
+		case ESipHashImpl::NEON:
+			return SipBlocksNEON<rotE>(keys, pBlockStarts, numBlocks, pBuffers);
+#endif
+		default:
+			return SipBlocksScalar<rotE>(keys, pBlockStarts, numBlocks, pBuffers);
+	}
+}
+
+template void SipHashLanes::SipBlocks<21>(const siphash_keys&, const word_t*, const size_t, uint64_t (*)[EDGE_BLOCK_SIZE]);
+template void SipHashLanes::SipBlocks<25>(const siphash_keys&, const word_t*, const size_t, uint64_t (*)[EDGE_BLOCK_SIZE]);
+
+void SipHashLanes::SipNodes(const siphash_keys& keys, const word_t* pNonces, const size_t numNonces, uint64_t* pHashes)
+{
+	switch (GetImpl())
+	{
+#if defined(SIPHASH_AVX2)
+		case ESipHashImpl::AVX2:
+			return SipNodesAVX2(keys, pNonces, numNonces, pHashes);
+#elif defined(SIPHASH_NEON)
+		case ESipHashImpl::NEON:
+			return SipNodesNEON(keys, pNonces, numNonces, pHashes);
+#endif
+		default:
+			return SipNodesScalar(keys, pNonces, numNonces, pHashes);
+	}
+}
+
+const char* SipHashLanes::GetImplementation()
+{
+	switch (GetImpl())
+	{
+		case ESipHashImpl::AVX2:
+			return "avx2";
+		case ESipHashImpl::NEON:
+			return "neon";
+		default:
+			return "scalar";
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+
+//
+// Computes many independent siphash-2-4 chains side by side, using AVX2 (4 lanes) or NEON (2 lanes) when available.
+// The implementation is selected once at runtime, falling back to the scalar siphash_state on other CPUs.
+//
+class SipHashLanes
+{
+public:
+	//
+	// For each block start (an edge with the low EDGE_BLOCK_BITS cleared), fills the corresponding buffer with the
+	// EDGE_BLOCK_SIZE chained siphash outputs used by the cuckaroo family. Outputs are not xored together,
+	// since each cuckaroo variant combines them differently.
+	//
+	template<int rotE = 21>
+	static void SipBlocks(
+		const siphash_keys& keys,
+		const word_t* pBlockStarts,
+		const size_t numBlocks,
+		uint64_t (*pBuffers)[EDGE_BLOCK_SIZE]
+	);
+
+	//
+	// Hashes each nonce starting from the initial key state, as used by cuckatoo's sipnode.
+	//
+	static void SipNodes(
+		const siphash_keys& keys,
+		const word_t* pNonces,
+		const size_t numNonces,
+		uint64_t* pHashes
+	);
+
+	//
+	// Returns "avx2", "neon" or "scalar", depending on which implementation this CPU uses.
+	//
+	static const char* GetImplementation();
+};
@@ -7,6 +7,7 @@
 #include <json/json.h>
 #include <BlockChain/BlockChain.h>
 #include <Database/BlockDb.h>
+#include <algorithm>
 
 int ChainAPI::GetChain_Handler(struct mg_connection* conn, void* pNodeContext)
 {
@@ -34,6 +35,13 @@ int ChainAPI::GetChain_Handler(struct mg_connection* conn, void* pNodeContext)
 	return HTTPUtil::BuildInternalErrorResponse(conn, "Failed to find tip.");
 }
 
+// Number of blocks read from the chain at a time while streaming outputs.
+static const uint64_t OUTPUTS_BY_HEIGHT_BATCH_SIZE = 16;
+
+// get chain/outputs/byheight?start_height=1&end_height=100[&max=50]
+//
+// The response is streamed, so memory use doesn't depend on the size of the range.
+// When 'max' cuts the range short, the X-Next-Start-Height header gives the start_height of the next page.
 int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void* pNodeContext)
 {
 	NodeContext* pServer = (NodeContext*)pNodeContext;
@@ -42,6 +50,7 @@ int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void*
 	{
 		uint64_t startHeight = 0;
 		uint64_t endHeight = 0;
+		uint64_t maxBlocks = 0;
 		const std::string queryString = HTTPUtil::GetQueryString(conn);
 		if (!queryString.empty())
 		{
@@ -68,54 +77,73 @@ int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void*
 
 					endHeight = std::stoull(endHeightTokens[1]);
 				}
+				else if (StringUtil::StartsWith(token, "max="))
+				{
+					std::vector<std::string> maxTokens = StringUtil::Split(token, "=");
+					if (maxTokens.size() != 2)
+					{
+						return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/chain/outputs/byheight?start_height=1&end_height=100&max=50");
+					}
+
+					maxBlocks = std::stoull(maxTokens[1]);
+				}
 			}
 		}
 
+		// Validated before the headers are sent, since errors can't be reported once streaming starts.
+		IBlockChain::Ptr pBlockChain = pServer->m_pBlockChain;
+		const uint64_t tipHeight = pBlockChain->GetHeight(EChainType::CONFIRMED);
+		if (startHeight > tipHeight)
+		{
+			return HTTPUtil::BuildBadRequestResponse(conn, "start_height is beyond the chain tip");
+		}
+
 		if (endHeight == 0 || endHeight < startHeight)
 		{
 			endHeight = startHeight;
 		}
 
-		Json::Value json;
+		endHeight = (std::min)(endHeight, tipHeight);
 
-		std::vector<BlockWithOutputs> blocksWithOutputs = pServer->m_pBlockChain->GetOutputsByHeight(startHeight, endHeight);
-		for (const BlockWithOutputs& block : blocksWithOutputs)
+		std::vector<std::pair<std::string, std::string>> headers;
+		if (maxBlocks > 0 && (endHeight - startHeight) >= maxBlocks)
 		{
-			/*
-
-			"header": {
-			  "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
-			  "height": 0,
-			  "previous": "0000000000000000000000000000000000000000000000000000000000000000"
-			},
-			"outputs": [
-			  {
-				"output_type": "Coinbase",
-				"commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
-				"spent": false,
-				"proof": null,
-				"proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
-				"block_height": 0,
-				"merkle_proof": "00000000000000010000000000000000",
-				"mmr_index": 1
-			  }
-			]
-			*/
-			Json::Value blockJSON;
-			blockJSON["header"] = block.GetBlockIdentifier().ToJSON();
-
-			Json::Value outputsJSON;
-			for (const OutputDTO& output : block.GetOutputs())
+			endHeight = startHeight + maxBlocks - 1;
+			headers.push_back({ "X-Next-Start-Height", std::to_string(endHeight + 1) });
+		}
+
+		return HTTPUtil::BuildChunkedJSONResponse(conn, [pBlockChain, startHeight, endHeight](JsonStreamWriter& writer) {
+			writer.BeginArray();
+
+			// The chain is only locked while each batch is read, never while writing to the client.
+			for (uint64_t height = startHeight; height <= endHeight; height += OUTPUTS_BY_HEIGHT_BATCH_SIZE)
 			{
-				outputsJSON.append(output.ToJSON());
-			}
+				const uint64_t batchEnd = (std::min)(height + OUTPUTS_BY_HEIGHT_BATCH_SIZE - 1, endHeight);
+				const std::vector<BlockWithOutputs> blocksWithOutputs = pBlockChain->GetOutputsByHeight(height, batchEnd);
+				for (const BlockWithOutputs& block : blocksWithOutputs)
+				{
+					writer.BeginObject();
+					writer.WriteMember("header", block.GetBlockIdentifier().ToJSON());
 
-			blockJSON["outputs"] = outputsJSON;
+					writer.Key("outputs");
+					writer.BeginArray();
+					for (const OutputDTO& output : block.GetOutputs())
+					{
+						writer.Write(output.ToJSON());
+					}
+					writer.EndArray();
 
-			json.append(blockJSON);
-		}
+					writer.EndObject();
+				}
+
+				if (batchEnd == endHeight)
+				{
+					break;
+				}
+			}
 
-		return HTTPUtil::BuildSuccessResponse(conn, json.toStyledString());
+			writer.EndArray();
+		}, headers);
 	}
 	catch (std::exception& e)
 	{
@@ -3,6 +3,9 @@
 
 #include <Net/Util/HTTPUtil.h>
 #include <P2P/Common.h>
+#include <Common/Metrics.h>
+#include <Common/Tracing.h>
+#include <Common/Logger.h>
 #include <json/json.h>
 
 /*
@@ -33,11 +36,15 @@ int ServerAPI::V1_Handler(struct mg_connection* conn, void*)
 		json.append("GET /v1/chain/");
 		json.append("GET /v1/chain/outputs/byids?id=xxx,yyy&id=zzz");
 		json.append("GET /v1/chain/outputs/byheight?start_height=100&end_height=200");
+		json.append("GET /v1/metrics");
 		json.append("GET /v1/peers/all");
 		json.append("GET /v1/peers/connected");
 		json.append("GET /v1/peers/a.b.c.d");
 		json.append("POST /v1/peers/ban?a.b.c.d");
 		json.append("POST /v1/peers/unban?a.b.c.d");
+		json.append("GET /v1/trace");
+		json.append("POST /v1/trace/start");
+		json.append("POST /v1/trace/stop");
 		json.append("GET /v1/txhashset/roots");
 		json.append("GET /v1/txhashset/lastkernels?n=###");
 		json.append("GET /v1/txhashset/lastoutputs?n=###");
@@ -139,4 +146,48 @@ int ServerAPI::ResyncChain_Handler(struct mg_connection* conn, void* pNodeContex
 	pServer->m_pP2PServer->UnbanAllPeers();
 
 	return HTTPUtil::BuildSuccessResponse(conn, "");
-}
\ No newline at end of file
+}
+
+int ServerAPI::GetMetrics_Handler(struct mg_connection* conn, void*)
+{
+	if (HTTPUtil::GetHTTPMethod(conn) != HTTP::EHTTPMethod::GET)
+	{
+		return HTTPUtil::BuildNotFoundResponse(conn, "Not Found");
+	}
+
+	return HTTPUtil::BuildSuccessResponseText(conn, Metrics::ExportPrometheus(), "text/plain; version=0.0.4");
+}
+
+//
+// Starts or stops recording tracing spans, or retrieves the recorded spans.
+// The trace can be opened in chrome://tracing or ui.perfetto.dev.
+//
+// APIs:
+// GET /v1/trace
+// POST /v1/trace/start
+// POST /v1/trace/stop
+//
+int ServerAPI::Trace_Handler(struct mg_connection* conn, void*)
+{
+	const HTTP::EHTTPMethod method = HTTPUtil::GetHTTPMethod(conn);
+	const std::string command = HTTPUtil::GetURIParam(conn, "/v1/trace");
+
+	if (command.empty() && method == HTTP::EHTTPMethod::GET)
+	{
+		return HTTPUtil::BuildSuccessResponse(conn, Tracing::ExportChromeJSON());
+	}
+	else if (command == "/start" && method == HTTP::EHTTPMethod::POST)
+	{
+		LOG_INFO("Tracing started");
+		Tracing::SetEnabled(true);
+		return HTTPUtil::BuildSuccessResponse(conn, "");
+	}
+	else if (command == "/stop" && method == HTTP::EHTTPMethod::POST)
+	{
+		Tracing::SetEnabled(false);
+		LOG_INFO("Tracing stopped");
+		return HTTPUtil::BuildSuccessResponse(conn, "");
+	}
+
+	return HTTPUtil::BuildNotFoundResponse(conn, "Not Found");
+}
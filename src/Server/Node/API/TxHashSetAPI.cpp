@@ -5,6 +5,7 @@
 #include <Common/Util/StringUtil.h>
 #include <Crypto/Hasher.h>
 #include <json/json.h>
+#include <algorithm>
 
 /*
   "get txhashset/roots",
@@ -172,7 +173,32 @@ int TxHashSetAPI::GetLastRangeproofs_Handler(struct mg_connection* conn, void* p
 	return HTTPUtil::BuildInternalErrorResponse(conn, "Failed to find TxHashSet.");
 }
 
+// Upper bound for 'max'. Responses are streamed, so this only limits how long a single request can run.
+static const uint64_t MAX_OUTPUTS_PER_REQUEST = 10000;
+
+// Number of outputs read from the TxHashSet at a time.
+static const uint64_t OUTPUTS_PAGE_SIZE = 100;
+
+static Json::Value BuildOutputJSON(const OutputDTO& info)
+{
+	Json::Value outputNode;
+	outputNode["output_type"] = OutputFeatures::ToString(info.GetIdentifier().GetFeatures());
+	outputNode["commit"] = info.GetIdentifier().GetCommitment().ToHex();
+	outputNode["spent"] = info.IsSpent();
+	outputNode["proof"] = info.GetRangeProof().Format();
+
+	Serializer proofSerializer;
+	info.GetRangeProof().Serialize(proofSerializer);
+	outputNode["proof_hash"] = Hasher::Blake2b(proofSerializer.GetBytes()).ToHex();
+
+	outputNode["block_height"] = info.GetLocation().GetBlockHeight();
+	outputNode["merkle_proof"] = Json::nullValue;
+	outputNode["mmr_index"] = info.GetLeafIndex().GetPosition() + 1;
+	return outputNode;
+}
+
 // get txhashset/outputs?start_index=1&max=100
+// To fetch the next page, use last_retrieved_index + 1 as the start_index.
 
 /*
 {
@@ -228,43 +254,89 @@ int TxHashSetAPI::GetOutputs_Handler(struct mg_connection* conn, void* pNodeCont
 			}
 		}
 
-		if (max > 1000)
+		if (max > MAX_OUTPUTS_PER_REQUEST)
 		{
-			max = 1000;
+			max = MAX_OUTPUTS_PER_REQUEST;
 		}
 
 		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
-			Json::Value rootNode;
+			auto pDatabase = pServer->m_pDatabase;
+			return HTTPUtil::BuildChunkedJSONResponse(conn, [pTxHashSet, pDatabase, startIndex, max](JsonStreamWriter& writer) {
+				writer.BeginObject();
+
+				// Outputs are read a page at a time, so only one page is ever held in memory.
+				const uint64_t lastRetrievedIndex = OutputRange::ReadPages(
+					startIndex,
+					max,
+					OUTPUTS_PAGE_SIZE,
+					[&pTxHashSet, &pDatabase](const uint64_t index, const uint64_t count) {
+						return pTxHashSet->GetOutputsByLeafIndex(pDatabase->GetBlockDB()->Read().GetShared(), index, count);
+					},
+					[&writer](const uint64_t highestIndex) {
+						writer.WriteMember("highest_index", highestIndex);
+						writer.Key("outputs");
+						writer.BeginArray();
+					},
+					[&writer](const OutputDTO& info) { writer.Write(BuildOutputJSON(info)); }
+				);
+
+				writer.EndArray();
+				writer.WriteMember("last_retrieved_index", lastRetrievedIndex);
+				writer.EndObject();
+			});
+		}
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Exception thrown: {}", e.what());
+	}
 
-			auto pBlockDB = pServer->m_pDatabase->GetBlockDB()->Read();
-			OutputRange range = pTxHashSet->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
-			rootNode["highest_index"] = range.GetHighestIndex();
-			rootNode["last_retrieved_index"] = range.GetLastRetrievedIndex();
+	return HTTPUtil::BuildInternalErrorResponse(conn, "Failed to find TxHashSet.");
+}
 
-			Json::Value outputsNode;
-			for (const OutputDTO& info : range.GetOutputs())
-			{
-				Json::Value outputNode;
-				outputNode["output_type"] = OutputFeatures::ToString(info.GetIdentifier().GetFeatures());
-				outputNode["commit"] = info.GetIdentifier().GetCommitment().ToHex();
-				outputNode["spent"] = info.IsSpent();
-				outputNode["proof"] = info.GetRangeProof().Format();
-
-				Serializer proofSerializer;
-				info.GetRangeProof().Serialize(proofSerializer);
-				outputNode["proof_hash"] = Hasher::Blake2b(proofSerializer.GetBytes()).ToHex();
-
-				outputNode["block_height"] = info.GetLocation().GetBlockHeight();
-				outputNode["merkle_proof"] = Json::nullValue;
-				outputNode["mmr_index"] = info.GetLeafIndex().GetPosition() + 1;
-				outputsNode.append(outputNode);
-			}
+// get txhashset/outputs/binary?start_index=1&max=1000
+//
+// Same outputs as txhashset/outputs, but as raw serialized records (see OutputRange::Serialize).
+// Skips hex encoding & JSON parsing, which dominate the cost of a full restore scan.
+int TxHashSetAPI::GetOutputsBinary_Handler(struct mg_connection* conn, void* pNodeContext)
+{
+	NodeContext* pServer = (NodeContext*)pNodeContext;
 
-			rootNode["outputs"] = outputsNode;
+	uint64_t startIndex = 1;
+	uint64_t max = 1000;
 
-			return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+	try
+	{
+		std::optional<std::string> startIndexOpt = HTTPUtil::GetQueryParam(conn, "start_index");
+		if (startIndexOpt.has_value())
+		{
+			startIndex = std::stoull(startIndexOpt.value());
+		}
+
+		std::optional<std::string> maxOpt = HTTPUtil::GetQueryParam(conn, "max");
+		if (maxOpt.has_value())
+		{
+			max = (std::min)((uint64_t)std::stoull(maxOpt.value()), MAX_OUTPUTS_PER_REQUEST);
+		}
+	}
+	catch (std::exception&)
+	{
+		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/txhashset/outputs/binary?start_index=1&max=1000");
+	}
+
+	try
+	{
+		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
+		if (pTxHashSet != nullptr)
+		{
+			Serializer serializer;
+			OutputRange::SerializePages(serializer, startIndex, max, OUTPUTS_PAGE_SIZE, [pServer, &pTxHashSet](const uint64_t index, const uint64_t count) {
+				return pTxHashSet->GetOutputsByLeafIndex(pServer->m_pDatabase->GetBlockDB()->Read().GetShared(), index, count);
+			});
+
+			return HTTPUtil::BuildSuccessResponseBinary(conn, serializer.GetBytes());
 		}
 	}
 	catch (std::exception& e)
@@ -273,4 +345,4 @@ int TxHashSetAPI::GetOutputs_Handler(struct mg_connection* conn, void* pNodeCont
 	}
 
 	return HTTPUtil::BuildInternalErrorResponse(conn, "Failed to find TxHashSet.");
-}
\ No newline at end of file
+}
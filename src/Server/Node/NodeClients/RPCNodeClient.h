@@ -2,8 +2,12 @@
 
 #include <Wallet/NodeClient.h>
 #include <Net/Connections/HttpConnection.h>
+#include <Net/Clients/HTTP/HTTPException.h>
 #include <Core/Exceptions/UnimplementedException.h>
 #include <Common/Macros.h>
+#include <Common/Logger.h>
+#include <algorithm>
+#include <atomic>
 #include <memory>
 
 // TODO: Implement caching & retry policies
@@ -17,7 +21,7 @@ class RPCNodeClient : public INodeClient
 
 public:
 	RPCNodeClient(const ENodeType type, HttpConnection::UPtr&& pConnection)
-		: m_type(type), m_pConnection(std::move(pConnection)) { }
+		: m_type(type), m_pConnection(std::move(pConnection)), m_binaryOutputs(type == ENodeType::GRINPP) { }
 
 	static INodeClientPtr Create(const std::string& host, const uint16_t port)
 	{
@@ -113,6 +117,33 @@ public:
 	//
 	std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const final
 	{
+		// Grin++ nodes serve raw serialized outputs, which avoids hex encoding & parsing every rangeproof.
+		// Older Grin++ nodes don't have the binary endpoint, or route it to the JSON txhashset/outputs handler,
+		// so once a response shows the node doesn't support it, the node is only queried through get_unspent_outputs from then on.
+		// Any other failure may be temporary, so only this call falls back, and binary is tried again next time.
+		if (m_binaryOutputs)
+		{
+			try
+			{
+				std::unique_ptr<OutputRange> pRange = ParseBinaryOutputRange(m_pConnection->Get(StringUtil::Format(
+					"/v1/txhashset/outputs/binary?start_index={}&max={}",
+					startIndex,
+					maxNumOutputs
+				)));
+				if (pRange != nullptr)
+				{
+					return pRange;
+				}
+
+				WALLET_INFO("Node doesn't support binary outputs. Falling back to get_unspent_outputs.");
+				m_binaryOutputs = false;
+			}
+			catch (std::exception& e)
+			{
+				WALLET_WARNING_F("Failed to get binary outputs. Using get_unspent_outputs for this request. Error: {}", e.what());
+			}
+		}
+
 		Json::Value params(Json::arrayValue);
 		params.append(Json::UInt64(startIndex));
 		params.append(Json::nullValue);
@@ -123,6 +154,42 @@ public:
 		return std::make_unique<OutputRange>(OutputRange::FromJSON(response));
 	}
 
+	//
+	// Parses a /v1/txhashset/outputs/binary response, or returns nullptr if the node doesn't support the binary format.
+	// Throws if the request failed for any other reason.
+	//
+	static std::unique_ptr<OutputRange> ParseBinaryOutputRange(const HTTP::Response& response)
+	{
+		if (response.GetStatusCode() == 404)
+		{
+			return nullptr;
+		}
+
+		if (response.GetStatusCode() != 200)
+		{
+			throw HTTP_EXCEPTION(StringUtil::Format("Unexpected status code {}", response.GetStatusCode()));
+		}
+
+		auto iter = std::find_if(
+			response.GetHeaders().cbegin(),
+			response.GetHeaders().cend(),
+			[](const HTTP::Header& header) { return StringUtil::ToLower(header.m_type) == "content-type"; }
+		);
+		if (iter == response.GetHeaders().cend() || !StringUtil::StartsWith(StringUtil::ToLower(iter->m_value), "application/octet-stream"))
+		{
+			return nullptr;
+		}
+
+		// A newer node may only serve a format version this wallet doesn't understand.
+		if (!response.GetBody().empty() && (uint8_t)response.GetBody().front() != OutputRange::BINARY_FORMAT_VERSION)
+		{
+			return nullptr;
+		}
+
+		ByteBuffer byteBuffer(std::vector<uint8_t>(response.GetBody().cbegin(), response.GetBody().cend()));
+		return std::make_unique<OutputRange>(OutputRange::Deserialize(byteBuffer));
+	}
+
 	//
 	// Posts the transaction to the P2P Network.
 	//
@@ -160,4 +227,5 @@ private:
 
 	ENodeType m_type;
 	HttpConnection::UPtr m_pConnection;
+	mutable std::atomic_bool m_binaryOutputs;
 };
\ No newline at end of file
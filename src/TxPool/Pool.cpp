@@ -9,19 +9,16 @@
 std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
 {
 	std::vector<TransactionPtr> transactionsFound;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& kernelEntry : m_byKernelHash)
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
+		const ShortId shortId = ShortId::Create(kernelEntry.first, hash, nonce);
+		if (missingShortIds.find(shortId) != missingShortIds.cend())
 		{
-			const ShortId shortId = ShortId::Create(kernel.GetHash(), hash, nonce);
-			if (missingShortIds.find(shortId) != missingShortIds.cend())
-			{
-				transactionsFound.push_back(txPoolEntry.GetTransaction());
+			transactionsFound.push_back(m_transactions.at(kernelEntry.second).GetTransaction());
 
-				if (transactionsFound.size() == missingShortIds.size())
-				{
-					return transactionsFound;
-				}
+			if (transactionsFound.size() == missingShortIds.size())
+			{
+				return transactionsFound;
 			}
 		}
 	}
@@ -31,35 +28,31 @@ std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, con
 
 void Pool::AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status)
 {
+	if (m_byTxHash.find(pTransaction->GetHash()) != m_byTxHash.cend())
+	{
+		LOG_DEBUG_F("Transaction already in pool: {}", pTransaction->GetHash());
+		return;
+	}
+
 	LOG_DEBUG_F("Transaction added: {}", pTransaction->GetHash());
 
-	m_transactions.emplace_back(TxPoolEntry(pTransaction, status, std::time_t()));
+	AddEntry(TxPoolEntry(pTransaction, status, std::time_t()));
 }
 
 bool Pool::ContainsTransaction(const Transaction& transaction) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
-	{
-		if (*txPoolEntry.GetTransaction() == transaction)
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return m_byTxHash.find(transaction.GetHash()) != m_byTxHash.cend();
 }
 
 std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const
 {
 	std::set<TransactionPtr> transactionSet;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const TransactionKernel& kernel : kernels)
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
+		auto iter = m_byKernelHash.find(kernel.GetHash());
+		if (iter != m_byKernelHash.cend())
 		{
-			if (kernels.count(kernel) > 0)
-			{
-				transactionSet.insert(txPoolEntry.GetTransaction());
-			}
+			transactionSet.insert(m_transactions.at(iter->second).GetTransaction());
 		}
 	}
 
@@ -71,15 +64,10 @@ std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<Transa
 
 TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	auto iter = m_byKernelHash.find(kernelHash);
+	if (iter != m_byKernelHash.cend())
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
-		{
-			if (kernel.GetHash() == kernelHash)
-			{
-				return txPoolEntry.GetTransaction();
-			}
-		}
+		return m_transactions.at(iter->second).GetTransaction();
 	}
 
 	return nullptr;
@@ -88,11 +76,11 @@ TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 std::vector<TransactionPtr> Pool::FindTransactionsByStatus(const EDandelionStatus status) const
 {
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
-		if (txPoolEntry.GetStatus() == status)
+		if (entry.second.GetStatus() == status)
 		{
-			transactions.push_back(txPoolEntry.GetTransaction());
+			transactions.push_back(entry.second.GetTransaction());
 		}
 	}
 
@@ -104,53 +92,95 @@ std::vector<TransactionPtr> Pool::GetExpiredTransactions(const uint16_t embargoS
 	const std::time_t cutoff = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() - std::chrono::seconds(embargoSeconds));
 
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
-		if (txPoolEntry.GetTimestamp() < cutoff)
+		if (entry.second.GetTimestamp() < cutoff)
 		{
-			transactions.push_back(txPoolEntry.GetTransaction());
+			transactions.push_back(entry.second.GetTransaction());
 		}
 	}
 
 	return transactions;
 }
 
-void Pool::RemoveTransaction(const Transaction& transaction)
+TransactionPtr Pool::GetLowestFeeRateTransaction() const
 {
-	auto iter = m_transactions.begin();
-	while (iter != m_transactions.end())
+	if (m_byFeeRate.empty())
 	{
-		if (transaction == *iter->GetTransaction())
-		{
-			m_transactions.erase(iter);
-			break;
-		}
+		return nullptr;
+	}
+
+	return m_transactions.at(m_byFeeRate.begin()->second).GetTransaction();
+}
 
-		++iter;
+uint64_t Pool::GetLowestFeeRate() const
+{
+	if (m_byFeeRate.empty())
+	{
+		return 0;
 	}
+
+	return m_byFeeRate.begin()->first;
+}
+
+TransactionPtr Pool::EvictLowestFeeRate()
+{
+	if (m_byFeeRate.empty())
+	{
+		return nullptr;
+	}
+
+	const uint64_t sequence = m_byFeeRate.begin()->second;
+	TransactionPtr pTransaction = m_transactions.at(sequence).GetTransaction();
+	LOG_DEBUG_F("Evicting transaction {} with fee rate {}", pTransaction->GetHash(), m_byFeeRate.begin()->first);
+
+	RemoveEntry(sequence);
+	return pTransaction;
+}
+
+void Pool::RemoveTransaction(const Transaction& transaction)
+{
+	auto iter = m_byTxHash.find(transaction.GetHash());
+	if (iter != m_byTxHash.end())
+	{
+		RemoveEntry(iter->second);
+	}
+}
+
+void Pool::Clear()
+{
+	m_transactions.clear();
+	m_byTxHash.clear();
+	m_byKernelHash.clear();
+	m_byInput.clear();
+	m_byOutput.clear();
+	m_byFeeRate.clear();
+	m_totalWeight = 0;
+	m_totalBytes = 0;
 }
 
 // Quick reconciliation step - we can evict any txs in the pool where
 // inputs or kernels intersect with the block.
 void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block, TransactionPtr pMemPoolAggTx)
 {
-	std::vector<TransactionPtr> filteredTransactions;
-	std::unordered_map<Hash, TxPoolEntry> filteredEntriesByHash;
-
 	// Filter txs in the pool based on the latest block.
 	// Reject any txs where we see a matching tx kernel in the block.
 	// Also reject any txs where we see a conflicting tx,
 	// where an input is spent in a different tx.
-	for (auto& txPoolEntry : m_transactions)
+	for (const uint64_t sequence : FindConflicts(block))
 	{
-		if (!ShouldEvict(*txPoolEntry.GetTransaction(), block))
-		{
-			filteredTransactions.push_back(txPoolEntry.GetTransaction());
-			filteredEntriesByHash.insert(std::pair<Hash, TxPoolEntry>(txPoolEntry.GetTransaction()->GetHash(), txPoolEntry));
-		}
+		RemoveEntry(sequence);
 	}
 
-	m_transactions.clear();
+	std::vector<TransactionPtr> filteredTransactions;
+	std::unordered_map<Hash, TxPoolEntry> filteredEntriesByHash;
+	for (const auto& entry : m_transactions)
+	{
+		filteredTransactions.push_back(entry.second.GetTransaction());
+		filteredEntriesByHash.insert({ entry.second.GetTransaction()->GetHash(), entry.second });
+	}
+
+	Clear();
 
 	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(
 		pBlockDB,
@@ -160,47 +190,127 @@ void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetCo
 	);
 	for (auto& pTransaction : validTransactions)
 	{
-		const TxPoolEntry& txPoolEntry = filteredEntriesByHash.at(pTransaction->GetHash());
-		m_transactions.push_back(txPoolEntry);
+		AddEntry(filteredEntriesByHash.at(pTransaction->GetHash()));
 	}
 }
 
 void Pool::ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
 {
-	for (auto& txPoolEntry : m_transactions)
+	for (auto& pTransaction : transactions)
 	{
-		for (auto& transaction : transactions)
+		auto iter = m_byTxHash.find(pTransaction->GetHash());
+		if (iter != m_byTxHash.end())
 		{
-			if (txPoolEntry.GetTransaction() == transaction)
-			{
-				txPoolEntry.SetStatus(status);
-				break;
-			}
+			m_transactions.at(iter->second).SetStatus(status);
 		}
 	}
 }
 
-bool Pool::ShouldEvict(const Transaction& transaction, const FullBlock& block) const
+// Looks up each of the block's inputs, outputs, and kernels in the indexes,
+// so the cost is proportional to the size of the block rather than the size of the pool.
+std::set<uint64_t> Pool::FindConflicts(const FullBlock& block) const
 {
-	const std::vector<TransactionInput>& blockInputs = block.GetInputs();
-	for (const TransactionInput& input : transaction.GetInputs())
+	std::set<uint64_t> conflicts;
+
+	for (const TransactionInput& input : block.GetInputs())
+	{
+		auto iter = m_byInput.find(input.GetCommitment());
+		if (iter != m_byInput.cend())
+		{
+			conflicts.insert(iter->second);
+		}
+	}
+
+	for (const TransactionOutput& output : block.GetOutputs())
+	{
+		auto iter = m_byOutput.find(output.GetCommitment());
+		if (iter != m_byOutput.cend())
+		{
+			conflicts.insert(iter->second);
+		}
+	}
+
+	for (const TransactionKernel& kernel : block.GetKernels())
 	{
-		if (std::find(blockInputs.begin(), blockInputs.end(), input) != blockInputs.end())
+		auto iter = m_byKernelHash.find(kernel.GetHash());
+		if (iter != m_byKernelHash.cend())
 		{
-			return true;
+			conflicts.insert(iter->second);
 		}
 	}
 
-	const std::vector<TransactionKernel>& blockKernels = block.GetKernels();
-	for (const TransactionKernel& kernel : transaction.GetKernels())
+	return conflicts;
+}
+
+void Pool::AddEntry(const TxPoolEntry& entry)
+{
+	const uint64_t sequence = m_nextSequence++;
+	const TransactionPtr& pTransaction = entry.GetTransaction();
+
+	m_transactions.insert({ sequence, entry });
+	m_byTxHash[pTransaction->GetHash()] = sequence;
+
+	for (const TransactionKernel& kernel : pTransaction->GetKernels())
+	{
+		m_byKernelHash[kernel.GetHash()] = sequence;
+	}
+
+	for (const TransactionInput& input : pTransaction->GetInputs())
+	{
+		m_byInput[input.GetCommitment()] = sequence;
+	}
+
+	for (const TransactionOutput& output : pTransaction->GetOutputs())
+	{
+		m_byOutput[output.GetCommitment()] = sequence;
+	}
+
+	m_byFeeRate.insert({ entry.GetFeeRate(), sequence });
+	m_totalWeight += entry.GetWeight();
+	m_totalBytes += entry.GetBytes();
+}
+
+void Pool::RemoveEntry(const uint64_t sequence)
+{
+	auto iter = m_transactions.find(sequence);
+	if (iter == m_transactions.end())
 	{
-		if (std::find(blockKernels.begin(), blockKernels.end(), kernel) != blockKernels.end())
+		return;
+	}
+
+	const TxPoolEntry& entry = iter->second;
+	const TransactionPtr& pTransaction = entry.GetTransaction();
+
+	// Only erase index entries that still point at this tx, in case a later tx shares a kernel or commitment.
+	auto eraseIndex = [sequence](auto& index, const auto& key) {
+		auto indexIter = index.find(key);
+		if (indexIter != index.end() && indexIter->second == sequence)
 		{
-			return true;
+			index.erase(indexIter);
 		}
+	};
+
+	eraseIndex(m_byTxHash, pTransaction->GetHash());
+
+	for (const TransactionKernel& kernel : pTransaction->GetKernels())
+	{
+		eraseIndex(m_byKernelHash, kernel.GetHash());
+	}
+
+	for (const TransactionInput& input : pTransaction->GetInputs())
+	{
+		eraseIndex(m_byInput, input.GetCommitment());
+	}
+
+	for (const TransactionOutput& output : pTransaction->GetOutputs())
+	{
+		eraseIndex(m_byOutput, output.GetCommitment());
 	}
 
-	return false;
+	m_byFeeRate.erase({ entry.GetFeeRate(), sequence });
+	m_totalWeight -= entry.GetWeight();
+	m_totalBytes -= entry.GetBytes();
+	m_transactions.erase(iter);
 }
 
 TransactionPtr Pool::Aggregate() const
@@ -213,9 +323,9 @@ TransactionPtr Pool::Aggregate() const
 	LOG_INFO_F("Aggregating {} transactions", m_transactions.size());
 
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& entry : m_transactions)
+	for (const auto& entry : m_transactions)
 	{
-		transactions.push_back(entry.GetTransaction());
+		transactions.push_back(entry.second.GetTransaction());
 	}
 
 	return TransactionUtil::Aggregate(transactions);
@@ -10,6 +10,9 @@
 #include <Core/Config.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Crypto/Models/Hash.h>
+#include <Crypto/Models/Commitment.h>
+#include <unordered_map>
+#include <map>
 #include <set>
 
 class Pool
@@ -38,12 +41,33 @@ public:
 	TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const;
 	std::vector<TransactionPtr> FindTransactionsByStatus(const EDandelionStatus status) const;
 	std::vector<TransactionPtr> GetExpiredTransactions(const uint16_t embargoSeconds) const;
+	TransactionPtr GetLowestFeeRateTransaction() const;
+	uint64_t GetLowestFeeRate() const;
+	TransactionPtr EvictLowestFeeRate();
 
 	TransactionPtr Aggregate() const;
-	void Clear() { m_transactions.clear(); }
+	size_t Size() const noexcept { return m_transactions.size(); }
+	uint64_t GetTotalWeight() const noexcept { return m_totalWeight; }
+	uint64_t GetTotalBytes() const noexcept { return m_totalBytes; }
+	void Clear();
 
 private:
-	bool ShouldEvict(const Transaction& transaction, const FullBlock& block) const;
+	void AddEntry(const TxPoolEntry& entry);
+	void RemoveEntry(const uint64_t sequence);
+	std::set<uint64_t> FindConflicts(const FullBlock& block) const;
 
-	std::vector<TxPoolEntry> m_transactions;
+	// Entries keyed by insertion sequence, since later txs may spend outputs of earlier ones.
+	std::map<uint64_t, TxPoolEntry> m_transactions;
+	uint64_t m_nextSequence{ 0 };
+	uint64_t m_totalWeight{ 0 };
+	uint64_t m_totalBytes{ 0 };
+
+	// Indexes into m_transactions.
+	std::unordered_map<Hash, uint64_t> m_byTxHash;
+	std::unordered_map<Hash, uint64_t> m_byKernelHash;
+	std::unordered_map<Commitment, uint64_t> m_byInput;
+	std::unordered_map<Commitment, uint64_t> m_byOutput;
+
+	// (fee rate, sequence) pairs, so the lowest paying tx is always at begin().
+	std::set<std::pair<uint64_t, uint64_t>> m_byFeeRate;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <Database/BlockDb.h>
 #include <Crypto/CSPRNG.h>
 #include <Common/Logger.h>
+#include <Common/Metrics.h>
 #include <Core/Util/FeeUtil.h>
 #include <Core/Validation/TransactionValidator.h>
 
@@ -24,6 +25,18 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 	const EPoolType poolType,
 	const BlockHeader& lastConfirmedBlock)
 {
+	static Metrics::Histogram& memPoolHistogram = Metrics::GetHistogram(
+		"grinpp_txpool_add_seconds",
+		"Time spent adding a transaction to the pool, including waiting for the pool lock.",
+		"pool=\"mempool\""
+	);
+	static Metrics::Histogram& stemPoolHistogram = Metrics::GetHistogram(
+		"grinpp_txpool_add_seconds",
+		"Time spent adding a transaction to the pool, including waiting for the pool lock.",
+		"pool=\"stempool\""
+	);
+	Metrics::ScopedTimer timer(poolType == EPoolType::MEMPOOL ? memPoolHistogram : stemPoolHistogram);
+
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 	const uint64_t next_block_height = lastConfirmedBlock.GetHeight() + 1;
 
@@ -39,6 +52,14 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		LOG_WARNING_F("Fee too low for transaction ({})", *pTransaction);
 		return EAddTransactionStatus::LOW_FEE;
 	}
+
+	// Reject txs that would just be evicted again before doing any expensive validation
+	Pool& pool = (poolType == EPoolType::MEMPOOL) ? m_memPool : m_stemPool;
+	if (!MeetsFeeFloor(pool, poolType, TxPoolEntry(pTransaction, EDandelionStatus::TO_STEM, std::time_t())))
+	{
+		LOG_DEBUG_F("Fee rate too low for full pool ({})", *pTransaction);
+		return EAddTransactionStatus::LOW_FEE;
+	}
 	
 	// Verify lock time
 	for (const TransactionKernel& kernel : pTransaction->GetKernels())
@@ -50,9 +71,18 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		}
 	}
 
+	// Txs being fluffed from our stempool already had their rangeproofs, signatures, and kernel sums verified when they were stemmed,
+	// but that may have been at a lower height, so the height-dependent checks are always repeated.
 	try
 	{
-		TransactionValidator().Validate(*pTransaction, next_block_height);
+		if (m_stemPool.ContainsTransaction(*pTransaction))
+		{
+			TransactionValidator().ValidateForHeight(*pTransaction, next_block_height);
+		}
+		else
+		{
+			TransactionValidator().Validate(*pTransaction, next_block_height);
+		}
 	}
 	catch (std::exception& e)
 	{
@@ -87,6 +117,13 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		}
 	}
 
+	EnforceLimits(pool, poolType);
+	if (!pool.ContainsTransaction(*pTransaction))
+	{
+		LOG_DEBUG_F("Transaction evicted from full pool ({})", *pTransaction);
+		return EAddTransactionStatus::LOW_FEE;
+	}
+
 	return EAddTransactionStatus::ADDED;
 }
 
@@ -112,6 +149,12 @@ TransactionPtr TransactionPool::FindTransactionByKernelHash(const Hash& kernelHa
 
 void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block)
 {
+	static Metrics::Histogram& histogram = Metrics::GetHistogram(
+		"grinpp_txpool_reconcile_seconds",
+		"Time spent removing a new block's transactions and conflicts from the pools."
+	);
+	Metrics::ScopedTimer timer(histogram);
+
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
 	// First reconcile the txpool.
@@ -183,6 +226,8 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 		m_stemPool.RemoveTransaction(*pTransaction);
 	}
 
+	EnforceLimits(m_memPool, EPoolType::MEMPOOL);
+
 	return pTransactionToFluff;
 }
 
@@ -194,6 +239,38 @@ std::vector<TransactionPtr> TransactionPool::GetExpiredTransactions() const
 	return m_stemPool.GetExpiredTransactions(embargoSeconds);
 }
 
+uint64_t TransactionPool::GetMaxWeight(const EPoolType poolType) const noexcept
+{
+	return (poolType == EPoolType::MEMPOOL) ? m_config.GetMempoolMaxWeight() : m_config.GetStempoolMaxWeight();
+}
+
+uint64_t TransactionPool::GetMaxBytes(const EPoolType poolType) const noexcept
+{
+	return (poolType == EPoolType::MEMPOOL) ? m_config.GetMempoolMaxBytes() : m_config.GetStempoolMaxBytes();
+}
+
+// A tx can only be added to a full pool if it pays a higher fee rate than the cheapest tx it would displace.
+bool TransactionPool::MeetsFeeFloor(const Pool& pool, const EPoolType poolType, const TxPoolEntry& entry) const
+{
+	const bool full = (pool.GetTotalWeight() + entry.GetWeight()) > GetMaxWeight(poolType)
+		|| (pool.GetTotalBytes() + entry.GetBytes()) > GetMaxBytes(poolType);
+
+	return !full || entry.GetFeeRate() > pool.GetLowestFeeRate();
+}
+
+// Evicts the lowest fee rate txs until the pool is back within its configured limits.
+// Txs spending outputs of evicted txs are dropped during the next reconciliation.
+void TransactionPool::EnforceLimits(Pool& pool, const EPoolType poolType)
+{
+	while (pool.GetTotalWeight() > GetMaxWeight(poolType) || pool.GetTotalBytes() > GetMaxBytes(poolType))
+	{
+		if (pool.EvictLowestFeeRate() == nullptr)
+		{
+			break;
+		}
+	}
+}
+
 namespace TxPoolAPI
 {
 	TX_POOL_API std::shared_ptr<ITransactionPool> CreateTransactionPool(const Config& config)
@@ -28,6 +28,11 @@ public:
 	std::vector<TransactionPtr> GetExpiredTransactions() const final;
 
 private:
+	uint64_t GetMaxWeight(const EPoolType poolType) const noexcept;
+	uint64_t GetMaxBytes(const EPoolType poolType) const noexcept;
+	bool MeetsFeeFloor(const Pool& pool, const EPoolType poolType, const TxPoolEntry& entry) const;
+	void EnforceLimits(Pool& pool, const EPoolType poolType);
+
 	const Config& m_config;
 	mutable std::shared_mutex m_mutex;
 
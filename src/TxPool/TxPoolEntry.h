@@ -1,7 +1,9 @@
 #pragma once
 
+#include <Consensus.h>
 #include <Core/Models/Transaction.h>
 #include <TxPool/DandelionStatus.h>
+#include <algorithm>
 #include <ctime>
 
 class TxPoolEntry
@@ -13,7 +15,16 @@ public:
 	TxPoolEntry(TransactionPtr pTransaction, const EDandelionStatus status, const std::time_t timestamp)
 		: m_pTransaction(pTransaction), m_status(status), m_timestamp(timestamp)
 	{
+		m_fee = pTransaction->CalcFee();
+		m_weight = Consensus::CalculateWeightV5(
+			pTransaction->GetInputs().size(),
+			pTransaction->GetOutputs().size(),
+			pTransaction->GetKernels().size()
+		);
 
+		Serializer serializer;
+		pTransaction->Serialize(serializer);
+		m_bytes = serializer.size();
 	}
 
 	TxPoolEntry(const TxPoolEntry& txPoolEntry) = default;
@@ -40,6 +51,10 @@ public:
 	inline TransactionPtr GetTransaction() const { return m_pTransaction; }
 	inline EDandelionStatus GetStatus() const { return m_status; }
 	inline std::time_t GetTimestamp() const { return m_timestamp; }
+	inline uint64_t GetFee() const { return m_fee; }
+	inline uint64_t GetWeight() const { return m_weight; }
+	inline uint64_t GetBytes() const { return m_bytes; }
+	inline uint64_t GetFeeRate() const { return m_fee / (std::max)(m_weight, (uint64_t)1); }
 
 	//
 	// Setters
@@ -50,4 +65,7 @@ private:
 	TransactionPtr m_pTransaction;
 	EDandelionStatus m_status;
 	std::time_t m_timestamp;
+	uint64_t m_fee;
+	uint64_t m_weight;
+	uint64_t m_bytes;
 };
\ No newline at end of file
@@ -1,64 +1,163 @@
 #include "ValidTransactionFinder.h"
 
-#include <Core/Util/TransactionUtil.h>
-#include <Core/Validation/TransactionValidator.h>
-#include <Core/Validation/KernelSumValidator.h>
-#include <Common/Util/FunctionalUtil.h>
+#include <Consensus.h>
+#include <Common/Logger.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Database/BlockDb.h>
 
+ValidTransactionFinder::ValidTransactionFinder(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet)
+	: m_pBlockDB(pBlockDB),
+	m_pTxHashSet(pTxHashSet),
+	m_nextBlockHeight(pTxHashSet->GetFlushedBlockHeader()->GetHeight() + 1),
+	m_numInputs(0),
+	m_numOutputs(0),
+	m_numKernels(0)
+{
+
+}
+
 std::vector<TransactionPtr> ValidTransactionFinder::FindValidTransactions(
 	std::shared_ptr<const IBlockDB> pBlockDB,
 	ITxHashSetConstPtr pTxHashSet,
 	const std::vector<TransactionPtr>& transactions,
 	TransactionPtr pExtraTransaction)
 {
+	ValidTransactionFinder finder(pBlockDB, pTxHashSet);
+	if (pExtraTransaction != nullptr)
+	{
+		finder.Seed(*pExtraTransaction);
+	}
+
 	std::vector<TransactionPtr> validTransactions;
 	for (TransactionPtr pTransaction : transactions)
 	{
-		std::vector<TransactionPtr> candidateTransactions = validTransactions;
-		if (pExtraTransaction != nullptr)
+		if (finder.TryAdd(*pTransaction))
 		{
-			candidateTransactions.push_back(pExtraTransaction);
+			validTransactions.push_back(pTransaction);
 		}
+	}
 
-		candidateTransactions.push_back(pTransaction);
+	return validTransactions;
+}
 
-		// Build a single aggregate tx from candidate txs.
-		TransactionPtr pAggregatedTransaction = TransactionUtil::Aggregate(candidateTransactions);
+void ValidTransactionFinder::Seed(const Transaction& transaction)
+{
+	Accept(transaction);
+}
 
-		// We know the tx is valid if the entire aggregate tx is valid.
-		if (IsValidTransaction(pBlockDB, pTxHashSet, pAggregatedTransaction))
+bool ValidTransactionFinder::TryAdd(const Transaction& transaction)
+{
+	if (HasConflicts(transaction))
+	{
+		LOG_DEBUG_F("Transaction {} conflicts with chain or pool", transaction);
+		return false;
+	}
+
+	Accept(transaction);
+	return true;
+}
+
+bool ValidTransactionFinder::HasConflicts(const Transaction& transaction) const
+{
+	for (const TransactionKernel& kernel : transaction.GetKernels())
+	{
+		if (m_kernels.find(kernel.GetHash()) != m_kernels.cend())
 		{
-			validTransactions.push_back(pTransaction);
+			return true;
 		}
 	}
 
-	return validTransactions;
+	// Inputs spending outputs of accepted txs will be cut-through.
+	// The rest must be unspent outputs in the current UTXO set.
+	uint64_t numCutThrough = 0;
+	std::vector<TransactionInput> chainInputs;
+	for (const TransactionInput& input : transaction.GetInputs())
+	{
+		if (m_spent.find(input.GetCommitment()) != m_spent.cend())
+		{
+			return true;
+		}
+
+		if (m_created.find(input.GetCommitment()) != m_created.cend())
+		{
+			++numCutThrough;
+		}
+		else
+		{
+			chainInputs.push_back(input);
+		}
+	}
+
+	for (const TransactionOutput& output : transaction.GetOutputs())
+	{
+		if (m_created.find(output.GetCommitment()) != m_created.cend())
+		{
+			return true;
+		}
+	}
+
+	// Verify the aggregate would still fit in a block, reserving enough space for a coinbase output and kernel.
+	const uint64_t weight = CalcWeight(
+		m_numInputs + chainInputs.size(),
+		m_numOutputs + transaction.GetOutputs().size() - numCutThrough,
+		m_numKernels + transaction.GetKernels().size()
+	);
+	const uint64_t reserveWeight = (Consensus::OUTPUT_WEIGHT + Consensus::KERNEL_WEIGHT);
+	if ((weight + reserveWeight) > Consensus::MAX_BLOCK_WEIGHT)
+	{
+		return true;
+	}
+
+	// Check all remaining inputs are in the current UTXO set & all outputs unique in current UTXO set.
+	try
+	{
+		const Transaction chainTx(
+			BlindingFactor(),
+			TransactionBody::NoSort(std::move(chainInputs), transaction.GetOutputs(), {})
+		);
+		return !m_pTxHashSet->IsValid(m_pBlockDB, chainTx);
+	}
+	catch (std::exception&)
+	{
+		return true;
+	}
 }
 
-bool ValidTransactionFinder::IsValidTransaction(
-	std::shared_ptr<const IBlockDB> pBlockDB,
-	ITxHashSetConstPtr pTxHashSet,
-	TransactionPtr pTransaction)
+void ValidTransactionFinder::Accept(const Transaction& transaction)
 {
-	try
+	for (const TransactionKernel& kernel : transaction.GetKernels())
+	{
+		m_kernels.insert(kernel.GetHash());
+	}
+
+	for (const TransactionInput& input : transaction.GetInputs())
 	{
-		const uint64_t next_block_height = pTxHashSet->GetFlushedBlockHeader()->GetHeight() + 1;
-		TransactionValidator().Validate(*pTransaction, next_block_height);
+		m_spent.insert(input.GetCommitment());
 
-		// Validate the tx against current chain state.
-		// Check all inputs are in the current UTXO set.
-		// Check all outputs are unique in current UTXO set.
-		if (!pTxHashSet->IsValid(pBlockDB, *pTransaction))
+		if (m_created.erase(input.GetCommitment()) > 0)
+		{
+			--m_numOutputs;
+		}
+		else
 		{
-			return false;
+			++m_numInputs;
 		}
 	}
-	catch (std::exception&)
+
+	for (const TransactionOutput& output : transaction.GetOutputs())
 	{
-		return false;
+		m_created.insert(output.GetCommitment());
+		++m_numOutputs;
 	}
 
-	return true;
-}
\ No newline at end of file
+	m_numKernels += transaction.GetKernels().size();
+}
+
+uint64_t ValidTransactionFinder::CalcWeight(const uint64_t numInputs, const uint64_t numOutputs, const uint64_t numKernels) const
+{
+	if (Consensus::GetHeaderVersion(m_nextBlockHeight) < 5) {
+		return Consensus::CalculateWeightV4(numInputs, numOutputs, numKernels);
+	} else {
+		return Consensus::CalculateWeightV5(numInputs, numOutputs, numKernels);
+	}
+}
@@ -2,14 +2,26 @@
 
 #include <Core/Models/Transaction.h>
 #include <Core/Models/BlockHeader.h>
+#include <Crypto/Models/Commitment.h>
+#include <Crypto/Models/Hash.h>
 #include <PMMR/TxHashSet.h>
+#include <unordered_set>
 
 // Forward Declarations
 class IBlockDB;
 
+//
+// Incrementally builds up a set of mutually-compatible pool transactions.
+// Every pool transaction was fully validated (rangeproofs, kernel signatures, kernel sums) when it entered the pool,
+// and those properties are preserved under aggregation, so only weight and UTXO conflicts need to be checked here.
+// Commitments spent and created by the accepted transactions are tracked, so each candidate is checked once
+// against the chain UTXO set and the txs accepted before it, instead of re-validating an ever-growing aggregate.
+//
 class ValidTransactionFinder
 {
 public:
+	ValidTransactionFinder(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet);
+
 	static std::vector<TransactionPtr> FindValidTransactions(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet,
@@ -17,10 +29,33 @@ public:
 		TransactionPtr pExtraTransaction
 	);
 
+	//
+	// Records the transaction as accepted without checking it.
+	// Used for transactions that were already reconciled, like the mempool aggregate.
+	//
+	void Seed(const Transaction& transaction);
+
+	//
+	// Checks the transaction against the chain UTXO set and all previously accepted txs.
+	// If it doesn't conflict, it's recorded as accepted and true is returned.
+	//
+	bool TryAdd(const Transaction& transaction);
+
 private:
-	static bool IsValidTransaction(
-		std::shared_ptr<const IBlockDB> pBlockDB,
-		ITxHashSetConstPtr pTxHashSet,
-		TransactionPtr pTransaction
-	);
-};
\ No newline at end of file
+	bool HasConflicts(const Transaction& transaction) const;
+	void Accept(const Transaction& transaction);
+	uint64_t CalcWeight(const uint64_t numInputs, const uint64_t numOutputs, const uint64_t numKernels) const;
+
+	std::shared_ptr<const IBlockDB> m_pBlockDB;
+	ITxHashSetConstPtr m_pTxHashSet;
+	uint64_t m_nextBlockHeight;
+
+	std::unordered_set<Commitment> m_spent;
+	std::unordered_set<Commitment> m_created;
+	std::unordered_set<Hash> m_kernels;
+
+	// Size of the aggregate after cut-through.
+	uint64_t m_numInputs;
+	uint64_t m_numOutputs;
+	uint64_t m_numKernels;
+};
@@ -5,42 +5,112 @@
 #include <Wallet/Keychain/KeyChain.h>
 #include <Wallet/WalletUtil.h>
 #include <Common/Logger.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Core/Exceptions/WalletException.h>
+#include <atomic>
+#include <thread>
 
 static const uint64_t NUM_OUTPUTS_PER_BATCH = 1000;
 
-std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::shared_ptr<IWalletDB>& pBatch, const bool fromGenesis) const
+void OutputRestorer::FindAndRewindOutputs(
+    const uint64_t startLeafIndex,
+    const std::unordered_set<Commitment>& knownCommitments,
+    const WindowCallback& onWindowRewound) const
 {
-    uint64_t nextLeafIndex = fromGenesis ? 0 : pBatch->GetRestoreLeafIndex() + 1;
+    const size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    uint64_t nextLeafIndex = startLeafIndex;
     uint64_t highestIndex = 0;
 
-    std::vector<OutputDataEntity> walletOutputs;
-    while (true) {
-        std::unique_ptr<OutputRange> pOutputRange = m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
-        if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0) {
-            // No new outputs since last restore
-            return std::vector<OutputDataEntity>();
-        }
+    bool finished = false;
+    while (!finished) {
+        // Fetch one batch per thread, so every core has work for the window.
+        std::vector<OutputDTO> candidates;
+        uint64_t lastRetrievedIndex = 0;
+        for (size_t i = 0; i < numThreads; i++) {
+            std::unique_ptr<OutputRange> pOutputRange = m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
+            if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0) {
+                // No new outputs since last restore
+                finished = true;
+                break;
+            }
 
-        for (const OutputDTO& output : pOutputRange->GetOutputs()) {
-            std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(output);
-            if (pOutputDataEntity != nullptr) {
-                walletOutputs.emplace_back(*pOutputDataEntity);
+            for (const OutputDTO& output : pOutputRange->GetOutputs()) {
+                // Spent and already known outputs would be discarded after rewinding, so don't waste time rewinding them.
+                if (!output.IsSpent() && knownCommitments.count(output.GetCommitment()) == 0) {
+                    candidates.push_back(output);
+                }
+            }
+
+            if (highestIndex == 0) {
+                // Cache this, rather than use the new response from pOutputRange.
+                // Otherwise, pOutputRange->GetHighestIndex() could continue to rise slowly during sync, tying up this thread.
+                highestIndex = pOutputRange->GetHighestIndex();
             }
-        }
 
-        if (highestIndex == 0) {
-            // Cache this, rather than use the new response from pOutputRange.
-            // Otherwise, pOutputRange->GetHighestIndex() could continue to rise slowly during sync, tying up this thread.
-            highestIndex = pOutputRange->GetHighestIndex();
+            lastRetrievedIndex = pOutputRange->GetLastRetrievedIndex();
+            nextLeafIndex = lastRetrievedIndex + 1;
+            if (nextLeafIndex > highestIndex) {
+                finished = true;
+                break;
+            }
         }
 
-        nextLeafIndex = pOutputRange->GetLastRetrievedIndex() + 1;
-        if (nextLeafIndex > highestIndex) {
+        if (lastRetrievedIndex == 0) {
             break;
         }
+
+        WALLET_DEBUG_F(
+            "Rewinding {} candidate outputs up to leaf index {} of {}",
+            candidates.size(),
+            lastRetrievedIndex,
+            highestIndex
+        );
+
+        onWindowRewound(RewindOutputs(candidates, numThreads), lastRetrievedIndex);
     }
+}
 
-    pBatch->UpdateRestoreLeafIndex(nextLeafIndex - 1);
+std::vector<OutputDataEntity> OutputRestorer::RewindOutputs(const std::vector<OutputDTO>& outputs, const size_t numThreads) const
+{
+    // Each thread writes only to the slots of the outputs it claims, so results stay in leaf order.
+    std::vector<std::unique_ptr<OutputDataEntity>> results(outputs.size());
+    std::atomic<size_t> nextOutput = 0;
+    std::atomic_bool failed = false;
+
+    auto rewindOutputs = [this, &outputs, &results, &nextOutput, &failed]() {
+        try
+        {
+            size_t i = nextOutput++;
+            while (i < outputs.size() && !failed) {
+                results[i] = GetWalletOutput(outputs[i]);
+                i = nextOutput++;
+            }
+        }
+        catch (std::exception& e)
+        {
+            WALLET_ERROR_F("Failed to rewind outputs. Error: {}", e.what());
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::min(numThreads, outputs.size()); i++) {
+        threads.emplace_back(std::thread(rewindOutputs));
+    }
+
+    ThreadUtil::JoinAll(threads);
+
+    if (failed) {
+        throw WALLET_EXCEPTION("Failed to rewind outputs");
+    }
+
+    std::vector<OutputDataEntity> walletOutputs;
+    for (auto& pOutputDataEntity : results) {
+        if (pOutputDataEntity != nullptr) {
+            walletOutputs.emplace_back(std::move(*pOutputDataEntity));
+        }
+    }
 
     return walletOutputs;
 }
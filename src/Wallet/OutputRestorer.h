@@ -5,6 +5,8 @@
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
 #include <Core/Models/DTOs/OutputDTO.h>
 #include <Crypto/BulletproofType.h>
+#include <functional>
+#include <unordered_set>
 
 // Forward Declarations
 class KeyChain;
@@ -13,15 +15,32 @@ class RewoundProof;
 class OutputRestorer
 {
 public:
+	//
+	// Called after each window of leaves is rewound, with the wallet outputs found in that window
+	// and the last leaf index checked. Persisting both allows an interrupted restore to resume.
+	//
+	using WindowCallback = std::function<void(std::vector<OutputDataEntity>&& outputs, const uint64_t lastLeafIndex)>;
+
 	OutputRestorer(INodeClientConstPtr pNodeClient, const KeyChain& keyChain)
 		: m_pNodeClient(pNodeClient), m_keyChain(keyChain) { }
 
-	std::vector<OutputDataEntity> FindAndRewindOutputs(
-		const std::shared_ptr<IWalletDB>& pBatch,
-		const bool fromGenesis
+	//
+	// Rewinds every unspent output from startLeafIndex up to the chain's highest leaf index.
+	// Outputs are fetched in windows of one batch per core, and each window's rewinds are spread across all cores.
+	// Spent outputs and outputs in knownCommitments are rejected without rewinding.
+	//
+	void FindAndRewindOutputs(
+		const uint64_t startLeafIndex,
+		const std::unordered_set<Commitment>& knownCommitments,
+		const WindowCallback& onWindowRewound
 	) const;
 
 private:
+	std::vector<OutputDataEntity> RewindOutputs(
+		const std::vector<OutputDTO>& outputs,
+		const size_t numThreads
+	) const;
+
 	std::unique_ptr<OutputDataEntity> GetWalletOutput(
 		const OutputDTO& output
 	) const;
@@ -34,4 +53,4 @@ private:
 
 	INodeClientConstPtr m_pNodeClient;
 	const KeyChain& m_keyChain;
-};
\ No newline at end of file
+};
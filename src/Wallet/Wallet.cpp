@@ -12,6 +12,7 @@
 
 #include "CancelTx.h"
 #include "WalletTxLoader.h"
+#include "WalletBalanceLoader.h"
 #include "Keychain/Mnemonic.h"
 #include "SlateBuilder/CoinSelection.h"
 
@@ -34,39 +35,7 @@ WalletSummaryDTO Wallet::GetWalletSummary() const
 
 WalletBalanceDTO Wallet::GetBalance() const
 {
-	uint64_t awaitingConfirmation = 0;
-	uint64_t immature = 0;
-	uint64_t locked = 0;
-	uint64_t spendable = 0;
-
-    auto pWalletDB = m_walletDB.Read();
-	const std::vector<OutputDataEntity> outputs = pWalletDB->GetOutputs(m_master_seed);
-	for (const OutputDataEntity& outputData : outputs)
-	{
-		const EOutputStatus status = outputData.GetStatus();
-		if (status == EOutputStatus::LOCKED) {
-			locked += outputData.GetAmount();
-		} else if (status == EOutputStatus::SPENDABLE) {
-			const EOutputFeatures features = outputData.GetFeatures();
-			const uint64_t output_height = outputData.GetBlockHeight().value_or(0);
-			const uint64_t current_height = pWalletDB->GetRefreshBlockHeight();
-			if (WalletUtil::IsOutputImmature(features, output_height, current_height)) {
-				immature += outputData.GetAmount();
-			} else {
-				spendable += outputData.GetAmount();
-			}
-		} if (status == EOutputStatus::NO_CONFIRMATIONS) {
-			awaitingConfirmation += outputData.GetAmount();
-		}
-	}
-
-	return WalletBalanceDTO(
-        pWalletDB->GetRefreshBlockHeight(),
-		awaitingConfirmation,
-		immature,
-		locked,
-		spendable
-	);
+	return WalletBalanceLoader().LoadBalance(m_walletDB.Read().GetShared(), m_master_seed);
 }
 
 std::unique_ptr<WalletTx> Wallet::GetTransactionById(const uint32_t txId) const
@@ -109,22 +78,30 @@ std::vector<WalletTxDTO> Wallet::GetTransactions(const ListTxsCriteria& criteria
 
 std::vector<WalletOutputDTO> Wallet::GetOutputs(const bool includeSpent, const bool includeCanceled) const
 {
-    std::vector<WalletOutputDTO> filtered_outputs;
+	std::vector<EOutputStatus> statuses = {
+		EOutputStatus::NO_CONFIRMATIONS,
+		EOutputStatus::SPENDABLE,
+		EOutputStatus::IMMATURE,
+		EOutputStatus::LOCKED
+	};
+	if (includeSpent) {
+		statuses.push_back(EOutputStatus::SPENT);
+	}
 
-	const std::vector<OutputDataEntity> all_outputs = m_walletDB.Read()->GetOutputs(m_master_seed);
-	for (const OutputDataEntity& output_data : all_outputs)
-	{
-		const EOutputStatus status = output_data.GetStatus();
-        if (status == EOutputStatus::SPENT && !includeSpent) {
-            continue;
-        } else if (status == EOutputStatus::CANCELED && !includeCanceled) {
-            continue;
-        }
+	if (includeCanceled) {
+		statuses.push_back(EOutputStatus::CANCELED);
+	}
 
-        filtered_outputs.push_back(WalletOutputDTO::FromOutputData(output_data));
-    }
+	std::vector<WalletOutputDTO> filtered_outputs;
 
-    return filtered_outputs;
+	const std::vector<OutputDataEntity> outputs = m_walletDB.Read()->GetOutputs(m_master_seed, statuses);
+	std::transform(
+		outputs.cbegin(), outputs.cend(),
+		std::back_inserter(filtered_outputs),
+		[](const OutputDataEntity& output_data) { return WalletOutputDTO::FromOutputData(output_data); }
+	);
+
+	return filtered_outputs;
 }
 
 Slate Wallet::GetSlate(const uuids::uuid& slateId, const SlateStage& stage) const
@@ -171,13 +148,7 @@ FeeEstimateDTO Wallet::EstimateFee(const EstimateFeeCriteria& criteria) const
 	// Select inputs using desired selection strategy.
 	const uint8_t totalNumOutputs = criteria.GetNumChangeOutputs() + 1;
 	const uint64_t numKernels = 1;
-	std::vector<OutputDataEntity> all_outputs = m_walletDB.Read()->GetOutputs(m_master_seed);
-    std::vector<OutputDataEntity> available_coins;
-    std::copy_if(
-        all_outputs.cbegin(), all_outputs.cend(),
-        std::back_inserter(available_coins),
-        [](const OutputDataEntity& output_data) { return output_data.GetStatus() == EOutputStatus::SPENDABLE; }
-    );
+	std::vector<OutputDataEntity> available_coins = m_walletDB.Read()->GetOutputs(m_master_seed, { EOutputStatus::SPENDABLE });
 
 	std::vector<OutputDataEntity> inputs = available_coins;
 	
@@ -0,0 +1,40 @@
+#include "WalletBalanceLoader.h"
+
+#include <Consensus.h>
+#include <Wallet/WalletDB/WalletDB.h>
+#include <Wallet/WalletUtil.h>
+
+WalletBalanceDTO WalletBalanceLoader::LoadBalance(
+    const std::shared_ptr<const IWalletDB>& pWalletDB,
+    const SecureVector& masterSeed) const
+{
+    const uint64_t current_height = pWalletDB->GetRefreshBlockHeight();
+    std::map<EOutputStatus, uint64_t> totals = pWalletDB->GetOutputTotals(masterSeed);
+
+    uint64_t immature = 0;
+    uint64_t spendable = totals[EOutputStatus::SPENDABLE];
+
+    // Outputs confirmed before this height have matured, whether coinbase or not.
+    const uint64_t maturity = (std::max)(Consensus::COINBASE_MATURITY, (uint64_t)Global::GetConfig().GetMinimumConfirmations());
+    const uint64_t min_height = (std::max)(current_height, maturity) - maturity;
+
+    std::vector<OutputDataEntity> recent_outputs = min_height == 0
+        ? pWalletDB->GetOutputs(masterSeed, { EOutputStatus::SPENDABLE })
+        : pWalletDB->GetRecentOutputs(masterSeed, { EOutputStatus::SPENDABLE }, min_height);
+    for (const OutputDataEntity& output : recent_outputs)
+    {
+        const uint64_t output_height = output.GetBlockHeight().value_or(0);
+        if (WalletUtil::IsOutputImmature(output.GetFeatures(), output_height, current_height)) {
+            immature += output.GetAmount();
+            spendable -= (std::min)(spendable, output.GetAmount());
+        }
+    }
+
+    return WalletBalanceDTO(
+        current_height,
+        totals[EOutputStatus::NO_CONFIRMATIONS],
+        immature,
+        totals[EOutputStatus::LOCKED],
+        spendable
+    );
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Wallet/Models/DTOs/WalletBalanceDTO.h>
+#include <Common/Secure.h>
+#include <memory>
+
+// Forward Declarations
+class IWalletDB;
+
+class WalletBalanceLoader
+{
+public:
+    //
+    // Calculates the balance from the wallet's materialized output totals.
+    // Only spendable outputs recent enough to still be immature are decrypted.
+    //
+    WalletBalanceDTO LoadBalance(
+        const std::shared_ptr<const IWalletDB>& pWalletDB,
+        const SecureVector& masterSeed
+    ) const;
+};
@@ -33,6 +33,34 @@ void SqliteDB::Statement::Finalize()
 	}
 }
 
+void SqliteDB::Statement::Execute(const std::vector<IParameter::UPtr>& parameters)
+{
+    Bind(parameters);
+
+    const int result = sqlite3_step(m_pStatement);
+    Reset();
+
+    if (result != SQLITE_DONE && result != SQLITE_ROW) {
+        WALLET_ERROR_F("Error executing statement: {}", sqlite3_errmsg(m_pDatabase));
+        throw WALLET_STORE_EXCEPTION("Error executing statement.");
+    }
+}
+
+void SqliteDB::Statement::Bind(const std::vector<IParameter::UPtr>& parameters)
+{
+    int index = 1;
+    for (const auto& pParam : parameters)
+    {
+        pParam->Bind(m_pStatement, index++);
+    }
+}
+
+void SqliteDB::Statement::Reset()
+{
+    sqlite3_reset(m_pStatement);
+    sqlite3_clear_bindings(m_pStatement);
+}
+
 bool SqliteDB::Statement::IsColumnNull(const int col) const
 {
 	return sqlite3_column_type(m_pStatement, col) == SQLITE_NULL;
@@ -81,7 +109,14 @@ SqliteDB::Ptr SqliteDB::Open(const fs::path& db_path, const std::string& usernam
         throw WALLET_STORE_EXCEPTION("Failed to open wallet.db");
     }
 
-    return std::make_shared<SqliteDB>(pDatabase, username);
+    auto pSqliteDB = std::make_shared<SqliteDB>(pDatabase, username);
+
+    // WAL lets readers proceed during writes, and only needs to sync on checkpoints when synchronous=NORMAL.
+    // A crash can't corrupt the database in this mode, though a power loss may roll back the most recent commits.
+    pSqliteDB->Execute("PRAGMA journal_mode=WAL;");
+    pSqliteDB->Execute("PRAGMA synchronous=NORMAL;");
+
+    return pSqliteDB;
 }
 
 void SqliteDB::Execute(const std::string& command)
@@ -94,6 +129,18 @@ void SqliteDB::Execute(const std::string& command)
 	}
 }
 
+SqliteDB::Statement::UPtr SqliteDB::Prepare(const std::string& statement)
+{
+	sqlite3_stmt* stmt = nullptr;
+	if (sqlite3_prepare_v2(m_pDatabase, statement.c_str(), -1, &stmt, NULL) != SQLITE_OK) {
+		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(m_pDatabase));
+		sqlite3_finalize(stmt);
+		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
+	}
+
+    return std::make_unique<SqliteDB::Statement>(m_pDatabase, stmt);
+}
+
 void SqliteDB::Update(const std::string& statement, const std::vector<IParameter::UPtr>& parameters)
 {
 	sqlite3_stmt* stmt = nullptr;
@@ -160,6 +207,14 @@ void IntParameter::Bind(sqlite3_stmt* stmt, const int index) const
     }
 }
 
+void Int64Parameter::Bind(sqlite3_stmt* stmt, const int index) const
+{
+	if (sqlite3_bind_int64(stmt, index, m_value) != SQLITE_OK) {
+		WALLET_ERROR_F("Failed to bind: {}", m_value);
+		throw WALLET_STORE_EXCEPTION("Failed to bind.");
+    }
+}
+
 void BlobParameter::Bind(sqlite3_stmt* stmt, const int index) const
 {
 	if (sqlite3_bind_blob(stmt, index, (const void*)m_blob.data(), (int)m_blob.size(), NULL) != SQLITE_OK) {
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 // Forward Declarations
 struct sqlite3;
@@ -12,6 +13,8 @@ struct sqlite3_stmt;
 class SqliteDB
 {
 public:
+    class IParameter;
+
     class Statement
     {
     public:
@@ -24,6 +27,18 @@ public:
         bool Step();
         void Finalize();
 
+        //
+        // Binds the parameters, runs the statement to completion, and resets it so it can be executed again.
+        // Throws a WalletStoreException if the statement fails.
+        //
+        void Execute(const std::vector<std::unique_ptr<IParameter>>& parameters);
+
+        //
+        // Bind and Reset allow a prepared query to be stepped through repeatedly with different parameters.
+        //
+        void Bind(const std::vector<std::unique_ptr<IParameter>>& parameters);
+        void Reset();
+
         bool IsColumnNull(const int col) const;
         int GetColumnInt(const int col) const;
         int64_t GetColumnInt64(const int col) const;
@@ -54,6 +69,12 @@ public:
     ~SqliteDB();
 
     void Execute(const std::string& command);
+
+    //
+    // Compiles the statement once, so it can be executed repeatedly (e.g. for batch inserts) without being recompiled.
+    //
+    Statement::UPtr Prepare(const std::string& statement);
+
     void Update(const std::string& statement, const std::vector<IParameter::UPtr>& parameters = {});
     Statement::UPtr Query(const std::string& query, const std::vector<IParameter::UPtr>& parameters = {});
     std::string GetError() const;
@@ -93,6 +114,21 @@ private:
     int m_value;
 };
 
+class Int64Parameter : public SqliteDB::IParameter
+{
+public:
+    Int64Parameter(const int64_t value) : m_value(value) { }
+    static SqliteDB::IParameter::UPtr New(const int64_t value)
+    {
+        return SqliteDB::IParameter::UPtr((SqliteDB::IParameter*)new Int64Parameter(value));
+    }
+
+    void Bind(sqlite3_stmt* stmt, const int index) const final;
+
+private:
+    int64_t m_value;
+};
+
 class BlobParameter : public SqliteDB::IParameter
 {
 public:
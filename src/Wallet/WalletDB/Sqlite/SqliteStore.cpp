@@ -8,6 +8,7 @@
 #include "Tables/SlateContextTable.h"
 #include "Tables/SlateTable.h"
 #include "Tables/AccountsTable.h"
+#include "Tables/RefreshCheckpointsTable.h"
 
 #include <Wallet/WalletDB/WalletStoreException.h>
 #include <Common/Util/FileUtil.h>
@@ -54,10 +55,12 @@ Locked<IWalletDB> SqliteStore::OpenWallet(const std::string& username, const Sec
 
 		VersionTable::UpdateSchema(*pDatabase, version);
 		OutputsTable::UpdateSchema(*pDatabase, masterSeed, version);
+		TransactionsTable::UpdateSchema(*pDatabase, masterSeed, version);
 		MetadataTable::UpdateSchema(*pDatabase, version);
 		SlateContextTable::UpdateSchema(*pDatabase, version);
 		SlateTable::UpdateSchema(*pDatabase, version);
 		AccountsTable::UpdateSchema(*pDatabase, version);
+		RefreshCheckpointsTable::UpdateSchema(*pDatabase, version);
 
 		transaction.Commit();
 	} else if (version > LATEST_SCHEMA_VERSION) {
@@ -153,6 +156,7 @@ SqliteDB::Ptr SqliteStore::CreateWalletDB(const std::string& username)
 		SlateContextTable::CreateTable(*pDatabase);
 		SlateTable::CreateTable(*pDatabase);
 		AccountsTable::CreateTable(*pDatabase);
+		RefreshCheckpointsTable::CreateTable(*pDatabase);
 
 		KeyChainPath nextChildPath = KeyChainPath::FromString("m/0/0").GetRandomChild();
 		std::string table_creation_cmd = StringUtil::Format("insert into accounts values('m/0/0','DEFAULT',{}, 0);", nextChildPath.GetKeyIndices().back());
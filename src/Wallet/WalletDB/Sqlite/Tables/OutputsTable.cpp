@@ -1,5 +1,4 @@
 #include "OutputsTable.h"
-#include "../../WalletEncryptionUtil.h"
 
 #include <Common/Logger.h>
 #include <Common/Util/StringUtil.h>
@@ -10,88 +9,283 @@
 // commitment: TEXT NOT NULL
 // status: INTEGER NOT NULL
 // transaction_id: INTEGER
+// block_height: INTEGER
+// encrypted: BLOB NOT NULL
+//
+// TABLE: output_totals
+// id: INTEGER PRIMARY KEY
 // encrypted: BLOB NOT NULL
 void OutputsTable::CreateTable(SqliteDB& database)
 {
-	std::string table_creation_cmd = "create table outputs(id INTEGER PRIMARY KEY, commitment TEXT UNIQUE NOT NULL, status INTEGER NOT NULL, transaction_id INTEGER, encrypted BLOB NOT NULL);";
+	std::string table_creation_cmd = "create table outputs(id INTEGER PRIMARY KEY, commitment TEXT UNIQUE NOT NULL, status INTEGER NOT NULL, transaction_id INTEGER, block_height INTEGER, encrypted BLOB NOT NULL);";
 	database.Execute(table_creation_cmd);
+
+	CreateIndices(database);
+}
+
+void OutputsTable::CreateIndices(SqliteDB& database)
+{
+	std::string index_creation_cmd = "create index if not exists outputs_status_height on outputs(status, block_height);";
+	index_creation_cmd += "create index if not exists outputs_transaction_id on outputs(transaction_id);";
+	index_creation_cmd += "create table if not exists output_totals(id INTEGER PRIMARY KEY, encrypted BLOB NOT NULL);";
+	database.Execute(index_creation_cmd);
+}
+
+bool OutputsTable::DoesColumnExist(SqliteDB& database, const std::string& columnName)
+{
+	// Each row describes one column, with its name in the 2nd column.
+	auto pStatement = database.Query("PRAGMA table_info(outputs)");
+	while (pStatement->Step()) {
+		if (pStatement->GetColumnString(1) == columnName) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void OutputsTable::UpdateSchema(SqliteDB& database, const SecureVector& masterSeed, const int previousVersion)
 {
-	if (previousVersion >= 1) {
-		return;
+	WalletEncryptionUtil::KeyCache keyCache;
+
+	if (previousVersion < 1) {
+		// Create "new_outputs" table
+		std::string table_creation_cmd = "create table new_outputs(id INTEGER PRIMARY KEY, commitment TEXT UNIQUE NOT NULL, status INTEGER NOT NULL, transaction_id INTEGER, block_height INTEGER, encrypted BLOB NOT NULL);";
+		database.Execute(table_creation_cmd);
+
+		// Load all outputs from existing table
+		std::vector<OutputDataEntity> outputs = GetOutputs(database, keyCache, masterSeed, previousVersion);
+
+		// Add outputs to "new_outputs" table
+		AddOutputs(database, keyCache, masterSeed, outputs, "new_outputs", nullptr);
+
+		// Delete existing table
+		std::string drop_table_cmd = "DROP TABLE outputs";
+		database.Execute(drop_table_cmd);
+
+		// Rename "new_outputs" table to "outputs"
+		const std::string rename_table_cmd = "ALTER TABLE new_outputs RENAME TO outputs";
+		database.Execute(rename_table_cmd);
 	}
 
-	// Create "new_outputs" table
-	std::string table_creation_cmd = "create table new_outputs(id INTEGER PRIMARY KEY, commitment TEXT UNIQUE NOT NULL, status INTEGER NOT NULL, transaction_id INTEGER, encrypted BLOB NOT NULL);";
-	database.Execute(table_creation_cmd);
+	if (previousVersion < 6) {
+		WALLET_INFO("Adding indexed columns to outputs table");
 
-	// Load all outputs from existing table
-	std::vector<OutputDataEntity> outputs = GetOutputs(database, masterSeed, previousVersion);
+		// Outputs tables rebuilt by the v1 migration already have the column.
+		if (!DoesColumnExist(database, "block_height")) {
+			database.Execute("ALTER TABLE outputs ADD block_height INTEGER;");
+		}
 
-	// Add outputs to "new_outputs" table
-	AddOutputs(database, masterSeed, outputs, "new_outputs");
+		CreateIndices(database);
 
-	// Delete existing table
-	std::string drop_table_cmd = "DROP TABLE outputs";
-	database.Execute(drop_table_cmd);
+		// Populate the new column and the totals from the encrypted outputs.
+		std::map<EOutputStatus, uint64_t> totals;
+		auto pStatement = database.Prepare("update outputs set block_height=? where commitment=?");
+		for (const OutputDataEntity& output : GetOutputs(database, keyCache, masterSeed, previousVersion))
+		{
+			if (output.GetBlockHeight().has_value()) {
+				std::vector<SqliteDB::IParameter::UPtr> parameters;
+				parameters.push_back(Int64Parameter::New((int64_t)output.GetBlockHeight().value()));
+				parameters.push_back(TextParameter::New(output.GetCommitment().ToHex()));
+				pStatement->Execute(parameters);
+			}
+
+			totals[output.GetStatus()] += output.GetAmount();
+		}
 
-	// Rename "new_outputs" table to "outputs"
-	const std::string rename_table_cmd = "ALTER TABLE new_outputs RENAME TO outputs";
-	database.Execute(rename_table_cmd);
+		SaveTotals(database, keyCache, masterSeed, totals);
+	}
 }
 
-void OutputsTable::AddOutputs(SqliteDB& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs)
+void OutputsTable::AddOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs)
 {
-	AddOutputs(database, masterSeed, outputs, "outputs");
+	if (outputs.empty()) {
+		return;
+	}
+
+	std::map<EOutputStatus, uint64_t> totals = GetTotals(database, keyCache, masterSeed);
+	AddOutputs(database, keyCache, masterSeed, outputs, "outputs", &totals);
+	SaveTotals(database, keyCache, masterSeed, totals);
 }
 
-void OutputsTable::AddOutputs(SqliteDB& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs, const std::string& tableName)
+void OutputsTable::AddOutputs(
+	SqliteDB& database,
+	WalletEncryptionUtil::KeyCache& keyCache,
+	const SecureVector& masterSeed,
+	const std::vector<OutputDataEntity>& outputs,
+	const std::string& tableName,
+	std::map<EOutputStatus, uint64_t>* pTotals)
 {
+	if (outputs.empty()) {
+		return;
+	}
+
+	std::string insert_output_cmd = "insert into " + tableName + "(commitment, status, transaction_id, block_height, encrypted) values(?, ?, ?, ?, ?)";
+	insert_output_cmd += " ON CONFLICT(commitment) DO UPDATE SET status=excluded.status, transaction_id=excluded.transaction_id, block_height=excluded.block_height, encrypted=excluded.encrypted";
+	auto pStatement = database.Prepare(insert_output_cmd);
+
+	std::unique_ptr<SqliteDB::Statement> pStatusStatement = nullptr;
+	if (pTotals != nullptr) {
+		pStatusStatement = database.Prepare("select status from " + tableName + " where commitment=?");
+	}
+
 	for (const OutputDataEntity& output : outputs)
 	{
 		WALLET_DEBUG_F("Saving output: {}", output.GetOutput());
 
-		std::string insert_output_cmd = "insert into " + tableName + "(commitment, status, transaction_id, encrypted) values(?, ?, ?, ?)";
-		insert_output_cmd += " ON CONFLICT(commitment) DO UPDATE SET status=excluded.status, transaction_id=excluded.transaction_id, encrypted=excluded.encrypted";
+		const std::string commitmentHex = output.GetOutput().GetCommitment().ToHex();
+
+		if (pTotals != nullptr) {
+			// An output's amount never changes, so updating the totals only requires the status it's moving from.
+			std::vector<SqliteDB::IParameter::UPtr> statusParameters;
+			statusParameters.push_back(TextParameter::New(commitmentHex));
+			pStatusStatement->Bind(statusParameters);
+			if (pStatusStatement->Step()) {
+				uint64_t& previousTotal = (*pTotals)[(EOutputStatus)pStatusStatement->GetColumnInt(0)];
+				previousTotal -= (std::min)(previousTotal, output.GetAmount());
+			}
+			pStatusStatement->Reset();
+
+			(*pTotals)[output.GetStatus()] += output.GetAmount();
+		}
 
 		Serializer serializer;
 		output.Serialize(serializer);
-		std::vector<uint8_t> encrypted = WalletEncryptionUtil::Encrypt(masterSeed, "OUTPUT", serializer.GetSecureBytes());
+		std::vector<uint8_t> encrypted = WalletEncryptionUtil::Encrypt(keyCache, masterSeed, "OUTPUT", serializer.GetSecureBytes());
 
 		std::vector<SqliteDB::IParameter::UPtr> parameters;
-		parameters.push_back(std::make_unique<TextParameter>(output.GetOutput().GetCommitment().ToHex()));
+		parameters.push_back(std::make_unique<TextParameter>(commitmentHex));
 		parameters.push_back(std::make_unique<IntParameter>((int)output.GetStatus()));
-		
+
 		if (output.GetWalletTxId().has_value()) {
 			parameters.push_back(std::make_unique<IntParameter>((int)output.GetWalletTxId().value()));
 		} else {
 			parameters.push_back(std::make_unique<NullParameter>());
 		}
 
+		if (output.GetBlockHeight().has_value()) {
+			parameters.push_back(std::make_unique<Int64Parameter>((int64_t)output.GetBlockHeight().value()));
+		} else {
+			parameters.push_back(std::make_unique<NullParameter>());
+		}
+
 		parameters.push_back(std::make_unique<BlobParameter>(encrypted));
 
-		database.Update(insert_output_cmd, parameters);
+		pStatement->Execute(parameters);
 	}
 }
 
-std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteDB& database, const SecureVector& masterSeed)
+std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed)
 {
-	return GetOutputs(database, masterSeed, 1);
+	return GetOutputs(database, keyCache, masterSeed, 1);
 }
 
-std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteDB& database, const SecureVector& masterSeed, const int /*version*/)
+std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<EOutputStatus>& statuses)
+{
+	if (statuses.empty()) {
+		return std::vector<OutputDataEntity>();
+	}
+
+	// Status is stored unencrypted, so only the matching outputs need to be decrypted.
+	std::string get_encrypted_query = "select encrypted from outputs where status in (" + ToList(statuses) + ")";
+	auto pStatement = database.Query(get_encrypted_query);
+
+	return DecryptOutputs(keyCache, masterSeed, *pStatement);
+}
+
+std::vector<OutputDataEntity> OutputsTable::GetRecentOutputs(
+	SqliteDB& database,
+	WalletEncryptionUtil::KeyCache& keyCache,
+	const SecureVector& masterSeed,
+	const std::vector<EOutputStatus>& statuses,
+	const uint64_t minBlockHeight)
+{
+	if (statuses.empty()) {
+		return std::vector<OutputDataEntity>();
+	}
+
+	std::string get_encrypted_query = StringUtil::Format(
+		"select encrypted from outputs where status in ({}) and block_height >= {}",
+		ToList(statuses),
+		minBlockHeight
+	);
+	auto pStatement = database.Query(get_encrypted_query);
+
+	return DecryptOutputs(keyCache, masterSeed, *pStatement);
+}
+
+std::vector<OutputDataEntity> OutputsTable::GetOutputsByTxIds(
+	SqliteDB& database,
+	WalletEncryptionUtil::KeyCache& keyCache,
+	const SecureVector& masterSeed,
+	const std::unordered_set<uint32_t>& walletTxIds)
+{
+	if (walletTxIds.empty()) {
+		return std::vector<OutputDataEntity>();
+	}
+
+	std::string get_encrypted_query = "select encrypted from outputs where transaction_id in (" + ToList(walletTxIds) + ")";
+	auto pStatement = database.Query(get_encrypted_query);
+
+	return DecryptOutputs(keyCache, masterSeed, *pStatement);
+}
+
+std::map<EOutputStatus, uint64_t> OutputsTable::GetTotals(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed)
+{
+	std::map<EOutputStatus, uint64_t> totals;
+
+	auto pStatement = database.Query("select encrypted from output_totals where id=1");
+	if (pStatement->Step())
+	{
+		std::vector<uint8_t> encrypted = pStatement->GetColumnBytes(0);
+		SecureVector decrypted = WalletEncryptionUtil::Decrypt(keyCache, masterSeed, "OUTPUT_TOTALS", encrypted);
+		std::vector<uint8_t> decryptedUnsafe(decrypted.begin(), decrypted.end());
+
+		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
+		const uint8_t numTotals = byteBuffer.ReadU8();
+		for (uint8_t i = 0; i < numTotals; i++)
+		{
+			const EOutputStatus status = (EOutputStatus)byteBuffer.ReadU8();
+			totals[status] = byteBuffer.ReadU64();
+		}
+	}
+
+	return totals;
+}
+
+void OutputsTable::SaveTotals(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::map<EOutputStatus, uint64_t>& totals)
+{
+	Serializer serializer;
+	serializer.Append<uint8_t>((uint8_t)totals.size());
+	for (const auto& total : totals)
+	{
+		serializer.Append<uint8_t>((uint8_t)total.first);
+		serializer.Append<uint64_t>(total.second);
+	}
+
+	std::vector<uint8_t> encrypted = WalletEncryptionUtil::Encrypt(keyCache, masterSeed, "OUTPUT_TOTALS", serializer.GetSecureBytes());
+
+	std::vector<SqliteDB::IParameter::UPtr> parameters;
+	parameters.push_back(BlobParameter::New(encrypted));
+	database.Update("insert or replace into output_totals(id, encrypted) values(1, ?)", parameters);
+}
+
+std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const int /*version*/)
 {
 	// Prepare statement
 	std::string get_encrypted_query = "select encrypted from outputs";
 	auto pStatement = database.Query(get_encrypted_query);
 
+	return DecryptOutputs(keyCache, masterSeed, *pStatement);
+}
+
+std::vector<OutputDataEntity> OutputsTable::DecryptOutputs(WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, SqliteDB::Statement& statement)
+{
 	std::vector<OutputDataEntity> outputs;
-	while (pStatement->Step())
+	while (statement.Step())
 	{
-		std::vector<uint8_t> encrypted = pStatement->GetColumnBytes(0);
-		SecureVector decrypted = WalletEncryptionUtil::Decrypt(masterSeed, "OUTPUT", encrypted);
+		std::vector<uint8_t> encrypted = statement.GetColumnBytes(0);
+		SecureVector decrypted = WalletEncryptionUtil::Decrypt(keyCache, masterSeed, "OUTPUT", encrypted);
 		std::vector<uint8_t> decryptedUnsafe(decrypted.begin(), decrypted.end());
 
 		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
@@ -99,4 +293,4 @@ std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteDB& database, const
 	}
 
 	return outputs;
-}
\ No newline at end of file
+}
@@ -2,8 +2,11 @@
 
 #include <Common/Secure.h>
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
+#include <map>
+#include <unordered_set>
 
 #include "../SqliteDB.h"
+#include "../../WalletEncryptionUtil.h"
 
 class OutputsTable
 {
@@ -11,10 +14,43 @@ public:
 	static void CreateTable(SqliteDB& database);
 	static void UpdateSchema(SqliteDB& database, const SecureVector& masterSeed, const int previousVersion);
 
-	static void AddOutputs(SqliteDB& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs);
-	static std::vector<OutputDataEntity> GetOutputs(SqliteDB& database, const SecureVector& masterSeed);
+	static void AddOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs);
+	static std::vector<OutputDataEntity> GetOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed);
+	static std::vector<OutputDataEntity> GetOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<EOutputStatus>& statuses);
+	static std::vector<OutputDataEntity> GetRecentOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<EOutputStatus>& statuses, const uint64_t minBlockHeight);
+	static std::vector<OutputDataEntity> GetOutputsByTxIds(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::unordered_set<uint32_t>& walletTxIds);
+
+	//
+	// The total amount of the outputs with each status. These are updated whenever outputs are added or saved.
+	//
+	static std::map<EOutputStatus, uint64_t> GetTotals(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed);
 
 private:
-	static void AddOutputs(SqliteDB& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs, const std::string& tableName);
-	static std::vector<OutputDataEntity> GetOutputs(SqliteDB& database, const SecureVector& masterSeed, const int version);
-};
\ No newline at end of file
+	static void CreateIndices(SqliteDB& database);
+	static bool DoesColumnExist(SqliteDB& database, const std::string& columnName);
+
+	static void AddOutputs(
+		SqliteDB& database,
+		WalletEncryptionUtil::KeyCache& keyCache,
+		const SecureVector& masterSeed,
+		const std::vector<OutputDataEntity>& outputs,
+		const std::string& tableName,
+		std::map<EOutputStatus, uint64_t>* pTotals
+	);
+	static std::vector<OutputDataEntity> GetOutputs(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const int version);
+	static std::vector<OutputDataEntity> DecryptOutputs(WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, SqliteDB::Statement& statement);
+
+	static void SaveTotals(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::map<EOutputStatus, uint64_t>& totals);
+
+	template<typename T>
+	static std::string ToList(const T& values)
+	{
+		std::string list;
+		for (const auto& value : values)
+		{
+			list += (list.empty() ? "" : ",") + std::to_string((int64_t)value);
+		}
+
+		return list;
+	}
+};
@@ -0,0 +1,63 @@
+#include "RefreshCheckpointsTable.h"
+
+#include <Common/Logger.h>
+#include <Common/Util/StringUtil.h>
+#include <Wallet/WalletDB/WalletStoreException.h>
+
+// TABLE: refresh_checkpoints
+// height: INTEGER PRIMARY KEY
+// hash: TEXT NOT NULL
+// restore_leaf_index: INTEGER NOT NULL
+void RefreshCheckpointsTable::CreateTable(SqliteDB& database)
+{
+	std::string table_creation_cmd = "create table if not exists refresh_checkpoints(height INTEGER PRIMARY KEY, hash TEXT NOT NULL, restore_leaf_index INTEGER NOT NULL);";
+	database.Execute(table_creation_cmd);
+}
+
+void RefreshCheckpointsTable::UpdateSchema(SqliteDB& database, const int previousVersion)
+{
+	if (previousVersion < 5) {
+		CreateTable(database);
+	}
+}
+
+std::vector<RefreshCheckpoint> RefreshCheckpointsTable::GetCheckpoints(SqliteDB& database)
+{
+	std::string get_checkpoints_query = "SELECT height, hash, restore_leaf_index FROM refresh_checkpoints ORDER BY height DESC";
+	auto pStatement = database.Query(get_checkpoints_query);
+
+	std::vector<RefreshCheckpoint> checkpoints;
+	while (pStatement->Step())
+	{
+		const uint64_t height = (uint64_t)pStatement->GetColumnInt64(0);
+		const Hash hash = Hash::FromHex(pStatement->GetColumnString(1));
+		const uint64_t restoreLeafIndex = (uint64_t)pStatement->GetColumnInt64(2);
+
+		checkpoints.emplace_back(RefreshCheckpoint(height, hash, restoreLeafIndex));
+	}
+
+	return checkpoints;
+}
+
+void RefreshCheckpointsTable::AddCheckpoint(SqliteDB& database, const RefreshCheckpoint& checkpoint)
+{
+	std::string insert_checkpoint_cmd = StringUtil::Format(
+		"insert or replace into refresh_checkpoints(height, hash, restore_leaf_index) values({}, '{}', {});",
+		checkpoint.GetHeight(),
+		checkpoint.GetHash().ToHex(),
+		checkpoint.GetRestoreLeafIndex()
+	);
+	database.Execute(insert_checkpoint_cmd);
+}
+
+void RefreshCheckpointsTable::DeleteCheckpointsAbove(SqliteDB& database, const uint64_t height)
+{
+	std::string delete_checkpoints_cmd = StringUtil::Format("delete from refresh_checkpoints where height > {};", height);
+	database.Execute(delete_checkpoints_cmd);
+}
+
+void RefreshCheckpointsTable::DeleteCheckpointsBelow(SqliteDB& database, const uint64_t height)
+{
+	std::string delete_checkpoints_cmd = StringUtil::Format("delete from refresh_checkpoints where height < {};", height);
+	database.Execute(delete_checkpoints_cmd);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Wallet/WalletDB/Models/RefreshCheckpoint.h>
+
+#include "../SqliteDB.h"
+
+class RefreshCheckpointsTable
+{
+public:
+	static void CreateTable(SqliteDB& database);
+	static void UpdateSchema(SqliteDB& database, const int previousVersion);
+
+	static std::vector<RefreshCheckpoint> GetCheckpoints(SqliteDB& database);
+	static void AddCheckpoint(SqliteDB& database, const RefreshCheckpoint& checkpoint);
+	static void DeleteCheckpointsAbove(SqliteDB& database, const uint64_t height);
+	static void DeleteCheckpointsBelow(SqliteDB& database, const uint64_t height);
+};
@@ -1,5 +1,4 @@
 #include "TransactionsTable.h"
-#include "../../WalletEncryptionUtil.h"
 #include "../SqliteDB.h"
 
 #include <Common/Logger.h>
@@ -9,28 +8,55 @@
 // TABLE: transactions
 // id: INTEGER PRIMARY KEY
 // slate_id: TEXT
+// type: INTEGER
 // encrypted: BLOB NOT NULL
 void TransactionsTable::CreateTable(SqliteDB& database)
 {
-	const std::string table_creation_cmd = "create table transactions(id INTEGER PRIMARY KEY, slate_id TEXT, encrypted BLOB NOT NULL);";
+	std::string table_creation_cmd = "create table transactions(id INTEGER PRIMARY KEY, slate_id TEXT, type INTEGER, encrypted BLOB NOT NULL);";
+	table_creation_cmd += "create index if not exists transactions_type on transactions(type);";
 	database.Execute(table_creation_cmd);
 }
 
-void TransactionsTable::UpdateSchema(SqliteDB& /*database*/, const SecureVector& /*masterSeed*/, const int /*previousVersion*/)
+void TransactionsTable::UpdateSchema(SqliteDB& database, const SecureVector& masterSeed, const int previousVersion)
 {
-	return;
+	WalletEncryptionUtil::KeyCache keyCache;
+
+	if (previousVersion < 6) {
+		WALLET_INFO("Adding indexed columns to transactions table");
+
+		try {
+			database.Execute("ALTER TABLE transactions ADD type INTEGER;");
+		} catch (...) { }
+
+		database.Execute("create index if not exists transactions_type on transactions(type);");
+
+		// Populate the new column from the encrypted transactions.
+		auto pStatement = database.Prepare("update transactions set type=? where id=?");
+		for (const WalletTx& walletTx : GetTransactions(database, keyCache, masterSeed))
+		{
+			std::vector<SqliteDB::IParameter::UPtr> parameters;
+			parameters.push_back(IntParameter::New((int)walletTx.GetType()));
+			parameters.push_back(IntParameter::New((int)walletTx.GetId()));
+			pStatement->Execute(parameters);
+		}
+	}
 }
 
-void TransactionsTable::AddTransactions(SqliteDB& database, const SecureVector& masterSeed, const std::vector<WalletTx>& transactions)
+void TransactionsTable::AddTransactions(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<WalletTx>& transactions)
 {
+	if (transactions.empty()) {
+		return;
+	}
+
+	std::string insert_tx_cmd = "insert into transactions(id, slate_id, type, encrypted) values(?, ?, ?, ?)";
+	insert_tx_cmd += " ON CONFLICT(id) DO UPDATE SET slate_id=excluded.slate_id, type=excluded.type, encrypted=excluded.encrypted";
+	auto pStatement = database.Prepare(insert_tx_cmd);
+
 	for (const WalletTx& walletTx : transactions)
 	{
-		std::string insert_tx_cmd = "insert into transactions(id, slate_id, encrypted) values(?, ?, ?)";
-		insert_tx_cmd += " ON CONFLICT(id) DO UPDATE SET slate_id=excluded.slate_id, encrypted=excluded.encrypted";
-
 		Serializer serializer;
 		walletTx.Serialize(serializer);
-		std::vector<uint8_t> encrypted = WalletEncryptionUtil::Encrypt(masterSeed, "WALLET_TX", serializer.GetSecureBytes());
+		std::vector<uint8_t> encrypted = WalletEncryptionUtil::Encrypt(keyCache, masterSeed, "WALLET_TX", serializer.GetSecureBytes());
 
 		std::vector<SqliteDB::IParameter::UPtr> parameters;
 		parameters.push_back(IntParameter::New((int)walletTx.GetId()));
@@ -40,23 +66,57 @@ void TransactionsTable::AddTransactions(SqliteDB& database, const SecureVector&
 		} else {
 			parameters.push_back(NullParameter::New());
 		}
-		
+
+		parameters.push_back(IntParameter::New((int)walletTx.GetType()));
 		parameters.push_back(BlobParameter::New(encrypted));
-		
-		database.Update(insert_tx_cmd, parameters);
+
+		pStatement->Execute(parameters);
 	}
 }
 
-std::vector<WalletTx> TransactionsTable::GetTransactions(SqliteDB& database, const SecureVector& masterSeed)
+std::vector<WalletTx> TransactionsTable::GetTransactions(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed)
+{
+	std::string get_tx_query = "select encrypted from transactions";
+	auto pStatement = database.Query(get_tx_query);
+
+	return DecryptTransactions(keyCache, masterSeed, *pStatement);
+}
+
+std::vector<WalletTx> TransactionsTable::GetTransactions(
+	SqliteDB& database,
+	WalletEncryptionUtil::KeyCache& keyCache,
+	const SecureVector& masterSeed,
+	const std::unordered_set<uint32_t>& ids,
+	const std::unordered_set<EWalletTxType>& types)
 {
+	// Ids and types are stored unencrypted, so only the matching transactions need to be decrypted.
+	std::vector<std::string> conditions;
+	if (!ids.empty()) {
+		conditions.push_back("id in (" + ToList(ids) + ")");
+	}
+
+	if (!types.empty()) {
+		conditions.push_back("type in (" + ToList(types) + ")");
+	}
+
 	std::string get_tx_query = "select encrypted from transactions";
+	for (size_t i = 0; i < conditions.size(); i++)
+	{
+		get_tx_query += (i == 0 ? " where " : " and ") + conditions[i];
+	}
+
 	auto pStatement = database.Query(get_tx_query);
 
+	return DecryptTransactions(keyCache, masterSeed, *pStatement);
+}
+
+std::vector<WalletTx> TransactionsTable::DecryptTransactions(WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, SqliteDB::Statement& statement)
+{
 	std::vector<WalletTx> transactions;
-	while (pStatement->Step())
+	while (statement.Step())
 	{
-		std::vector<uint8_t> encrypted = pStatement->GetColumnBytes(0);
-		SecureVector decrypted = WalletEncryptionUtil::Decrypt(masterSeed, "WALLET_TX", encrypted);
+		std::vector<uint8_t> encrypted = statement.GetColumnBytes(0);
+		SecureVector decrypted = WalletEncryptionUtil::Decrypt(keyCache, masterSeed, "WALLET_TX", encrypted);
 		std::vector<uint8_t> decryptedUnsafe(decrypted.data(), decrypted.data() + decrypted.size());
 
 		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
@@ -66,7 +126,7 @@ std::vector<WalletTx> TransactionsTable::GetTransactions(SqliteDB& database, con
 	return transactions;
 }
 
-std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(SqliteDB& database, const SecureVector& masterSeed, const uint32_t walletTxId)
+std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const uint32_t walletTxId)
 {
 	std::string get_tx_query = "select encrypted from transactions where id=?";
 	std::vector<SqliteDB::IParameter::UPtr> parameters;
@@ -79,7 +139,7 @@ std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(SqliteDB& databa
 	}
 
 	std::vector<uint8_t> encrypted = pStatement->GetColumnBytes(0);
-	SecureVector decrypted = WalletEncryptionUtil::Decrypt(masterSeed, "WALLET_TX", encrypted);
+	SecureVector decrypted = WalletEncryptionUtil::Decrypt(keyCache, masterSeed, "WALLET_TX", encrypted);
 	std::vector<uint8_t> decryptedUnsafe(decrypted.data(), decrypted.data() + decrypted.size());
 
 	ByteBuffer byteBuffer(std::move(decryptedUnsafe));
@@ -2,9 +2,10 @@
 
 #include <Common/Secure.h>
 #include <Wallet/WalletTx.h>
+#include <unordered_set>
 
-// Forward Declarations
-class SqliteDB;
+#include "../SqliteDB.h"
+#include "../../WalletEncryptionUtil.h"
 
 class TransactionsTable
 {
@@ -12,7 +13,29 @@ public:
 	static void CreateTable(SqliteDB& database);
 	static void UpdateSchema(SqliteDB& database, const SecureVector& masterSeed, const int previousVersion);
 
-	static void AddTransactions(SqliteDB& database, const SecureVector& masterSeed, const std::vector<WalletTx>& transactions);
-	static std::vector<WalletTx> GetTransactions(SqliteDB& database, const SecureVector& masterSeed);
-	static std::unique_ptr<WalletTx> GetTransactionById(SqliteDB& database, const SecureVector& masterSeed, const uint32_t walletTxId);
+	static void AddTransactions(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const std::vector<WalletTx>& transactions);
+	static std::vector<WalletTx> GetTransactions(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed);
+	static std::vector<WalletTx> GetTransactions(
+		SqliteDB& database,
+		WalletEncryptionUtil::KeyCache& keyCache,
+		const SecureVector& masterSeed,
+		const std::unordered_set<uint32_t>& ids,
+		const std::unordered_set<EWalletTxType>& types
+	);
+	static std::unique_ptr<WalletTx> GetTransactionById(SqliteDB& database, WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, const uint32_t walletTxId);
+
+private:
+	static std::vector<WalletTx> DecryptTransactions(WalletEncryptionUtil::KeyCache& keyCache, const SecureVector& masterSeed, SqliteDB::Statement& statement);
+
+	template<typename T>
+	static std::string ToList(const T& values)
+	{
+		std::string list;
+		for (const auto& value : values)
+		{
+			list += (list.empty() ? "" : ",") + std::to_string((int64_t)value);
+		}
+
+		return list;
+	}
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "Tables/SlateTable.h"
 #include "Tables/SlateContextTable.h"
 #include "Tables/AccountsTable.h"
+#include "Tables/RefreshCheckpointsTable.h"
 
 #include <Wallet/WalletDB/WalletStoreException.h>
 #include <Wallet/Models/Slate/SlateStage.h>
@@ -96,27 +97,58 @@ void WalletSqlite::SaveSlateContext(const SecureVector& masterSeed, const uuids:
 
 void WalletSqlite::AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs)
 {
-	OutputsTable::AddOutputs(*m_pDatabase, masterSeed, outputs);
+	OutputsTable::AddOutputs(*m_pDatabase, m_keyCache, masterSeed, outputs);
 }
 
 std::vector<OutputDataEntity> WalletSqlite::GetOutputs(const SecureVector& masterSeed) const
 {
-	return OutputsTable::GetOutputs(*m_pDatabase, masterSeed);
+	return OutputsTable::GetOutputs(*m_pDatabase, m_keyCache, masterSeed);
+}
+
+std::vector<OutputDataEntity> WalletSqlite::GetOutputs(const SecureVector& masterSeed, const std::vector<EOutputStatus>& statuses) const
+{
+	return OutputsTable::GetOutputs(*m_pDatabase, m_keyCache, masterSeed, statuses);
+}
+
+std::vector<OutputDataEntity> WalletSqlite::GetRecentOutputs(
+	const SecureVector& masterSeed,
+	const std::vector<EOutputStatus>& statuses,
+	const uint64_t minBlockHeight) const
+{
+	return OutputsTable::GetRecentOutputs(*m_pDatabase, m_keyCache, masterSeed, statuses, minBlockHeight);
+}
+
+std::vector<OutputDataEntity> WalletSqlite::GetOutputsByTxIds(const SecureVector& masterSeed, const std::unordered_set<uint32_t>& walletTxIds) const
+{
+	return OutputsTable::GetOutputsByTxIds(*m_pDatabase, m_keyCache, masterSeed, walletTxIds);
+}
+
+std::map<EOutputStatus, uint64_t> WalletSqlite::GetOutputTotals(const SecureVector& masterSeed) const
+{
+	return OutputsTable::GetTotals(*m_pDatabase, m_keyCache, masterSeed);
 }
 
 void WalletSqlite::AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx)
 {
-	TransactionsTable::AddTransactions(*m_pDatabase, masterSeed, std::vector<WalletTx>({ walletTx }));
+	TransactionsTable::AddTransactions(*m_pDatabase, m_keyCache, masterSeed, std::vector<WalletTx>({ walletTx }));
 }
 
 std::vector<WalletTx> WalletSqlite::GetTransactions(const SecureVector& masterSeed) const
 {
-	return TransactionsTable::GetTransactions(*m_pDatabase, masterSeed);
+	return TransactionsTable::GetTransactions(*m_pDatabase, m_keyCache, masterSeed);
+}
+
+std::vector<WalletTx> WalletSqlite::GetTransactions(
+	const SecureVector& masterSeed,
+	const std::unordered_set<uint32_t>& ids,
+	const std::unordered_set<EWalletTxType>& types) const
+{
+	return TransactionsTable::GetTransactions(*m_pDatabase, m_keyCache, masterSeed, ids, types);
 }
 
 std::unique_ptr<WalletTx> WalletSqlite::GetTransactionById(const SecureVector& masterSeed, const uint32_t walletTxId) const
 {
-	return TransactionsTable::GetTransactionById(*m_pDatabase, masterSeed, walletTxId);
+	return TransactionsTable::GetTransactionById(*m_pDatabase, m_keyCache, masterSeed, walletTxId);
 }
 
 uint32_t WalletSqlite::GetNextTransactionId()
@@ -154,6 +186,26 @@ void WalletSqlite::UpdateRestoreLeafIndex(const uint64_t lastLeafIndex)
 	SaveMetadata(UserMetadata{ metadata.GetNextTxId(), metadata.GetRefreshBlockHeight(), lastLeafIndex });
 }
 
+std::vector<RefreshCheckpoint> WalletSqlite::GetRefreshCheckpoints() const
+{
+	return RefreshCheckpointsTable::GetCheckpoints(*m_pDatabase);
+}
+
+void WalletSqlite::AddRefreshCheckpoint(const RefreshCheckpoint& checkpoint)
+{
+	RefreshCheckpointsTable::AddCheckpoint(*m_pDatabase, checkpoint);
+}
+
+void WalletSqlite::DeleteRefreshCheckpointsAbove(const uint64_t height)
+{
+	RefreshCheckpointsTable::DeleteCheckpointsAbove(*m_pDatabase, height);
+}
+
+void WalletSqlite::DeleteRefreshCheckpointsBelow(const uint64_t height)
+{
+	RefreshCheckpointsTable::DeleteCheckpointsBelow(*m_pDatabase, height);
+}
+
 UserMetadata WalletSqlite::GetMetadata() const
 {
 	return MetadataTable::GetMetadata(*m_pDatabase);
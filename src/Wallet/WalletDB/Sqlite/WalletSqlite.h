@@ -3,6 +3,7 @@
 #include "../UserMetadata.h"
 #include "SqliteTransaction.h"
 #include "SqliteDB.h"
+#include "../WalletEncryptionUtil.h"
 
 #include <Wallet/WalletDB/WalletDB.h>
 #include <Wallet/WalletDB/Models/SlateContextEntity.h>
@@ -55,9 +56,22 @@ public:
 
 	void AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs) final;
 	std::vector<OutputDataEntity> GetOutputs(const SecureVector& masterSeed) const final;
+	std::vector<OutputDataEntity> GetOutputs(const SecureVector& masterSeed, const std::vector<EOutputStatus>& statuses) const final;
+	std::vector<OutputDataEntity> GetRecentOutputs(
+		const SecureVector& masterSeed,
+		const std::vector<EOutputStatus>& statuses,
+		const uint64_t minBlockHeight
+	) const final;
+	std::vector<OutputDataEntity> GetOutputsByTxIds(const SecureVector& masterSeed, const std::unordered_set<uint32_t>& walletTxIds) const final;
+	std::map<EOutputStatus, uint64_t> GetOutputTotals(const SecureVector& masterSeed) const final;
 
 	void AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx) final;
 	std::vector<WalletTx> GetTransactions(const SecureVector& masterSeed) const final;
+	std::vector<WalletTx> GetTransactions(
+		const SecureVector& masterSeed,
+		const std::unordered_set<uint32_t>& ids,
+		const std::unordered_set<EWalletTxType>& types
+	) const final;
 	std::unique_ptr<WalletTx> GetTransactionById(const SecureVector& masterSeed, const uint32_t walletTxId) const final;
 
 	uint32_t GetNextTransactionId() final;
@@ -66,6 +80,11 @@ public:
 	uint64_t GetRestoreLeafIndex() const final;
 	void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) final;
 
+	std::vector<RefreshCheckpoint> GetRefreshCheckpoints() const final;
+	void AddRefreshCheckpoint(const RefreshCheckpoint& checkpoint) final;
+	void DeleteRefreshCheckpointsAbove(const uint64_t height) final;
+	void DeleteRefreshCheckpointsBelow(const uint64_t height) final;
+
 
 private:
 	UserMetadata GetMetadata() const;
@@ -75,4 +94,7 @@ private:
 	std::string m_username;
 	SqliteDB::Ptr m_pDatabase;
 	std::unique_ptr<SqliteTransaction> m_pTransaction;
+
+	// Keys derived from this wallet's seed. They're wiped when the wallet is closed and this is destroyed.
+	mutable WalletEncryptionUtil::KeyCache m_keyCache;
 };
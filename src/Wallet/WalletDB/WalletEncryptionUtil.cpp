@@ -6,14 +6,62 @@
 
 static const uint8_t ENCRYPTION_FORMAT = 0;
 
+SecretKey WalletEncryptionUtil::KeyCache::GetKey(const SecureVector& masterSeed, const std::string& dataType)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_keys.find(dataType);
+	if (iter == m_keys.end()) {
+		iter = m_keys.emplace(dataType, WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType)).first;
+	}
+
+	return iter->second;
+}
+
+void WalletEncryptionUtil::KeyCache::Clear()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_keys.clear();
+}
+
 std::vector<uint8_t> WalletEncryptionUtil::Encrypt(
 	const SecureVector& masterSeed,
 	const std::string& dataType,
 	const SecureVector& bytes)
+{
+	return Encrypt(WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType), bytes);
+}
+
+std::vector<uint8_t> WalletEncryptionUtil::Encrypt(
+	KeyCache& keyCache,
+	const SecureVector& masterSeed,
+	const std::string& dataType,
+	const SecureVector& bytes)
+{
+	return Encrypt(keyCache.GetKey(masterSeed, dataType), bytes);
+}
+
+SecureVector WalletEncryptionUtil::Decrypt(
+	const SecureVector& masterSeed,
+	const std::string& dataType,
+	const std::vector<uint8_t>& encrypted)
+{
+	return Decrypt(WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType), encrypted);
+}
+
+SecureVector WalletEncryptionUtil::Decrypt(
+	KeyCache& keyCache,
+	const SecureVector& masterSeed,
+	const std::string& dataType,
+	const std::vector<uint8_t>& encrypted)
+{
+	return Decrypt(keyCache.GetKey(masterSeed, dataType), encrypted);
+}
+
+std::vector<uint8_t> WalletEncryptionUtil::Encrypt(const SecretKey& key, const SecureVector& bytes)
 {
 	const SecureVector randomNumber = CSPRNG::GenerateRandomBytes(16);
 	const CBigInteger<16> iv = CBigInteger<16>(randomNumber.data());
-	const SecretKey key = WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType);
 
 	const std::vector<uint8_t> encryptedBytes = AES256::Encrypt(bytes, key, iv);
 
@@ -24,10 +72,7 @@ std::vector<uint8_t> WalletEncryptionUtil::Encrypt(
 	return serializer.GetBytes();
 }
 
-SecureVector WalletEncryptionUtil::Decrypt(
-	const SecureVector& masterSeed,
-	const std::string& dataType,
-	const std::vector<uint8_t>& encrypted)
+SecureVector WalletEncryptionUtil::Decrypt(const SecretKey& key, const std::vector<uint8_t>& encrypted)
 {
 	ByteBuffer byteBuffer(encrypted);
 
@@ -43,7 +88,6 @@ SecureVector WalletEncryptionUtil::Decrypt(
 	const CBigInteger<16> iv = byteBuffer.ReadBigInteger<16>();
 	const std::vector<uint8_t> encryptedBytes =
 		byteBuffer.ReadVector(byteBuffer.GetRemainingSize());
-	const SecretKey key = WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType);
 
 	return AES256::Decrypt(encryptedBytes, key, iv);
 }
@@ -63,4 +107,4 @@ SecretKey WalletEncryptionUtil::CreateSecureKey(
 	);
 
 	return Hasher::Blake2b(seedWithNonce.data(), seedWithNonce.size());
-}
\ No newline at end of file
+}
@@ -2,13 +2,39 @@
 
 #include <Crypto/Models/SecretKey.h>
 #include <Common/Secure.h>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class WalletEncryptionUtil
 {
 public:
+	//
+	// The keys derived from one wallet's seed, by data type.
+	// Deriving a key hashes a secure (mlocked) copy of the seed, which is costly to repeat for every record.
+	// Only the derived keys are kept, never the seed, so a cache must only ever be used with its wallet's seed.
+	// Keys are wiped when the cache is cleared or destroyed.
+	//
+	class KeyCache
+	{
+	public:
+		SecretKey GetKey(const SecureVector& masterSeed, const std::string& dataType);
+		void Clear();
+
+	private:
+		std::mutex m_mutex;
+		std::unordered_map<std::string, SecretKey> m_keys;
+	};
+
+	static std::vector<uint8_t> Encrypt(
+		const SecureVector& masterSeed,
+		const std::string& dataType,
+		const SecureVector& bytes
+	);
+
 	static std::vector<uint8_t> Encrypt(
+		KeyCache& keyCache,
 		const SecureVector& masterSeed,
 		const std::string& dataType,
 		const SecureVector& bytes
@@ -20,6 +46,16 @@ public:
 		const std::vector<uint8_t>& encrypted
 	);
 
+	static SecureVector Decrypt(
+		KeyCache& keyCache,
+		const SecureVector& masterSeed,
+		const std::string& dataType,
+		const std::vector<uint8_t>& encrypted
+	);
+
 private:
+	static std::vector<uint8_t> Encrypt(const SecretKey& key, const SecureVector& bytes);
+	static SecureVector Decrypt(const SecretKey& key, const std::vector<uint8_t>& encrypted);
+
 	static SecretKey CreateSecureKey(const SecureVector& masterSeed, const std::string& dataType);
-};
\ No newline at end of file
+};
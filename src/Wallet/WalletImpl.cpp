@@ -1,5 +1,6 @@
 #include "WalletImpl.h"
 #include "WalletRefresher.h"
+#include "WalletBalanceLoader.h"
 
 #include <Consensus.h>
 #include <Wallet/Keychain/KeyChain.h>
@@ -60,45 +61,14 @@ WalletSummaryDTO WalletImpl::GetWalletSummary(const SecureVector& masterSeed)
 
 WalletBalanceDTO WalletImpl::GetBalance(const SecureVector& masterSeed)
 {
-    uint64_t awaitingConfirmation = 0;
-    uint64_t immature = 0;
-    uint64_t locked = 0;
-    uint64_t spendable = 0;
-
-	const std::vector<OutputDataEntity> outputs = RefreshOutputs(masterSeed, false);
-	const uint64_t current_height = m_walletDB.Read()->GetRefreshBlockHeight();
-
-    for (const OutputDataEntity& outputData : outputs) {
-        const EOutputStatus status = outputData.GetStatus();
-
-        if (status == EOutputStatus::LOCKED) {
-            locked += outputData.GetAmount();
-        } else if (status == EOutputStatus::SPENDABLE) {
-            const EOutputFeatures features = outputData.GetFeatures();
-            const uint64_t output_height = outputData.GetBlockHeight().value_or(0);
-
-            if (WalletUtil::IsOutputImmature(features, output_height, current_height)) {
-                immature += outputData.GetAmount();
-            } else {
-                spendable += outputData.GetAmount();
-            }
-        } else if (status == EOutputStatus::NO_CONFIRMATIONS) {
-            awaitingConfirmation += outputData.GetAmount();
-        }
-    }
-
-    return WalletBalanceDTO(
-		current_height,
-        awaitingConfirmation,
-        immature,
-        locked,
-        spendable
-    );
+	RefreshOutputs(masterSeed, false);
+
+	return WalletBalanceLoader().LoadBalance(m_walletDB.Read().GetShared(), masterSeed);
 }
 
-std::vector<OutputDataEntity> WalletImpl::RefreshOutputs(const SecureVector& masterSeed, const bool fromGenesis)
+void WalletImpl::RefreshOutputs(const SecureVector& masterSeed, const bool fromGenesis)
 {
-	return WalletRefresher(m_config, m_pNodeClient).Refresh(masterSeed, m_walletDB, fromGenesis);
+	WalletRefresher(m_config, m_pNodeClient).Refresh(masterSeed, m_walletDB, fromGenesis);
 }
 
 std::vector<OutputDataEntity> WalletImpl::GetAllAvailableCoins(const SecureVector& masterSeed)
@@ -111,16 +81,14 @@ std::vector<OutputDataEntity> WalletImpl::GetAllAvailableCoins(const SecureVecto
 
 	std::vector<OutputDataEntity> coins;
 
-	std::vector<Commitment> commitments;
-	const std::vector<OutputDataEntity> outputs = RefreshOutputs(masterSeed, false);
+	RefreshOutputs(masterSeed, false);
+	const std::vector<OutputDataEntity> outputs = m_walletDB.Read()->GetOutputs(masterSeed, { EOutputStatus::SPENDABLE });
 	for (const OutputDataEntity& output : outputs) {
-		if (output.GetStatus() == EOutputStatus::SPENDABLE) {
-			EOutputFeatures features = output.GetFeatures();
-			uint64_t output_height = output.GetBlockHeight().value_or(0);
+		EOutputFeatures features = output.GetFeatures();
+		uint64_t output_height = output.GetBlockHeight().value_or(0);
 
-			if (!WalletUtil::IsOutputImmature(features, output_height, pTip->GetHeight())) {
-				coins.emplace_back(output);
-			}
+		if (!WalletUtil::IsOutputImmature(features, output_height, pTip->GetHeight())) {
+			coins.emplace_back(output);
 		}
 	}
 
@@ -226,17 +194,12 @@ BuildCoinbaseResponse WalletImpl::CreateCoinbase(
 
 std::unique_ptr<WalletTx> WalletImpl::GetTxById(const SecureVector& masterSeed, const uint32_t walletTxId) const
 {
-	std::vector<WalletTx> transactions = m_walletDB.Read()->GetTransactions(masterSeed);
-	for (WalletTx& walletTx : transactions)
-	{
-		if (walletTx.GetId() == walletTxId)
-		{
-			return std::make_unique<WalletTx>(WalletTx(walletTx));
-		}
+	std::unique_ptr<WalletTx> pWalletTx = m_walletDB.Read()->GetTransactionById(masterSeed, walletTxId);
+	if (pWalletTx == nullptr) {
+		WALLET_INFO_F("Could not find transaction {}", walletTxId);
 	}
 
-	WALLET_INFO_F("Could not find transaction {}", walletTxId);
-	return std::unique_ptr<WalletTx>(nullptr);
+	return pWalletTx;
 }
 
 std::unique_ptr<WalletTx> WalletImpl::GetTxBySlateId(const SecureVector& masterSeed, const uuids::uuid& slateId) const
@@ -53,7 +53,7 @@ public:
 	std::unique_ptr<WalletTx> GetTxById(const SecureVector& masterSeed, const uint32_t walletTxId) const;
 	std::unique_ptr<WalletTx> GetTxBySlateId(const SecureVector& masterSeed, const uuids::uuid& slateId) const;
 
-	std::vector<OutputDataEntity> RefreshOutputs(const SecureVector& masterSeed, const bool fromGenesis);
+	void RefreshOutputs(const SecureVector& masterSeed, const bool fromGenesis);
 
 	std::vector<OutputDataEntity> GetAllAvailableCoins(const SecureVector& masterSeed);
 	OutputDataEntity CreateBlindedOutput(
@@ -3,106 +3,201 @@
 #include <Wallet/Keychain/KeyChain.h>
 
 #include <Common/Logger.h>
+#include <Consensus.h>
 #include <Wallet/WalletUtil.h>
 #include <Wallet/NodeClient.h>
 #include <Wallet/WalletDB/WalletDB.h>
 #include <unordered_map>
+#include <unordered_set>
 
-// TODO: Rewrite this && use cache - Shouldn't refresh when block height = same
 // 0. Initial login after upgrade - for every output, find matching WalletTx and update OutputDataEntity TxId. If none found, create new WalletTx.
 //
 // 1. Check for own outputs in new blocks.
 // 2. For each output, look for OutputDataEntity with matching commitment. If no output found, create new WalletTx and OutputDataEntity.
 // 3. Refresh status for all OutputDataEntity by calling m_pNodeClient->GetOutputsByCommitment
 // 4. For all OutputDataEntity, update matching WalletTx status.
-
-std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& masterSeed, Locked<IWalletDB> walletDB, const bool fromGenesis)
+//
+// Refreshes are incremental. Each completed refresh records a checkpoint of the tip it refreshed to.
+// If the tip hasn't changed since the last checkpoint, nothing needs to be refreshed.
+// If the last checkpoint is no longer on the chain, the wallet is rolled back to the fork point and fully refreshed.
+// Otherwise, only outputs that can still change status (i.e. not spent or canceled) are checked.
+
+// Outputs that can still change status without a reorg.
+static const std::vector<EOutputStatus> UNSPENT_STATUSES = {
+    EOutputStatus::SPENDABLE,
+    EOutputStatus::IMMATURE,
+    EOutputStatus::NO_CONFIRMATIONS,
+    EOutputStatus::LOCKED
+};
+
+void WalletRefresher::Refresh(const SecureVector& masterSeed, Locked<IWalletDB> walletDB, const bool fromGenesis)
 {
-    auto pBatch = walletDB.BatchWrite();
-
-    if (m_pNodeClient->GetChainHeight() < pBatch->GetRefreshBlockHeight()) {
+    if (m_pNodeClient->GetChainHeight() < walletDB.Read()->GetRefreshBlockHeight()) {
         WALLET_TRACE("Skipping refresh since node is resyncing.");
-        return std::vector<OutputDataEntity>();
+        return;
     }
 
-    std::vector<OutputDataEntity> walletOutputs = pBatch->GetOutputs(masterSeed);
-    std::vector<WalletTx> walletTransactions = pBatch->GetTransactions(masterSeed);
+    BlockHeaderPtr pTipHeader = m_pNodeClient->GetTipHeader();
+    if (pTipHeader == nullptr) {
+        WALLET_WARNING("Skipping refresh since tip header was not received.");
+        return;
+    }
 
-    // 1. Check for new outputs we hadn't seen before.
-    std::vector<OutputDataEntity> new_outputs = FindNewOutputs(masterSeed, pBatch.GetShared(), walletOutputs, fromGenesis);
+    const std::vector<RefreshCheckpoint> checkpoints = walletDB.Read()->GetRefreshCheckpoints();
 
-    // 2. Create a new WalletTx for each newly received output, and add the output & tx to the database.
-    for (OutputDataEntity& new_output : new_outputs) {
-        WALLET_INFO_F("Restoring unknown output: {}", new_output);
-
-        auto blockTimeOpt = GetBlockTime(new_output);
-
-        // If no output found, create new WalletTx and OutputDataEntity.
-        const uint32_t walletTxId = pBatch->GetNextTransactionId();
-        WalletTx walletTx(
-            walletTxId,
-            EWalletTxType::RECEIVED,
-            std::nullopt,
-            std::nullopt,
-            std::nullopt,
-            blockTimeOpt.value_or(std::chrono::system_clock::now()),
-            blockTimeOpt,
-            new_output.GetBlockHeight(),
-            new_output.GetAmount(),
-            0,
-            std::nullopt,
-            std::nullopt,
-            std::nullopt
-        );
-
-        new_output.SetWalletTxId(walletTxId);
-        pBatch->AddOutputs(masterSeed, std::vector<OutputDataEntity>({ new_output }));
-        pBatch->AddTransaction(masterSeed, walletTx);
-
-        walletOutputs.push_back(new_output);
-        walletTransactions.emplace_back(std::move(walletTx));
+    bool fullRefresh = fromGenesis || checkpoints.empty();
+    if (!fullRefresh) {
+        if (checkpoints.front().GetHash() == pTipHeader->GetHash()) {
+            WALLET_TRACE_F("Already refreshed to tip {}", pTipHeader->GetHeight());
+            return;
+        }
+
+        if (!IsOnChain(checkpoints.front())) {
+            RollbackToForkPoint(masterSeed, walletDB, checkpoints);
+            fullRefresh = true;
+        }
     }
 
+    const uint64_t restoreLeafIndex = fromGenesis ? 0 : walletDB.Read()->GetRestoreLeafIndex();
+
+    // 1. Check for new outputs we hadn't seen before.
+    // 2. Create a new WalletTx for each newly received output, and add the output & tx to the database.
+    RestoreOutputs(masterSeed, walletDB, fromGenesis);
+
+    auto pBatch = walletDB.BatchWrite();
+
+    // Spent and canceled outputs can only become unspent again after a reorg, so they're only checked on full refreshes.
+    std::vector<OutputDataEntity> walletOutputs = fullRefresh ? pBatch->GetOutputs(masterSeed) : pBatch->GetOutputs(masterSeed, UNSPENT_STATUSES);
+
     // 3. Refresh status for all wallet outputs
-    RefreshOutputs(masterSeed, pBatch, walletOutputs);
+    const bool outputsChanged = RefreshOutputs(masterSeed, pBatch, walletOutputs);
 
     // 4. For all wallet outputs, update matching WalletTx status.
-    RefreshTransactions(masterSeed, pBatch, walletOutputs, walletTransactions);
+    if (fullRefresh || outputsChanged) {
+        std::vector<WalletTx> walletTransactions = pBatch->GetTransactions(masterSeed);
+        RefreshTransactions(masterSeed, pBatch, walletOutputs, walletTransactions);
+    }
+
+    pBatch->UpdateRefreshBlockHeight(pTipHeader->GetHeight());
+    pBatch->AddRefreshCheckpoint(RefreshCheckpoint(pTipHeader->GetHeight(), pTipHeader->GetHash(), restoreLeafIndex));
+    pBatch->DeleteRefreshCheckpointsBelow(Consensus::GetHorizonHeight(pTipHeader->GetHeight()));
 
     pBatch->Commit();
-    return walletOutputs;
 }
 
-std::vector<OutputDataEntity> WalletRefresher::FindNewOutputs(
+bool WalletRefresher::IsOnChain(const RefreshCheckpoint& checkpoint) const
+{
+    auto pHeader = m_pNodeClient->GetBlockHeader(checkpoint.GetHeight());
+    return pHeader != nullptr && pHeader->GetHash() == checkpoint.GetHash();
+}
+
+void WalletRefresher::RollbackToForkPoint(
     const SecureVector& masterSeed,
-    const std::shared_ptr<IWalletDB>& pBatch,
-    const std::vector<OutputDataEntity>& walletOutputs,
+    Locked<IWalletDB> walletDB,
+    const std::vector<RefreshCheckpoint>& checkpoints)
+{
+    // Checkpoints are ordered from highest to lowest, so the first one still on the chain is the fork point.
+    // If none are, the fork is deeper than the checkpoints go, so everything is rolled back.
+    auto forkIter = std::find_if(
+        checkpoints.cbegin(), checkpoints.cend(),
+        [this](const RefreshCheckpoint& checkpoint) { return IsOnChain(checkpoint); }
+    );
+    const uint64_t forkHeight = forkIter != checkpoints.cend() ? forkIter->GetHeight() : 0;
+    const uint64_t restoreLeafIndex = forkIter != checkpoints.cend() ? forkIter->GetRestoreLeafIndex() : 0;
+
+    WALLET_WARNING_F("Reorg detected. Rolling back from height {} to {}", checkpoints.front().GetHeight(), forkHeight);
+
+    auto pBatch = walletDB.BatchWrite();
+
+    // Outputs confirmed after the fork point may no longer be on the chain.
+    // They're awaiting confirmation again until the full refresh finds them on chain.
+    std::vector<OutputDataEntity> confirmedOutputs = pBatch->GetOutputs(
+        masterSeed,
+        std::vector<EOutputStatus>{ EOutputStatus::SPENDABLE, EOutputStatus::IMMATURE }
+    );
+    for (OutputDataEntity& output : confirmedOutputs) {
+        if (output.GetBlockHeight().value_or(0) > forkHeight) {
+            WALLET_DEBUG_F("Marking output as unconfirmed: {}", output);
+            output.SetStatus(EOutputStatus::NO_CONFIRMATIONS);
+            pBatch->SaveOutput(masterSeed, output);
+        }
+    }
+
+    pBatch->UpdateRestoreLeafIndex(restoreLeafIndex);
+    pBatch->UpdateRefreshBlockHeight(forkHeight);
+    pBatch->DeleteRefreshCheckpointsAbove(forkHeight);
+    pBatch->Commit();
+}
+
+void WalletRefresher::RestoreOutputs(
+    const SecureVector& masterSeed,
+    Locked<IWalletDB> walletDB,
     const bool fromGenesis)
 {
-    std::vector<OutputDataEntity> new_outputs;
+    std::unordered_set<Commitment> knownCommitments;
+    for (const OutputDataEntity& output : walletDB.Read()->GetOutputs(masterSeed)) {
+        knownCommitments.insert(output.GetCommitment());
+    }
+
+    const uint64_t startLeafIndex = fromGenesis ? 0 : walletDB.Read()->GetRestoreLeafIndex() + 1;
 
     KeyChain keyChain = KeyChain::FromSeed(masterSeed);
     OutputRestorer restorer(m_pNodeClient, keyChain);
-    std::vector<OutputDataEntity> restoredOutputs = restorer.FindAndRewindOutputs(pBatch, fromGenesis);
 
-    // For each restored output, look for known outputs with matching commitment.
-    // If no matching output is found, this must be a new output that was received by another one of the user's wallets with the same seed.
-    for (OutputDataEntity& restoredOutput : restoredOutputs) {
-        WALLET_INFO_F("Output found at index {}", restoredOutput.GetMMRIndex().value_or(0));
+    // Each window is committed on its own, so an interrupted restore resumes from the last committed leaf index.
+    auto onWindowRewound = [this, &masterSeed, &walletDB, &knownCommitments](std::vector<OutputDataEntity>&& restoredOutputs, const uint64_t lastLeafIndex) {
+        auto pBatch = walletDB.BatchWrite();
+
+        // Restored outputs are never spent or known to the wallet already,
+        // so this must be a new output that was received by another one of the user's wallets with the same seed.
+        for (OutputDataEntity& restoredOutput : restoredOutputs) {
+            WALLET_INFO_F("Output found at index {}", restoredOutput.GetMMRIndex().value_or(0));
 
-        if (restoredOutput.GetStatus() != EOutputStatus::SPENT) {
-            auto pExistingOutput = FindOutput(walletOutputs, restoredOutput.GetCommitment());
-            if (pExistingOutput == nullptr) {
-                new_outputs.push_back(restoredOutput);
+            if (knownCommitments.insert(restoredOutput.GetCommitment()).second) {
+                AddRestoredOutput(masterSeed, pBatch, restoredOutput);
             }
         }
-    }
 
-    return new_outputs;
+        pBatch->UpdateRestoreLeafIndex(lastLeafIndex);
+        pBatch->Commit();
+    };
+
+    restorer.FindAndRewindOutputs(startLeafIndex, knownCommitments, onWindowRewound);
+}
+
+void WalletRefresher::AddRestoredOutput(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, OutputDataEntity& new_output)
+{
+    WALLET_INFO_F("Restoring unknown output: {}", new_output);
+
+    auto blockTimeOpt = GetBlockTime(new_output);
+
+    // If no output found, create new WalletTx and OutputDataEntity.
+    const uint32_t walletTxId = pBatch->GetNextTransactionId();
+    WalletTx walletTx(
+        walletTxId,
+        EWalletTxType::RECEIVED,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        blockTimeOpt.value_or(std::chrono::system_clock::now()),
+        blockTimeOpt,
+        new_output.GetBlockHeight(),
+        new_output.GetAmount(),
+        0,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    );
+
+    new_output.SetWalletTxId(walletTxId);
+    pBatch->AddOutputs(masterSeed, std::vector<OutputDataEntity>({ new_output }));
+    pBatch->AddTransaction(masterSeed, walletTx);
 }
 
-void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, std::vector<OutputDataEntity>& walletOutputs)
+bool WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, std::vector<OutputDataEntity>& walletOutputs)
 {
+    bool changed = false;
+
     std::vector<Commitment> commitments;
     std::transform(
         walletOutputs.begin(), walletOutputs.end(),
@@ -110,8 +205,6 @@ void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWal
         [](const OutputDataEntity& output) { return output.GetCommitment(); }
     );
 
-    const uint64_t lastConfirmedHeight = m_pNodeClient->GetChainHeight();
-
     const std::map<Commitment, OutputLocation> outputLocations = m_pNodeClient->GetOutputsByCommitment(commitments);
     for (OutputDataEntity& outputData : walletOutputs) {
         const EOutputStatus current_status = outputData.GetStatus();
@@ -132,6 +225,7 @@ void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWal
             outputData.SetBlockHeight(iter->second.GetBlockHeight());
             outputData.SetStatus(EOutputStatus::SPENDABLE);
             pBatch->SaveOutput(masterSeed, outputData);
+            changed = true;
         } else {
             // NO_CONFIRMATIONS means the output is being received, but hasn't been seen on chain yet.
             // Since we still have not seen it on-chain, no need to update.
@@ -144,15 +238,15 @@ void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWal
                 continue;
             }
 
-            // TODO: Check if (lastConfirmedHeight > outputData.GetConfirmedHeight)
             WALLET_DEBUG_F("Marking output as spent: {}", outputData);
 
             outputData.SetStatus(EOutputStatus::SPENT);
             pBatch->SaveOutput(masterSeed, outputData);
+            changed = true;
         }
     }
 
-    pBatch->UpdateRefreshBlockHeight(lastConfirmedHeight);
+    return changed;
 }
 
 void WalletRefresher::RefreshTransactions(
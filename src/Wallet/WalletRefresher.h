@@ -20,21 +20,34 @@ public:
 	WalletRefresher(const Config& config, const INodeClientConstPtr& pNodeClient)
 		: m_config(config), m_pNodeClient(pNodeClient) { }
 
-	std::vector<OutputDataEntity> Refresh(
+	void Refresh(
 		const SecureVector& masterSeed,
 		Locked<IWalletDB> walletDB,
 		const bool fromGenesis
 	);
 
 private:
-	std::vector<OutputDataEntity> FindNewOutputs(
+	void RestoreOutputs(
 		const SecureVector& masterSeed,
-		const std::shared_ptr<IWalletDB>& pBatch,
-		const std::vector<OutputDataEntity>& walletOutputs,
+		Locked<IWalletDB> walletDB,
 		const bool fromGenesis
 	);
 
-	void RefreshOutputs(
+	void AddRestoredOutput(
+		const SecureVector& masterSeed,
+		Writer<IWalletDB> pBatch,
+		OutputDataEntity& new_output
+	);
+
+	bool IsOnChain(const RefreshCheckpoint& checkpoint) const;
+
+	void RollbackToForkPoint(
+		const SecureVector& masterSeed,
+		Locked<IWalletDB> walletDB,
+		const std::vector<RefreshCheckpoint>& checkpoints
+	);
+
+	bool RefreshOutputs(
 		const SecureVector& masterSeed,
 		Writer<IWalletDB> pBatch,
 		std::vector<OutputDataEntity>& walletOutputs
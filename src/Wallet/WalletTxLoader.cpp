@@ -2,15 +2,22 @@
 
 #include <Wallet/WalletDB/WalletDB.h>
 #include <Common/Util/FunctionalUtil.h>
+#include <unordered_set>
 
 std::vector<WalletTxDTO> WalletTxLoader::LoadTransactions(
     const std::shared_ptr<const IWalletDB>& pWalletDB,
 	const SecureVector& masterSeed,
     const ListTxsCriteria& criteria) const
 {
-	std::vector<OutputDataEntity> outputs = pWalletDB->GetOutputs(masterSeed);
 	std::vector<WalletTx> walletTransactions = LoadWalletTxs(pWalletDB, masterSeed, criteria);
 
+	std::unordered_set<uint32_t> walletTxIds;
+	for (const WalletTx& walletTx : walletTransactions) {
+		walletTxIds.insert(walletTx.GetId());
+	}
+
+	std::vector<OutputDataEntity> outputs = pWalletDB->GetOutputsByTxIds(masterSeed, walletTxIds);
+
 	std::vector<WalletTxDTO> walletTxDTOs;
 	std::transform(
 		walletTransactions.cbegin(), walletTransactions.cend(),
@@ -72,7 +79,8 @@ std::vector<WalletTx> WalletTxLoader::LoadWalletTxs(
 	const SecureVector& masterSeed,
 	const ListTxsCriteria& criteria) const
 {
-	std::vector<WalletTx> walletTxs = pWalletDB->GetTransactions(masterSeed);
+	// Ids and types are indexed, so only the matching transactions are decrypted.
+	std::vector<WalletTx> walletTxs = pWalletDB->GetTransactions(masterSeed, criteria.GetTxIds(), criteria.GetStatuses());
 
 	std::vector<WalletTx> filteredTxs;
 	std::copy_if(
@@ -12,7 +12,7 @@ class WalletTxLoader
 {
 public:
     //
-    // Loads all transactions, and filters them using the given criteria.
+    // Loads the transactions matching the given criteria, along with their outputs.
     //
     std::vector<WalletTxDTO> LoadTransactions(
         const std::shared_ptr<const IWalletDB>& pWalletDB,
@@ -56,6 +56,7 @@ public:
 	static TestServer::Ptr Create();
 	static TestServer::Ptr CreateWithWallet();
 
+	const std::shared_ptr<IDatabase>& GetDatabase() const noexcept { return m_pDatabase; }
 	std::shared_ptr<Locked<IBlockDB>> GetBlockDB() const noexcept;
 	const std::shared_ptr<Locked<TxHashSetManager>>& GetTxHashSetManager() const noexcept { return m_pTxHashSetManager; }
 	const ITransactionPool::Ptr& GetTxPool() const noexcept { return m_pTxPool; }
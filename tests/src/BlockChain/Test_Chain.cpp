@@ -1,7 +1,9 @@
 #include <catch.hpp>
 
 #include <TestServer.h>
+#include <TestMiner.h>
 
+#include <BlockChain/BlockChain.h>
 #include <BlockChain/Chain.h>
 
 TEST_CASE("Chain Batching")
@@ -61,4 +63,26 @@ TEST_CASE("Chain Batching")
 		REQUIRE(pReader->GetByHeight(3)->GetHash() == hash3b);
 		REQUIRE(pReader->GetByHeight(4)->GetHash() == hash4b);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("BlockChain::GetOutputsByHeight beyond the tip")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom();
+	miner.MineChain(keyChain, 10);
+
+	IBlockChain::Ptr pBlockChain = pTestServer->GetBlockChain();
+	REQUIRE(pBlockChain->GetHeight(EChainType::CONFIRMED) == 9);
+
+	// The end of the range is clamped to the tip.
+	std::vector<BlockWithOutputs> blocks = pBlockChain->GetOutputsByHeight(5, 100);
+	REQUIRE(blocks.size() == 5);
+	REQUIRE(blocks.front().GetBlockIdentifier().GetHeight() == 5);
+	REQUIRE(blocks.back().GetBlockIdentifier().GetHeight() == 9);
+
+	// A range that starts past the tip is empty.
+	REQUIRE(pBlockChain->GetOutputsByHeight(10, 100).empty());
+	REQUIRE(pBlockChain->GetOutputsByHeight(100, 200).empty());
+	REQUIRE(pBlockChain->GetOutputsByHeight(100, 50).empty());
+}
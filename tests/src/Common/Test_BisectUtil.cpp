@@ -0,0 +1,76 @@
+#include <catch.hpp>
+
+#include <Common/Util/BisectUtil.h>
+#include <set>
+
+TEST_CASE("BisectUtil::FindFailures")
+{
+	const size_t numItems = 1000;
+
+	auto findFailures = [numItems](const std::set<size_t>& invalid, size_t& numVerifications) {
+		numVerifications = 0;
+		return BisectUtil::FindFailures(
+			numItems,
+			[&invalid, &numVerifications](const size_t begin, const size_t end) {
+				++numVerifications;
+				auto iter = invalid.lower_bound(begin);
+				return iter == invalid.end() || *iter >= end;
+			}
+		);
+	};
+
+	size_t numVerifications = 0;
+
+	// Valid batches are only verified once
+	REQUIRE(findFailures({}, numVerifications).empty());
+	REQUIRE(numVerifications == 1);
+
+	// A single invalid item is isolated in a logarithmic number of verifications
+	REQUIRE(findFailures({ 637 }, numVerifications) == std::vector<size_t>({ 637 }));
+	REQUIRE(numVerifications <= 21);
+
+	REQUIRE(findFailures({ 0 }, numVerifications) == std::vector<size_t>({ 0 }));
+	REQUIRE(findFailures({ 999 }, numVerifications) == std::vector<size_t>({ 999 }));
+
+	// Multiple invalid items are all reported, in ascending order
+	REQUIRE(findFailures({ 3, 4, 500, 998 }, numVerifications) == std::vector<size_t>({ 3, 4, 500, 998 }));
+
+	// Empty batches never call verify
+	numVerifications = 0;
+	REQUIRE(BisectUtil::FindFailures(0, [&numVerifications](const size_t, const size_t) { ++numVerifications; return false; }).empty());
+	REQUIRE(numVerifications == 0);
+}
+
+TEST_CASE("BisectUtil::FindFirstFailure")
+{
+	const size_t numItems = 1000;
+
+	size_t numVerified = 0;
+	auto findFirstFailure = [numItems, &numVerified](const std::set<size_t>& invalid) {
+		numVerified = 0;
+		return BisectUtil::FindFirstFailure(
+			numItems,
+			[&invalid, &numVerified](const size_t begin, const size_t end) {
+				numVerified += end - begin;
+				auto iter = invalid.lower_bound(begin);
+				return iter == invalid.end() || *iter >= end;
+			}
+		);
+	};
+
+	// Valid batches are only verified once
+	REQUIRE(!findFirstFailure({}).has_value());
+	REQUIRE(numVerified == numItems);
+
+	// Only the first invalid item is isolated, re-verifying no more than the original batch size.
+	REQUIRE(findFirstFailure({ 637 }) == std::optional<size_t>(637));
+	REQUIRE(numVerified <= 2 * numItems);
+
+	REQUIRE(findFirstFailure({ 3, 4, 500, 998 }) == std::optional<size_t>(3));
+	REQUIRE(numVerified <= 2 * numItems);
+
+	REQUIRE(findFirstFailure({ 0 }) == std::optional<size_t>(0));
+	REQUIRE(findFirstFailure({ 999 }) == std::optional<size_t>(999));
+
+	REQUIRE(!BisectUtil::FindFirstFailure(0, [](const size_t, const size_t) { return false; }).has_value());
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+
+#include <Common/Metrics.h>
+#include <thread>
+#include <vector>
+
+using namespace Metrics;
+
+TEST_CASE("Metrics::Histogram buckets")
+{
+	// Everything under 1us shares the first bucket
+	REQUIRE(Histogram::GetBucket(0) == 0);
+	REQUIRE(Histogram::GetBucket(1023) == 0);
+	REQUIRE(Histogram::GetUpperBound(0) == 1024);
+
+	// Each power of two is split into equal halves
+	REQUIRE(Histogram::GetBucket(1024) == 1);
+	REQUIRE(Histogram::GetBucket(1535) == 1);
+	REQUIRE(Histogram::GetUpperBound(1) == 1536);
+	REQUIRE(Histogram::GetBucket(1536) == 2);
+	REQUIRE(Histogram::GetBucket(2047) == 2);
+	REQUIRE(Histogram::GetUpperBound(2) == 2048);
+	REQUIRE(Histogram::GetBucket(2048) == 3);
+
+	// Every value is below its bucket's upper bound, and at or above the previous one
+	for (uint64_t nanos = 1; nanos < (1ull << Histogram::MAX_EXPONENT); nanos = nanos * 3 / 2 + 1)
+	{
+		const size_t bucket = Histogram::GetBucket(nanos);
+		REQUIRE(nanos < Histogram::GetUpperBound(bucket));
+		if (bucket > 0) {
+			REQUIRE(nanos >= Histogram::GetUpperBound(bucket - 1));
+		}
+	}
+
+	// Anything too slow lands in the unbounded last bucket
+	REQUIRE(Histogram::GetBucket(1ull << Histogram::MAX_EXPONENT) == Histogram::NUM_BUCKETS - 1);
+	REQUIRE(Histogram::GetBucket(UINT64_MAX) == Histogram::NUM_BUCKETS - 1);
+	REQUIRE(Histogram::GetUpperBound(Histogram::NUM_BUCKETS - 1) == UINT64_MAX);
+}
+
+TEST_CASE("Metrics::Registry")
+{
+	// Lookups with the same name and labels return the same metric
+	Counter& counter = GetCounter("test_registry_total", "Test counter", "kind=\"a\"");
+	REQUIRE(&counter == &GetCounter("test_registry_total", "Test counter", "kind=\"a\""));
+	REQUIRE(&counter != &GetCounter("test_registry_total", "Test counter", "kind=\"b\""));
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < 4; i++)
+	{
+		threads.emplace_back([&counter]() {
+			for (size_t j = 0; j < 10000; j++)
+			{
+				counter.Increment();
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	REQUIRE(counter.Get() == 40000);
+
+	Gauge& gauge = GetGauge("test_registry_gauge", "Test gauge");
+	gauge.Set(10);
+	gauge.Add(-3);
+	REQUIRE(gauge.Get() == 7);
+
+	Histogram& histogram = GetHistogram("test_registry_seconds", "Test histogram", "stage=\"x\"");
+	histogram.Observe(std::chrono::nanoseconds(500));
+	histogram.Observe(std::chrono::microseconds(3));
+	histogram.Observe(std::chrono::seconds(100));
+	REQUIRE(histogram.GetCount() == 3);
+	REQUIRE(histogram.GetSumNanos() == 100'000'003'500);
+
+	const std::string exported = ExportPrometheus();
+	REQUIRE(exported.find("# TYPE test_registry_total counter\n") != std::string::npos);
+	REQUIRE(exported.find("test_registry_total{kind=\"a\"} 40000\n") != std::string::npos);
+	REQUIRE(exported.find("test_registry_total{kind=\"b\"} 0\n") != std::string::npos);
+	REQUIRE(exported.find("test_registry_gauge 7\n") != std::string::npos);
+	REQUIRE(exported.find("# TYPE test_registry_seconds histogram\n") != std::string::npos);
+	REQUIRE(exported.find("test_registry_seconds_bucket{stage=\"x\",le=\"1.024e-06\"} 1\n") != std::string::npos);
+	REQUIRE(exported.find("test_registry_seconds_bucket{stage=\"x\",le=\"+Inf\"} 3\n") != std::string::npos);
+	REQUIRE(exported.find("test_registry_seconds_count{stage=\"x\"} 3\n") != std::string::npos);
+}
@@ -0,0 +1,95 @@
+#include <catch.hpp>
+
+#include <Common/Tracing.h>
+#include <thread>
+
+static size_t CountOccurrences(const std::string& str, const std::string& substr)
+{
+	size_t count = 0;
+	for (size_t pos = str.find(substr); pos != std::string::npos; pos = str.find(substr, pos + substr.size()))
+	{
+		count++;
+	}
+
+	return count;
+}
+
+TEST_CASE("Tracing::Span")
+{
+	Tracing::SetEnabled(false);
+	{
+		Tracing::Span span("test_disabled");
+	}
+
+	REQUIRE(Tracing::ExportChromeJSON().find("test_disabled") == std::string::npos);
+
+	Tracing::SetEnabled(true);
+	std::thread thread([]() {
+		Tracing::SetThreadName("TEST_WORKER");
+		Tracing::Span span("test_worker", "height", 1234);
+	});
+	thread.join();
+
+	{
+		Tracing::Span span("test_main");
+	}
+	Tracing::SetEnabled(false);
+
+	// Spans from exited threads are kept until the next session starts
+	const std::string exported = Tracing::ExportChromeJSON();
+	REQUIRE(exported.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+	REQUIRE(exported.find("\"args\":{\"name\":\"TEST_WORKER\"}") != std::string::npos);
+	REQUIRE(exported.find("{\"name\":\"test_worker\",\"cat\":\"grinpp\",\"ph\":\"X\"") != std::string::npos);
+	REQUIRE(exported.find("\"args\":{\"height\":1234}") != std::string::npos);
+	REQUIRE(exported.find("{\"name\":\"test_main\"") != std::string::npos);
+
+	// Starting a new session discards the previous one
+	Tracing::SetEnabled(true);
+	Tracing::SetEnabled(false);
+	REQUIRE(Tracing::ExportChromeJSON().find("test_worker") == std::string::npos);
+	REQUIRE(Tracing::ExportChromeJSON().find("test_main") == std::string::npos);
+}
+
+TEST_CASE("Tracing::Ring buffer")
+{
+	Tracing::SetEnabled(true);
+
+	// The oldest spans are overwritten once a thread's buffer is full
+	const auto start = std::chrono::steady_clock::now();
+	Tracing::Record("test_oldest", start, start, nullptr, 0);
+	for (size_t i = 1; i < Tracing::BUFFER_CAPACITY + 10; i++)
+	{
+		Tracing::Record("test_ring", start, start, "i", i);
+	}
+
+	Tracing::SetEnabled(false);
+
+	const std::string exported = Tracing::ExportChromeJSON();
+	REQUIRE(exported.find("test_oldest") == std::string::npos);
+	REQUIRE(CountOccurrences(exported, "\"name\":\"test_ring\"") == Tracing::BUFFER_CAPACITY);
+
+	// Exported in the order recorded
+	const size_t firstKept = exported.find("\"args\":{\"i\":10}");
+	REQUIRE(firstKept != std::string::npos);
+	REQUIRE(firstKept < exported.find("\"args\":{\"i\":11}"));
+	REQUIRE(exported.find("\"args\":{\"i\":9}") == std::string::npos);
+	REQUIRE(exported.find("\"args\":{\"i\":" + std::to_string(Tracing::BUFFER_CAPACITY + 9) + "}") != std::string::npos);
+}
+
+TEST_CASE("Tracing::Exited threads")
+{
+	Tracing::SetEnabled(true);
+
+	// Only the most recently exited threads' spans are kept
+	for (size_t i = 0; i < Tracing::MAX_EXITED_THREADS + 10; i++)
+	{
+		std::thread thread([]() { Tracing::Span span("test_exited"); });
+		thread.join();
+	}
+
+	Tracing::SetEnabled(false);
+
+	const size_t numKept = CountOccurrences(Tracing::ExportChromeJSON(), "\"name\":\"test_exited\"");
+	REQUIRE(numKept <= Tracing::MAX_EXITED_THREADS);
+	REQUIRE(numKept >= Tracing::MAX_EXITED_THREADS - 1);
+}
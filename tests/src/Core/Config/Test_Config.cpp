@@ -0,0 +1,60 @@
+#include <catch.hpp>
+
+#include <Core/Config.h>
+
+TEST_CASE("Config - HTTP server defaults")
+{
+	Config::Ptr pConfig = Config::Load(Json::Value(Json::objectValue), Environment::AUTOMATED_TESTING);
+
+	const ServerOptions& restAPIOptions = pConfig->GetRestAPIServerOptions();
+	REQUIRE(restAPIOptions.numThreads == 32);
+	REQUIRE(restAPIOptions.keepAlive);
+	REQUIRE(restAPIOptions.endpointLimits.at("/v1/txhashset/outputs") == 2);
+	REQUIRE(restAPIOptions.endpointLimits.at("/v1/blocks/") == 4);
+
+	const ServerOptions& walletOptions = pConfig->GetWalletServerOptions();
+	REQUIRE(walletOptions.numThreads == ServerOptions().numThreads);
+	REQUIRE(walletOptions.keepAliveTimeoutMs == ServerOptions().keepAliveTimeoutMs);
+	REQUIRE(walletOptions.endpointLimits.empty());
+}
+
+TEST_CASE("Config - HTTP server overrides")
+{
+	Json::Value json;
+
+	Json::Value& restAPIJSON = json["SERVER"]["HTTP"];
+	restAPIJSON["THREADS"] = 0;
+	restAPIJSON["KEEP_ALIVE"] = false;
+	restAPIJSON["KEEP_ALIVE_TIMEOUT_MS"] = 1000;
+	restAPIJSON["REQUEST_TIMEOUT_MS"] = 30000;
+	restAPIJSON["CONNECTION_QUEUE"] = 16;
+	restAPIJSON["LISTEN_BACKLOG"] = 32;
+	restAPIJSON["ENDPOINT_LIMITS"]["/v1/txhashset/outputs"] = 0;
+	restAPIJSON["ENDPOINT_LIMITS"]["/v1/blocks/"] = 8;
+	restAPIJSON["ENDPOINT_LIMITS"]["/v1/status"] = 1;
+
+	json["WALLET"]["HTTP"]["THREADS"] = 4;
+
+	Config::Ptr pConfig = Config::Load(json, Environment::AUTOMATED_TESTING);
+
+	const ServerOptions& restAPIOptions = pConfig->GetRestAPIServerOptions();
+
+	// At least 1 thread is always used.
+	REQUIRE(restAPIOptions.numThreads == 1);
+	REQUIRE_FALSE(restAPIOptions.keepAlive);
+	REQUIRE(restAPIOptions.keepAliveTimeoutMs == 1000);
+	REQUIRE(restAPIOptions.requestTimeoutMs == 30000);
+	REQUIRE(restAPIOptions.connectionQueue == 16);
+	REQUIRE(restAPIOptions.listenBacklog == 32);
+
+	// A limit of 0 removes the default, and limits not in the config keep their defaults.
+	REQUIRE(restAPIOptions.endpointLimits.count("/v1/txhashset/outputs") == 0);
+	REQUIRE(restAPIOptions.endpointLimits.at("/v1/blocks/") == 8);
+	REQUIRE(restAPIOptions.endpointLimits.at("/v1/status") == 1);
+	REQUIRE(restAPIOptions.endpointLimits.at("/v1/chain/outputs/byheight") == 2);
+
+	// The wallet server is configured separately.
+	const ServerOptions& walletOptions = pConfig->GetWalletServerOptions();
+	REQUIRE(walletOptions.numThreads == 4);
+	REQUIRE(walletOptions.keepAlive);
+}
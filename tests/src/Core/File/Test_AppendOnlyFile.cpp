@@ -1,6 +1,8 @@
 #include <catch.hpp>
 
 #include <Core/File/DataFile.h>
+#include <Core/File/FileSwap.h>
+#include <Core/File/FileRemover.h>
 #include <TestFileUtil.h>
 #include <Crypto/CSPRNG.h>
 
@@ -30,4 +32,92 @@ TEST_CASE("DataFile")
     pDataFile->Commit();
 
     REQUIRE(pDataFile->GetSize() == 4);
+}
+
+TEST_CASE("DataFile - Staged Compaction")
+{
+    auto pFile = TestFileUtil::CreateTempFile();
+    auto pDataFile = DataFile<32>::Load(pFile->GetPath());
+    FileRemover stagedFileRemover(FileSwap::GetStagedPath(pFile->GetPath()));
+
+    std::vector<CBigInteger<32>> data;
+    for (size_t i = 0; i < 10; i++)
+    {
+        data.push_back(CSPRNG::GenerateRandom32());
+        pDataFile->AddData(data.back());
+    }
+    pDataFile->Commit();
+
+    // The compacted copy is staged without touching the loaded file.
+    std::vector<bool> keep = { true, false, false, true, true, false, true, true, false, true };
+    DataFile<32>::StageCompaction(pFile->GetPath(), keep);
+    REQUIRE(pDataFile->GetSize() == 10);
+
+    // Data added after staging is carried over to the staged copy.
+    CBigInteger<32> appended = CSPRNG::GenerateRandom32();
+    pDataFile->AddData(appended);
+
+    // Uncommitted changes can't be carried over.
+    REQUIRE_THROWS(pDataFile->AppendToStaged(keep.size()));
+    pDataFile->Commit();
+
+    pDataFile->AppendToStaged(keep.size());
+    pDataFile->SwapStaged();
+
+    REQUIRE(pDataFile->GetSize() == 7);
+    REQUIRE_FALSE(FileUtil::Exists(FileSwap::GetStagedPath(pFile->GetPath())));
+
+    size_t index = 0;
+    for (size_t i = 0; i < keep.size(); i++)
+    {
+        if (keep[i])
+        {
+            REQUIRE(pDataFile->GetDataAt(index++) == data[i].GetData());
+        }
+    }
+
+    REQUIRE(pDataFile->GetDataAt(6) == appended.GetData());
+
+    // New data is appended after the compacted entries.
+    CBigInteger<32> appended2 = CSPRNG::GenerateRandom32();
+    pDataFile->AddData(appended2);
+    pDataFile->Commit();
+
+    REQUIRE(pDataFile->GetSize() == 8);
+    REQUIRE(pDataFile->GetDataAt(7) == appended2.GetData());
+}
+
+TEST_CASE("FileSwap - Recover")
+{
+    auto pManifest = TestFileUtil::CreateTempFile();
+    auto pFile1 = TestFileUtil::CreateTempFile();
+    auto pFile2 = TestFileUtil::CreateTempFile();
+    auto pFile3 = TestFileUtil::CreateTempFile();
+
+    FileUtil::WriteTextToFile(pFile1->GetPath(), "old1");
+    FileUtil::WriteTextToFile(pFile2->GetPath(), "old2");
+    FileUtil::WriteTextToFile(pFile3->GetPath(), "old3");
+    FileUtil::WriteTextToFile(FileSwap::GetStagedPath(pFile1->GetPath()), "new1");
+    FileUtil::WriteTextToFile(FileSwap::GetStagedPath(pFile2->GetPath()), "new2");
+    FileUtil::WriteTextToFile(FileSwap::GetStagedPath(pFile3->GetPath()), "new3");
+
+    auto readText = [](const fs::path& path) {
+        std::vector<uint8_t> bytes;
+        REQUIRE(FileUtil::ReadFile(path, bytes));
+        return std::string(bytes.cbegin(), bytes.cend());
+    };
+
+    // Interrupted after the first file of the swap was replaced.
+    FileSwap::Begin(pManifest->GetPath(), { pFile1->GetPath(), pFile2->GetPath() });
+    FileSwap::Swap(pFile1->GetPath());
+
+    FileSwap::Recover(pManifest->GetPath(), { pFile1->GetPath(), pFile2->GetPath(), pFile3->GetPath() });
+
+    REQUIRE(readText(pFile1->GetPath()) == "new1");
+    REQUIRE(readText(pFile2->GetPath()) == "new2");
+    REQUIRE_FALSE(FileUtil::Exists(pManifest->GetPath()));
+
+    // File 3 was staged, but never part of a swap, so it's left as it was.
+    REQUIRE(readText(pFile3->GetPath()) == "old3");
+    REQUIRE_FALSE(FileUtil::Exists(FileSwap::GetStagedPath(pFile3->GetPath())));
 }
\ No newline at end of file
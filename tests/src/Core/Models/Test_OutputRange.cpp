@@ -0,0 +1,112 @@
+#include <catch.hpp>
+
+#include <Core/Models/DTOs/OutputRange.h>
+#include <Crypto/CSPRNG.h>
+
+static OutputDTO CreateOutput(const uint64_t leafIndex, const uint64_t blockHeight)
+{
+	SecureVector commitBytes = CSPRNG::GenerateRandomBytes(33);
+	SecureVector proofBytes = CSPRNG::GenerateRandomBytes(MAX_PROOF_SIZE);
+
+	return OutputDTO(
+		false,
+		OutputIdentifier(EOutputFeatures::DEFAULT, Commitment(CBigInteger<33>(std::vector<uint8_t>(commitBytes.begin(), commitBytes.end())))),
+		OutputLocation(LeafIndex::At(leafIndex), blockHeight),
+		RangeProof(std::vector<uint8_t>(proofBytes.begin(), proofBytes.end()))
+	);
+}
+
+TEST_CASE("OutputRange - Binary Serialization")
+{
+	std::vector<OutputDTO> outputs = {
+		CreateOutput(5, 100),
+		CreateOutput(6, 100),
+		CreateOutput(9, 102)
+	};
+	const OutputRange range(1000, 9, std::vector<OutputDTO>(outputs));
+
+	Serializer serializer;
+	range.Serialize(serializer);
+
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	const OutputRange deserialized = OutputRange::Deserialize(byteBuffer);
+	REQUIRE(byteBuffer.GetRemainingSize() == 0);
+
+	REQUIRE(deserialized.GetHighestIndex() == 1000);
+	REQUIRE(deserialized.GetLastRetrievedIndex() == 9);
+	REQUIRE(deserialized.GetOutputs().size() == outputs.size());
+	for (size_t i = 0; i < outputs.size(); i++)
+	{
+		const OutputDTO& output = deserialized.GetOutputs()[i];
+		REQUIRE(output.GetIdentifier() == outputs[i].GetIdentifier());
+		REQUIRE(output.GetLeafIndex() == outputs[i].GetLeafIndex());
+		REQUIRE(output.GetBlockHeight() == outputs[i].GetBlockHeight());
+		REQUIRE(output.GetRangeProof() == outputs[i].GetRangeProof());
+	}
+
+	// Much smaller than the hex-encoded JSON
+	REQUIRE(serializer.size() < 3 * 800);
+
+	// Unknown versions are rejected
+	std::vector<uint8_t> bytes = serializer.GetBytes();
+	bytes[0] = OutputRange::BINARY_FORMAT_VERSION + 1;
+	ByteBuffer badVersion(bytes);
+	REQUIRE_THROWS(OutputRange::Deserialize(badVersion));
+}
+
+TEST_CASE("OutputRange - Paged Serialization")
+{
+	// Leaves 1-20, with every third one spent.
+	std::vector<OutputDTO> unspent;
+	for (uint64_t leafIndex = 1; leafIndex <= 20; leafIndex++)
+	{
+		if (leafIndex % 3 != 0)
+		{
+			unspent.push_back(CreateOutput(leafIndex, leafIndex / 2));
+		}
+	}
+
+	std::vector<std::pair<uint64_t, uint64_t>> pagesRequested;
+	auto getPage = [&unspent, &pagesRequested](const uint64_t startIndex, const uint64_t maxOutputs) {
+		pagesRequested.push_back({ startIndex, maxOutputs });
+
+		std::vector<OutputDTO> outputs;
+		uint64_t lastRetrievedIndex = 0;
+		for (const OutputDTO& output : unspent)
+		{
+			if (output.GetLeafIndex() >= startIndex && outputs.size() < maxOutputs)
+			{
+				outputs.push_back(output);
+				lastRetrievedIndex = output.GetLeafIndex().Get();
+			}
+		}
+
+		return OutputRange(20, lastRetrievedIndex, std::move(outputs));
+	};
+
+	Serializer serializer;
+	OutputRange::SerializePages(serializer, 2, 7, 3, getPage);
+
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	const OutputRange deserialized = OutputRange::Deserialize(byteBuffer);
+	REQUIRE(byteBuffer.GetRemainingSize() == 0);
+
+	// Leaves 2, 4, 5, 7, 8, 10 & 11, fetched in pages of at most 3.
+	REQUIRE(deserialized.GetHighestIndex() == 20);
+	REQUIRE(deserialized.GetLastRetrievedIndex() == 11);
+	REQUIRE(deserialized.GetOutputs().size() == 7);
+	REQUIRE(deserialized.GetOutputs().front().GetLeafIndex().Get() == 2);
+	REQUIRE(deserialized.GetOutputs().back().GetLeafIndex().Get() == 11);
+	REQUIRE(pagesRequested == std::vector<std::pair<uint64_t, uint64_t>>({ { 2, 3 }, { 6, 3 }, { 11, 1 } }));
+
+	// Stops at the end of the MMR, even if fewer than max outputs were found.
+	pagesRequested.clear();
+	Serializer tailSerializer;
+	OutputRange::SerializePages(tailSerializer, 17, 100, 3, getPage);
+
+	ByteBuffer tailBuffer(tailSerializer.GetBytes());
+	const OutputRange tail = OutputRange::Deserialize(tailBuffer);
+	REQUIRE(tail.GetOutputs().size() == 3);
+	REQUIRE(tail.GetLastRetrievedIndex() == 20);
+	REQUIRE(pagesRequested.size() == 2);
+}
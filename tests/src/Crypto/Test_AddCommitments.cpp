@@ -65,4 +65,52 @@ TEST_CASE("Crypto - PublicKey to Commitment")
 {
 	auto commit = Crypto::ToCommitment(PublicKey(CBigInteger<33>::FromHex("02f434a6b929d0aa6ac757bbe387075066d51ee5308d5be91d2fb478a494d38bdf")));
 	REQUIRE(commit.ToHex() == "08f434a6b929d0aa6ac757bbe387075066d51ee5308d5be91d2fb478a494d38bdf");
-}
\ No newline at end of file
+}
+TEST_CASE("Crypto::AddCommitments - Parallel")
+{
+	const uint64_t numCommitments = 20'000;
+
+	std::vector<BlindingFactor> blinds;
+	std::vector<Commitment> commitments;
+	for (uint64_t i = 0; i < numCommitments; i++)
+	{
+		BlindingFactor blind = CSPRNG::GenerateRandom32() / 2;
+		commitments.push_back(Crypto::CommitBlinded(i, blind));
+		blinds.push_back(std::move(blind));
+	}
+
+	const uint64_t totalAmount = (numCommitments * (numCommitments - 1)) / 2;
+	const Commitment expected = Crypto::CommitBlinded(totalAmount, Crypto::AddBlindingFactors(blinds, {}));
+
+	// Large vectors are split across threads
+	REQUIRE(Crypto::AddCommitments(commitments, {}) == expected);
+
+	// Streamed commitments, skipping every 3rd index
+	std::vector<BlindingFactor> streamedBlinds;
+	uint64_t streamedAmount = 0;
+	for (uint64_t i = 0; i < numCommitments; i++)
+	{
+		if (i % 3 != 0) {
+			streamedBlinds.push_back(blinds[i]);
+			streamedAmount += i;
+		}
+	}
+
+	Commitment streamedSum = Crypto::AddCommitments(
+		numCommitments,
+		[&commitments](const uint64_t index) -> std::optional<Commitment> {
+			if (index % 3 == 0) {
+				return std::nullopt;
+			}
+
+			return std::make_optional(commitments[index]);
+		}
+	);
+	REQUIRE(streamedSum == Crypto::CommitBlinded(streamedAmount, Crypto::AddBlindingFactors(streamedBlinds, {})));
+
+	// Negative commitments are applied after the parallel sum
+	REQUIRE(Crypto::AddCommitments(commitments, { commitments.back() }) == Crypto::AddCommitments(
+		std::vector<Commitment>(commitments.cbegin(), commitments.cend() - 1),
+		{}
+	));
+}
@@ -0,0 +1,36 @@
+#include <catch.hpp>
+
+#include <Crypto/VerificationCache.h>
+#include <Crypto/CSPRNG.h>
+
+TEST_CASE("VerificationCache")
+{
+	VerificationCache cache(64);
+
+	std::vector<std::vector<uint8_t>> keys;
+	for (size_t i = 0; i < 16; i++)
+	{
+		keys.push_back(CSPRNG::GenerateRandom32().GetData());
+	}
+
+	for (const auto& key : keys)
+	{
+		REQUIRE_FALSE(cache.Contains(key));
+	}
+
+	cache.Add(keys[0]);
+	REQUIRE(cache.Contains(keys[0]));
+	REQUIRE_FALSE(cache.Contains(keys[1]));
+
+	// Adding twice is harmless
+	cache.Add(keys[0]);
+	REQUIRE(cache.Contains(keys[0]));
+
+	// Filling the cache past its capacity evicts older entries, but never loses the newest one.
+	for (size_t i = 0; i < 1000; i++)
+	{
+		const std::vector<uint8_t> key = CSPRNG::GenerateRandom32().GetData();
+		cache.Add(key);
+		REQUIRE(cache.Contains(key));
+	}
+}
@@ -0,0 +1,69 @@
+#include <catch.hpp>
+
+#include <Database/HeaderCache.h>
+
+static BlockHeaderPtr CreateHeader(const uint64_t height)
+{
+	return std::make_shared<BlockHeader>(
+		(uint16_t)1,
+		height,
+		(int64_t)height,
+		Hash(ZERO_HASH),
+		Hash(ZERO_HASH),
+		Hash(ZERO_HASH),
+		Hash(ZERO_HASH),
+		Hash(ZERO_HASH),
+		BlindingFactor(ZERO_HASH),
+		0,
+		0,
+		height,
+		1,
+		height,
+		ProofOfWork(29, std::vector<uint64_t>(42, height))
+	);
+}
+
+TEST_CASE("HeaderCache - Get & Put")
+{
+	HeaderCache cache(1024 * 1024);
+	REQUIRE(cache.GetCapacity() > 0);
+
+	BlockHeaderPtr pHeader = CreateHeader(1);
+	REQUIRE(cache.Get(pHeader->GetHash()) == nullptr);
+
+	cache.Put(pHeader);
+	REQUIRE(cache.Get(pHeader->GetHash()) == pHeader);
+	REQUIRE(cache.GetSize() == 1);
+
+	// Adding the same header again doesn't create a second entry.
+	cache.Put(pHeader);
+	REQUIRE(cache.GetSize() == 1);
+}
+
+TEST_CASE("HeaderCache - Eviction")
+{
+	// The smallest possible cache holds one entry per shard.
+	HeaderCache cache(0);
+	const size_t capacity = cache.GetCapacity();
+
+	std::vector<BlockHeaderPtr> headers;
+	for (uint64_t height = 0; height < capacity * 10; height++)
+	{
+		headers.push_back(CreateHeader(height));
+		cache.Put(headers.back());
+		REQUIRE(cache.Get(headers.back()->GetHash()) == headers.back());
+	}
+
+	REQUIRE(cache.GetSize() <= capacity);
+
+	size_t numCached = 0;
+	for (const BlockHeaderPtr& pHeader : headers)
+	{
+		if (cache.Get(pHeader->GetHash()) != nullptr)
+		{
+			numCached++;
+		}
+	}
+
+	REQUIRE(numCached == cache.GetSize());
+}
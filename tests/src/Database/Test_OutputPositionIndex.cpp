@@ -0,0 +1,132 @@
+#include <catch.hpp>
+
+#include <Database/OutputPositionIndex.h>
+#include <Crypto/CSPRNG.h>
+#include <cstring>
+#include <unordered_map>
+
+static Commitment RandomCommitment()
+{
+	const SecureVector random = CSPRNG::GenerateRandomBytes(33);
+	std::vector<uint8_t> bytes(random.begin(), random.end());
+	bytes[0] = 0x08;
+	return Commitment(CBigInteger<33>(std::move(bytes)));
+}
+
+TEST_CASE("OutputPositionIndex - Put, Get & Remove")
+{
+	OutputPositionIndex index;
+
+	const Commitment commitment = RandomCommitment();
+	REQUIRE(index.Get(commitment) == nullptr);
+
+	index.Put(commitment, OutputLocation(LeafIndex::At(5), 100));
+	auto pLocation = index.Get(commitment);
+	REQUIRE(pLocation != nullptr);
+	REQUIRE(pLocation->GetLeafIndex().Get() == 5);
+	REQUIRE(pLocation->GetBlockHeight() == 100);
+
+	// Overwrite
+	index.Put(commitment, OutputLocation(LeafIndex::At(7), 101));
+	REQUIRE(index.GetSize() == 1);
+	REQUIRE(index.Get(commitment)->GetLeafIndex().Get() == 7);
+
+	index.Remove(commitment);
+	REQUIRE(index.Get(commitment) == nullptr);
+	REQUIRE(index.GetSize() == 0);
+}
+
+TEST_CASE("OutputPositionIndex - Shared prefixes")
+{
+	OutputPositionIndex index(16);
+
+	// Same prefix, different suffix.
+	std::vector<uint8_t> bytes(33, 0x01);
+	bytes[0] = 0x08;
+	const Commitment commitment1{ CBigInteger<33>(std::vector<uint8_t>(bytes)) };
+	bytes[32] = 0x02;
+	const Commitment commitment2{ CBigInteger<33>(std::vector<uint8_t>(bytes)) };
+
+	index.Put(commitment1, OutputLocation(LeafIndex::At(1), 1));
+	REQUIRE(index.Get(commitment2) == nullptr);
+
+	index.Put(commitment2, OutputLocation(LeafIndex::At(2), 2));
+	REQUIRE(index.Get(commitment1)->GetLeafIndex().Get() == 1);
+	REQUIRE(index.Get(commitment2)->GetLeafIndex().Get() == 2);
+
+	index.Remove(commitment1);
+	REQUIRE(index.Get(commitment1) == nullptr);
+	REQUIRE(index.Get(commitment2)->GetLeafIndex().Get() == 2);
+}
+
+TEST_CASE("OutputPositionIndex - Growth & removal")
+{
+	OutputPositionIndex index(16);
+
+	std::unordered_map<Commitment, uint64_t> expected;
+	for (uint64_t i = 0; i < 5000; i++)
+	{
+		const Commitment commitment = RandomCommitment();
+		index.Put(commitment, OutputLocation(LeafIndex::At(i), i));
+		expected.insert({ commitment, i });
+	}
+
+	REQUIRE(index.GetSize() == expected.size());
+
+	size_t i = 0;
+	for (auto iter = expected.begin(); iter != expected.end();)
+	{
+		if (i++ % 2 == 0)
+		{
+			index.Remove(iter->first);
+			REQUIRE(index.Get(iter->first) == nullptr);
+			iter = expected.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	REQUIRE(index.GetSize() == expected.size());
+	for (const auto& entry : expected)
+	{
+		auto pLocation = index.Get(entry.first);
+		REQUIRE(pLocation != nullptr);
+		REQUIRE(pLocation->GetLeafIndex().Get() == entry.second);
+	}
+
+	index.Clear();
+	REQUIRE(index.GetSize() == 0);
+	REQUIRE(index.Get(expected.begin()->first) == nullptr);
+}
+
+TEST_CASE("OutputPositionIndex - Ground commitments")
+{
+	OutputPositionIndex index(16);
+
+	// Commitments that only differ past the first 9 bytes used to all share a home slot.
+	std::vector<Commitment> commitments;
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		std::vector<uint8_t> bytes(33, 0x01);
+		bytes[0] = 0x08;
+		std::memcpy(bytes.data() + 29, &i, sizeof(i));
+		commitments.push_back(Commitment{ CBigInteger<33>(std::move(bytes)) });
+		index.Put(commitments.back(), OutputLocation(LeafIndex::At(i), i));
+	}
+
+	for (uint32_t i = 0; i < 1000; i += 2)
+	{
+		index.Remove(commitments[i]);
+	}
+
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		if (i % 2 == 0) {
+			REQUIRE(index.Get(commitments[i]) == nullptr);
+		} else {
+			REQUIRE(index.Get(commitments[i])->GetLeafIndex().Get() == i);
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#include <catch.hpp>
+
+#include <Net/Util/JsonStreamWriter.h>
+#include <Net/Clients/HTTP/HTTPException.h>
+
+TEST_CASE("JsonStreamWriter")
+{
+	std::vector<std::string> chunks;
+	JsonStreamWriter writer([&chunks](const std::string& chunk) { chunks.push_back(chunk); }, 16);
+
+	writer.BeginObject();
+	writer.WriteMember("highest_index", 5);
+	writer.Key("outputs");
+	writer.BeginArray();
+	for (int i = 0; i < 3; i++)
+	{
+		Json::Value output;
+		output["commit"] = "0" + std::to_string(i);
+		output["spent"] = false;
+		writer.Write(output);
+	}
+	writer.EndArray();
+	writer.WriteMember("last_retrieved_index", 3);
+	writer.EndObject();
+	writer.Flush();
+
+	// Output is handed to the sink in multiple chunks.
+	REQUIRE(chunks.size() > 1);
+
+	std::string json;
+	for (const std::string& chunk : chunks)
+	{
+		json += chunk;
+	}
+
+	REQUIRE(json == "{\"highest_index\":5,\"outputs\":[{\"commit\":\"00\",\"spent\":false},{\"commit\":\"01\",\"spent\":false},{\"commit\":\"02\",\"spent\":false}],\"last_retrieved_index\":3}");
+
+	Json::Value parsed;
+	Json::CharReaderBuilder builder;
+	std::string errors;
+	std::unique_ptr<Json::CharReader> pReader(builder.newCharReader());
+	REQUIRE(pReader->parse(json.data(), json.data() + json.size(), &parsed, &errors));
+	REQUIRE(parsed["outputs"].size() == 3);
+}
+
+TEST_CASE("JsonStreamWriter - Invalid Structure")
+{
+	JsonStreamWriter writer([](const std::string&) { });
+
+	writer.BeginObject();
+	REQUIRE_THROWS_AS(writer.Write(Json::Value(1)), HTTPException);
+	REQUIRE_THROWS_AS(writer.EndArray(), HTTPException);
+
+	writer.Key("key");
+	REQUIRE_THROWS_AS(writer.Key("another"), HTTPException);
+	REQUIRE_THROWS_AS(writer.EndObject(), HTTPException);
+}
@@ -0,0 +1,77 @@
+#include <catch.hpp>
+
+#include <Net/Servers/Server.h>
+#include <Net/Connections/HttpConnection.h>
+#include <Net/Util/HTTPUtil.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+//
+// Handler that doesn't respond until released, so the test controls how many requests are active.
+//
+struct BlockingHandler
+{
+	std::atomic<uint32_t> numEntered{ 0 };
+	std::promise<void> release;
+	std::shared_future<void> released{ release.get_future().share() };
+
+	static int Handle(struct mg_connection* conn, void* pHandler)
+	{
+		BlockingHandler* pBlockingHandler = (BlockingHandler*)pHandler;
+		pBlockingHandler->numEntered++;
+		pBlockingHandler->released.wait();
+
+		return HTTPUtil::BuildSuccessResponse(conn, "done");
+	}
+};
+
+TEST_CASE("Server - Endpoint concurrency limit")
+{
+	// Declared before the server, so they outlive its worker threads.
+	BlockingHandler limitedHandler;
+	BlockingHandler unlimitedHandler;
+
+	ServerOptions options;
+	options.numThreads = 8;
+	options.endpointLimits = { { "/limited", 1 } };
+	ServerPtr pServer = Server::Create(EServerType::LOCAL, std::nullopt, options);
+	pServer->AddListener("/limited", BlockingHandler::Handle, &limitedHandler);
+	pServer->AddListener("/unlimited", BlockingHandler::Handle, &unlimitedHandler);
+
+	const uint16_t port = pServer->GetPortNumber();
+	auto get = [port](const std::string& location) {
+		return std::async(std::launch::async, [port, location]() {
+			return HttpConnection::Connect("127.0.0.1", port)->Get(location).GetStatusCode();
+		});
+	};
+	auto wait_for_entered = [](const BlockingHandler& handler, const uint32_t numEntered) {
+		const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (handler.numEntered < numEntered && std::chrono::steady_clock::now() < timeout) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return handler.numEntered == numEntered;
+	};
+
+	// The first request occupies the only slot, so the next one is turned away without reaching the handler.
+	auto firstLimited = get("/limited");
+	REQUIRE(wait_for_entered(limitedHandler, 1));
+	REQUIRE(get("/limited").get() == 503);
+	REQUIRE(limitedHandler.numEntered == 1);
+
+	// Endpoints without a limit aren't affected.
+	auto firstUnlimited = get("/unlimited");
+	auto secondUnlimited = get("/unlimited");
+	REQUIRE(wait_for_entered(unlimitedHandler, 2));
+
+	limitedHandler.release.set_value();
+	unlimitedHandler.release.set_value();
+	REQUIRE(firstLimited.get() == 200);
+	REQUIRE(firstUnlimited.get() == 200);
+	REQUIRE(secondUnlimited.get() == 200);
+
+	// The slot is freed once the request completes.
+	REQUIRE(get("/limited").get() == 200);
+	REQUIRE(limitedHandler.numEntered == 2);
+}
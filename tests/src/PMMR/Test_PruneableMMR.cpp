@@ -0,0 +1,182 @@
+#include <catch.hpp>
+
+#include <Core/Models/FullBlock.h>
+#include <PMMR/OutputPMMR.h>
+#include <Core/File/FileSwap.h>
+#include <Crypto/CSPRNG.h>
+#include <TestFileUtil.h>
+#include <functional>
+
+using TestMMR = PruneableMMR<OUTPUT_SIZE, OutputIdentifier>;
+
+static std::shared_ptr<TestMMR> LoadMMR(const fs::path& directory)
+{
+	FileUtil::CreateDirectories(directory);
+
+	return std::make_shared<TestMMR>(
+		HashFile::Load(directory / "pmmr_hash.bin"),
+		LeafSet::Load(directory / "pmmr_leafset.bin"),
+		PruneList::Load(directory / "pmmr_prun.bin"),
+		DataFile<OUTPUT_SIZE>::Load(directory / "pmmr_data.bin")
+	);
+}
+
+static OutputIdentifier RandomOutput()
+{
+	const SecureVector random = CSPRNG::GenerateRandomBytes(33);
+	std::vector<uint8_t> bytes(random.begin(), random.end());
+	bytes[0] = 0x08;
+	return OutputIdentifier(EOutputFeatures::DEFAULT, Commitment(CBigInteger<33>(std::move(bytes))));
+}
+
+//
+// Applies the same changes to an MMR that gets compacted and to a reference MMR that doesn't,
+// so the compacted one can be checked against it.
+//
+class CompactionFixture
+{
+public:
+	CompactionFixture()
+		: m_pDir(TestFileUtil::CreateTempFile()),
+		m_pMMR(LoadMMR(m_pDir->GetPath() / "compacted")),
+		m_pReference(LoadMMR(m_pDir->GetPath() / "reference")) { }
+
+	void Apply(const std::function<void(TestMMR&)>& change)
+	{
+		change(*m_pMMR);
+		m_pMMR->Commit();
+		change(*m_pReference);
+		m_pReference->Commit();
+	}
+
+	void Append(const size_t numOutputs)
+	{
+		std::vector<OutputIdentifier> outputs;
+		for (size_t i = 0; i < numOutputs; i++) {
+			outputs.push_back(RandomOutput());
+		}
+
+		Apply([&outputs](TestMMR& mmr) {
+			for (const OutputIdentifier& output : outputs) {
+				mmr.Append(output);
+			}
+		});
+		m_numLeaves += numOutputs;
+	}
+
+	void Rewind(const uint64_t numLeaves, const std::vector<uint64_t>& leavesToAdd)
+	{
+		Apply([numLeaves, &leavesToAdd](TestMMR& mmr) { mmr.Rewind(numLeaves, leavesToAdd); });
+		m_numLeaves = numLeaves;
+	}
+
+	// Roots and leaf lookups match the reference MMR.
+	void Verify(const TestMMR& mmr) const
+	{
+		REQUIRE(mmr.GetSize() == m_pReference->GetSize());
+		REQUIRE(mmr.Root(mmr.GetSize()) == m_pReference->Root(m_pReference->GetSize()));
+
+		for (uint64_t leaf = 0; leaf < m_numLeaves; leaf++) {
+			std::unique_ptr<OutputIdentifier> pOutput = mmr.GetAt(LeafIndex::At(leaf));
+			std::unique_ptr<OutputIdentifier> pExpected = m_pReference->GetAt(LeafIndex::At(leaf));
+			REQUIRE((pOutput == nullptr) == (pExpected == nullptr));
+			if (pOutput != nullptr) {
+				REQUIRE(*pOutput == *pExpected);
+			}
+		}
+	}
+
+	fs::path GetCompactedPath() const { return m_pDir->GetPath() / "compacted"; }
+	const std::shared_ptr<TestMMR>& GetMMR() const noexcept { return m_pMMR; }
+
+private:
+	TemporaryFile::Ptr m_pDir;
+	std::shared_ptr<TestMMR> m_pMMR;
+	std::shared_ptr<TestMMR> m_pReference;
+	uint64_t m_numLeaves{ 0 };
+};
+
+TEST_CASE("PruneableMMR - Compaction")
+{
+	CompactionFixture fixture;
+	auto pMMR = fixture.GetMMR();
+
+	fixture.Append(20);
+
+	// Leaves 0-3 are a full subtree, so their parents get compacted too.
+	// Leaf 9 was spent in a block that can still be rewound, and leaf 17 is above the cutoff, so neither gets pruned.
+	const std::vector<uint64_t> spent = { 0, 1, 2, 3, 5, 8, 9, 12, 17 };
+	fixture.Apply([&spent](TestMMR& mmr) {
+		for (uint64_t leaf : spent) {
+			mmr.Remove(LeafIndex::At(leaf));
+		}
+	});
+
+	auto pCompaction = pMMR->PlanCompaction(16, { 9 });
+	REQUIRE(pCompaction != nullptr);
+
+	// Staging doesn't touch the MMR itself.
+	pCompaction->Stage();
+	REQUIRE_FALSE(pMMR->IsCompacted(LeafIndex::At(0).GetIndex()));
+	fixture.Verify(*pMMR);
+
+	// Outputs added while the compaction was staged are carried over.
+	fixture.Append(3);
+
+	REQUIRE(pMMR->FinishCompaction(*pCompaction));
+	pMMR->SwapCompaction(*pCompaction);
+
+	for (const fs::path& file : pCompaction->GetFiles()) {
+		REQUIRE_FALSE(FileUtil::Exists(FileSwap::GetStagedPath(file)));
+	}
+
+	REQUIRE(pMMR->IsCompacted(LeafIndex::At(0).GetIndex()));
+	REQUIRE(pMMR->GetHashAt(LeafIndex::At(1).GetIndex()) == nullptr);
+	REQUIRE(pMMR->GetHashAt(LeafIndex::At(9).GetIndex()) != nullptr);
+	REQUIRE(pMMR->GetHashAt(LeafIndex::At(17).GetIndex()) != nullptr);
+	fixture.Verify(*pMMR);
+
+	// New outputs are appended after the compacted entries.
+	fixture.Append(5);
+	fixture.Verify(*pMMR);
+
+	// Rewinding above the cutoff still works, including restoring spent leaves.
+	fixture.Rewind(20, { 17 });
+	fixture.Verify(*pMMR);
+
+	// The compacted files and prune list were all persisted.
+	fixture.Verify(*LoadMMR(fixture.GetCompactedPath()));
+
+	// Nothing left to prune.
+	REQUIRE(pMMR->PlanCompaction(16, { 9 }) == nullptr);
+}
+
+TEST_CASE("PruneableMMR - Compaction Discarded After Rewind")
+{
+	CompactionFixture fixture;
+	auto pMMR = fixture.GetMMR();
+
+	fixture.Append(20);
+	fixture.Apply([](TestMMR& mmr) {
+		mmr.Remove(LeafIndex::At(0));
+		mmr.Remove(LeafIndex::At(1));
+	});
+
+	auto pCompaction = pMMR->PlanCompaction(16, {});
+	REQUIRE(pCompaction != nullptr);
+	pCompaction->Stage();
+
+	// Rewinding may change what was staged, so the staged files can't be used anymore.
+	fixture.Rewind(18, {});
+	fixture.Append(2);
+
+	REQUIRE_FALSE(pMMR->FinishCompaction(*pCompaction));
+
+	FileSwap::Discard(pCompaction->GetFiles());
+	for (const fs::path& file : pCompaction->GetFiles()) {
+		REQUIRE_FALSE(FileUtil::Exists(FileSwap::GetStagedPath(file)));
+	}
+
+	REQUIRE_FALSE(pMMR->IsCompacted(LeafIndex::At(0).GetIndex()));
+	fixture.Verify(*pMMR);
+}
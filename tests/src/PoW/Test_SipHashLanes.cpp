@@ -0,0 +1,61 @@
+#include <catch.hpp>
+
+#include <PoW/SipHashLanes.h>
+#include <Crypto/CSPRNG.h>
+#include <Crypto/Models/SecretKey.h>
+#include <memory>
+
+template<int rotE>
+static void CheckSipBlocks(const siphash_keys& keys, const std::vector<word_t>& starts)
+{
+    std::unique_ptr<uint64_t[][EDGE_BLOCK_SIZE]> buffers(new uint64_t[starts.size()][EDGE_BLOCK_SIZE]);
+    SipHashLanes::SipBlocks<rotE>(keys, starts.data(), starts.size(), buffers.get());
+
+    for (size_t b = 0; b < starts.size(); b++)
+    {
+        siphash_state<rotE> shs(keys);
+        for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
+        {
+            shs.hash24(starts[b] + i);
+            REQUIRE(buffers[b][i] == shs.xor_lanes());
+        }
+    }
+}
+
+TEST_CASE("SipHashLanes")
+{
+    INFO("Implementation: " << SipHashLanes::GetImplementation());
+
+    SecretKey keyBytes = CSPRNG::GenerateRandom32();
+    siphash_keys keys((const char*)keyBytes.data());
+
+    // Block counts that don't divide evenly into lanes exercise the scalar tail.
+    for (size_t numBlocks : std::vector<size_t>{ 0, 1, 3, 4, 5, PROOFSIZE })
+    {
+        std::vector<word_t> starts;
+        for (size_t b = 0; b < numBlocks; b++)
+        {
+            starts.push_back(CSPRNG::GenerateRandom(0, 1 << 29) & ~(word_t)EDGE_BLOCK_MASK);
+        }
+
+        CheckSipBlocks<21>(keys, starts);
+        CheckSipBlocks<25>(keys, starts);
+    }
+
+    // Nodes are each hashed from the initial key state.
+    std::vector<word_t> nonces;
+    for (size_t n = 0; n < 2 * PROOFSIZE + 1; n++)
+    {
+        nonces.push_back(CSPRNG::GenerateRandom(0, 1ull << 32));
+    }
+
+    std::vector<uint64_t> hashes(nonces.size());
+    SipHashLanes::SipNodes(keys, nonces.data(), nonces.size(), hashes.data());
+
+    for (size_t n = 0; n < nonces.size(); n++)
+    {
+        siphash_state<> shs(keys);
+        shs.hash24(nonces[n]);
+        REQUIRE(hashes[n] == shs.xor_lanes());
+    }
+}
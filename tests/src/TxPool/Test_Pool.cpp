@@ -0,0 +1,70 @@
+#include <catch.hpp>
+
+#include <TxPool/Pool.h>
+#include <TxBuilder.h>
+
+TEST_CASE("Pool indexes")
+{
+    TxBuilder tx_builder(KeyChain::FromRandom());
+
+    auto build_tx = [&tx_builder](const uint32_t idx, const uint64_t fee_base) {
+        TxBuilder::Criteria criteria;
+        criteria.inputs = { tx_builder.BuildInput(EOutputFeatures::DEFAULT, KeyChainPath({ 1, idx }), (uint64_t)10'000'000'000) };
+        criteria.outputs = { Test::Output{ KeyChainPath({ 2, idx }), (uint64_t)5'000'000'000 } };
+        criteria.include_change = true;
+        criteria.fee_base = fee_base;
+        return std::make_shared<const Transaction>(tx_builder.BuildTx(criteria));
+    };
+
+    TransactionPtr pTx1 = build_tx(0, 1'000'000);
+    TransactionPtr pTx2 = build_tx(1, 500'000);
+    TransactionPtr pTx3 = build_tx(2, 2'000'000);
+
+    Pool pool;
+    pool.AddTransaction(pTx1, EDandelionStatus::FLUFFED);
+    pool.AddTransaction(pTx2, EDandelionStatus::FLUFFED);
+    pool.AddTransaction(pTx3, EDandelionStatus::TO_STEM);
+
+    // Duplicates are ignored
+    pool.AddTransaction(pTx1, EDandelionStatus::FLUFFED);
+    REQUIRE(pool.Size() == 3);
+
+    REQUIRE(pool.ContainsTransaction(*pTx1));
+    REQUIRE(pool.ContainsTransaction(*pTx2));
+    REQUIRE(pool.ContainsTransaction(*pTx3));
+
+    REQUIRE(pool.FindTransactionByKernelHash(pTx2->GetKernels().front().GetHash()) == pTx2);
+    REQUIRE(pool.FindTransactionByKernelHash(Hash()) == nullptr);
+
+    std::vector<TransactionPtr> byKernel = pool.FindTransactionsByKernel({ pTx1->GetKernels().front(), pTx3->GetKernels().front() });
+    REQUIRE(byKernel.size() == 2);
+
+    std::vector<TransactionPtr> toStem = pool.FindTransactionsByStatus(EDandelionStatus::TO_STEM);
+    REQUIRE(toStem.size() == 1);
+    REQUIRE(toStem.front() == pTx3);
+
+    // Lowest fee rate is evicted first
+    REQUIRE(pool.GetLowestFeeRateTransaction() == pTx2);
+
+    pool.RemoveTransaction(*pTx2);
+    REQUIRE(pool.Size() == 2);
+    REQUIRE_FALSE(pool.ContainsTransaction(*pTx2));
+    REQUIRE(pool.FindTransactionByKernelHash(pTx2->GetKernels().front().GetHash()) == nullptr);
+    REQUIRE(pool.GetLowestFeeRateTransaction() == pTx1);
+
+    // Weight and byte accounting
+    const uint64_t tx_weight = Consensus::CalculateWeightV5(1, 2, 1);
+    REQUIRE(pool.GetTotalWeight() == 2 * tx_weight);
+    REQUIRE(pool.GetTotalBytes() > 0);
+
+    REQUIRE(pool.EvictLowestFeeRate() == pTx1);
+    REQUIRE(pool.Size() == 1);
+    REQUIRE(pool.GetTotalWeight() == tx_weight);
+    REQUIRE(pool.GetLowestFeeRate() == pool.GetLowestFeeRateTransaction()->CalcFee() / tx_weight);
+
+    pool.Clear();
+    REQUIRE(pool.Size() == 0);
+    REQUIRE(pool.GetTotalWeight() == 0);
+    REQUIRE(pool.GetTotalBytes() == 0);
+    REQUIRE(pool.GetLowestFeeRateTransaction() == nullptr);
+}
@@ -0,0 +1,78 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <Core/Config.h>
+#include <Core/Serialization/Serializer.h>
+#include <Database/BlockDb.h>
+#include <PMMR/TxHashSetManager.h>
+#include <TxPool/TransactionPool.h>
+
+TEST_CASE("TransactionPool fee floor and eviction")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom();
+	TxBuilder txBuilder(keyChain);
+
+	// Coinbase maturity for tests is only 25
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+
+	auto spend_coinbase = [&txBuilder, &minedChain](const uint32_t height, const uint64_t fee_base) {
+		const TransactionOutput& coinbase = minedChain[height].block.GetOutputs().front();
+
+		TxBuilder::Criteria criteria;
+		criteria.inputs = { Test::Input({
+			{ coinbase.GetFeatures(), coinbase.GetCommitment() },
+			minedChain[height].coinbasePath.value(),
+			minedChain[height].coinbaseAmount
+		}) };
+		criteria.outputs = { Test::Output{ KeyChainPath({ 1, height }), (uint64_t)10'000'000 } };
+		criteria.include_change = true;
+		criteria.fee_base = fee_base;
+		return std::make_shared<const Transaction>(txBuilder.BuildTx(criteria));
+	};
+
+	// Every tx has the same shape, so they all have the same weight and size.
+	TransactionPtr pLowFeeTx = spend_coinbase(1, 1'000'000);
+	TransactionPtr pMidFeeTx = spend_coinbase(2, 2'000'000);
+	TransactionPtr pHighFeeTx = spend_coinbase(3, 4'000'000);
+	TransactionPtr pBelowFloorTx = spend_coinbase(4, 500'000);
+
+	Serializer serializer;
+	pLowFeeTx->Serialize(serializer);
+	const uint64_t txBytes = serializer.size();
+
+	// Room for 2 txs, but not 3.
+	Json::Value json;
+	json["TX_POOL"]["MEMPOOL_MAX_BYTES"] = Json::UInt64(2 * txBytes + txBytes / 2);
+	Config::Ptr pConfig = Config::Load(json, Environment::AUTOMATED_TESTING);
+	ITransactionPool::Ptr pTxPool = TxPoolAPI::CreateTransactionPool(*pConfig);
+
+	auto add_tx = [&pTestServer, &pTxPool](const TransactionPtr& pTransaction) {
+		auto pBlockDB = pTestServer->GetBlockDB()->Read();
+		auto pTxHashSet = pTestServer->GetTxHashSetManager()->Read()->GetTxHashSet();
+		auto pTip = pTestServer->GetBlockChain()->GetTipBlockHeader(EChainType::CONFIRMED);
+		return pTxPool->AddTransaction(pBlockDB.GetShared(), pTxHashSet, pTransaction, EPoolType::MEMPOOL, *pTip);
+	};
+	auto in_pool = [&pTxPool](const TransactionPtr& pTransaction) {
+		return pTxPool->FindTransactionByKernelHash(pTransaction->GetKernels().front().GetHash()) != nullptr;
+	};
+
+	REQUIRE(add_tx(pMidFeeTx) == EAddTransactionStatus::ADDED);
+	REQUIRE(add_tx(pLowFeeTx) == EAddTransactionStatus::ADDED);
+
+	// Once full, a tx that doesn't beat the lowest fee rate in the pool is rejected.
+	REQUIRE(add_tx(pBelowFloorTx) == EAddTransactionStatus::LOW_FEE);
+	REQUIRE_FALSE(in_pool(pBelowFloorTx));
+	REQUIRE(in_pool(pLowFeeTx));
+	REQUIRE(in_pool(pMidFeeTx));
+
+	// A higher fee rate tx is accepted, and the lowest fee rate tx is evicted to make room.
+	REQUIRE(add_tx(pHighFeeTx) == EAddTransactionStatus::ADDED);
+	REQUIRE(in_pool(pHighFeeTx));
+	REQUIRE(in_pool(pMidFeeTx));
+	REQUIRE_FALSE(in_pool(pLowFeeTx));
+}
@@ -0,0 +1,213 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <Consensus.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Crypto/CSPRNG.h>
+#include <Database/BlockDb.h>
+#include <PMMR/TxHashSetManager.h>
+#include <TxPool/TransactionPool.h>
+#include <TxPool/ValidTransactionFinder.h>
+
+TEST_CASE("ValidTransactionFinder")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom();
+	TxBuilder txBuilder(keyChain);
+
+	// Coinbase maturity for tests is only 25
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+
+	auto spend_coinbase = [&txBuilder, &minedChain](const uint32_t height, const uint32_t outputIndex) {
+		const TransactionOutput& coinbase = minedChain[height].block.GetOutputs().front();
+
+		TxBuilder::Criteria criteria;
+		criteria.inputs = { Test::Input({
+			{ coinbase.GetFeatures(), coinbase.GetCommitment() },
+			minedChain[height].coinbasePath.value(),
+			minedChain[height].coinbaseAmount
+		}) };
+		// Change always uses the same key path, so amounts must differ to keep the change outputs unique.
+		criteria.outputs = { Test::Output{ KeyChainPath({ outputIndex, height }), (uint64_t)(outputIndex * 10'000'000 + height) } };
+		criteria.include_change = true;
+		return std::make_shared<const Transaction>(txBuilder.BuildTx(criteria));
+	};
+	auto find_valid = [&pTestServer](const std::vector<TransactionPtr>& transactions, TransactionPtr pExtraTransaction = nullptr) {
+		auto pBlockDB = pTestServer->GetBlockDB()->Read();
+		auto pTxHashSet = pTestServer->GetTxHashSetManager()->Read()->GetTxHashSet();
+		return ValidTransactionFinder::FindValidTransactions(pBlockDB.GetShared(), pTxHashSet, transactions, pExtraTransaction);
+	};
+
+	SECTION("Double spend")
+	{
+		TransactionPtr pTx = spend_coinbase(1, 1);
+		TransactionPtr pDoubleSpendTx = spend_coinbase(1, 2);
+		TransactionPtr pOtherTx = spend_coinbase(2, 1);
+
+		// The first tx to spend an output wins.
+		REQUIRE(find_valid({ pTx, pDoubleSpendTx, pOtherTx }) == std::vector<TransactionPtr>{ pTx, pOtherTx });
+
+		// Including when it was accepted as part of the extra tx.
+		REQUIRE(find_valid({ pDoubleSpendTx, pOtherTx }, pTx) == std::vector<TransactionPtr>{ pOtherTx });
+	}
+
+	SECTION("Child spends parent's output")
+	{
+		TransactionPtr pParentTx = spend_coinbase(1, 1);
+
+		TxBuilder::Criteria criteria;
+		criteria.inputs = { txBuilder.BuildInput(EOutputFeatures::DEFAULT, KeyChainPath({ 1, 1 }), (uint64_t)10'000'001) };
+		criteria.outputs = { Test::Output{ KeyChainPath({ 2, 1 }), (uint64_t)1'000'000 } };
+		criteria.include_change = true;
+		TransactionPtr pChildTx = std::make_shared<const Transaction>(txBuilder.BuildTx(criteria));
+
+		// The parent's output isn't on chain, so the child is only valid once the parent is accepted.
+		REQUIRE(find_valid({ pChildTx }).empty());
+		REQUIRE(find_valid({ pParentTx, pChildTx }) == std::vector<TransactionPtr>{ pParentTx, pChildTx });
+		REQUIRE(find_valid({ pChildTx }, pParentTx) == std::vector<TransactionPtr>{ pChildTx });
+
+		// The cut-through aggregate is still valid.
+		TransactionPtr pAggregateTx = TransactionUtil::Aggregate({ pParentTx, pChildTx });
+		REQUIRE(pAggregateTx->GetInputs().size() == 1);
+		REQUIRE(find_valid({ pAggregateTx }) == std::vector<TransactionPtr>{ pAggregateTx });
+	}
+
+	SECTION("Duplicate kernel")
+	{
+		TransactionPtr pTx = spend_coinbase(1, 1);
+		TransactionPtr pOtherTx = spend_coinbase(2, 1);
+
+		// Inputs & outputs don't conflict with pTx, but the kernel does.
+		TransactionPtr pDuplicateKernelTx = std::make_shared<const Transaction>(
+			BlindingFactor(pOtherTx->GetOffset()),
+			TransactionBody(
+				std::vector<TransactionInput>(pOtherTx->GetInputs()),
+				std::vector<TransactionOutput>(pOtherTx->GetOutputs()),
+				std::vector<TransactionKernel>(pTx->GetKernels())
+			)
+		);
+
+		REQUIRE(find_valid({ pTx, pDuplicateKernelTx }) == std::vector<TransactionPtr>{ pTx });
+		REQUIRE(find_valid({ pDuplicateKernelTx }) == std::vector<TransactionPtr>{ pDuplicateKernelTx });
+	}
+
+	SECTION("Input not in UTXO set")
+	{
+		TxBuilder::Criteria criteria;
+		criteria.inputs = { txBuilder.BuildInput(EOutputFeatures::DEFAULT, KeyChainPath({ 3, 0 }), (uint64_t)10'000'000'000) };
+		criteria.outputs = { Test::Output{ KeyChainPath({ 4, 0 }), (uint64_t)5'000'000'000 } };
+		criteria.include_change = true;
+		TransactionPtr pMissingInputTx = std::make_shared<const Transaction>(txBuilder.BuildTx(criteria));
+
+		// Coinbase mined at height 29 isn't mature yet.
+		TransactionPtr pImmatureTx = spend_coinbase(29, 1);
+		TransactionPtr pTx = spend_coinbase(1, 1);
+
+		REQUIRE(find_valid({ pMissingInputTx, pImmatureTx, pTx }) == std::vector<TransactionPtr>{ pTx });
+	}
+
+	SECTION("Block weight limit")
+	{
+		TransactionPtr pTx1 = spend_coinbase(1, 1);
+		TransactionPtr pTx2 = spend_coinbase(2, 1);
+		const uint64_t numInputs = pTx1->GetInputs().size();
+		const uint64_t numOutputs = pTx1->GetOutputs().size();
+		const uint64_t numKernels = pTx1->GetKernels().size();
+
+		const uint64_t nextHeight = minedChain.back().block.GetHeight() + 1;
+		auto fits_in_block = [nextHeight](const uint64_t inputs, const uint64_t outputs, const uint64_t kernels) {
+			const uint64_t weight = Consensus::GetHeaderVersion(nextHeight) < 5
+				? Consensus::CalculateWeightV4(inputs, outputs, kernels)
+				: Consensus::CalculateWeightV5(inputs, outputs, kernels);
+			return (weight + Consensus::OUTPUT_WEIGHT + Consensus::KERNEL_WEIGHT) <= Consensus::MAX_BLOCK_WEIGHT;
+		};
+
+		// Fill the block with outputs, leaving room for exactly one more tx.
+		uint64_t numFillerOutputs = 0;
+		while (fits_in_block(numInputs, numFillerOutputs + 1 + numOutputs, numKernels)) {
+			++numFillerOutputs;
+		}
+		REQUIRE_FALSE(fits_in_block(2 * numInputs, numFillerOutputs + 2 * numOutputs, 2 * numKernels));
+
+		// Pool txs were already validated, so only the number of outputs matters here, not their rangeproofs.
+		std::vector<TransactionOutput> fillerOutputs;
+		for (uint64_t i = 0; i < numFillerOutputs; i++)
+		{
+			const SecureVector random = CSPRNG::GenerateRandomBytes(33);
+			std::vector<uint8_t> bytes(random.begin(), random.end());
+			bytes[0] = 0x08;
+			fillerOutputs.push_back(TransactionOutput(
+				EOutputFeatures::DEFAULT,
+				Commitment(CBigInteger<33>(std::move(bytes))),
+				pTx1->GetOutputs().front().GetRangeProof()
+			));
+		}
+		TransactionPtr pFillerTx = std::make_shared<const Transaction>(
+			BlindingFactor(),
+			TransactionBody::NoSort({}, std::move(fillerOutputs), {})
+		);
+
+		REQUIRE(find_valid({ pTx1, pTx2 }, pFillerTx) == std::vector<TransactionPtr>{ pTx1 });
+		REQUIRE(find_valid({ pTx2, pTx1 }, pFillerTx) == std::vector<TransactionPtr>{ pTx2 });
+	}
+}
+
+TEST_CASE("TransactionPool::ReconcileBlock")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom();
+	TxBuilder txBuilder(keyChain);
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+
+	auto spend_coinbase = [&txBuilder, &minedChain](const uint32_t height, const uint32_t outputIndex) {
+		const TransactionOutput& coinbase = minedChain[height].block.GetOutputs().front();
+
+		TxBuilder::Criteria criteria;
+		criteria.inputs = { Test::Input({
+			{ coinbase.GetFeatures(), coinbase.GetCommitment() },
+			minedChain[height].coinbasePath.value(),
+			minedChain[height].coinbaseAmount
+		}) };
+		// Change always uses the same key path, so amounts must differ to keep the change outputs unique.
+		criteria.outputs = { Test::Output{ KeyChainPath({ outputIndex, height }), (uint64_t)(outputIndex * 10'000'000 + height) } };
+		criteria.include_change = true;
+		return std::make_shared<const Transaction>(txBuilder.BuildTx(criteria));
+	};
+
+	const ITransactionPool::Ptr& pTxPool = pTestServer->GetTxPool();
+	auto add_tx = [&pTestServer, &pTxPool](const TransactionPtr& pTransaction) {
+		auto pBlockDB = pTestServer->GetBlockDB()->Read();
+		auto pTxHashSet = pTestServer->GetTxHashSetManager()->Read()->GetTxHashSet();
+		auto pTip = pTestServer->GetBlockChain()->GetTipBlockHeader(EChainType::CONFIRMED);
+		return pTxPool->AddTransaction(pBlockDB.GetShared(), pTxHashSet, pTransaction, EPoolType::MEMPOOL, *pTip);
+	};
+	auto in_pool = [&pTxPool](const TransactionPtr& pTransaction) {
+		return pTxPool->FindTransactionByKernelHash(pTransaction->GetKernels().front().GetHash()) != nullptr;
+	};
+
+	TransactionPtr pMinedTx = spend_coinbase(1, 1);
+	TransactionPtr pConflictingTx = spend_coinbase(2, 1);
+	TransactionPtr pUnaffectedTx = spend_coinbase(3, 1);
+	REQUIRE(add_tx(pMinedTx) == EAddTransactionStatus::ADDED);
+	REQUIRE(add_tx(pConflictingTx) == EAddTransactionStatus::ADDED);
+	REQUIRE(add_tx(pUnaffectedTx) == EAddTransactionStatus::ADDED);
+
+	// The next block includes pMinedTx, and a different tx spending the same coinbase as pConflictingTx.
+	TransactionPtr pDoubleSpendTx = spend_coinbase(2, 2);
+	Test::Tx coinbaseTx = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 30 }));
+	TransactionPtr pBlockTx = TransactionUtil::Aggregate({ coinbaseTx.pTransaction, pMinedTx, pDoubleSpendTx });
+
+	FullBlock block = miner.MineNextBlock(minedChain.back().block.GetHeader(), *pBlockTx);
+	REQUIRE(pTestServer->GetBlockChain()->AddBlock(block) == EBlockChainStatus::SUCCESS);
+
+	// Adding the block reconciles the pool.
+	REQUIRE_FALSE(in_pool(pMinedTx));
+	REQUIRE_FALSE(in_pool(pConflictingTx));
+	REQUIRE(in_pool(pUnaffectedTx));
+}
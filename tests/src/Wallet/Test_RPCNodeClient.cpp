@@ -0,0 +1,65 @@
+#include <catch.hpp>
+
+#include <Server/Node/NodeClients/RPCNodeClient.h>
+#include <Crypto/CSPRNG.h>
+
+static HTTP::Response BuildResponse(const unsigned int statusCode, const std::string& contentType, const std::vector<uint8_t>& body)
+{
+	std::vector<HTTP::Header> headers = {
+		HTTP::Header{ "Content-Length", std::to_string(body.size()) },
+		HTTP::Header{ "Content-Type", contentType }
+	};
+
+	return HTTP::Response(statusCode, std::move(headers), std::string(body.cbegin(), body.cend()));
+}
+
+TEST_CASE("RPCNodeClient - Binary output range fallback")
+{
+	SecureVector commitBytes = CSPRNG::GenerateRandomBytes(33);
+	SecureVector proofBytes = CSPRNG::GenerateRandomBytes(MAX_PROOF_SIZE);
+	std::vector<OutputDTO> outputs;
+	outputs.push_back(OutputDTO(
+		false,
+		OutputIdentifier(EOutputFeatures::DEFAULT, Commitment(CBigInteger<33>(std::vector<uint8_t>(commitBytes.begin(), commitBytes.end())))),
+		OutputLocation(LeafIndex::At(3), 2),
+		RangeProof(std::vector<uint8_t>(proofBytes.begin(), proofBytes.end()))
+	));
+
+	Serializer serializer;
+	OutputRange(10, 3, std::move(outputs)).Serialize(serializer);
+
+	// Nodes with the binary endpoint
+	std::unique_ptr<OutputRange> pRange = RPCNodeClient::ParseBinaryOutputRange(
+		BuildResponse(200, "application/octet-stream", serializer.GetBytes())
+	);
+	REQUIRE(pRange != nullptr);
+	REQUIRE(pRange->GetHighestIndex() == 10);
+	REQUIRE(pRange->GetLastRetrievedIndex() == 3);
+	REQUIRE(pRange->GetOutputs().size() == 1);
+
+	// Older nodes prefix-match the binary path to the JSON txhashset/outputs handler.
+	const std::string json = "{\"highest_index\":10,\"last_retrieved_index\":3,\"outputs\":[]}";
+	REQUIRE(RPCNodeClient::ParseBinaryOutputRange(
+		BuildResponse(200, "application/json", std::vector<uint8_t>(json.cbegin(), json.cend()))
+	) == nullptr);
+
+	// Nodes without the binary endpoint
+	REQUIRE(RPCNodeClient::ParseBinaryOutputRange(
+		BuildResponse(404, "text/plain", {})
+	) == nullptr);
+
+	// Nodes that only serve a newer binary format
+	std::vector<uint8_t> newVersion = serializer.GetBytes();
+	newVersion[0] = OutputRange::BINARY_FORMAT_VERSION + 1;
+	REQUIRE(RPCNodeClient::ParseBinaryOutputRange(
+		BuildResponse(200, "application/octet-stream", newVersion)
+	) == nullptr);
+
+	// Other failures may be temporary, so they're errors, which GetOutputsByLeafIndex handles
+	// by falling back to JSON for that request only.
+	REQUIRE_THROWS(RPCNodeClient::ParseBinaryOutputRange(BuildResponse(503, "text/plain", {})));
+
+	std::vector<uint8_t> truncated = serializer.GetBytes();
+	truncated.resize(truncated.size() / 2);
+	REQUIRE_THROWS(RPCNodeClient::ParseBinaryOutputRange(BuildResponse(200, "application/octet-stream", truncated)));
+}
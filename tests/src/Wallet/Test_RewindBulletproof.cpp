@@ -46,4 +46,29 @@ TEST_CASE("REWIND_BULLETPROOF_ENHANCED")
 	REQUIRE(pRewoundProof != nullptr);
 	REQUIRE(amount == pRewoundProof->GetAmount());
 	REQUIRE(keyId.GetKeyIndices() == pRewoundProof->GetProofMessage().ToKeyIndices(EBulletproofType::ENHANCED));
-}
\ No newline at end of file
+}
+
+TEST_CASE("REWIND_BULLETPROOF_ENHANCED_RESTORED_KEYCHAIN")
+{
+	const CBigInteger<32> masterSeed = CSPRNG::GenerateRandom32();
+	const SecureVector masterSeedBytes(masterSeed.GetData().begin(), masterSeed.GetData().end());
+	const uint64_t amount = 1000;
+	KeyChainPath keyId(std::vector<uint32_t>({ 0, 0, 5 }));
+
+	KeyChain keyChain = KeyChain::FromSeed(masterSeedBytes);
+	SecretKey blindingFactor = keyChain.DerivePrivateKey(keyId, amount);
+	Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blindingFactor.GetBytes()));
+	RangeProof rangeProof = keyChain.GenerateRangeProof(keyId, amount, commitment, blindingFactor, EBulletproofType::ENHANCED);
+
+	// A keychain restored from the same seed must be able to rewind the proof.
+	KeyChain restoredKeyChain = KeyChain::FromSeed(masterSeedBytes);
+	std::unique_ptr<RewoundProof> pRewoundProof = restoredKeyChain.RewindRangeProof(commitment, rangeProof, EBulletproofType::ENHANCED);
+	REQUIRE(pRewoundProof != nullptr);
+	REQUIRE(amount == pRewoundProof->GetAmount());
+	REQUIRE(keyId.GetKeyIndices() == pRewoundProof->GetProofMessage().ToKeyIndices(EBulletproofType::ENHANCED));
+
+	// A keychain from a different seed must not.
+	KeyChain otherKeyChain = KeyChain::FromRandom();
+	REQUIRE(otherKeyChain.RewindRangeProof(commitment, rangeProof, EBulletproofType::ENHANCED) == nullptr);
+	REQUIRE(otherKeyChain.RewindRangeProof(commitment, rangeProof, EBulletproofType::ORIGINAL) == nullptr);
+}
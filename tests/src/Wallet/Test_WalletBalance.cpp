@@ -0,0 +1,52 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+
+#include <Wallet/Wallet.h>
+#include <Wallet/WalletDB/WalletDB.h>
+
+TEST_CASE("Wallet Balance - Output Totals")
+{
+    TestServer::Ptr pTestServer = TestServer::CreateWithWallet();
+    auto pWallet = pTestServer->CreateUser("Alice", "P@ssw0rd123!", UseTor::NO).wallet;
+
+    TestChain chain(pTestServer->GetBlockChain());
+    chain.MineChain(pWallet, 10);
+
+    const uint64_t reward = (uint64_t)Consensus::REWARD;
+    const SecureVector masterSeed = pWallet->GetWallet().Read()->GetMasterSeed();
+    Locked<IWalletDB> walletDB = pWallet->GetWallet().Read()->GetDatabase();
+
+    std::vector<OutputDataEntity> outputs = walletDB.Read()->GetOutputs(masterSeed);
+    REQUIRE(outputs.size() == 10);
+
+    // Coinbase outputs are immature until they reach coinbase maturity.
+    WalletBalanceDTO balance = pWallet->GetWallet().Read()->GetBalance();
+    REQUIRE(balance.GetTotal() == 10 * reward);
+    REQUIRE(balance.GetImmature() == 10 * reward);
+    REQUIRE(balance.GetSpendable() == 0);
+    REQUIRE(balance.GetLocked() == 0);
+
+    // Totals follow status changes without needing to reload every output.
+    OutputDataEntity lockedOutput = outputs.front();
+    lockedOutput.SetStatus(EOutputStatus::LOCKED);
+    {
+        auto pBatch = walletDB.BatchWrite();
+        pBatch->SaveOutput(masterSeed, lockedOutput);
+        pBatch->Commit();
+    }
+
+    std::map<EOutputStatus, uint64_t> totals = walletDB.Read()->GetOutputTotals(masterSeed);
+    REQUIRE(totals[EOutputStatus::SPENDABLE] == 9 * reward);
+    REQUIRE(totals[EOutputStatus::LOCKED] == reward);
+
+    balance = pWallet->GetWallet().Read()->GetBalance();
+    REQUIRE(balance.GetImmature() == 9 * reward);
+    REQUIRE(balance.GetLocked() == reward);
+
+    // Indexed queries only return the requested statuses.
+    REQUIRE(walletDB.Read()->GetOutputs(masterSeed, { EOutputStatus::LOCKED }).size() == 1);
+    REQUIRE(walletDB.Read()->GetOutputs(masterSeed, { EOutputStatus::SPENDABLE }).size() == 9);
+    REQUIRE(walletDB.Read()->GetRecentOutputs(masterSeed, { EOutputStatus::SPENDABLE }, 6).size() == 5);
+}
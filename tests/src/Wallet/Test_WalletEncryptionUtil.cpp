@@ -0,0 +1,33 @@
+#include <catch.hpp>
+
+#include <Wallet/WalletDB/WalletEncryptionUtil.h>
+#include <Crypto/CSPRNG.h>
+
+TEST_CASE("WalletEncryptionUtil - Encrypt/Decrypt")
+{
+	const SecureVector masterSeed1 = CSPRNG::GenerateRandomBytes(32);
+	const SecureVector masterSeed2 = CSPRNG::GenerateRandomBytes(32);
+	const SecureVector bytes = CSPRNG::GenerateRandomBytes(100);
+
+	// Each wallet has its own cache, so interleave wallets and data types to make sure the right key is used.
+	WalletEncryptionUtil::KeyCache keyCache1;
+	WalletEncryptionUtil::KeyCache keyCache2;
+	const std::vector<uint8_t> encrypted1 = WalletEncryptionUtil::Encrypt(keyCache1, masterSeed1, "OUTPUT", bytes);
+	const std::vector<uint8_t> encrypted2 = WalletEncryptionUtil::Encrypt(keyCache2, masterSeed2, "OUTPUT", bytes);
+	const std::vector<uint8_t> encrypted3 = WalletEncryptionUtil::Encrypt(keyCache1, masterSeed1, "WALLET_TX", bytes);
+
+	REQUIRE(WalletEncryptionUtil::Decrypt(keyCache1, masterSeed1, "OUTPUT", encrypted1) == bytes);
+	REQUIRE(WalletEncryptionUtil::Decrypt(keyCache2, masterSeed2, "OUTPUT", encrypted2) == bytes);
+	REQUIRE(WalletEncryptionUtil::Decrypt(keyCache1, masterSeed1, "WALLET_TX", encrypted3) == bytes);
+
+	// Cached keys match the uncached ones.
+	REQUIRE(WalletEncryptionUtil::Decrypt(masterSeed1, "OUTPUT", encrypted1) == bytes);
+	REQUIRE(WalletEncryptionUtil::Decrypt(masterSeed2, "OUTPUT", encrypted2) == bytes);
+	REQUIRE(WalletEncryptionUtil::Decrypt(keyCache2, masterSeed2, "OUTPUT", WalletEncryptionUtil::Encrypt(masterSeed2, "OUTPUT", bytes)) == bytes);
+
+	// Keys must be re-derived identically after the cache is cleared.
+	keyCache1.Clear();
+
+	REQUIRE(WalletEncryptionUtil::Decrypt(keyCache1, masterSeed1, "OUTPUT", encrypted1) == bytes);
+	REQUIRE(WalletEncryptionUtil::Decrypt(keyCache1, masterSeed1, "WALLET_TX", encrypted3) == bytes);
+}
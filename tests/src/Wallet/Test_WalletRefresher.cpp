@@ -0,0 +1,298 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TestNodeClient.h>
+#include <TxBuilder.h>
+
+#include <Wallet/Wallet.h>
+#include <Wallet/WalletDB/WalletDB.h>
+#include <Wallet/WalletRefresher.h>
+#include <Wallet/WalletDB/Sqlite/SqliteDB.h>
+#include <Wallet/WalletDB/Sqlite/SqliteStore.h>
+#include <Wallet/WalletDB/Sqlite/Schema.h>
+#include <Wallet/WalletDB/Sqlite/Tables/VersionTable.h>
+
+//
+// Records the commitments the refresher asks the node about, so tests can tell incremental refreshes from full ones.
+//
+class CountingNodeClient : public INodeClient
+{
+public:
+	CountingNodeClient(const std::shared_ptr<INodeClient>& pNodeClient)
+		: m_pNodeClient(pNodeClient) { }
+
+	uint64_t GetChainHeight() const final { return m_pNodeClient->GetChainHeight(); }
+	BlockHeaderPtr GetTipHeader() const final { return m_pNodeClient->GetTipHeader(); }
+	BlockHeaderPtr GetBlockHeader(const uint64_t height) const final { return m_pNodeClient->GetBlockHeader(height); }
+
+	std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>& commitments) const final
+	{
+		m_requested.insert(m_requested.end(), commitments.cbegin(), commitments.cend());
+		return m_pNodeClient->GetOutputsByCommitment(commitments);
+	}
+
+	std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t startHeight, const uint64_t maxHeight) const final
+	{
+		return m_pNodeClient->GetBlockOutputs(startHeight, maxHeight);
+	}
+
+	std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const final
+	{
+		return m_pNodeClient->GetOutputsByLeafIndex(startIndex, maxNumOutputs);
+	}
+
+	bool PostTransaction(TransactionPtr pTransaction, const EPoolType poolType) final
+	{
+		return m_pNodeClient->PostTransaction(pTransaction, poolType);
+	}
+
+	std::vector<Commitment> TakeRequested() const
+	{
+		std::vector<Commitment> requested;
+		requested.swap(m_requested);
+		return requested;
+	}
+
+private:
+	std::shared_ptr<INodeClient> m_pNodeClient;
+	mutable std::vector<Commitment> m_requested;
+};
+
+static std::shared_ptr<CountingNodeClient> CreateNodeClient(const TestServer::Ptr& pTestServer)
+{
+	auto pTestNodeClient = std::make_shared<TestNodeClient>(
+		pTestServer->GetDatabase(),
+		*pTestServer->GetTxHashSetManager(),
+		pTestServer->GetTxPool(),
+		pTestServer->GetBlockChain()
+	);
+	return std::make_shared<CountingNodeClient>(pTestNodeClient);
+}
+
+static void MineWalletBlock(TestChain& chain, const IBlockChain::Ptr& pBlockChain, const TestWallet::Ptr& pWallet, const uint64_t height)
+{
+	Test::Tx coinbase = pWallet->CreateCoinbase(KeyChainPath::FromString("m/0/0/" + std::to_string(height)), 0);
+	MinedBlock block = chain.AddNextBlock({ coinbase });
+	REQUIRE(pBlockChain->AddBlock(block.block) == EBlockChainStatus::SUCCESS);
+}
+
+TEST_CASE("WalletRefresher - Incremental Refresh")
+{
+	TestServer::Ptr pTestServer = TestServer::CreateWithWallet();
+	auto pWallet = pTestServer->CreateUser("Alice", "P@ssw0rd123!", UseTor::NO).wallet;
+	auto pBlockChain = pTestServer->GetBlockChain();
+
+	const SecureVector masterSeed = pWallet->GetWallet().Read()->GetMasterSeed();
+	Locked<IWalletDB> walletDB = pWallet->GetWallet().Read()->GetDatabase();
+
+	auto pNodeClient = CreateNodeClient(pTestServer);
+	WalletRefresher refresher(Global::GetConfig(), pNodeClient);
+
+	TestChain chain(pBlockChain);
+	for (uint64_t height = 1; height <= 5; height++) {
+		MineWalletBlock(chain, pBlockChain, pWallet, height);
+	}
+
+	// First refresh has no checkpoint to start from, so every output is checked.
+	refresher.Refresh(masterSeed, walletDB, false);
+	REQUIRE(pNodeClient->TakeRequested().size() == 5);
+
+	std::vector<RefreshCheckpoint> checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 1);
+	REQUIRE(checkpoints.front().GetHeight() == 5);
+	REQUIRE(checkpoints.front().GetHash() == pBlockChain->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash());
+
+	// Tip hasn't changed, so there's nothing to refresh.
+	refresher.Refresh(masterSeed, walletDB, false);
+	REQUIRE(pNodeClient->TakeRequested().empty());
+
+	// Spent outputs are skipped by incremental refreshes.
+	OutputDataEntity spentOutput = walletDB.Read()->GetOutputs(masterSeed).front();
+	spentOutput.SetStatus(EOutputStatus::SPENT);
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->SaveOutput(masterSeed, spentOutput);
+		pBatch->Commit();
+	}
+
+	MineWalletBlock(chain, pBlockChain, pWallet, 6);
+
+	refresher.Refresh(masterSeed, walletDB, false);
+	std::vector<Commitment> requested = pNodeClient->TakeRequested();
+	REQUIRE(requested.size() == 5);
+	REQUIRE(std::find(requested.cbegin(), requested.cend(), spentOutput.GetCommitment()) == requested.cend());
+
+	checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 2);
+	REQUIRE(checkpoints[0].GetHeight() == 6);
+	REQUIRE(checkpoints[1].GetHeight() == 5);
+
+	// Refreshing from genesis always checks every output.
+	refresher.Refresh(masterSeed, walletDB, true);
+	REQUIRE(pNodeClient->TakeRequested().size() == 6);
+}
+
+TEST_CASE("WalletRefresher - Rollback After Reorg")
+{
+	TestServer::Ptr pTestServer = TestServer::CreateWithWallet();
+	auto pWallet = pTestServer->CreateUser("Alice", "P@ssw0rd123!", UseTor::NO).wallet;
+	auto pBlockChain = pTestServer->GetBlockChain();
+
+	const SecureVector masterSeed = pWallet->GetWallet().Read()->GetMasterSeed();
+	Locked<IWalletDB> walletDB = pWallet->GetWallet().Read()->GetDatabase();
+
+	auto pNodeClient = CreateNodeClient(pTestServer);
+	WalletRefresher refresher(Global::GetConfig(), pNodeClient);
+
+	TestChain chain(pBlockChain);
+	for (uint64_t height = 1; height <= 6; height++) {
+		MineWalletBlock(chain, pBlockChain, pWallet, height);
+	}
+	refresher.Refresh(masterSeed, walletDB, false);
+
+	MineWalletBlock(chain, pBlockChain, pWallet, 7);
+	MineWalletBlock(chain, pBlockChain, pWallet, 8);
+	refresher.Refresh(masterSeed, walletDB, false);
+
+	REQUIRE(walletDB.Read()->GetOutputs(masterSeed, { EOutputStatus::NO_CONFIRMATIONS }).empty());
+
+	//
+	// 1 - ... - 6 - 7 - 8
+	//              \_ 7' - 8' - 9'
+	//
+	// The fork outputs belong to someone else, so the wallet's outputs at 7 & 8 are no longer on chain.
+	//
+	KeyChain forkKeyChain = KeyChain::FromRandom();
+	TxBuilder txBuilder(forkKeyChain);
+
+	chain.Rewind(7);
+	for (uint32_t height = 7; height <= 9; height++) {
+		Test::Tx coinbase = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, height }));
+		MinedBlock block = chain.AddNextBlock({ coinbase }, height == 7 ? 10 : 0);
+		REQUIRE(pBlockChain->AddBlock(block.block) == EBlockChainStatus::SUCCESS);
+	}
+	REQUIRE(pBlockChain->GetHeight(EChainType::CONFIRMED) == 9);
+
+	refresher.Refresh(masterSeed, walletDB, false);
+
+	// Outputs confirmed above the fork point are awaiting confirmation again.
+	std::vector<OutputDataEntity> unconfirmed = walletDB.Read()->GetOutputs(masterSeed, { EOutputStatus::NO_CONFIRMATIONS });
+	REQUIRE(unconfirmed.size() == 2);
+	for (const OutputDataEntity& output : unconfirmed) {
+		REQUIRE(output.GetBlockHeight().value_or(0) > 6);
+	}
+
+	REQUIRE(walletDB.Read()->GetOutputs(masterSeed, { EOutputStatus::SPENDABLE, EOutputStatus::IMMATURE }).size() == 6);
+
+	// Checkpoints from the abandoned fork are gone, and the new tip is checkpointed on top of the fork point.
+	std::vector<RefreshCheckpoint> checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 2);
+	REQUIRE(checkpoints[0].GetHeight() == 9);
+	REQUIRE(checkpoints[0].GetHash() == pBlockChain->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash());
+	REQUIRE(checkpoints[1].GetHeight() == 6);
+}
+
+TEST_CASE("WalletDB - Refresh Checkpoints")
+{
+	TestServer::Ptr pTestServer = TestServer::CreateWithWallet();
+	auto pWallet = pTestServer->CreateUser("Alice", "P@ssw0rd123!", UseTor::NO).wallet;
+	Locked<IWalletDB> walletDB = pWallet->GetWallet().Read()->GetDatabase();
+
+	REQUIRE(walletDB.Read()->GetRefreshCheckpoints().empty());
+
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddRefreshCheckpoint(RefreshCheckpoint(20, Hash::FromHex("0202020202020202020202020202020202020202020202020202020202020202"), 2));
+		pBatch->AddRefreshCheckpoint(RefreshCheckpoint(10, Hash::FromHex("0101010101010101010101010101010101010101010101010101010101010101"), 1));
+		pBatch->AddRefreshCheckpoint(RefreshCheckpoint(30, Hash::FromHex("0303030303030303030303030303030303030303030303030303030303030303"), 3));
+		pBatch->Commit();
+	}
+
+	// Checkpoints are returned from highest to lowest.
+	std::vector<RefreshCheckpoint> checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 3);
+	REQUIRE(checkpoints[0].GetHeight() == 30);
+	REQUIRE(checkpoints[1].GetHeight() == 20);
+	REQUIRE(checkpoints[2].GetHeight() == 10);
+	REQUIRE(checkpoints[1].GetRestoreLeafIndex() == 2);
+
+	// A checkpoint at an existing height replaces it.
+	const Hash replacedHash = Hash::FromHex("2020202020202020202020202020202020202020202020202020202020202020");
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddRefreshCheckpoint(RefreshCheckpoint(20, replacedHash, 5));
+		pBatch->Commit();
+	}
+
+	checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 3);
+	REQUIRE(checkpoints[1].GetHash() == replacedHash);
+	REQUIRE(checkpoints[1].GetRestoreLeafIndex() == 5);
+
+	// Trimming keeps the boundary height.
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->DeleteRefreshCheckpointsBelow(20);
+		pBatch->Commit();
+	}
+
+	checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 2);
+	REQUIRE(checkpoints.back().GetHeight() == 20);
+
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->DeleteRefreshCheckpointsAbove(20);
+		pBatch->Commit();
+	}
+
+	checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 1);
+	REQUIRE(checkpoints.front().GetHeight() == 20);
+
+	// Uncommitted batches leave the checkpoints untouched.
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->DeleteRefreshCheckpointsAbove(0);
+		pBatch->Rollback();
+	}
+
+	REQUIRE(walletDB.Read()->GetRefreshCheckpoints().size() == 1);
+}
+
+TEST_CASE("WalletDB - Migrate Refresh Checkpoints From v4")
+{
+	TestServer::Ptr pTestServer = TestServer::CreateWithWallet();
+	auto pWallet = pTestServer->CreateUser("Alice", "P@ssw0rd123!", UseTor::NO).wallet;
+	const SecureVector masterSeed = pWallet->GetWallet().Read()->GetMasterSeed();
+
+	// Turn the wallet back into a v4 wallet, from before refresh checkpoints existed.
+	const fs::path dbFile = Global::GetConfig().GetWalletPath() / "alice" / "wallet.db";
+	{
+		SqliteDB::Ptr pDatabase = SqliteDB::Open(dbFile, "alice");
+		pDatabase->Execute("drop table refresh_checkpoints; update version set schema_version=4;");
+		REQUIRE(VersionTable::GetCurrentVersion(*pDatabase) == 4);
+	}
+
+	std::shared_ptr<SqliteStore> pStore = SqliteStore::Open(Global::GetConfig());
+	Locked<IWalletDB> walletDB = pStore->OpenWallet("alice", masterSeed);
+
+	{
+		SqliteDB::Ptr pDatabase = SqliteDB::Open(dbFile, "alice");
+		REQUIRE(VersionTable::GetCurrentVersion(*pDatabase) == LATEST_SCHEMA_VERSION);
+	}
+
+	REQUIRE(walletDB.Read()->GetRefreshCheckpoints().empty());
+
+	const Hash hash = Hash::FromHex("0404040404040404040404040404040404040404040404040404040404040404");
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddRefreshCheckpoint(RefreshCheckpoint(4, hash, 0));
+		pBatch->Commit();
+	}
+
+	std::vector<RefreshCheckpoint> checkpoints = walletDB.Read()->GetRefreshCheckpoints();
+	REQUIRE(checkpoints.size() == 1);
+	REQUIRE(checkpoints.front().GetHash() == hash);
+}